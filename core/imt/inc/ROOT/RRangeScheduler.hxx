@@ -0,0 +1,60 @@
+/*************************************************************************
+ * Copyright (C) 1995-2023, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RRANGESCHEDULER
+#define ROOT_RRANGESCHEDULER
+
+#include <RtypesCore.h> // ULong64_t
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <utility> // std::pair
+#include <vector>
+
+namespace ROOT {
+namespace Internal {
+
+/// Distribute a range of entries among the workers of a multi-thread event loop.
+/// Each worker initially owns a contiguous share of the range, from which it takes small sub-ranges of at most
+/// `grainSize` entries. A worker that runs out of entries steals the second half of the remaining entries of the
+/// worker with the most work left. This way large ranges are only split when needed, each worker mostly processes
+/// consecutive entries, and no worker stays idle while there is work left to do.
+class RRangeScheduler {
+public:
+   using Range_t = std::pair<ULong64_t, ULong64_t>;
+
+private:
+   /// The entries of a worker that have not been handed out yet
+   struct RWorkerRange {
+      std::mutex fMutex;
+      ULong64_t fBegin = 0;
+      ULong64_t fEnd = 0;
+   };
+
+   std::vector<std::unique_ptr<RWorkerRange>> fWorkerRanges;
+   ULong64_t fGrainSize;
+   std::atomic<ULong64_t> fNSteals{0};
+
+   bool Steal(unsigned int worker);
+
+public:
+   RRangeScheduler(const Range_t &range, unsigned int nWorkers, ULong64_t grainSize);
+   RRangeScheduler(const RRangeScheduler &) = delete;
+   RRangeScheduler &operator=(const RRangeScheduler &) = delete;
+
+   /// Retrieve the next sub-range that `worker` should process. Return false when all entries have been handed out.
+   bool Next(unsigned int worker, Range_t &range);
+   /// The number of times a worker took over entries initially assigned to another worker
+   ULong64_t GetNSteals() const { return fNSteals; }
+};
+
+} // namespace Internal
+} // namespace ROOT
+
+#endif
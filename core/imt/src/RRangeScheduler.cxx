@@ -0,0 +1,95 @@
+/*************************************************************************
+ * Copyright (C) 1995-2023, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/RRangeScheduler.hxx"
+
+#include <algorithm>
+
+namespace ROOT {
+namespace Internal {
+
+RRangeScheduler::RRangeScheduler(const Range_t &range, unsigned int nWorkers, ULong64_t grainSize)
+   : fGrainSize(std::max(grainSize, ULong64_t(1)))
+{
+   nWorkers = std::max(nWorkers, 1u);
+   const auto nEntries = range.second > range.first ? range.second - range.first : 0ull;
+   const auto nEntriesPerWorker = nEntries / nWorkers;
+   auto remainder = nEntries % nWorkers;
+   auto begin = range.first;
+   for (auto i = 0u; i < nWorkers; ++i) {
+      fWorkerRanges.emplace_back(std::make_unique<RWorkerRange>());
+      auto end = begin + nEntriesPerWorker;
+      if (remainder > 0) {
+         ++end;
+         --remainder;
+      }
+      fWorkerRanges.back()->fBegin = begin;
+      fWorkerRanges.back()->fEnd = end;
+      begin = end;
+   }
+}
+
+bool RRangeScheduler::Next(unsigned int worker, Range_t &range)
+{
+   auto &workerRange = *fWorkerRanges[worker];
+   do {
+      std::lock_guard<std::mutex> lock(workerRange.fMutex);
+      if (workerRange.fBegin < workerRange.fEnd) {
+         range.first = workerRange.fBegin;
+         range.second = std::min(workerRange.fEnd, workerRange.fBegin + fGrainSize);
+         workerRange.fBegin = range.second;
+         return true;
+      }
+   } while (Steal(worker));
+
+   return false;
+}
+
+/// Move half of the remaining entries of the busiest worker to `worker`. Return false if there was nothing to steal.
+bool RRangeScheduler::Steal(unsigned int worker)
+{
+   while (true) {
+      // find the worker with the most entries left
+      RWorkerRange *victim = nullptr;
+      ULong64_t maxLeft = 0;
+      for (auto &candidate : fWorkerRanges) {
+         std::lock_guard<std::mutex> lock(candidate->fMutex);
+         const auto left = candidate->fEnd - candidate->fBegin;
+         if (left > maxLeft) {
+            maxLeft = left;
+            victim = candidate.get();
+         }
+      }
+      if (victim == nullptr)
+         return false;
+
+      Range_t stolen;
+      {
+         std::lock_guard<std::mutex> lock(victim->fMutex);
+         const auto left = victim->fEnd - victim->fBegin;
+         if (left == 0)
+            continue; // someone else got there first, look for another victim
+         // if only a grain is left, take it all: the victim is busy with its current sub-range anyway
+         const auto split = left <= fGrainSize ? victim->fBegin : victim->fBegin + left / 2;
+         stolen = {split, victim->fEnd};
+         victim->fEnd = split;
+      }
+
+      // the stolen entries are not reachable by other workers until they are assigned to this worker, and this
+      // worker's range is empty, so there is no need to hold both locks at the same time
+      auto &workerRange = *fWorkerRanges[worker];
+      std::lock_guard<std::mutex> lock(workerRange.fMutex);
+      workerRange.fBegin = stolen.first;
+      workerRange.fEnd = stolen.second;
+      ++fNSteals;
+      return true;
+   }
+}
+
+} // namespace Internal
+} // namespace ROOT
@@ -0,0 +1,52 @@
+#include "ROOT/RRangeScheduler.hxx"
+
+#include "gtest/gtest.h"
+
+#include <utility>
+#include <vector>
+
+TEST(RRangeScheduler, StealHalf)
+{
+   ROOT::Internal::RRangeScheduler scheduler({10, 110}, 4, 5);
+
+   // worker 0 takes its share in grains
+   std::pair<ULong64_t, ULong64_t> range;
+   ASSERT_TRUE(scheduler.Next(0, range));
+   EXPECT_EQ(range, std::make_pair(10ull, 15ull));
+
+   // worker 1 processes all of its entries
+   std::vector<int> processed(120, 0);
+   ULong64_t nProcessed = 5;
+   for (int i = 0; i < 5; ++i) {
+      ASSERT_TRUE(scheduler.Next(1, range));
+      EXPECT_EQ(range.second - range.first, 5u);
+      EXPECT_GE(range.first, 35u);
+      EXPECT_LE(range.second, 60u);
+      nProcessed += range.second - range.first;
+   }
+   EXPECT_EQ(scheduler.GetNSteals(), 0u);
+
+   // ...then steals half of the remaining entries of one of the others
+   ASSERT_TRUE(scheduler.Next(1, range));
+   EXPECT_EQ(scheduler.GetNSteals(), 1u);
+   EXPECT_GE(range.first, 60u);
+   nProcessed += range.second - range.first;
+   for (auto e = range.first; e < range.second; ++e)
+      ++processed[e];
+
+   // all entries are handed out exactly once
+   for (auto e = 10u; e < 15u; ++e)
+      ++processed[e];
+   for (auto e = 35u; e < 60u; ++e)
+      ++processed[e];
+   for (unsigned int worker : {3u, 0u, 2u, 1u}) {
+      while (scheduler.Next(worker, range)) {
+         nProcessed += range.second - range.first;
+         for (auto e = range.first; e < range.second; ++e)
+            ++processed[e];
+      }
+   }
+   EXPECT_EQ(nProcessed, 100u);
+   for (auto e = 0u; e < processed.size(); ++e)
+      EXPECT_EQ(processed[e], (e >= 10 && e < 110) ? 1 : 0) << "entry " << e;
+}
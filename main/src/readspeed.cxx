@@ -11,6 +11,9 @@
 #include "ReadSpeedCLI.hxx"
 #include "ReadSpeed.hxx"
 
+#include <iostream>
+#include <vector>
+
 using namespace ReadSpeed;
 
 int main(int argc, char **argv)
@@ -20,7 +23,27 @@ int main(int argc, char **argv)
    if (!args.fShouldRun)
       return 1; // ParseArgs has printed the --help, has run the --test or has encountered an issue and logged about it
 
-   PrintThroughput(EvalThroughput(args.fData, args.fNThreads));
+   std::vector<Result> results;
+   if (args.fThreadScan.size() > 1) {
+      for (const auto nThreads : args.fThreadScan) {
+         std::cout << "Running with " << nThreads << " threads:\n";
+         results.emplace_back(EvalThroughput(args.fData, nThreads));
+         PrintThroughput(results.back());
+         std::cout << '\n';
+      }
+   } else {
+      results.emplace_back(EvalThroughput(args.fData, args.fNThreads));
+      PrintThroughput(results.back());
+   }
+
+   if (!args.fOutputFile.empty())
+      WriteResults(args.fOutputFile, args.fData, results);
+
+   if (!args.fBaselineFile.empty()) {
+      std::cout << "\nComparison to " << args.fBaselineFile << ":\n";
+      if (CompareToBaseline(args.fBaselineFile, args.fData, results, args.fTolerance) > 0)
+         return 2;
+   }
 
    return 0;
 }
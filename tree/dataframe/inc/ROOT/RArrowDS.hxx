@@ -53,6 +53,7 @@ public:
 };
 
 RDataFrame FromArrow(std::shared_ptr<arrow::Table> table, std::vector<std::string> const &columnNames);
+RDataFrame FromArrowFile(std::string_view fileName, std::vector<std::string> const &columnNames);
 
 } // namespace RDF
 
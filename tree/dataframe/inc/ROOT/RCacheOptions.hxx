@@ -0,0 +1,31 @@
+/*************************************************************************
+ * Copyright (C) 1995-2023, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RCACHEOPTIONS
+#define ROOT_RCACHEOPTIONS
+
+#include <RtypesCore.h> // ULong64_t
+
+#include <string>
+
+namespace ROOT {
+
+namespace RDF {
+/// A collection of options to steer the storage of the values cached by RInterface::Cache
+struct RCacheOptions {
+   /// Maximum amount of memory, in bytes, used to store the cached values. 0 means no limit.
+   /// Values that do not fit in the budget are written to a temporary file and read back when needed.
+   ULong64_t fMemoryBudget = 0;
+   /// Directory of the temporary file used for the values that exceed the memory budget. If empty, the temporary
+   /// directory of the system is used.
+   std::string fSpillDirectory;
+};
+} // ns RDF
+} // ns ROOT
+
+#endif
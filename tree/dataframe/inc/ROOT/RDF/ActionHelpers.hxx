@@ -62,6 +62,8 @@
 /// \cond HIDDEN_SYMBOLS
 
 namespace ROOT {
+class RDataFrame;
+
 namespace Internal {
 namespace RDF {
 using namespace ROOT::TypeTraits;
@@ -1638,6 +1640,9 @@ public:
    {
       return [this](unsigned int, const RSampleInfo &) mutable { fBranchAddressesNeedReset = true; };
    }
+
+   /// Output branches are bound to the addresses of the input values, which change from entry to entry in batch mode.
+   bool SupportsBatchMode() const final { return false; }
 };
 
 /// Helper object for a multi-thread Snapshot action
@@ -1805,6 +1810,63 @@ public:
    {
       return [this](unsigned int slot, const RSampleInfo &) mutable { fBranchAddressesNeedReset[slot] = 1; };
    }
+
+   /// See SnapshotHelper::SupportsBatchMode()
+   bool SupportsBatchMode() const final { return false; }
+};
+
+/// Type-erased writer of the RNTuple produced by a Snapshot action, see SnapshotRNTupleHelper
+class RNTupleSnapshotWriterBase {
+public:
+   virtual ~RNTupleSnapshotWriterBase() = default;
+   virtual void Initialize() = 0;
+   /// Write an entry: `values` holds the addresses of the values of the output fields, in order
+   virtual void Exec(unsigned int slot, void *const *values) = 0;
+   virtual void Finalize() = 0;
+};
+
+/// Create the writer of an RNTuple Snapshot. The RDataFrame `outputDF` is set to read the RNTuple once it is written.
+/// Throws if ROOT was built without RNTuple support.
+std::unique_ptr<RNTupleSnapshotWriterBase>
+MakeRNTupleSnapshotWriter(unsigned int nSlots, const std::string &fileName, const std::string &dirName,
+                          const std::string &ntupleName, const ColumnNames_t &fieldNames,
+                          const std::vector<std::string> &typeNames, const RSnapshotOptions &options,
+                          const std::shared_ptr<ROOT::RDataFrame> &outputDF);
+
+/// Helper object for a Snapshot action that writes an RNTuple instead of a TTree.
+/// Every slot fills its own clusters, which are appended to the output RNTuple as soon as they are complete, so the
+/// output file is written without TBufferMerger, both in single-thread and multi-thread runs. As for TTrees, the order
+/// of the entries is not preserved in multi-thread runs. The types of the fields are the types of the input columns.
+template <typename... ColTypes>
+class R__CLING_PTRCHECK(off) SnapshotRNTupleHelper : public RActionImpl<SnapshotRNTupleHelper<ColTypes...>> {
+   std::unique_ptr<RNTupleSnapshotWriterBase> fWriter;
+
+public:
+   using ColumnTypes_t = TypeList<ColTypes...>;
+   SnapshotRNTupleHelper(const unsigned int nSlots, std::string_view filename, std::string_view dirname,
+                         std::string_view ntuplename, const ColumnNames_t &bnames, const RSnapshotOptions &options,
+                         const std::shared_ptr<ROOT::RDataFrame> &outputDF)
+      : fWriter(MakeRNTupleSnapshotWriter(nSlots, std::string(filename), std::string(dirname),
+                                          std::string(ntuplename), ReplaceDotWithUnderscore(bnames),
+                                          {TypeID2TypeName(typeid(ColTypes))...}, options, outputDF))
+   {
+   }
+   SnapshotRNTupleHelper(const SnapshotRNTupleHelper &) = delete;
+   SnapshotRNTupleHelper(SnapshotRNTupleHelper &&) = default;
+
+   void InitTask(TTreeReader *, unsigned int) {}
+
+   void Exec(unsigned int slot, ColTypes &... values)
+   {
+      void *const addresses[] = {&values..., nullptr}; // nullptr: no zero-sized array if there are no columns
+      fWriter->Exec(slot, addresses);
+   }
+
+   void Initialize() { fWriter->Initialize(); }
+
+   void Finalize() { fWriter->Finalize(); }
+
+   std::string GetActionName() { return "Snapshot"; }
 };
 
 template <typename Acc, typename Merge, typename R, typename T, typename U,
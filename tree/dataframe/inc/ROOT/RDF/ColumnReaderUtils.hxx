@@ -11,15 +11,18 @@
 #ifndef ROOT_RDF_COLUMNREADERUTILS
 #define ROOT_RDF_COLUMNREADERUTILS
 
+#include "RBlockColumnReader.hxx"
 #include "RColumnReaderBase.hxx"
 #include "RColumnRegister.hxx"
 #include "RDefineBase.hxx"
 #include "RDefineReader.hxx"
 #include "RDSColumnReader.hxx"
 #include "RLoopManager.hxx"
+#include "RProfiledColumnReader.hxx"
 #include "RTreeColumnReader.hxx"
 #include "RVariationBase.hxx"
 #include "RVariationReader.hxx"
+#include "Utils.hxx" // TypeID2TypeName
 
 #include <ROOT/RDataSource.hxx>
 #include <ROOT/TypeTraits.hxx>
@@ -29,7 +32,9 @@
 #include <cassert>
 #include <map>
 #include <memory>
+#include <stdexcept>
 #include <string>
+#include <type_traits>
 #include <typeinfo> // for typeid
 #include <vector>
 
@@ -40,6 +45,24 @@ namespace RDF {
 using namespace ROOT::TypeTraits;
 namespace RDFDetail = ROOT::Detail::RDF;
 
+template <typename T>
+RDFDetail::RColumnReaderBase *AddBlockColumnReader(unsigned int slot, RDFDetail::RColumnReaderBase &datasetColReader,
+                                                   RLoopManager &lm, const std::string &colName, std::true_type)
+{
+   auto blockColReader =
+      std::make_unique<RBlockColumnReader<T>>(datasetColReader, lm.GetEntryBlock(slot), lm.GetBatchSize());
+   return lm.AddBlockColumnReader(slot, colName, std::move(blockColReader), typeid(T));
+}
+
+template <typename T>
+[[noreturn]] RDFDetail::RColumnReaderBase *
+AddBlockColumnReader(unsigned int, RDFDetail::RColumnReaderBase &, RLoopManager &, const std::string &colName,
+                     std::false_type)
+{
+   throw std::runtime_error("Column \"" + colName + "\" cannot be read in batch mode: its type, " +
+                            TypeID2TypeName(typeid(T)) + ", is not default-constructible and copy-assignable.");
+}
+
 template <typename T>
 RDFDetail::RColumnReaderBase *GetColumnReader(unsigned int slot, RColumnReaderBase *defineOrVariationReader,
                                               RLoopManager &lm, TTreeReader *r, const std::string &colName)
@@ -47,17 +70,39 @@ RDFDetail::RColumnReaderBase *GetColumnReader(unsigned int slot, RColumnReaderBa
    if (defineOrVariationReader != nullptr)
       return defineOrVariationReader;
 
+   // In batch mode, nodes read the values that the block column readers staged for the current block of entries
+   const bool isBatchMode = lm.GetBatchSize() > 0;
+   if (isBatchMode) {
+      auto *blockColReader = lm.GetBlockColumnReader(slot, colName, typeid(T));
+      if (blockColReader != nullptr)
+         return blockColReader;
+   }
+
    // Check if we already inserted a reader for this column in the dataset column readers (RDataSource or Tree/TChain
    // readers)
    auto *datasetColReader = lm.GetDatasetColumnReader(slot, colName, typeid(T));
-   if (datasetColReader != nullptr)
-      return datasetColReader;
-
-   assert(r != nullptr && "We could not find a reader for this column, this should never happen at this point.");
-
-   // Make a RTreeColumnReader for this column and insert it in RLoopManager's map
-   auto treeColReader = std::make_unique<RTreeColumnReader<T>>(*r, colName);
-   return lm.AddTreeColumnReader(slot, colName, std::move(treeColReader), typeid(T));
+   if (datasetColReader == nullptr) {
+      assert(r != nullptr && "We could not find a reader for this column, this should never happen at this point.");
+
+      // Make a RTreeColumnReader for this column and insert it in RLoopManager's map
+      auto treeColReader = std::make_unique<RTreeColumnReader<T>>(*r, colName);
+      datasetColReader = lm.AddTreeColumnReader(slot, colName, std::move(treeColReader), typeid(T));
+   }
+
+   // In profiled event loops, the reads of dataset columns go through readers that measure their time and size
+   if (auto *profiler = lm.GetProfiler()) {
+      auto *profiledColReader = lm.GetProfiledColumnReader(slot, colName, typeid(T));
+      if (profiledColReader == nullptr) {
+         auto reader =
+            std::make_unique<RProfiledColumnReader<T>>(*datasetColReader, profiler->GetColumnProfile(colName, slot));
+         profiledColReader = lm.AddProfiledColumnReader(slot, colName, std::move(reader), typeid(T));
+      }
+      datasetColReader = profiledColReader;
+   }
+
+   if (isBatchMode)
+      return AddBlockColumnReader<T>(slot, *datasetColReader, lm, colName, IsBlockStorable_t<T>{});
+   return datasetColReader;
 }
 
 /// This type aggregates some of the arguments passed to GetColumnReaders.
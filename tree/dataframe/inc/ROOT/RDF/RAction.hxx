@@ -12,6 +12,7 @@
 #define ROOT_RACTION
 
 #include "ROOT/RDF/ColumnReaderUtils.hxx"
+#include "ROOT/RDF/RBlockColumnReader.hxx" // GetBlockValue
 #include "ROOT/RDF/GraphNode.hxx"
 #include "ROOT/RDF/RActionBase.hxx"
 #include "ROOT/RDF/RColumnReaderBase.hxx"
@@ -23,6 +24,7 @@
 #include <cstddef> // std::size_t
 #include <memory>
 #include <string>
+#include <tuple>
 #include <vector>
 
 namespace ROOT {
@@ -109,10 +111,38 @@ public:
    void Run(unsigned int slot, Long64_t entry) final
    {
       // check if entry passes all filters
-      if (fPrevNode.CheckFilters(slot, entry))
+      if (fPrevNode.CheckFilters(slot, entry)) {
+         RDFInternal::RNodeTimer::RScope timing(fTimer, slot);
          CallExec(slot, entry, ColumnTypes_t{}, TypeInd_t{});
+      }
    }
 
+   template <typename... ColTypes, std::size_t... S>
+   void CallExecBlock(unsigned int slot, REntryBlock &block, const char *mask, TypeList<ColTypes...>,
+                      std::index_sequence<S...>)
+   {
+      std::tuple<ColTypes *...> blockValues{fValues[slot][S]->template GetBlock<ColTypes>(block, mask)...};
+      const auto current = block.fCurrent;
+      const auto nEntries = block.fEntries.size();
+      for (std::size_t i = 0u; i < nEntries; ++i) {
+         if (mask[i])
+            fHelper.Exec(slot, GetBlockValue(std::get<S>(blockValues), *fValues[slot][S], block, i)...);
+      }
+      block.fCurrent = current;
+      (void)blockValues; // avoid unused variable warning for actions without input columns
+   }
+
+   void RunBlock(unsigned int slot, REntryBlock &block) final
+   {
+      const char *mask = fPrevNode.CheckFiltersBlock(slot, block);
+      RDFInternal::RNodeTimer::RScope timing(fTimer, slot);
+      CallExecBlock(slot, block, mask, ColumnTypes_t{}, TypeInd_t{});
+   }
+
+   bool SupportsBatchMode() const final { return fHelper.SupportsBatchMode(); }
+
+   std::string GetActionName() final { return fHelper.GetActionName(); }
+
    void TriggerChildrenCount() final { fPrevNode.IncrChildrenCount(); }
 
    /// Clean-up operations to be performed at the end of a task.
@@ -11,11 +11,14 @@
 #ifndef ROOT_RACTIONBASE
 #define ROOT_RACTIONBASE
 
+#include "ROOT/RDF/RColumnReaderBase.hxx" // REntryBlock
 #include "ROOT/RDF/RColumnRegister.hxx"
+#include "ROOT/RDF/RProfiler.hxx" // RNodeTimer
 #include "ROOT/RDF/RSampleInfo.hxx"
 #include "ROOT/RDF/Utils.hxx" // ColumnNames_t
 #include "RtypesCore.h"
 
+#include <cstddef> // std::size_t
 #include <memory>
 #include <string>
 
@@ -52,6 +55,10 @@ private:
 
    RColumnRegister fColRegister;
 
+protected:
+   /// Time spent executing the action on the selected entries, only measured in profiled event loops
+   RNodeTimer fTimer;
+
 public:
    RActionBase(RLoopManager *lm, const ColumnNames_t &colNames, const RColumnRegister &colRegister,
                const std::vector<std::string> &prevVariations);
@@ -63,7 +70,21 @@ public:
    RColumnRegister &GetColRegister() { return fColRegister; }
    RLoopManager *GetLoopManager() { return fLoopManager; }
    unsigned int GetNSlots() const { return fNSlots; }
+   RNodeTimer &GetTimer() { return fTimer; }
+   /// The name of the action, e.g. "Histo1D", used in the graph representation and in the profile of the event loop
+   virtual std::string GetActionName() = 0;
    virtual void Run(unsigned int slot, Long64_t entry) = 0;
+   /// Run the action on all the entries of a block (batch mode). By default, entries are processed one at a time.
+   virtual void RunBlock(unsigned int slot, REntryBlock &block)
+   {
+      const auto nEntries = block.fEntries.size();
+      for (std::size_t i = 0u; i < nEntries; ++i) {
+         block.fCurrent = i;
+         Run(slot, block.fEntries[i]);
+      }
+   }
+   /// Whether the action can run in batch mode, in which the addresses of the input values change from entry to entry.
+   virtual bool SupportsBatchMode() const { return true; }
    virtual void Initialize() = 0;
    virtual void InitSlot(TTreeReader *r, unsigned int slot) = 0;
    virtual void TriggerChildrenCount() = 0;
@@ -71,6 +71,10 @@ public:
    /// Override this method to register a callback that is executed before the processing a new data sample starts.
    /// The callback will be invoked in the same conditions as with DefinePerSample().
    virtual ROOT::RDF::SampleCallback_t GetSampleCallback() { return {}; }
+
+   /// Override this method to return false if the helper relies on the addresses of its input values staying the same
+   /// across entries, which is not the case in batch mode (see ROOT::RDF::Experimental::SetBatchSize()).
+   virtual bool SupportsBatchMode() const { return true; }
 };
 
 } // namespace RDF
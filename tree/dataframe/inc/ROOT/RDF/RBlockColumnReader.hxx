@@ -0,0 +1,74 @@
+/*************************************************************************
+ * Copyright (C) 1995-2023, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RDF_RBLOCKCOLUMNREADER
+#define ROOT_RDF_RBLOCKCOLUMNREADER
+
+#include "RColumnReaderBase.hxx"
+#include <Rtypes.h> // Long64_t, R__CLING_PTRCHECK
+
+#include <cstddef> // std::size_t
+#include <memory>
+#include <type_traits>
+
+namespace ROOT {
+namespace Internal {
+namespace RDF {
+
+/// Base class of the column readers that stage the values of dataset columns in batch mode.
+class RBlockColumnReaderBase : public ROOT::Detail::RDF::RColumnReaderBase {
+public:
+   /// Copy the value of the entry the dataset is currently positioned at to position `idx` of the block.
+   virtual void Stage(std::size_t idx, Long64_t entry) = 0;
+};
+
+/// Column reader for TTree and RDataSource columns in batch mode.
+/// While the event loop moves through the entries of a block, the values read by the wrapped dataset column reader are
+/// copied into a contiguous array. Once the block is complete, downstream nodes access all the values of the block
+/// at once, or entry by entry at the position given by the block's fCurrent data member.
+template <typename T>
+class R__CLING_PTRCHECK(off) RBlockColumnReader final : public RBlockColumnReaderBase {
+   /// Non-owning pointer to the dataset column reader
+   ROOT::Detail::RDF::RColumnReaderBase *fReader;
+   /// The block of the processing slot this reader belongs to
+   const REntryBlock &fBlock;
+   std::unique_ptr<T[]> fValues;
+
+   void *GetImpl(Long64_t) final { return &fValues[fBlock.fCurrent]; }
+   void *GetBlockImpl(REntryBlock &, const char *) final { return fValues.get(); }
+
+public:
+   RBlockColumnReader(ROOT::Detail::RDF::RColumnReaderBase &reader, const REntryBlock &block, std::size_t batchSize)
+      : fReader(&reader), fBlock(block), fValues(new T[batchSize])
+   {
+   }
+
+   void Stage(std::size_t idx, Long64_t entry) final { fValues[idx] = fReader->template Get<T>(entry); }
+};
+
+/// Whether values of type T can be stored in the contiguous arrays used in batch mode.
+template <typename T>
+using IsBlockStorable_t =
+   std::integral_constant<bool, std::is_default_constructible<T>::value && std::is_copy_assignable<T>::value>;
+
+/// Return the value of the idx-th entry of the block. It is taken from `blockValues` if the column reader could
+/// provide the values of the whole block, otherwise it is read on its own.
+template <typename T>
+T &GetBlockValue(T *blockValues, ROOT::Detail::RDF::RColumnReaderBase &reader, REntryBlock &block, std::size_t idx)
+{
+   if (blockValues != nullptr)
+      return blockValues[idx];
+   block.fCurrent = idx;
+   return reader.template Get<T>(block.fEntries[idx]);
+}
+
+} // namespace RDF
+} // namespace Internal
+} // namespace ROOT
+
+#endif
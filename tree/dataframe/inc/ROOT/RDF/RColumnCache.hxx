@@ -0,0 +1,485 @@
+/*************************************************************************
+ * Copyright (C) 1995-2023, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RDF_RCOLUMNCACHE
+#define ROOT_RDF_RCOLUMNCACHE
+
+#include "ROOT/RCacheOptions.hxx"
+#include "ROOT/RDataSource.hxx"
+#include "ROOT/RDF/RActionImpl.hxx"
+#include "ROOT/RDF/RColumnReaderBase.hxx"
+#include "ROOT/RDF/Utils.hxx" // TypeID2TypeName
+#include "ROOT/RResultPtr.hxx"
+#include "ROOT/RVec.hxx"
+#include "ROOT/TypeTraits.hxx"
+#include "RtypesCore.h"
+#include "TBufferFile.h"
+#include "TClass.h"
+#include "TError.h" // Warning
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio> // FILE
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <typeinfo>
+#include <utility> // std::index_sequence
+#include <vector>
+
+class TTreeReader;
+
+namespace ROOT {
+namespace Internal {
+namespace RDF {
+
+/// Storage of the values of the columns cached by RInterface::Cache when it is called with RCacheOptions.
+/// Values are stored column by column, in chunks of consecutive entries. The values of a column in a chunk are stored
+/// contiguously in a RVec. Chunks that do not fit in the memory budget are written to a temporary file and read back
+/// when needed.
+class RColumnCache {
+public:
+   /// Location of the values of one column of a spilled chunk in the spill file
+   struct RSpilledColumn {
+      std::uint64_t fOffset = 0;
+      std::uint64_t fSize = 0;
+   };
+
+   struct RChunk {
+      ULong64_t fNEntries = 0;
+      /// The values of each column, type-erased RVecs. Empty if the chunk has been written to the spill file.
+      std::vector<std::shared_ptr<void>> fColumns;
+      /// The location of the values of each column in the spill file, if the chunk has been spilled.
+      std::vector<RSpilledColumn> fSpilledColumns;
+   };
+
+private:
+   ULong64_t fMemoryBudget;
+   std::string fSpillDirectory;
+   std::atomic<ULong64_t> fMemoryUsage{0};
+   /// Protects fChunks and the spill file
+   std::mutex fMutex;
+   std::vector<RChunk> fChunks;
+   ULong64_t fNEntries = 0;
+   FILE *fSpillFile = nullptr;
+   std::string fSpillFileName;
+   std::uint64_t fSpillFileSize = 0;
+
+public:
+   explicit RColumnCache(const ROOT::RDF::RCacheOptions &options);
+   RColumnCache(const RColumnCache &) = delete;
+   RColumnCache &operator=(const RColumnCache &) = delete;
+   ~RColumnCache();
+
+   ULong64_t GetMemoryBudget() const { return fMemoryBudget; }
+   ULong64_t GetMemoryUsage() const { return fMemoryUsage; }
+   ULong64_t GetNEntries() const { return fNEntries; }
+   const std::vector<RChunk> &GetChunks() const { return fChunks; }
+   const std::string &GetSpillFileName() const { return fSpillFileName; }
+
+   /// Account for `bytes` of memory. Return false, without accounting for them, if the budget would be exceeded.
+   bool ReserveMemory(ULong64_t bytes);
+   /// Account for `bytes` of memory, regardless of the budget.
+   void AddMemory(ULong64_t bytes) { fMemoryUsage += bytes; }
+   /// Append `size` bytes to the spill file, which is created if needed. Thread-safe.
+   RSpilledColumn Spill(const char *buffer, std::uint64_t size);
+   /// Read the values of a spilled column into `buffer`, which must be large enough.
+   void ReadSpilled(std::ifstream &spillFile, const RSpilledColumn &column, char *buffer) const;
+   /// Add a complete chunk to the cache. Thread-safe.
+   void AddChunk(RChunk &&chunk);
+   /// Make the contents of the spill file available for reading. Called when all chunks have been added.
+   void Flush();
+};
+
+/// Estimate the memory used by a value stored in the cache.
+template <typename T>
+std::size_t CacheValueSize(const T &)
+{
+   return sizeof(T);
+}
+
+template <typename T>
+std::size_t CacheValueSize(const ROOT::VecOps::RVec<T> &v)
+{
+   return sizeof(v) + v.capacity() * sizeof(T);
+}
+
+template <typename T>
+std::size_t CacheValueSize(const std::vector<T> &v)
+{
+   return sizeof(v) + v.capacity() * sizeof(T);
+}
+
+inline std::size_t CacheValueSize(const std::string &s)
+{
+   return sizeof(s) + s.capacity();
+}
+
+/// How the values of a column can be written to the spill file: 0 means that they cannot, 1 means as raw bytes,
+/// 2 means through the streamer of the corresponding TClass.
+template <typename T>
+using CacheSpillKind_t = std::integral_constant<
+   int, !std::is_default_constructible<T>::value ? 0 : (std::is_trivially_copyable<T>::value ? 1 : 2)>;
+
+template <typename T>
+bool CanSpillColumn(std::integral_constant<int, 0>)
+{
+   return false;
+}
+
+template <typename T>
+bool CanSpillColumn(std::integral_constant<int, 1>)
+{
+   return true;
+}
+
+template <typename T>
+bool CanSpillColumn(std::integral_constant<int, 2>)
+{
+   return std::is_same<T, std::string>::value || TClass::GetClass(typeid(T)) != nullptr;
+}
+
+/// Write a value to, or read it from, a buffer: std::strings are streamed directly, other types through their TClass.
+template <typename T>
+void StreamCacheValue(TBuffer &buffer, T &value, TClass *cl)
+{
+   cl->Streamer(&value, buffer);
+}
+
+inline void StreamCacheValue(TBuffer &buffer, std::string &value, TClass *)
+{
+   if (buffer.IsReading())
+      buffer.ReadStdString(&value);
+   else
+      buffer.WriteStdString(&value);
+}
+
+template <typename T>
+RColumnCache::RSpilledColumn
+SpillColumn(RColumnCache &cache, const ROOT::VecOps::RVec<T> &values, std::integral_constant<int, 1>)
+{
+   return cache.Spill(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(T));
+}
+
+template <typename T>
+RColumnCache::RSpilledColumn
+SpillColumn(RColumnCache &cache, const ROOT::VecOps::RVec<T> &values, std::integral_constant<int, 2>)
+{
+   TClass *cl = TClass::GetClass(typeid(T));
+   TBufferFile buffer(TBuffer::kWrite);
+   for (auto &value : values)
+      StreamCacheValue(buffer, const_cast<T &>(value), cl);
+   return cache.Spill(buffer.Buffer(), buffer.Length());
+}
+
+template <typename T>
+RColumnCache::RSpilledColumn SpillColumn(RColumnCache &, const ROOT::VecOps::RVec<T> &, std::integral_constant<int, 0>)
+{
+   throw std::logic_error("RColumnCache: attempted to spill a column that cannot be spilled.");
+}
+
+template <typename T>
+std::shared_ptr<void> LoadSpilledColumn(const RColumnCache &cache, std::ifstream &spillFile,
+                                        const RColumnCache::RSpilledColumn &column, ULong64_t nEntries,
+                                        std::integral_constant<int, 1>)
+{
+   auto values = std::make_shared<ROOT::VecOps::RVec<T>>(nEntries);
+   cache.ReadSpilled(spillFile, column, reinterpret_cast<char *>(values->data()));
+   return values;
+}
+
+template <typename T>
+std::shared_ptr<void> LoadSpilledColumn(const RColumnCache &cache, std::ifstream &spillFile,
+                                        const RColumnCache::RSpilledColumn &column, ULong64_t nEntries,
+                                        std::integral_constant<int, 2>)
+{
+   std::vector<char> bytes(column.fSize);
+   cache.ReadSpilled(spillFile, column, bytes.data());
+   TBufferFile buffer(TBuffer::kRead, bytes.size(), bytes.data(), /*adopt=*/false);
+   TClass *cl = TClass::GetClass(typeid(T));
+   auto values = std::make_shared<ROOT::VecOps::RVec<T>>(nEntries);
+   for (auto &value : *values)
+      StreamCacheValue(buffer, value, cl);
+   return values;
+}
+
+template <typename T>
+std::shared_ptr<void> LoadSpilledColumn(const RColumnCache &, std::ifstream &, const RColumnCache::RSpilledColumn &,
+                                        ULong64_t, std::integral_constant<int, 0>)
+{
+   throw std::logic_error("RColumnCache: a column that cannot be spilled was found in the spill file.");
+}
+
+/// Action helper that fills a RColumnCache.
+/// Each processing slot accumulates values in its own chunk, which is added to the cache when it reaches a fraction of
+/// the memory budget. If the chunk does not fit in the budget, it is written to the spill file instead.
+template <typename... ColTypes>
+class R__CLING_PTRCHECK(off) CacheHelper : public ROOT::Detail::RDF::RActionImpl<CacheHelper<ColTypes...>> {
+   using Buffers_t = std::tuple<ROOT::VecOps::RVec<ColTypes>...>;
+
+   std::shared_ptr<RColumnCache> fCache;
+   std::vector<Buffers_t> fBuffers;
+   std::vector<ULong64_t> fBufferMemory;
+   /// The memory usage at which the chunk of a slot is added to the cache
+   ULong64_t fChunkMemory;
+   bool fCanSpill;
+
+   template <std::size_t... S>
+   void FillBuffers(unsigned int slot, std::index_sequence<S...>, const ColTypes &...values)
+   {
+      auto &buffers = fBuffers[slot];
+      std::initializer_list<int> expander{
+         (std::get<S>(buffers).push_back(values), fBufferMemory[slot] += CacheValueSize(values), 0)...};
+      (void)expander; // avoid unused variable warnings
+   }
+
+   template <std::size_t... S>
+   void SealChunk(unsigned int slot, std::index_sequence<S...>)
+   {
+      auto &buffers = fBuffers[slot];
+      RColumnCache::RChunk chunk;
+      chunk.fNEntries = std::get<0>(buffers).size();
+      if (chunk.fNEntries == 0)
+         return;
+
+      const auto memory = fBufferMemory[slot];
+      fBufferMemory[slot] = 0;
+      const bool fitsInBudget = fCache->ReserveMemory(memory);
+      if (fitsInBudget || !fCanSpill) {
+         if (!fitsInBudget)
+            fCache->AddMemory(memory);
+         chunk.fColumns = {std::make_shared<ROOT::VecOps::RVec<ColTypes>>(std::move(std::get<S>(buffers)))...};
+      } else {
+         chunk.fSpilledColumns = {SpillColumn(*fCache, std::get<S>(buffers), CacheSpillKind_t<ColTypes>{})...};
+      }
+      std::initializer_list<int> expander{(std::get<S>(buffers).clear(), 0)...};
+      (void)expander; // avoid unused variable warnings
+
+      fCache->AddChunk(std::move(chunk));
+   }
+
+public:
+   using Result_t = RColumnCache;
+   using ColumnTypes_t = ROOT::TypeTraits::TypeList<ColTypes...>;
+
+   CacheHelper(const std::shared_ptr<RColumnCache> &cache, unsigned int nSlots)
+      : fCache(cache), fBuffers(nSlots), fBufferMemory(nSlots, 0)
+   {
+      // chunks must be small enough that the budget is not exceeded when each slot holds a chunk that is still being
+      // filled, but large enough that there is no significant per-chunk overhead
+      constexpr ULong64_t maxChunkMemory = 16 * 1024 * 1024;
+      const auto budget = fCache->GetMemoryBudget();
+      fChunkMemory =
+         budget == 0 ? maxChunkMemory : std::max(ULong64_t(1), std::min(maxChunkMemory, budget / (4 * nSlots)));
+
+      const bool canSpill[] = {CanSpillColumn<ColTypes>(CacheSpillKind_t<ColTypes>{})...};
+      fCanSpill = std::all_of(std::begin(canSpill), std::end(canSpill), [](bool b) { return b; });
+      if (budget != 0 && !fCanSpill) {
+         Warning("Cache", "Some of the cached columns cannot be written to disk: the memory budget of %llu bytes will "
+                          "be exceeded if needed.",
+                 budget);
+      }
+   }
+   CacheHelper(CacheHelper &&) = default;
+   CacheHelper(const CacheHelper &) = delete;
+
+   void InitTask(TTreeReader *, unsigned int) {}
+
+   void Exec(unsigned int slot, const ColTypes &...values)
+   {
+      FillBuffers(slot, std::index_sequence_for<ColTypes...>(), values...);
+      if (fBufferMemory[slot] >= fChunkMemory)
+         SealChunk(slot, std::index_sequence_for<ColTypes...>());
+   }
+
+   void Initialize() { /* noop */}
+
+   void Finalize()
+   {
+      for (auto slot = 0u; slot < fBuffers.size(); ++slot)
+         SealChunk(slot, std::index_sequence_for<ColTypes...>());
+      fCache->Flush();
+   }
+
+   std::shared_ptr<RColumnCache> GetResultPtr() const { return fCache; }
+
+   std::string GetActionName() { return "Cache"; }
+};
+
+/// The state of a processing slot of a RCacheDS: the chunk it is processing and where its values are.
+struct RCacheSlotData {
+   /// Entry number of the first entry of the current chunk
+   ULong64_t fFirstEntry = 0;
+   /// The RVecs that contain the values of each column for the current chunk
+   std::vector<void *> fValues;
+   /// The values of the current chunk, if it had to be read from the spill file
+   std::vector<std::shared_ptr<void>> fLoadedValues;
+   std::unique_ptr<std::ifstream> fSpillFile;
+};
+
+/// Column reader for RCacheDS: it gives access to the cached values without copies.
+template <typename T>
+class R__CLING_PTRCHECK(off) RCacheColumnReader final : public ROOT::Detail::RDF::RColumnReaderBase {
+   const RCacheSlotData &fSlotData;
+   std::size_t fColumn;
+
+   void *GetImpl(Long64_t entry) final
+   {
+      auto &values = *static_cast<ROOT::VecOps::RVec<T> *>(fSlotData.fValues[fColumn]);
+      return &values[entry - fSlotData.fFirstEntry];
+   }
+
+public:
+   RCacheColumnReader(const RCacheSlotData &slotData, std::size_t column) : fSlotData(slotData), fColumn(column) {}
+};
+
+template <typename T>
+std::unique_ptr<ROOT::Detail::RDF::RColumnReaderBase>
+MakeCacheColumnReader(const RCacheSlotData &slotData, std::size_t column)
+{
+   return std::make_unique<RCacheColumnReader<T>>(slotData, column);
+}
+
+/// The data source of the dataframes returned by RInterface::Cache when it is called with RCacheOptions.
+/// Each chunk of the cache is an entry range. Processing slots access the values of in-memory chunks directly and
+/// read the values of spilled chunks once per chunk.
+template <typename... ColTypes>
+class RCacheDS final : public ROOT::RDF::RDataSource {
+   ROOT::RDF::RResultPtr<RColumnCache> fCache;
+   const std::vector<std::string> fColNames;
+   std::vector<std::unique_ptr<RCacheSlotData>> fSlotData;
+   /// Entry number of the first entry of each chunk
+   std::vector<ULong64_t> fChunkStarts;
+   std::vector<std::pair<ULong64_t, ULong64_t>> fEntryRanges;
+
+   std::size_t GetColumnIndex(std::string_view colName) const
+   {
+      const auto it = std::find(fColNames.begin(), fColNames.end(), colName);
+      if (it == fColNames.end()) {
+         std::string err =
+            "The specified column name, \"" + std::string(colName) + "\" is not known to the data source.";
+         throw std::runtime_error(err);
+      }
+      return std::distance(fColNames.begin(), it);
+   }
+
+   template <std::size_t... S>
+   void LoadSpilledChunk(RCacheSlotData &slotData, const RColumnCache::RChunk &chunk, std::index_sequence<S...>)
+   {
+      if (!slotData.fSpillFile)
+         slotData.fSpillFile = std::make_unique<std::ifstream>(fCache->GetSpillFileName(), std::ios::binary);
+      slotData.fLoadedValues = {LoadSpilledColumn<ColTypes>(*fCache, *slotData.fSpillFile, chunk.fSpilledColumns[S],
+                                                            chunk.fNEntries, CacheSpillKind_t<ColTypes>{})...};
+      for (auto i = 0u; i < fColNames.size(); ++i)
+         slotData.fValues[i] = slotData.fLoadedValues[i].get();
+   }
+
+protected:
+   std::string AsString() final { return "cache data source"; };
+
+public:
+   RCacheDS(ROOT::RDF::RResultPtr<RColumnCache> cache, const std::vector<std::string> &colNames)
+      : fCache(std::move(cache)), fColNames(colNames)
+   {
+   }
+
+   const std::vector<std::string> &GetColumnNames() const final { return fColNames; }
+
+   bool HasColumn(std::string_view colName) const final
+   {
+      return std::find(fColNames.begin(), fColNames.end(), colName) != fColNames.end();
+   }
+
+   std::string GetTypeName(std::string_view colName) const final
+   {
+      const std::string typeNames[] = {ROOT::Internal::RDF::TypeID2TypeName(typeid(ColTypes))...};
+      return typeNames[GetColumnIndex(colName)];
+   }
+
+   Record_t GetColumnReadersImpl(std::string_view, const std::type_info &) final { return {}; }
+
+   std::unique_ptr<ROOT::Detail::RDF::RColumnReaderBase>
+   GetColumnReaders(unsigned int slot, std::string_view colName, const std::type_info &tid) final
+   {
+      const auto index = GetColumnIndex(colName);
+      const std::type_info *typeIds[] = {&typeid(ColTypes)...};
+      if (*typeIds[index] != tid) {
+         std::string err = "Column " + std::string(colName) + " has type " + GetTypeName(colName) +
+                           " while the id specified is associated to type " +
+                           ROOT::Internal::RDF::TypeID2TypeName(tid);
+         throw std::runtime_error(err);
+      }
+      using MakeReader_t = std::unique_ptr<ROOT::Detail::RDF::RColumnReaderBase> (*)(const RCacheSlotData &,
+                                                                                    std::size_t);
+      const MakeReader_t makeReaders[] = {&MakeCacheColumnReader<ColTypes>...};
+      return makeReaders[index](*fSlotData[slot], index);
+   }
+
+   void SetNSlots(unsigned int nSlots) final
+   {
+      fSlotData.clear();
+      for (auto slot = 0u; slot < nSlots; ++slot) {
+         fSlotData.emplace_back(std::make_unique<RCacheSlotData>());
+         fSlotData.back()->fValues.resize(fColNames.size(), nullptr);
+      }
+   }
+
+   void Initialize() final
+   {
+      // this runs the event loop that fills the cache, if it did not run yet
+      const auto &chunks = fCache->GetChunks();
+      fChunkStarts.clear();
+      fEntryRanges.clear();
+      ULong64_t start = 0;
+      for (const auto &chunk : chunks) {
+         fChunkStarts.emplace_back(start);
+         fEntryRanges.emplace_back(start, start + chunk.fNEntries);
+         start += chunk.fNEntries;
+      }
+   }
+
+   std::vector<std::pair<ULong64_t, ULong64_t>> GetEntryRanges() final
+   {
+      auto entryRanges(std::move(fEntryRanges)); // empty fEntryRanges
+      fEntryRanges.clear();
+      return entryRanges;
+   }
+
+   void InitSlot(unsigned int slot, ULong64_t firstEntry) final
+   {
+      const auto chunkIdx = std::distance(fChunkStarts.begin(),
+                                          std::upper_bound(fChunkStarts.begin(), fChunkStarts.end(), firstEntry)) -
+                            1;
+      const auto &chunk = fCache->GetChunks()[chunkIdx];
+      auto &slotData = *fSlotData[slot];
+      slotData.fFirstEntry = fChunkStarts[chunkIdx];
+      if (chunk.fColumns.empty()) {
+         LoadSpilledChunk(slotData, chunk, std::index_sequence_for<ColTypes...>());
+      } else {
+         for (auto i = 0u; i < fColNames.size(); ++i)
+            slotData.fValues[i] = chunk.fColumns[i].get();
+      }
+   }
+
+   void FinalizeSlot(unsigned int slot) final { fSlotData[slot]->fLoadedValues.clear(); }
+
+   bool SetEntry(unsigned int, ULong64_t) final { return true; }
+
+   std::string GetLabel() final { return "Cache"; }
+};
+
+} // namespace RDF
+} // namespace Internal
+} // namespace ROOT
+
+#endif
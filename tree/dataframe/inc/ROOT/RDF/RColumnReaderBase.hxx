@@ -13,7 +13,26 @@
 
 #include <Rtypes.h>
 
+#include <cstddef> // std::size_t
+#include <vector>
+
 namespace ROOT {
+namespace Internal {
+namespace RDF {
+
+/// A block of entries that the nodes of the computation graph process at once in batch mode, see
+/// ROOT::RDF::Experimental::SetBatchSize(). There is one block per processing slot.
+struct REntryBlock {
+   std::vector<Long64_t> fEntries; ///< The entry numbers in the block
+   /// Position in the block of the entry that is being processed one at a time, by nodes that have no batch
+   /// implementation
+   std::size_t fCurrent = 0;
+   Long64_t fId = -1; ///< Identifies the block within a processing slot; nodes use it to cache their results
+};
+
+} // namespace RDF
+} // namespace Internal
+
 namespace Detail {
 namespace RDF {
 
@@ -38,8 +57,20 @@ public:
       return *static_cast<T *>(GetImpl(entry));
    }
 
+   /// Return the column values for all the entries of the block, or nullptr if the reader can only provide values
+   /// one entry at a time via Get().
+   /// \tparam T The column type
+   /// \param block The entries to read
+   /// \param mask Only the values of the entries whose mask element is non-zero are guaranteed to be valid
+   template <typename T>
+   T *GetBlock(ROOT::Internal::RDF::REntryBlock &block, const char *mask)
+   {
+      return static_cast<T *>(GetBlockImpl(block, mask));
+   }
+
 private:
    virtual void *GetImpl(Long64_t entry) = 0;
+   virtual void *GetBlockImpl(ROOT::Internal::RDF::REntryBlock &, const char *) { return nullptr; }
 };
 
 } // namespace RDF
@@ -12,6 +12,7 @@
 #define ROOT_RDF_RDEFINE
 
 #include "ROOT/RDF/ColumnReaderUtils.hxx"
+#include "ROOT/RDF/RBlockColumnReader.hxx" // GetBlockValue, IsBlockStorable_t
 #include "ROOT/RDF/RColumnReaderBase.hxx"
 #include "ROOT/RDF/RDefineBase.hxx"
 #include "ROOT/RDF/RLoopManager.hxx"
@@ -21,7 +22,10 @@
 #include "RtypesCore.h"
 
 #include <array>
+#include <cstddef> // std::size_t
 #include <deque>
+#include <memory>
+#include <tuple>
 #include <type_traits>
 #include <utility> // std::index_sequence
 #include <vector>
@@ -62,6 +66,8 @@ class R__CLING_PTRCHECK(off) RDefine final : public RDefineBase {
 
    F fExpression;
    ValuesPerSlot_t fLastResults;
+   /// Values for the entries of the last block processed in batch mode, per slot
+   std::vector<std::unique_ptr<ret_type[]>> fBlockValues;
 
    /// Column readers per slot and per input column
    std::vector<std::array<RColumnReaderBase *, ColumnTypes_t::list_size>> fValues;
@@ -94,12 +100,67 @@ class R__CLING_PTRCHECK(off) RDefine final : public RDefineBase {
          fExpression(slot, entry, fValues[slot][S]->template Get<ColTypes>(entry)...);
    }
 
+   template <typename... Args>
+   ret_type Eval(unsigned int, Long64_t, NoneTag, Args &...args)
+   {
+      return fExpression(args...);
+   }
+
+   template <typename... Args>
+   ret_type Eval(unsigned int slot, Long64_t, SlotTag, Args &...args)
+   {
+      return fExpression(slot, args...);
+   }
+
+   template <typename... Args>
+   ret_type Eval(unsigned int slot, Long64_t entry, SlotAndEntryTag, Args &...args)
+   {
+      return fExpression(slot, entry, args...);
+   }
+
+   template <typename... ColTypes, std::size_t... S>
+   void UpdateBlockHelper(unsigned int slot, RDFInternal::REntryBlock &block, const char *mask, char *done,
+                          ret_type *values, TypeList<ColTypes...>, std::index_sequence<S...>)
+   {
+      std::tuple<ColTypes *...> blockValues{fValues[slot][S]->template GetBlock<ColTypes>(block, mask)...};
+      const auto current = block.fCurrent;
+      const auto nEntries = block.fEntries.size();
+      for (std::size_t i = 0u; i < nEntries; ++i) {
+         if (!mask[i] || done[i])
+            continue;
+         values[i] = Eval(slot, block.fEntries[i], ExtraArgsTag{},
+                          RDFInternal::GetBlockValue(std::get<S>(blockValues), *fValues[slot][S], block, i)...);
+         done[i] = true;
+      }
+      block.fCurrent = current;
+      (void)blockValues; // avoid unused variable warning for defines without input columns
+   }
+
+   void *UpdateBlockImpl(unsigned int slot, RDFInternal::REntryBlock &block, const char *mask, std::true_type)
+   {
+      auto &values = fBlockValues[slot];
+      auto &done = fBlockDone[slot];
+      if (block.fId != fLastCheckedBlock[slot * RDFInternal::CacheLineStep<Long64_t>()]) {
+         if (!values)
+            values.reset(new ret_type[fLoopManager->GetBatchSize()]);
+         done.assign(block.fEntries.size(), false);
+         fLastCheckedBlock[slot * RDFInternal::CacheLineStep<Long64_t>()] = block.fId;
+      }
+      RDFInternal::RNodeTimer::RScope timing(fTimer, slot);
+      UpdateBlockHelper(slot, block, mask, done.data(), values.get(), ColumnTypes_t{}, TypeInd_t{});
+      return values.get();
+   }
+
+   // values of this type cannot be stored in a block, they are computed one entry at a time
+   void *UpdateBlockImpl(unsigned int, RDFInternal::REntryBlock &, const char *, std::false_type) { return nullptr; }
+
 public:
    RDefine(std::string_view name, std::string_view type, F expression, const ROOT::RDF::ColumnNames_t &columns,
            const RDFInternal::RColumnRegister &colRegister, RLoopManager &lm,
            const std::string &variationName = "nominal")
       : RDefineBase(name, type, colRegister, lm, columns, variationName), fExpression(std::move(expression)),
-        fLastResults(lm.GetNSlots() * RDFInternal::CacheLineStep<ret_type>()), fValues(lm.GetNSlots())
+        fLastResults(lm.GetNSlots() * RDFInternal::CacheLineStep<ret_type>()), fBlockValues(lm.GetNSlots()),
+        fValues(lm.GetNSlots())
    {
       fLoopManager->Register(this);
    }
@@ -113,6 +174,9 @@ public:
       RDFInternal::RColumnReadersInfo info{fColumnNames, fColRegister, fIsDefine.data(), *fLoopManager};
       fValues[slot] = RDFInternal::GetColumnReaders(slot, r, ColumnTypes_t{}, info, fVariation);
       fLastCheckedEntry[slot * RDFInternal::CacheLineStep<Long64_t>()] = -1;
+      fLastCheckedBlock[slot * RDFInternal::CacheLineStep<Long64_t>()] = -1;
+      // the batch size might have changed since the last event loop
+      fBlockValues[slot].reset();
    }
 
    /// Return the (type-erased) address of the Define'd value for the given processing slot.
@@ -126,11 +190,17 @@ public:
    {
       if (entry != fLastCheckedEntry[slot * RDFInternal::CacheLineStep<Long64_t>()]) {
          // evaluate this define expression, cache the result
+         RDFInternal::RNodeTimer::RScope timing(fTimer, slot);
          UpdateHelper(slot, entry, ColumnTypes_t{}, TypeInd_t{}, ExtraArgsTag{});
          fLastCheckedEntry[slot * RDFInternal::CacheLineStep<Long64_t>()] = entry;
       }
    }
 
+   void *UpdateBlock(unsigned int slot, RDFInternal::REntryBlock &block, const char *mask) final
+   {
+      return UpdateBlockImpl(slot, block, mask, RDFInternal::IsBlockStorable_t<ret_type>{});
+   }
+
    void Update(unsigned int /*slot*/, const ROOT::RDF::RSampleInfo &/*id*/) final {}
 
    const std::type_info &GetTypeId() const final { return typeid(ret_type); }
@@ -12,7 +12,9 @@
 #define ROOT_RDEFINEBASE
 
 #include "ROOT/RDF/GraphNode.hxx"
+#include "ROOT/RDF/RColumnReaderBase.hxx" // REntryBlock
 #include "ROOT/RDF/RColumnRegister.hxx"
+#include "ROOT/RDF/RProfiler.hxx" // RNodeTimer
 #include "ROOT/RDF/RSampleInfo.hxx"
 #include "ROOT/RDF/Utils.hxx"
 #include "ROOT/RVec.hxx"
@@ -41,6 +43,9 @@ protected:
    const std::string fName; ///< The name of the custom column
    const std::string fType; ///< The type of the custom column as a text string
    std::vector<Long64_t> fLastCheckedEntry;
+   std::vector<Long64_t> fLastCheckedBlock; ///< Id of the last entry block processed in batch mode, per slot
+   /// Whether the value was already computed, for each entry of the last block processed in batch mode, per slot
+   std::vector<std::vector<char>> fBlockDone;
    RDFInternal::RColumnRegister fColRegister;
    RLoopManager *fLoopManager; // non-owning pointer to the RLoopManager
    const ROOT::RDF::ColumnNames_t fColumnNames;
@@ -48,6 +53,7 @@ protected:
    ROOT::RVecB fIsDefine;
    std::vector<std::string> fVariationDeps; ///< List of systematic variations that affect the value of this define.
    std::string fVariation;                  ///< This indicates for what variation this define evaluates values.
+   RDFInternal::RNodeTimer fTimer; ///< Time spent computing the values, only measured in profiled event loops
 
 public:
    RDefineBase(std::string_view name, std::string_view type, const RDFInternal::RColumnRegister &colRegister,
@@ -64,12 +70,20 @@ public:
    std::string GetTypeName() const;
    /// Update the value at the address returned by GetValuePtr with the content corresponding to the given entry
    virtual void Update(unsigned int slot, Long64_t entry) = 0;
+   /// Compute the values of the defined column for the entries of the block selected by `mask` (batch mode).
+   /// Return the address of the array of values, or nullptr if values can only be computed one entry at a time.
+   virtual void *UpdateBlock(unsigned int /*slot*/, RDFInternal::REntryBlock & /*block*/, const char * /*mask*/)
+   {
+      return nullptr;
+   }
    /// Update function to be called once per sample, used if the derived type is a RDefinePerSample
    virtual void Update(unsigned int /*slot*/, const ROOT::RDF::RSampleInfo &/*id*/) {}
    /// Clean-up operations to be performed at the end of a task.
    virtual void FinalizeSlot(unsigned int slot) = 0;
 
    const std::vector<std::string> &GetVariations() const { return fVariationDeps; }
+   const std::string &GetVariation() const { return fVariation; }
+   RDFInternal::RNodeTimer &GetTimer() { return fTimer; }
 
    /// Create clones of this Define that work with values in varied "universes".
    virtual void MakeVariations(const std::vector<std::string> &variations) = 0;
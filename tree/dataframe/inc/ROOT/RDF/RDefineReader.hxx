@@ -41,6 +41,8 @@ class R__CLING_PTRCHECK(off) RDefineReader final : public ROOT::Detail::RDF::RCo
       return fValuePtr;
    }
 
+   void *GetBlockImpl(REntryBlock &block, const char *mask) final { return fDefine.UpdateBlock(fSlot, block, mask); }
+
 public:
    RDefineReader(unsigned int slot, RDFDetail::RDefineBase &define)
       : fDefine(define), fValuePtr(define.GetValuePtr(slot)), fSlot(slot)
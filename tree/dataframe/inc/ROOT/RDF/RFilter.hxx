@@ -12,10 +12,12 @@
 #define ROOT_RFILTER
 
 #include "ROOT/RDF/ColumnReaderUtils.hxx"
+#include "ROOT/RDF/RBlockColumnReader.hxx" // GetBlockValue
 #include "ROOT/RDF/RColumnReaderBase.hxx"
 #include "ROOT/RDF/RCutFlowReport.hxx"
 #include "ROOT/RDF/Utils.hxx"
 #include "ROOT/RDF/RFilterBase.hxx"
+#include "ROOT/RDF/RFilterChain.hxx"
 #include "ROOT/RDF/RLoopManager.hxx"
 #include "ROOT/TypeTraits.hxx"
 #include "RtypesCore.h"
@@ -24,6 +26,7 @@
 #include <cassert>
 #include <memory>
 #include <string>
+#include <tuple>
 #include <unordered_map>
 #include <utility> // std::index_sequence
 #include <vector>
@@ -91,22 +94,38 @@ public:
 
    bool CheckFilters(unsigned int slot, Long64_t entry) final
    {
+      if (fLoopManager->GetBatchSize() > 0) {
+         // in batch mode the filter is evaluated for the whole block of entries at once
+         auto &block = fLoopManager->GetEntryBlock(slot);
+         return CheckFiltersBlock(slot, block)[block.fCurrent];
+      }
       if (entry != fLastCheckedEntry[slot * RDFInternal::CacheLineStep<Long64_t>()]) {
-         if (!fPrevNode.CheckFilters(slot, entry)) {
+         if (fFilterChain) {
+            // this is the last filter of a chain: the chain evaluates the upstream filters and this one
+            fLastResult[slot * RDFInternal::CacheLineStep<int>()] = fFilterChain->CheckFilters(slot, entry);
+         } else if (!fPrevNode.CheckFilters(slot, entry)) {
             // a filter upstream returned false, cache the result
             fLastResult[slot * RDFInternal::CacheLineStep<int>()] = false;
          } else {
             // evaluate this filter, cache the result
-            auto passed = CheckFilterHelper(slot, entry, ColumnTypes_t{}, TypeInd_t{});
-            passed ? ++fAccepted[slot * RDFInternal::CacheLineStep<ULong64_t>()]
-                   : ++fRejected[slot * RDFInternal::CacheLineStep<ULong64_t>()];
-            fLastResult[slot * RDFInternal::CacheLineStep<int>()] = passed;
+            fLastResult[slot * RDFInternal::CacheLineStep<int>()] = EvaluateFilter(slot, entry);
          }
          fLastCheckedEntry[slot * RDFInternal::CacheLineStep<Long64_t>()] = entry;
       }
       return fLastResult[slot * RDFInternal::CacheLineStep<int>()];
    }
 
+   bool EvaluateFilter(unsigned int slot, Long64_t entry) final
+   {
+      RDFInternal::RNodeTimer::RScope timing(fTimer, slot);
+      const auto passed = CheckFilterHelper(slot, entry, ColumnTypes_t{}, TypeInd_t{});
+      passed ? ++fAccepted[slot * RDFInternal::CacheLineStep<ULong64_t>()]
+             : ++fRejected[slot * RDFInternal::CacheLineStep<ULong64_t>()];
+      return passed;
+   }
+
+   RNodeBase *GetPrevNode() final { return &fPrevNode; }
+
    template <typename... ColTypes, std::size_t... S>
    bool CheckFilterHelper(unsigned int slot, Long64_t entry, TypeList<ColTypes...>, std::index_sequence<S...>)
    {
@@ -116,11 +135,49 @@ public:
       (void)entry;
    }
 
+   const char *CheckFiltersBlock(unsigned int slot, RDFInternal::REntryBlock &block) final
+   {
+      auto &mask = fBlockMasks[slot];
+      if (block.fId != fLastCheckedBlock[slot * RDFInternal::CacheLineStep<Long64_t>()]) {
+         const char *prevMask = fPrevNode.CheckFiltersBlock(slot, block);
+         mask.resize(block.fEntries.size());
+         RDFInternal::RNodeTimer::RScope timing(fTimer, slot);
+         CheckFilterBlockHelper(slot, block, prevMask, mask.data(), ColumnTypes_t{}, TypeInd_t{});
+         fLastCheckedBlock[slot * RDFInternal::CacheLineStep<Long64_t>()] = block.fId;
+      }
+      return mask.data();
+   }
+
+   template <typename... ColTypes, std::size_t... S>
+   void CheckFilterBlockHelper(unsigned int slot, RDFInternal::REntryBlock &block, const char *prevMask, char *mask,
+                               TypeList<ColTypes...>, std::index_sequence<S...>)
+   {
+      std::tuple<ColTypes *...> blockValues{fValues[slot][S]->template GetBlock<ColTypes>(block, prevMask)...};
+      ULong64_t nAccepted = 0;
+      ULong64_t nChecked = 0;
+      const auto current = block.fCurrent;
+      const auto nEntries = block.fEntries.size();
+      for (std::size_t i = 0u; i < nEntries; ++i) {
+         if (!prevMask[i]) {
+            mask[i] = false;
+            continue;
+         }
+         mask[i] = fFilter(RDFInternal::GetBlockValue(std::get<S>(blockValues), *fValues[slot][S], block, i)...);
+         nAccepted += mask[i];
+         ++nChecked;
+      }
+      block.fCurrent = current;
+      fAccepted[slot * RDFInternal::CacheLineStep<ULong64_t>()] += nAccepted;
+      fRejected[slot * RDFInternal::CacheLineStep<ULong64_t>()] += nChecked - nAccepted;
+      (void)blockValues; // avoid unused variable warning for filters without input columns
+   }
+
    void InitSlot(TTreeReader *r, unsigned int slot) final
    {
       RDFInternal::RColumnReadersInfo info{fColumnNames, fColRegister, fIsDefine.data(), *fLoopManager};
       fValues[slot] = RDFInternal::GetColumnReaders(slot, r, ColumnTypes_t{}, info, fVariation);
       fLastCheckedEntry[slot * RDFInternal::CacheLineStep<Long64_t>()] = -1;
+      fLastCheckedBlock[slot * RDFInternal::CacheLineStep<Long64_t>()] = -1;
    }
 
    // recursive chain of `Report`s
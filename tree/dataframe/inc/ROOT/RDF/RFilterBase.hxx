@@ -13,11 +13,13 @@
 
 #include "ROOT/RDF/RColumnRegister.hxx"
 #include "ROOT/RDF/RNodeBase.hxx"
+#include "ROOT/RDF/RProfiler.hxx" // RNodeTimer
 #include "ROOT/RDF/Utils.hxx" // ColumnNames_t
 #include "ROOT/RVec.hxx"
 #include "RtypesCore.h"
 
 #include <cassert>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -29,6 +31,12 @@ namespace RDF {
 class RCutFlowReport;
 } // ns RDF
 
+namespace Internal {
+namespace RDF {
+class RFilterChain;
+} // ns RDF
+} // ns Internal
+
 namespace Detail {
 namespace RDF {
 namespace RDFInternal = ROOT::Internal::RDF;
@@ -41,6 +49,8 @@ protected:
    std::vector<int> fLastResult = {true}; // std::vector<bool> cannot be used in a MT context safely
    std::vector<ULong64_t> fAccepted = {0};
    std::vector<ULong64_t> fRejected = {0};
+   std::vector<Long64_t> fLastCheckedBlock; ///< Id of the last entry block processed in batch mode, per slot
+   std::vector<std::vector<char>> fBlockMasks; ///< Result for each entry of the last block processed, per slot
    const std::string fName;
    const ROOT::RDF::ColumnNames_t fColumnNames;
    RDFInternal::RColumnRegister fColRegister;
@@ -48,6 +58,12 @@ protected:
    ROOT::RVecB fIsDefine;
    std::string fVariation; ///< This indicates for what variation this filter evaluates values.
    std::unordered_map<std::string, std::shared_ptr<RFilterBase>> fVariedFilters;
+   /// Set if this filter is the last of a chain of filters whose evaluation order is chosen at runtime
+   std::unique_ptr<RDFInternal::RFilterChain> fFilterChain;
+   /// Position of this filter in the evaluation order chosen for its chain, shown by SaveGraph
+   std::string fPlanInfo;
+   /// Time spent evaluating the condition of this filter, only measured in profiled event loops
+   RDFInternal::RNodeTimer fTimer;
 
 public:
    RFilterBase(RLoopManager *df, std::string_view name, const unsigned int nSlots,
@@ -58,6 +74,17 @@ public:
    ~RFilterBase() override;
 
    virtual void InitSlot(TTreeReader *r, unsigned int slot) = 0;
+   /// Evaluate the condition of this filter only, without checking the filters upstream
+   virtual bool EvaluateFilter(unsigned int slot, Long64_t entry) = 0;
+   /// The node upstream of this filter
+   virtual RNodeBase *GetPrevNode() = 0;
+   /// The filter that evaluates the condition: this object, except for jitted filters
+   virtual RFilterBase *GetConcreteFilter() { return this; }
+   void SetFilterChain(std::unique_ptr<RDFInternal::RFilterChain> chain);
+   void SetPlanInfo(const std::string &info) { fPlanInfo = info; }
+   const std::string &GetPlanInfo() const { return fPlanInfo; }
+   RDFInternal::RNodeTimer &GetTimer() { return fTimer; }
+   const std::string &GetVariation() const { return fVariation; }
    bool HasName() const;
    std::string GetName() const;
    virtual void FillReport(ROOT::RDF::RCutFlowReport &) const;
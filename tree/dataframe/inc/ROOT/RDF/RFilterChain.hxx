@@ -0,0 +1,80 @@
+/*************************************************************************
+ * Copyright (C) 1995-2023, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RDF_RFILTERCHAIN
+#define ROOT_RDF_RFILTERCHAIN
+
+#include "ROOT/RDF/RFilterBase.hxx"
+#include "ROOT/RDF/RNodeBase.hxx"
+#include <RtypesCore.h> // Long64_t, ULong64_t
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace ROOT {
+namespace Internal {
+namespace RDF {
+
+/// A chain of consecutive unnamed filters whose evaluation order is chosen at runtime.
+/// During the first entries processed by each slot, all the filters of the chain are evaluated and their pass rate
+/// and cost are measured. Once a slot has profiled the requested number of entries, the filters are ordered by
+/// increasing cost per rejected entry, and for the rest of the event loop each entry is only checked until the first
+/// failing filter. Since dataset columns and Defines are read or computed when a filter first needs them, the columns
+/// used by the filters moved to the end of the chain are not read for the entries rejected by the filters before them.
+/// The filters of the chain must not have side effects and must be safe to evaluate in any order.
+class RFilterChain {
+   struct RFilterProfile {
+      ULong64_t fNEvaluated = 0;
+      ULong64_t fNPassed = 0;
+      double fTime = 0.; ///< Nanoseconds
+   };
+   struct RSlotProfile {
+      ULong64_t fNEntries = 0;
+      std::vector<RFilterProfile> fFilters;
+   };
+
+   std::vector<ROOT::Detail::RDF::RFilterBase *> fFilters; ///< In declaration order
+   ROOT::Detail::RDF::RNodeBase &fPrevNode;               ///< The node upstream of the first filter of the chain
+   ULong64_t fNProfileEntries;
+   std::vector<std::unique_ptr<RSlotProfile>> fSlotProfiles;
+   /// Indexes in fFilters, in evaluation order. Only set once fHasPlan is true.
+   std::vector<std::size_t> fOrder;
+   std::atomic<bool> fHasPlan{false};
+   std::mutex fMutex;
+
+   bool Profile(unsigned int slot, Long64_t entry);
+   void ChoosePlan(const RSlotProfile &profile);
+
+public:
+   RFilterChain(const std::vector<ROOT::Detail::RDF::RFilterBase *> &filters, ROOT::Detail::RDF::RNodeBase &prevNode,
+                unsigned int nSlots, ULong64_t nProfileEntries);
+   RFilterChain(const RFilterChain &) = delete;
+   RFilterChain &operator=(const RFilterChain &) = delete;
+
+   /// Return whether the entry passes the filters upstream of the chain and all the filters of the chain
+   bool CheckFilters(unsigned int slot, Long64_t entry)
+   {
+      if (!fPrevNode.CheckFilters(slot, entry))
+         return false;
+      if (!fHasPlan.load(std::memory_order_acquire))
+         return Profile(slot, entry);
+      for (auto idx : fOrder) {
+         if (!fFilters[idx]->EvaluateFilter(slot, entry))
+            return false;
+      }
+      return true;
+   }
+};
+
+} // namespace RDF
+} // namespace Internal
+} // namespace ROOT
+
+#endif
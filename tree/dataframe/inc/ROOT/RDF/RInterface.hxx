@@ -11,8 +11,10 @@
 #ifndef ROOT_RDF_TINTERFACE
 #define ROOT_RDF_TINTERFACE
 
+#include "ROOT/RCacheOptions.hxx"
 #include "ROOT/RDataSource.hxx"
 #include "ROOT/RDF/ActionHelpers.hxx"
+#include "ROOT/RDF/RColumnCache.hxx"
 #include "ROOT/RDF/HistoModels.hxx"
 #include "ROOT/RDF/InterfaceUtils.hxx"
 #include "ROOT/RDF/RColumnRegister.hxx"
@@ -86,6 +88,16 @@ template <typename Proxied, typename DataSource>
 class RInterface;
 
 using RNode = RInterface<::ROOT::Detail::RDF::RNodeBase, void>;
+
+namespace Experimental {
+void SetBatchSize(const RNode &node, std::size_t batchSize);
+void SetFilterReordering(const RNode &node, ULong64_t nProfileEntries);
+void SetProfiling(const RNode &node, bool enable);
+/// The formats in which SaveProfile() exports the profile of an event loop
+enum class EProfileFormat { kJSON, kChromeTrace };
+std::string SaveProfile(const RNode &node, EProfileFormat format);
+void SaveProfile(const RNode &node, const std::string &outputFile, EProfileFormat format);
+} // namespace Experimental
 } // namespace RDF
 
 namespace Internal {
@@ -122,6 +134,10 @@ class RInterface : public RInterfaceBase {
 
    friend void RDFInternal::TriggerRun(RNode &node);
    friend void RDFInternal::ChangeEmptyEntryRange(const RNode &node, std::pair<ULong64_t, ULong64_t> &&newRange);
+   friend void ROOT::RDF::Experimental::SetBatchSize(const RNode &node, std::size_t batchSize);
+   friend void ROOT::RDF::Experimental::SetFilterReordering(const RNode &node, ULong64_t nProfileEntries);
+   friend void ROOT::RDF::Experimental::SetProfiling(const RNode &node, bool enable);
+   friend std::string ROOT::RDF::Experimental::SaveProfile(const RNode &node, EProfileFormat format);
 
    std::shared_ptr<Proxied> fProxiedPtr; ///< Smart pointer to the graph node encapsulated by this RInterface.
 
@@ -976,6 +992,20 @@ public:
    /// opts.fLazy = true;
    /// df.Snapshot("outputTree", "outputFile.root", {"x"}, opts);
    /// ~~~
+   ///
+   /// ### Writing an RNTuple
+   ///
+   /// Setting `RSnapshotOptions::fOutputFormat` to `ESnapshotOutputFormat::kRNTuple` writes an RNTuple (experimental)
+   /// called `treename` instead of a TTree. The types of the fields are the types of the columns. Each slot fills its
+   /// own clusters, which are appended to the output as soon as they are complete, so multi-thread runs do not need
+   /// to merge per-thread files. `fAutoFlush`, if positive, is the maximum number of entries of the clusters of each
+   /// slot; `fSplitLevel` is ignored. Writing to a sub-directory is not supported. The returned RDataFrame reads the
+   /// RNTuple once the event loop has run.
+   /// ~~~{.cpp}
+   /// RSnapshotOptions opts;
+   /// opts.fOutputFormat = ESnapshotOutputFormat::kRNTuple;
+   /// df.Snapshot("ntuple", "outputFile.root", {"x"}, opts);
+   /// ~~~
    template <typename... ColumnTypes>
    RResultPtr<RInterface<RLoopManager>>
    Snapshot(std::string_view treename, std::string_view filename, const ColumnNames_t &columnList,
@@ -1023,7 +1053,7 @@ public:
                                          colListWithAliasesAndSizeBranches, options});
 
       ::TDirectory::TContext ctxt;
-      auto newRDF = std::make_shared<ROOT::RDataFrame>(fullTreeName, filename, colListNoAliasesWithSizeBranches);
+      auto newRDF = MakeSnapshotDataFrame(fullTreeName, filename, colListNoAliasesWithSizeBranches, *snapHelperArgs);
 
       auto resPtr = CreateAction<RDFInternal::ActionTags::Snapshot, RDFDetail::RInferredType>(
          colListNoAliasesWithSizeBranches, newRDF, snapHelperArgs, fProxiedPtr,
@@ -1107,7 +1137,8 @@ public:
    /// columns and stores their content in memory for fast, zero-copy subsequent access.
    ///
    /// Use `Cache` if you know you will only need a subset of the (`Filter`ed) data that
-   /// fits in memory and that will be accessed many times.
+   /// fits in memory and that will be accessed many times. If the data might not fit in memory, use the overloads
+   /// that take a RCacheOptions object, which can limit the amount of memory used by the cache.
    ///
    /// \note Cache will refuse to process columns with names of the form `#columnname`. These are special columns
    /// made available by some data sources (e.g. RNTupleDS) that represent the size of column `columnname`, and are
@@ -1137,52 +1168,52 @@ public:
       return CacheImpl<ColumnTypes...>(columnList, staticSeq);
    }
 
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Save selected columns in memory, or on disk if they exceed a memory budget.
+   /// \tparam ColumnTypes variadic list of branch/column types.
+   /// \param[in] columnList columns to be cached.
+   /// \param[in] options options to steer the storage of the cached values, such as the memory budget.
+   /// \return a `RDataFrame` that wraps the cached dataset.
+   ///
+   /// The values are stored column by column, in chunks of consecutive entries. Each chunk is processed by a single
+   /// task of the event loops that run on the cached dataset, and its values are accessed without copies. The chunks
+   /// that do not fit in `options.fMemoryBudget` are written to a temporary file in `options.fSpillDirectory`, which
+   /// is deleted together with the cached dataset. They are read back one chunk at a time, when needed.
+   ///
+   /// Values can be written to disk if their type is trivially copyable or if it has a dictionary; otherwise the
+   /// memory budget is exceeded when needed and a warning is issued. In multi-thread event loops, the order of the
+   /// cached entries is not guaranteed to be the order of the original entries.
+   ///
+   /// ### Example usage:
+   /// ~~~{.cpp}
+   /// ROOT::RDF::RCacheOptions opts;
+   /// opts.fMemoryBudget = 4ull * 1024 * 1024 * 1024; // 4 GB
+   /// auto cached = df.Filter("nMuon > 2").Cache<int, ROOT::RVecF>({"nMuon", "Muon_pt"}, opts);
+   /// ~~~
+   template <typename... ColumnTypes>
+   RInterface<RLoopManager> Cache(const ColumnNames_t &columnList, const RCacheOptions &options)
+   {
+      return CacheImpl<ColumnTypes...>(columnList, options);
+   }
+
    ////////////////////////////////////////////////////////////////////////////
    /// \brief Save selected columns in memory.
    /// \param[in] columnList columns to be cached in memory
    /// \return a `RDataFrame` that wraps the cached dataset.
    ///
    /// See the previous overloads for more information.
-   RInterface<RLoopManager> Cache(const ColumnNames_t &columnList)
-   {
-      // Early return: if the list of columns is empty, just return an empty RDF
-      // If we proceed, the jitted call will not compile!
-      if (columnList.empty()) {
-         auto nEntries = *this->Count();
-         RInterface<RLoopManager> emptyRDF(std::make_shared<RLoopManager>(nEntries));
-         return emptyRDF;
-      }
+   RInterface<RLoopManager> Cache(const ColumnNames_t &columnList) { return JitCache(columnList, nullptr); }
 
-      std::stringstream cacheCall;
-      auto upcastNode = RDFInternal::UpcastNode(fProxiedPtr);
-      RInterface<TTraits::TakeFirstParameter_t<decltype(upcastNode)>> upcastInterface(fProxiedPtr, *fLoopManager,
-                                                                                      fColRegister);
-      // build a string equivalent to
-      // "(RInterface<nodetype*>*)(this)->Cache<Ts...>(*(ColumnNames_t*)(&columnList))"
-      RInterface<RLoopManager> resRDF(std::make_shared<ROOT::Detail::RDF::RLoopManager>(0));
-      cacheCall << "*reinterpret_cast<ROOT::RDF::RInterface<ROOT::Detail::RDF::RLoopManager>*>("
-                << RDFInternal::PrettyPrintAddr(&resRDF)
-                << ") = reinterpret_cast<ROOT::RDF::RInterface<ROOT::Detail::RDF::RNodeBase>*>("
-                << RDFInternal::PrettyPrintAddr(&upcastInterface) << ")->Cache<";
-
-      const auto columnListWithoutSizeColumns = RDFInternal::FilterArraySizeColNames(columnList, "Cache");
-
-      const auto validColumnNames =
-         GetValidatedColumnNames(columnListWithoutSizeColumns.size(), columnListWithoutSizeColumns);
-      const auto colTypes = GetValidatedArgTypes(validColumnNames, fColRegister, fLoopManager->GetTree(), fDataSource,
-                                                 "Cache", /*vector2rvec=*/false);
-      for (const auto &colType : colTypes)
-         cacheCall << colType << ", ";
-      if (!columnListWithoutSizeColumns.empty())
-         cacheCall.seekp(-2, cacheCall.cur);                         // remove the last ",
-      cacheCall << ">(*reinterpret_cast<std::vector<std::string>*>(" // vector<string> should be ColumnNames_t
-                << RDFInternal::PrettyPrintAddr(&columnListWithoutSizeColumns) << "));";
-
-      // book the code to jit with the RLoopManager and trigger the event loop
-      fLoopManager->ToJitExec(cacheCall.str());
-      fLoopManager->Jit();
-
-      return resRDF;
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Save selected columns in memory, or on disk if they exceed a memory budget.
+   /// \param[in] columnList columns to be cached.
+   /// \param[in] options options to steer the storage of the cached values, such as the memory budget.
+   /// \return a `RDataFrame` that wraps the cached dataset.
+   ///
+   /// See the previous overloads for more information.
+   RInterface<RLoopManager> Cache(const ColumnNames_t &columnList, const RCacheOptions &options)
+   {
+      return JitCache(columnList, &options);
    }
 
    ////////////////////////////////////////////////////////////////////////////
@@ -2836,8 +2867,7 @@ private:
          std::string(filename), std::string(dirname), std::string(treename), columnListWithoutSizeColumns, options});
 
       ::TDirectory::TContext ctxt;
-      auto newRDF =
-         std::make_shared<ROOT::RDataFrame>(fullTreeName, filename, /*defaultColumns=*/columnListWithoutSizeColumns);
+      auto newRDF = MakeSnapshotDataFrame(fullTreeName, filename, columnListWithoutSizeColumns, *snapHelperArgs);
 
       // The Snapshot helper will use validCols (with aliases resolved) as input columns, and
       // columnListWithoutSizeColumns (still with aliases in it, passed through snapHelperArgs) as output column names.
@@ -2849,6 +2879,69 @@ private:
       return resPtr;
    }
 
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Create the RDataFrame returned by Snapshot, which reads the output dataset.
+   /// An RNTuple can only be opened once it is written: in that case a placeholder is returned, which the Snapshot
+   /// action replaces at the end of the event loop.
+   std::shared_ptr<ROOT::RDataFrame> MakeSnapshotDataFrame(std::string_view fullTreeName, std::string_view filename,
+                                                           const ColumnNames_t &defaultColumns,
+                                                           RDFInternal::SnapshotHelperArgs &snapHelperArgs)
+   {
+      if (snapHelperArgs.fOptions.fOutputFormat == ROOT::RDF::ESnapshotOutputFormat::kRNTuple) {
+         snapHelperArgs.fOutputDataFrame = std::make_shared<ROOT::RDataFrame>(0);
+         return snapHelperArgs.fOutputDataFrame;
+      }
+      return std::make_shared<ROOT::RDataFrame>(fullTreeName, filename, defaultColumns);
+   }
+
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Implementation of the Cache overloads that infer the column types: the typed overload is jitted.
+   RInterface<RLoopManager> JitCache(const ColumnNames_t &columnList, const RCacheOptions *options)
+   {
+      // Early return: if the list of columns is empty, just return an empty RDF
+      // If we proceed, the jitted call will not compile!
+      if (columnList.empty()) {
+         auto nEntries = *this->Count();
+         RInterface<RLoopManager> emptyRDF(std::make_shared<RLoopManager>(nEntries));
+         return emptyRDF;
+      }
+
+      std::stringstream cacheCall;
+      auto upcastNode = RDFInternal::UpcastNode(fProxiedPtr);
+      RInterface<TTraits::TakeFirstParameter_t<decltype(upcastNode)>> upcastInterface(fProxiedPtr, *fLoopManager,
+                                                                                      fColRegister);
+      // build a string equivalent to
+      // "(RInterface<nodetype*>*)(this)->Cache<Ts...>(*(ColumnNames_t*)(&columnList))"
+      RInterface<RLoopManager> resRDF(std::make_shared<ROOT::Detail::RDF::RLoopManager>(0));
+      cacheCall << "*reinterpret_cast<ROOT::RDF::RInterface<ROOT::Detail::RDF::RLoopManager>*>("
+                << RDFInternal::PrettyPrintAddr(&resRDF)
+                << ") = reinterpret_cast<ROOT::RDF::RInterface<ROOT::Detail::RDF::RNodeBase>*>("
+                << RDFInternal::PrettyPrintAddr(&upcastInterface) << ")->Cache<";
+
+      const auto columnListWithoutSizeColumns = RDFInternal::FilterArraySizeColNames(columnList, "Cache");
+
+      const auto validColumnNames =
+         GetValidatedColumnNames(columnListWithoutSizeColumns.size(), columnListWithoutSizeColumns);
+      const auto colTypes = GetValidatedArgTypes(validColumnNames, fColRegister, fLoopManager->GetTree(), fDataSource,
+                                                 "Cache", /*vector2rvec=*/false);
+      for (const auto &colType : colTypes)
+         cacheCall << colType << ", ";
+      if (!columnListWithoutSizeColumns.empty())
+         cacheCall.seekp(-2, cacheCall.cur);                         // remove the last ",
+      cacheCall << ">(*reinterpret_cast<std::vector<std::string>*>(" // vector<string> should be ColumnNames_t
+                << RDFInternal::PrettyPrintAddr(&columnListWithoutSizeColumns) << ")";
+      if (options != nullptr)
+         cacheCall << ", *reinterpret_cast<const ROOT::RDF::RCacheOptions*>(" << RDFInternal::PrettyPrintAddr(options)
+                   << ")";
+      cacheCall << ");";
+
+      // book the code to jit with the RLoopManager and trigger the event loop
+      fLoopManager->ToJitExec(cacheCall.str());
+      fLoopManager->Jit();
+
+      return resRDF;
+   }
+
    ////////////////////////////////////////////////////////////////////////////
    /// \brief Implementation of cache.
    template <typename... ColTypes, std::size_t... S>
@@ -2872,6 +2965,32 @@ private:
       return cachedRDF;
    }
 
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Implementation of cache with a memory budget.
+   template <typename... ColTypes>
+   RInterface<RLoopManager> CacheImpl(const ColumnNames_t &columnList, const RCacheOptions &options)
+   {
+      const auto columnListWithoutSizeColumns = RDFInternal::FilterArraySizeColNames(columnList, "Cache");
+
+      // Check at compile time that the columns types are copy constructible
+      constexpr bool areCopyConstructible =
+         RDFInternal::TEvalAnd<std::is_copy_constructible<ColTypes>::value...>::value;
+      static_assert(areCopyConstructible, "Columns of a type which is not copy constructible cannot be cached yet.");
+
+      RDFInternal::CheckTypesAndPars(sizeof...(ColTypes), columnListWithoutSizeColumns.size());
+
+      const auto nSlots = fLoopManager->GetNSlots();
+      auto cache = std::make_shared<RDFInternal::RColumnCache>(options);
+      auto cacheResult = this->template Book<ColTypes...>(RDFInternal::CacheHelper<ColTypes...>(cache, nSlots),
+                                                          columnListWithoutSizeColumns);
+      auto ds =
+         std::make_unique<RDFInternal::RCacheDS<ColTypes...>>(std::move(cacheResult), columnListWithoutSizeColumns);
+
+      RInterface<RLoopManager> cachedRDF(std::make_shared<RLoopManager>(std::move(ds), columnListWithoutSizeColumns));
+
+      return cachedRDF;
+   }
+
    template <bool IsSingleColumn, typename F>
    RInterface<Proxied, DS_t>
    VaryImpl(const std::vector<std::string> &colNames, F &&expression, const ColumnNames_t &inputColumns,
@@ -48,6 +48,9 @@ public:
    void SetAction(std::unique_ptr<RActionBase> a) { fConcreteAction = std::move(a); }
 
    void Run(unsigned int slot, Long64_t entry) final;
+   void RunBlock(unsigned int slot, REntryBlock &block) final;
+   bool SupportsBatchMode() const final;
+   std::string GetActionName() final;
    void Initialize() final;
    void InitSlot(TTreeReader *r, unsigned int slot) final;
    void TriggerChildrenCount() final;
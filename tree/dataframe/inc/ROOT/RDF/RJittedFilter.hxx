@@ -47,6 +47,10 @@ public:
 
    void InitSlot(TTreeReader *r, unsigned int slot) final;
    bool CheckFilters(unsigned int slot, Long64_t entry) final;
+   bool EvaluateFilter(unsigned int slot, Long64_t entry) final;
+   RNodeBase *GetPrevNode() final;
+   RFilterBase *GetConcreteFilter() final;
+   const char *CheckFiltersBlock(unsigned int slot, ROOT::Internal::RDF::REntryBlock &block) final;
    void Report(ROOT::RDF::RCutFlowReport &) const final;
    void PartialReport(ROOT::RDF::RCutFlowReport &) const final;
    void FillReport(ROOT::RDF::RCutFlowReport &) const final;
@@ -12,12 +12,15 @@
 #define ROOT_RLOOPMANAGER
 
 #include "ROOT/InternalTreeUtils.hxx" // RNoCleanupNotifier
+#include "ROOT/RDF/RBlockColumnReader.hxx"
 #include "ROOT/RDF/RColumnReaderBase.hxx"
 #include "ROOT/RDF/RDatasetSpec.hxx"
 #include "ROOT/RDF/RNodeBase.hxx"
 #include "ROOT/RDF/RNewSampleNotifier.hxx"
+#include "ROOT/RDF/RProfiler.hxx"
 #include "ROOT/RDF/RSampleInfo.hxx"
 
+#include <cstddef> // std::size_t
 #include <functional>
 #include <limits>
 #include <map>
@@ -103,6 +106,12 @@ class RRangeBase;
 class RDefineBase;
 using ROOT::RDF::RDataSource;
 
+/// Time spent by a processing slot during the last multi-thread event loop, in seconds.
+struct RSlotTiming {
+   double fBusyTime = 0.; ///< Time spent processing entries
+   double fIdleTime = 0.; ///< Rest of the duration of the event loop
+};
+
 /// The head node of a RDF computation graph.
 /// This class is responsible of running the event loop.
 class RLoopManager : public RNodeBase {
@@ -152,6 +161,38 @@ class RLoopManager : public RNodeBase {
    /// Readers for TTree/RDataSource columns (one per slot), shared by all nodes in the computation graph.
    std::vector<std::unordered_map<std::string, std::unique_ptr<RColumnReaderBase>>> fDatasetColumnReaders;
 
+   /// Number of entries that are processed together by the nodes of the computation graph. 0 if batch mode is off.
+   std::size_t fBatchSize{0};
+   /// The blocks of entries being staged, one per slot. Only used in batch mode.
+   std::vector<RDFInternal::REntryBlock> fEntryBlocks;
+   /// Readers that stage the values of TTree/RDataSource columns in batch mode (one map per slot), with the same keys
+   /// as fDatasetColumnReaders.
+   std::vector<std::unordered_map<std::string, std::unique_ptr<RDFInternal::RBlockColumnReaderBase>>>
+      fBlockColumnReaders;
+   /// Number of entries per slot used to profile chains of filters before reordering them. 0 disables reordering.
+   ULong64_t fFilterProfileEntries{0};
+   /// Mask returned by CheckFiltersBlock: the head node lets all entries of a block through.
+   std::vector<char> fAllPassMask;
+
+   /// Busy and idle time of each slot during the last multi-thread event loop
+   std::vector<RSlotTiming> fSlotTimings;
+
+   /// Whether the next event loops are profiled, see ROOT::RDF::Experimental::SetProfiling()
+   bool fProfiling{false};
+   /// Seconds spent jitting before the current event loop
+   double fJitTime{0.};
+   /// The profiler of the current event loop. Null if the event loop is not profiled.
+   std::unique_ptr<RDFInternal::RProfiler> fProfiler;
+   /// The profile of the last profiled event loop
+   std::unique_ptr<RDFInternal::RProfiler> fLastProfile;
+   /// Readers that measure the reads of TTree/RDataSource columns in profiled event loops (one map per slot), with the
+   /// same keys as fDatasetColumnReaders.
+   std::vector<std::unordered_map<std::string, std::unique_ptr<RColumnReaderBase>>> fProfiledColumnReaders;
+
+   /// Loop managers that read the same dataset as this one and whose computation graphs are run as part of the next
+   /// event loop of this one, see Fuse(). Cleared at the end of the event loop.
+   std::vector<RLoopManager *> fFusedLoops;
+
    /// Cache of the tree/chain branch names. Never access directy, always use GetBranchNames().
    ColumnNames_t fValidBranchNames;
 
@@ -164,14 +205,20 @@ class RLoopManager : public RNodeBase {
    void RunDataSourceMT();
    void RunDataSource();
    void RunAndCheckFilters(unsigned int slot, Long64_t entry);
+   void StageEntry(unsigned int slot, Long64_t entry);
+   void RunAndCheckFiltersBlock(unsigned int slot);
+   void FlushEntryBlock(unsigned int slot);
    void InitNodeSlots(TTreeReader *r, unsigned int slot);
    void InitNodes();
+   void InitProfiler();
    void CleanUpNodes();
    void CleanUpTask(TTreeReader *r, unsigned int slot);
    void EvalChildrenCounts();
+   void BuildFilterChains();
    void SetupSampleCallbacks(TTreeReader *r, unsigned int slot);
    void UpdateSampleInfo(unsigned int slot, const std::pair<ULong64_t, ULong64_t> &range);
    void UpdateSampleInfo(unsigned int slot, TTreeReader &r);
+   bool HasActiveChildren() const;
 
 public:
    RLoopManager(TTree *tree, const ColumnNames_t &defaultBranches);
@@ -201,7 +248,16 @@ public:
    void Register(RDFInternal::RVariationBase *varPtr);
    void Deregister(RDFInternal::RVariationBase *varPtr);
    bool CheckFilters(unsigned int, Long64_t) final;
+   const char *CheckFiltersBlock(unsigned int, RDFInternal::REntryBlock &) final;
    unsigned int GetNSlots() const { return fNSlots; }
+   void SetBatchSize(std::size_t batchSize);
+   std::size_t GetBatchSize() const { return fBatchSize; }
+   void SetFilterProfileEntries(ULong64_t nEntries) { fFilterProfileEntries = nEntries; }
+   ULong64_t GetFilterProfileEntries() const { return fFilterProfileEntries; }
+   void SetProfiling(bool enable);
+   RDFInternal::RProfiler *GetProfiler() const { return fProfiler.get(); }
+   const RDFInternal::RProfiler *GetLastProfile() const { return fLastProfile.get(); }
+   RDFInternal::REntryBlock &GetEntryBlock(unsigned int slot) { return fEntryBlocks[slot]; }
    void Report(ROOT::RDF::RCutFlowReport &rep) const final;
    /// End of recursive chain of calls, does nothing
    void PartialReport(ROOT::RDF::RCutFlowReport &) const final {}
@@ -211,12 +267,23 @@ public:
    void ToJitExec(const std::string &) const;
    void RegisterCallback(ULong64_t everyNEvents, std::function<void(unsigned int)> &&f);
    unsigned int GetNRuns() const { return fNRuns; }
+   const std::vector<RSlotTiming> &GetSlotTimings() const { return fSlotTimings; }
+   bool HasSameDataset(const RLoopManager &other) const;
+   void Fuse(RLoopManager &other);
    bool HasDataSourceColumnReaders(const std::string &col, const std::type_info &ti) const;
    void AddDataSourceColumnReaders(const std::string &col, std::vector<std::unique_ptr<RColumnReaderBase>> &&readers,
                                    const std::type_info &ti);
    RColumnReaderBase *AddTreeColumnReader(unsigned int slot, const std::string &col,
                                           std::unique_ptr<RColumnReaderBase> &&reader, const std::type_info &ti);
    RColumnReaderBase *GetDatasetColumnReader(unsigned int slot, const std::string &col, const std::type_info &ti) const;
+   RColumnReaderBase *AddBlockColumnReader(unsigned int slot, const std::string &col,
+                                           std::unique_ptr<RDFInternal::RBlockColumnReaderBase> &&reader,
+                                           const std::type_info &ti);
+   RColumnReaderBase *GetBlockColumnReader(unsigned int slot, const std::string &col, const std::type_info &ti) const;
+   RColumnReaderBase *AddProfiledColumnReader(unsigned int slot, const std::string &col,
+                                              std::unique_ptr<RColumnReaderBase> &&reader, const std::type_info &ti);
+   RColumnReaderBase *
+   GetProfiledColumnReader(unsigned int slot, const std::string &col, const std::type_info &ti) const;
 
    /// End of recursive chain of calls, does nothing
    void AddFilterName(std::vector<std::string> &) final {}
@@ -29,6 +29,7 @@ namespace RDF {
 namespace GraphDrawing {
 class GraphNode;
 }
+struct REntryBlock;
 }
 }
 
@@ -54,6 +55,9 @@ public:
    }
    virtual ~RNodeBase() {}
    virtual bool CheckFilters(unsigned int, Long64_t) = 0;
+   /// Batch-mode counterpart of CheckFilters: return a mask with one element per entry of the block, non-zero for the
+   /// entries that pass all filters up to and including this node.
+   virtual const char *CheckFiltersBlock(unsigned int slot, ROOT::Internal::RDF::REntryBlock &block) = 0;
    virtual void Report(ROOT::RDF::RCutFlowReport &) const = 0;
    virtual void PartialReport(ROOT::RDF::RCutFlowReport &) const = 0;
    virtual void IncrChildrenCount() = 0;
@@ -71,6 +75,8 @@ public:
 
    virtual RLoopManager *GetLoopManagerUnchecked() { return fLoopManager; }
 
+   unsigned int GetNChildren() const { return fNChildren; }
+
    const std::vector<std::string> &GetVariations() const { return fVariations; }
 
    /// Return a clone of this node that acts as a Filter working with values in the variationName "universe".
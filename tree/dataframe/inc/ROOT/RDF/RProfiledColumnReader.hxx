@@ -0,0 +1,71 @@
+/*************************************************************************
+ * Copyright (C) 1995-2023, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RDF_RPROFILEDCOLUMNREADER
+#define ROOT_RDF_RPROFILEDCOLUMNREADER
+
+#include "RColumnReaderBase.hxx"
+#include "RProfiler.hxx"
+#include <Rtypes.h> // Long64_t, R__CLING_PTRCHECK
+
+#include <chrono>
+#include <cstddef> // std::size_t
+
+namespace ROOT {
+namespace Internal {
+namespace RDF {
+
+/// The in-memory size of the elements of a contiguous collection, e.g. an RVec or a std::vector
+template <typename T>
+auto GetValueSize(const T &value, int) -> decltype(value.size() * sizeof(*value.data()))
+{
+   return value.size() * sizeof(*value.data());
+}
+
+template <typename T>
+std::size_t GetValueSize(const T &, long)
+{
+   return sizeof(T);
+}
+
+/// Column reader for TTree and RDataSource columns in profiled event loops.
+/// It forwards to the wrapped dataset column reader, measuring the time it takes and the size of the values it
+/// returns. Each entry is counted once even if several nodes read the column.
+template <typename T>
+class R__CLING_PTRCHECK(off) RProfiledColumnReader final : public ROOT::Detail::RDF::RColumnReaderBase {
+   /// Non-owning pointer to the dataset column reader
+   ROOT::Detail::RDF::RColumnReaderBase *fReader;
+   RColumnProfile &fProfile;
+   Long64_t fLastEntry = -1;
+
+   void *GetImpl(Long64_t entry) final
+   {
+      const auto start = std::chrono::steady_clock::now();
+      T &value = fReader->template Get<T>(entry);
+      fProfile.fTime +=
+         std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+      if (entry != fLastEntry) {
+         ++fProfile.fNReads;
+         fProfile.fBytes += GetValueSize(value, 0);
+         fLastEntry = entry;
+      }
+      return &value;
+   }
+
+public:
+   RProfiledColumnReader(ROOT::Detail::RDF::RColumnReaderBase &reader, RColumnProfile &profile)
+      : fReader(&reader), fProfile(profile)
+   {
+   }
+};
+
+} // namespace RDF
+} // namespace Internal
+} // namespace ROOT
+
+#endif
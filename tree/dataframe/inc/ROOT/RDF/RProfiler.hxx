@@ -0,0 +1,154 @@
+/*************************************************************************
+ * Copyright (C) 1995-2023, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RDF_RPROFILER
+#define ROOT_RDF_RPROFILER
+
+#include "ROOT/RDF/Utils.hxx" // CacheLineStep
+#include <RtypesCore.h>       // ULong64_t
+
+#include <chrono>
+#include <cstddef> // std::size_t
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility> // std::pair
+#include <vector>
+
+namespace ROOT {
+namespace Internal {
+namespace RDF {
+
+/// Cumulative time that a node of the computation graph spends evaluating its expression, per processing slot.
+/// The time includes the evaluation of the Defines and the reading of the dataset columns that the node triggers.
+/// The clock is only read during the event loops that are profiled, see ROOT::RDF::Experimental::SetProfiling().
+class RNodeTimer {
+public:
+   using Clock_t = std::chrono::steady_clock;
+
+   /// Add the time elapsed between its construction and its destruction to the timer, if the timer is enabled
+   class RScope {
+      RNodeTimer &fTimer;
+      unsigned int fSlot;
+      Clock_t::time_point fStart;
+
+   public:
+      RScope(RNodeTimer &timer, unsigned int slot) : fTimer(timer), fSlot(slot)
+      {
+         if (fTimer.fEnabled)
+            fStart = Clock_t::now();
+      }
+      ~RScope()
+      {
+         if (fTimer.fEnabled)
+            fTimer.Add(fSlot, Clock_t::now() - fStart);
+      }
+      RScope(const RScope &) = delete;
+      RScope &operator=(const RScope &) = delete;
+   };
+
+private:
+   bool fEnabled = false;
+   /// Nanoseconds, one element every CacheLineStep<ULong64_t>() to avoid false sharing
+   std::vector<ULong64_t> fTimes;
+   /// Number of evaluations: entries, or blocks of entries in batch mode
+   std::vector<ULong64_t> fNCalls;
+
+   void Add(unsigned int slot, Clock_t::duration duration)
+   {
+      const auto idx = slot * CacheLineStep<ULong64_t>();
+      fTimes[idx] += std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+      ++fNCalls[idx];
+   }
+
+public:
+   /// Zero the timer and enable or disable it for the next event loop
+   void Reset(unsigned int nSlots, bool enable)
+   {
+      fEnabled = enable;
+      const auto size = enable ? nSlots * CacheLineStep<ULong64_t>() : 0u;
+      fTimes.assign(size, 0ull);
+      fNCalls.assign(size, 0ull);
+   }
+   bool IsEnabled() const { return fEnabled; }
+   ULong64_t GetTime(unsigned int slot) const { return fTimes[slot * CacheLineStep<ULong64_t>()]; }
+   ULong64_t GetNCalls(unsigned int slot) const { return fNCalls[slot * CacheLineStep<ULong64_t>()]; }
+};
+
+/// The values of a dataset column read by a processing slot during a profiled event loop
+struct RColumnProfile {
+   ULong64_t fNReads = 0; ///< Number of entries for which the column was read
+   ULong64_t fBytes = 0;  ///< In-memory size of the values read, see RProfiledColumnReader
+   ULong64_t fTime = 0;   ///< Nanoseconds spent in the dataset column reader, including decompression and conversions
+};
+
+/// Collect the timings of the nodes of a computation graph, of the dataset columns they read and of the processing
+/// slots during an event loop, and export them as JSON or in the Chrome trace event format.
+/// Each slot only updates its own data during the event loop, so that no synchronization is needed except when
+/// a column is read for the first time by a slot.
+class RProfiler {
+public:
+   using Clock_t = std::chrono::steady_clock;
+
+private:
+   struct RNodeInfo {
+      std::string fKind;
+      std::string fName;
+      RNodeTimer *fTimer; ///< Only valid during the event loop
+      std::vector<ULong64_t> fTimes; ///< Nanoseconds per slot, filled at the end of the event loop
+      ULong64_t fNCalls = 0;
+   };
+   /// A range of entries processed by a slot
+   struct RTaskInfo {
+      double fStart; ///< Seconds since the beginning of the event loop
+      double fEnd;
+      /// Time spent in each node during the task, in nanoseconds. Nodes that were not evaluated are omitted.
+      std::vector<std::pair<std::size_t, ULong64_t>> fNodeTimes;
+   };
+   struct RSlotInfo {
+      bool fInTask = false;
+      Clock_t::time_point fTaskStart;
+      std::vector<ULong64_t> fNodeTimesAtTaskStart;
+      std::vector<RTaskInfo> fTasks;
+   };
+
+   unsigned int fNSlots;
+   double fJitTime; ///< Seconds spent jitting before the event loop
+   Clock_t::time_point fLoopStart;
+   double fLoopTime = 0.; ///< Seconds
+   std::vector<RNodeInfo> fNodes;
+   std::vector<std::unique_ptr<RSlotInfo>> fSlots;
+   std::mutex fColumnsMutex;
+   /// The profiles of each column, one per slot. Never shrinks during an event loop, so references stay valid.
+   std::map<std::string, std::vector<std::unique_ptr<RColumnProfile>>> fColumns;
+
+   double ToSeconds(Clock_t::duration duration) const { return std::chrono::duration<double>(duration).count(); }
+
+public:
+   RProfiler(unsigned int nSlots, double jitTime);
+   RProfiler(const RProfiler &) = delete;
+   RProfiler &operator=(const RProfiler &) = delete;
+
+   /// Profile the node with the given timer. Must be called before BeginLoop().
+   void AddNode(const std::string &kind, const std::string &name, RNodeTimer &timer);
+   void BeginLoop();
+   void BeginTask(unsigned int slot);
+   void EndTask(unsigned int slot);
+   void EndLoop();
+   RColumnProfile &GetColumnProfile(const std::string &colName, unsigned int slot);
+
+   std::string ToJSON() const;
+   std::string ToChromeTrace() const;
+};
+
+} // namespace RDF
+} // namespace Internal
+} // namespace ROOT
+
+#endif
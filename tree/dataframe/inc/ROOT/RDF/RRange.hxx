@@ -17,6 +17,7 @@
 #include "RtypesCore.h"
 
 #include <cassert>
+#include <cstddef> // std::size_t
 #include <memory>
 
 namespace ROOT {
@@ -45,6 +46,19 @@ class RRange final : public RRangeBase {
    const std::shared_ptr<PrevNode_t> fPrevNodePtr;
    PrevNode_t &fPrevNode;
 
+   /// Apply the range logic to the next entry that passed the upstream filters
+   bool CheckRange()
+   {
+      const bool pass = !(fNProcessedEntries < fStart || (fStop > 0 && fNProcessedEntries >= fStop) ||
+                          (fStride != 1 && (fNProcessedEntries - fStart) % fStride != 0));
+      ++fNProcessedEntries;
+      if (fNProcessedEntries == fStop) {
+         fHasStopped = true;
+         fPrevNode.StopProcessing();
+      }
+      return pass;
+   }
+
 public:
    RRange(unsigned int start, unsigned int stop, unsigned int stride, std::shared_ptr<PrevNode_t> pd)
       : RRangeBase(pd->GetLoopManagerUnchecked(), start, stop, stride, pd->GetLoopManagerUnchecked()->GetNSlots(),
@@ -63,6 +77,10 @@ public:
    /// Ranges act as filters when it comes to selecting entries that downstream nodes should process
    bool CheckFilters(unsigned int slot, Long64_t entry) final
    {
+      if (fLoopManager->GetBatchSize() > 0) {
+         auto &block = fLoopManager->GetEntryBlock(slot);
+         return CheckFiltersBlock(slot, block)[block.fCurrent];
+      }
       if (entry != fLastCheckedEntry) {
          if (fHasStopped)
             return false;
@@ -71,22 +89,30 @@ public:
             fLastResult = false;
          } else {
             // apply range filter logic, cache the result
-            if (fNProcessedEntries < fStart || (fStop > 0 && fNProcessedEntries >= fStop) ||
-                (fStride != 1 && (fNProcessedEntries - fStart) % fStride != 0))
-               fLastResult = false;
-            else
-               fLastResult = true;
-            ++fNProcessedEntries;
-            if (fNProcessedEntries == fStop) {
-               fHasStopped = true;
-               fPrevNode.StopProcessing();
-            }
+            fLastResult = CheckRange();
          }
          fLastCheckedEntry = entry;
       }
       return fLastResult;
    }
 
+   const char *CheckFiltersBlock(unsigned int slot, ROOT::Internal::RDF::REntryBlock &block) final
+   {
+      if (block.fId != fLastCheckedBlock) {
+         const auto nEntries = block.fEntries.size();
+         fBlockMask.assign(nEntries, false);
+         if (!fHasStopped) {
+            const char *prevMask = fPrevNode.CheckFiltersBlock(slot, block);
+            for (std::size_t i = 0u; i < nEntries && !fHasStopped; ++i) {
+               if (prevMask[i])
+                  fBlockMask[i] = CheckRange();
+            }
+         }
+         fLastCheckedBlock = block.fId;
+      }
+      return fBlockMask.data();
+   }
+
    // recursive chain of `Report`s
    // RRange simply forwards these calls to the previous node
    void Report(ROOT::RDF::RCutFlowReport &rep) const final { fPrevNode.PartialReport(rep); }
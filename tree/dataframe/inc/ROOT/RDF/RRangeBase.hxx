@@ -15,6 +15,7 @@
 #include "RtypesCore.h"
 
 #include <unordered_map>
+#include <vector>
 
 namespace ROOT {
 namespace Internal {
@@ -39,6 +40,8 @@ protected:
    bool fLastResult{true};
    ULong64_t fNProcessedEntries{0};
    bool fHasStopped{false};    ///< True if the end of the range has been reached
+   Long64_t fLastCheckedBlock{-1}; ///< Id of the last entry block processed in batch mode
+   std::vector<char> fBlockMask;   ///< Result for each entry of the last block processed in batch mode
    const unsigned int fNSlots; ///< Number of thread slots used by this node, inherited from parent node.
    std::unordered_map<std::string, std::shared_ptr<RRangeBase>> fVariedRanges;
 
@@ -123,8 +123,10 @@ public:
    void Run(unsigned int slot, Long64_t entry) final
    {
       for (auto varIdx = 0u; varIdx < GetVariations().size(); ++varIdx) {
-         if (fPrevNodes[varIdx]->CheckFilters(slot, entry))
+         if (fPrevNodes[varIdx]->CheckFilters(slot, entry)) {
+            RNodeTimer::RScope timing(fTimer, slot);
             CallExec(slot, varIdx, entry, ColumnTypes_t{}, TypeInd_t{});
+         }
       }
    }
 
@@ -154,6 +156,10 @@ public:
    /// Return the per-sample callback connected to the nominal result.
    ROOT::RDF::SampleCallback_t GetSampleCallback() final { return fHelpers[0].GetSampleCallback(); }
 
+   bool SupportsBatchMode() const final { return fHelpers[0].SupportsBatchMode(); }
+
+   std::string GetActionName() final { return "Varied " + fHelpers[0].GetActionName(); }
+
    std::shared_ptr<RDFGraphDrawing::GraphNode>
    GetGraph(std::unordered_map<void *, std::shared_ptr<RDFGraphDrawing::GraphNode>> &visitedMap) final
    {
@@ -197,6 +197,20 @@ void InterpreterDeclare(const std::string &code);
 /// The pointer returned by the call to TInterpreter::Calc is returned in case of success.
 Long64_t InterpreterCalc(const std::string &code, const std::string &context = "");
 
+/// Compile the expressions jitted since the last call and add them to the persistent cache of jitted expressions, if
+/// the cache is enabled. See ROOT::RDF::Experimental::SetJitCacheDir.
+void FlushJitCache();
+
+/// Number of functions jitted by this process, by outcome of their lookup in the persistent cache of jitted
+/// expressions. Meant for testing.
+struct RJitCacheCounters {
+   unsigned int fNLoaded = 0;      ///< functions taken from a library in the cache
+   unsigned int fNUncacheable = 0; ///< functions that the cache marks as not compilable, jitted as usual
+   unsigned int fNPending = 0;     ///< functions jitted and scheduled to be added to the cache
+};
+
+RJitCacheCounters GetJitCacheCounters();
+
 /// Whether custom column with name colName is an "internal" column such as rdfentry_ or rdfslot_
 bool IsInternalColumn(std::string_view colName);
 
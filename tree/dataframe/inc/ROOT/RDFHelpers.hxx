@@ -17,8 +17,10 @@
 #include <ROOT/RDF/RActionBase.hxx>
 #include <ROOT/RDF/RResultMap.hxx>
 #include <ROOT/RResultHandle.hxx> // users of RunGraphs might rely on this transitive include
+#include <ROOT/RStringView.hxx>
 #include <ROOT/TypeTraits.hxx>
 
+#include <cstddef> // std::size_t
 #include <fstream>
 #include <functional>
 #include <memory>
@@ -159,6 +161,7 @@ RNode AsRNode(NodeType node)
 // clang-format off
 /// Trigger the event loop of multiple RDataFrames concurrently
 /// \param[in] handles A vector of RResultHandles
+/// \param[in] fuseGraphs Whether computation graphs that read the same dataset should share a single event loop
 ///
 /// This function triggers the event loop of all computation graphs which relate to the
 /// given RResultHandles. The advantage compared to running the event loop implicitly by accessing the
@@ -176,8 +179,26 @@ RNode AsRNode(NodeType node)
 /// // RResultPtr -> RResultHandle conversion is automatic
 /// ROOT::RDF::RunGraphs({r1, r2});
 /// ~~~
+///
+/// If `fuseGraphs` is true, the computation graphs that read the same entries of the same dataset are run in a single
+/// event loop: the dataset is traversed once, and the columns needed by several graphs are read and decompressed once
+/// per entry. Empty sources with the same number of entries, the same TTree or TChain object, and trees or chains
+/// without friends or entry lists that read the same trees from the same files with the same entry range are
+/// considered the same dataset. Graphs that read from an RDataSource are never fused. Identical just-in-time compiled
+/// expressions (e.g. in Filter and Define calls) are compiled once for all graphs, whether fusion is enabled or not.
+///
+/// ~~~{.cpp}
+/// ROOT::RDataFrame df1("tree", "file.root");
+/// auto r1 = df1.Filter("x > 0").Histo1D("y");
+///
+/// ROOT::RDataFrame df2("tree", "file.root");
+/// auto r2 = df2.Filter("x < 0").Histo1D("y");
+///
+/// // a single event loop over "file.root" fills both histograms
+/// ROOT::RDF::RunGraphs({r1, r2}, /*fuseGraphs=*/true);
+/// ~~~
 // clang-format on
-void RunGraphs(std::vector<RResultHandle> handles);
+void RunGraphs(std::vector<RResultHandle> handles, bool fuseGraphs = false);
 
 namespace Experimental {
 
@@ -248,6 +269,119 @@ RResultMap<T> VariationsFor(RResultPtr<T> resPtr)
                                         *resPtr.fLoopManager, std::move(nominalAction), std::move(variedAction));
 }
 
+/// \brief Process entries in blocks of the given size rather than one at a time.
+/// \param[in] node Any node of the computation graph: the setting applies to the whole graph.
+/// \param[in] batchSize The number of entries in a block. 0 (the default) disables batch mode.
+///
+/// In batch mode, the values of the dataset columns required by the computation graph are copied into contiguous
+/// arrays, one block of entries at a time. Each Filter is then evaluated on all the entries of a block in one tight
+/// loop, producing a selection mask for the nodes downstream, and each Define computes its values for all the
+/// selected entries of the block at once. Actions are executed on the selected entries after all upstream nodes have
+/// processed the block. This improves data locality and reduces the per-entry overhead of traversing the
+/// computation graph, at the cost of reading all required dataset columns for every entry.
+///
+/// Results are identical to those obtained without batch mode. Since each entry is processed only when its block is
+/// complete, callbacks registered with RResultPtr::OnPartialResult are invoked once per entry but only after the
+/// processing of the corresponding block. The setting must be changed only between event loops.
+///
+/// \note Batch mode requires dataset columns to have a default-constructible and copy-assignable type, and it is not
+///       supported by the Snapshot action: in these cases an exception is thrown when the event loop starts.
+///
+/// ~~~{.cpp}
+/// ROOT::RDataFrame df("tree", "file.root");
+/// ROOT::RDF::Experimental::SetBatchSize(df, 64);
+/// auto h = df.Filter("pt > 10").Define("pt2", "pt * pt").Histo1D("pt2");
+/// ~~~
+void SetBatchSize(const RNode &node, std::size_t batchSize);
+
+/// \brief Let RDataFrame choose the order in which chains of consecutive Filters are evaluated.
+/// \param[in] node Any node of the computation graph: the setting applies to the whole graph.
+/// \param[in] nProfileEntries The number of entries that each slot uses to profile the filters. 0 (the default)
+///            disables reordering.
+///
+/// Analysis cuts are usually written in the order that makes physics sense rather than in the cheapest order to
+/// evaluate. With this option, each sequence of consecutive unnamed Filters whose intermediate results are not used
+/// by any other node is treated as a single conjunction. For the first `nProfileEntries` entries of each slot, all
+/// the filters of the sequence are evaluated, measuring their pass rate and their evaluation time. The filters are
+/// then evaluated in order of increasing cost per rejected entry and the evaluation stops at the first failing
+/// filter. As dataset columns and Defines are only read or computed when they are first needed, the columns used by
+/// the filters moved towards the end of the sequence are not read for the entries rejected earlier.
+///
+/// The selected entries and all results are the same as without reordering, provided that the filters have no side
+/// effects and are safe to evaluate in any order: e.g. `Filter("nJets > 0").Filter("Jet_pt[0] > 30")` must instead
+/// be written as a single Filter. Named filters are never reordered, nor are filters before a Range or before another
+/// branch of the computation graph, so that cut-flow reports are not affected. The chosen order, the pass rate and
+/// the cost of each reordered filter are shown by SaveGraph. Reordering is not applied in batch mode (see
+/// SetBatchSize()). The setting must be changed only between event loops.
+///
+/// ~~~{.cpp}
+/// ROOT::RDataFrame df("tree", "file.root");
+/// ROOT::RDF::Experimental::SetFilterReordering(df, 1000);
+/// auto h = df.Filter("pt > 10").Filter("ExpensiveIsolation(tracks) < 0.1").Filter("nMuons == 2").Histo1D("pt");
+/// ~~~
+void SetFilterReordering(const RNode &node, ULong64_t nProfileEntries);
+
+/// \brief Measure where the time of the next event loops of a computation graph is spent.
+/// \param[in] node Any node of the computation graph: the setting applies to the whole graph.
+/// \param[in] enable Whether the next event loops are profiled. Profiling is disabled by default.
+///
+/// In a profiled event loop, RDataFrame measures the cumulative time spent by each processing slot in each Filter,
+/// Define and action, the number of values read from each dataset column together with their in-memory size and the
+/// time spent reading them, the time each slot spends processing entries, and the time spent jitting before the event
+/// loop. The time of a node includes the Defines it triggers and the reads of the columns it uses: e.g. the time of a
+/// Filter includes the computation of the Defines it is the first node to need. The profile of the last profiled
+/// event loop can be exported with SaveProfile().
+///
+/// Reading the clock twice per node and per entry adds an overhead which is negligible for most analyses but can be
+/// noticeable for computation graphs made of many trivial expressions; when profiling is disabled, the overhead is a
+/// branch per node and per entry. The setting must be changed only between event loops.
+///
+/// ~~~{.cpp}
+/// ROOT::RDataFrame df("tree", "file.root");
+/// ROOT::RDF::Experimental::SetProfiling(df, true);
+/// auto h = df.Filter("pt > 10").Define("pt2", "pt * pt").Histo1D("pt2");
+/// h->Draw();
+/// ROOT::RDF::Experimental::SaveProfile(df, "profile.json", ROOT::RDF::Experimental::EProfileFormat::kChromeTrace);
+/// ~~~
+void SetProfiling(const RNode &node, bool enable = true);
+
+/// \brief Return the profile of the last profiled event loop of a computation graph, see SetProfiling().
+/// \param[in] node Any node of the computation graph.
+/// \param[in] format kJSON returns a summary with the total time of each node, the reads of each dataset column and
+///            the utilization of each slot. kChromeTrace returns the jitting phase, the event loop and the tasks of
+///            each slot, with the time spent in each node during each task, in the Chrome trace event format: it can
+///            be displayed by chrome://tracing or https://ui.perfetto.dev.
+///
+/// All times are given in seconds in the JSON summary, in microseconds in the trace. An exception is thrown if no
+/// event loop was profiled.
+std::string SaveProfile(const RNode &node, EProfileFormat format = EProfileFormat::kJSON);
+
+/// \brief Write the profile of the last profiled event loop of a computation graph to a file, see SaveProfile().
+void SaveProfile(const RNode &node, const std::string &outputFile, EProfileFormat format = EProfileFormat::kJSON);
+
+/// \brief Enable a persistent cache of the code jitted for RDataFrame string expressions.
+/// \param[in] dir The directory of the cache, which is created if needed. An empty string disables the cache.
+///
+/// The functions generated for the expressions passed as strings to Filter, Define, DefinePerSample and Vary are
+/// compiled into shared libraries stored in `dir`, keyed by the expression, the types of the columns it uses, the ROOT
+/// version and the compiler configuration. When another process encounters the same expression, it loads the
+/// corresponding library and only declares the prototype of the function to the interpreter, skipping the parsing
+/// and the compilation of its body. New expressions are compiled, once per event loop, when the event loop starts;
+/// this first compilation is slower than jitting. The glue code that connects the expressions to the computation
+/// graph is still jitted at every execution.
+///
+/// Expressions that use entities only known to the interpreter (e.g. functions passed to gInterpreter->Declare)
+/// cannot be compiled: they are recorded as such in the cache and keep being jitted. The cache directory can be
+/// shared by concurrent processes. The default value is taken from the `RDataFrame.JitCacheDir` rootrc setting.
+/// The setting must be changed before the expressions are booked.
+///
+/// ~~~{.cpp}
+/// ROOT::RDF::Experimental::SetJitCacheDir("/path/to/jitcache");
+/// ROOT::RDataFrame df("tree", "file.root");
+/// auto h = df.Filter("pt > 10").Define("pt2", "pt * pt").Histo1D("pt2");
+/// ~~~
+void SetJitCacheDir(std::string_view dir);
+
 } // namespace Experimental
 } // namespace RDF
 } // namespace ROOT
@@ -19,6 +19,7 @@
 
 #include <ROOT/RDataFrame.hxx>
 #include <ROOT/RDataSource.hxx>
+#include <ROOT/RNTupleDescriptor.hxx>
 #include <ROOT/RNTupleUtil.hxx>
 #include <ROOT/RStringView.hxx>
 
@@ -31,7 +32,6 @@ namespace ROOT {
 namespace Experimental {
 
 class RNTuple;
-class RNTupleDescriptor;
 
 namespace Detail {
 class RFieldBase;
@@ -55,6 +55,9 @@ class RNTupleDS final : public ROOT::RDF::RDataSource {
    std::vector<std::string> fColumnTypes;
    std::vector<size_t> fActiveColumns;
 
+   /// Cuts used to skip the clusters and pages whose statistics show that they cannot contain passing entries
+   std::vector<RNTupleDescriptor::RValueRangeCut> fValueRangeCuts;
+
    unsigned fNSlots = 0;
    bool fHasSeenAllRanges = false;
 
@@ -83,6 +86,12 @@ public:
 
    bool SetEntry(unsigned int slot, ULong64_t entry) final;
 
+   /// Restrict the event loop to the clusters and pages that, according to their min/max statistics, may contain
+   /// entries passing the given cuts (see RNTupleDescriptor::FindEntryRanges()). This is an optimization only:
+   /// the skipped entries are guaranteed to fail the cuts but the processed entries still need to be filtered,
+   /// e.g. `df.Filter("pt > 50")` for the cut `{"pt", 50., inf}`. Must be set before the event loop starts.
+   void SetValueRangeCuts(const std::vector<RNTupleDescriptor::RValueRangeCut> &cuts) { fValueRangeCuts = cuts; }
+
    void Initialize() final;
    void Finalize() final;
 
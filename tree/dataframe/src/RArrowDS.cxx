@@ -20,9 +20,17 @@ A RDataFrame that adapts an arrow::Table class can be constructed using the fact
 ROOT::RDF::FromArrow, which accepts one parameter:
 1. An arrow::Table smart pointer.
 
+Files in the Arrow IPC file format (also known as Feather V2) can be read directly with ROOT::RDF::FromArrowFile.
+The file is mapped in memory rather than read: the values of numeric columns and of lists of numbers are accessed
+in place, without any copy, and only the requested columns are ever loaded from disk.
+
 The types of the columns are derived from the types in the associated
 arrow::Schema.
 
+If the columns of the table are split in several chunks (e.g. the record batches of an Arrow file), and all columns
+share the same chunk boundaries, each entry range processed by RDataFrame corresponds to one chunk. Otherwise the
+entries are split in as many equal ranges as there are processing slots.
+
 */
 // clang-format on
 
@@ -41,6 +49,8 @@ arrow::Schema.
 #pragma GCC diagnostic ignored "-Wshadow"
 #pragma GCC diagnostic ignored "-Wunused-parameter"
 #endif
+#include <arrow/io/file.h>
+#include <arrow/ipc/reader.h>
 #include <arrow/table.h>
 #include <arrow/stl.h>
 #if defined(__GNUC__)
@@ -551,6 +561,43 @@ getData<std::shared_ptr<arrow::ChunkedArray>>(std::shared_ptr<arrow::ChunkedArra
    return p;
 }
 
+/// Split the entries in one range per chunk of the table, so that chunks (e.g. the record batches of an Arrow file) are
+/// not split among tasks. Return false, leaving the ranges empty, if the columns do not share the same chunk boundaries
+/// or if there is only one chunk.
+bool splitInChunkRanges(std::vector<std::pair<ULong64_t, ULong64_t>> &ranges, arrow::Table &table,
+                        const std::vector<std::pair<size_t, size_t>> &getterIndex)
+{
+   ranges.clear();
+   if (getterIndex.empty())
+      return false;
+
+   auto getChunkEnds = [&table](size_t columnIdx) {
+      std::vector<ULong64_t> ends;
+      ULong64_t end = 0;
+      for (auto &chunk : getData(table.column(columnIdx))->chunks()) {
+         end += chunk->length();
+         ends.push_back(end);
+      }
+      return ends;
+   };
+
+   const auto chunkEnds = getChunkEnds(getterIndex.front().first);
+   if (chunkEnds.size() < 2)
+      return false;
+   for (auto &link : getterIndex) {
+      if (getChunkEnds(link.first) != chunkEnds)
+         return false;
+   }
+
+   ULong64_t start = 0;
+   for (auto end : chunkEnds) {
+      if (end > start)
+         ranges.emplace_back(start, end);
+      start = end;
+   }
+   return true;
+}
+
 void RArrowDS::SetNSlots(unsigned int nSlots)
 {
    assert(0U == fNSlots && "Setting the number of slots even if the number of slots is different from zero.");
@@ -588,6 +635,8 @@ std::vector<void *> RArrowDS::GetColumnReadersImpl(std::string_view colName, con
 
 void RArrowDS::Initialize()
 {
+   if (splitInChunkRanges(fEntryRanges, *fTable, fGetterIndex))
+      return;
    auto nRecords = getNRecords(fTable, fColumnNames);
    splitInEqualRanges(fEntryRanges, nRecords, fNSlots);
 }
@@ -609,6 +658,54 @@ RDataFrame FromArrow(std::shared_ptr<arrow::Table> table, std::vector<std::strin
    return tdf;
 }
 
+namespace {
+template <typename T>
+T ValueOrThrow(arrow::Result<T> &&result, const std::string &what)
+{
+   if (!result.ok())
+      throw std::runtime_error("FromArrowFile: " + what + ": " + result.status().ToString());
+   return std::move(result).ValueOrDie();
+}
+} // anonymous namespace
+
+/// \brief Factory method to create a RDataFrame that reads a file in the Arrow IPC file format.
+///
+/// The file is mapped in memory: the columns are not copied, and only the requested columns are read from disk.
+/// Each record batch of the file is processed as a separate entry range, so that in multi-thread event loops
+/// record batches are distributed among the processing slots.
+/// \param[in] fileName the path of the file to read
+/// \param[in] columnNames the name of the columns to use
+/// In case columnNames is empty, we use all the columns found in the file
+RDataFrame FromArrowFile(std::string_view fileName, std::vector<std::string> const &columnNames)
+{
+   const std::string fname(fileName);
+   auto file =
+      ValueOrThrow(arrow::io::MemoryMappedFile::Open(fname, arrow::io::FileMode::READ), "could not open " + fname);
+   const auto schema =
+      ValueOrThrow(arrow::ipc::RecordBatchFileReader::Open(file), "could not read the schema of " + fname)->schema();
+
+   // only read the requested columns
+   auto options = arrow::ipc::IpcReadOptions::Defaults();
+   for (const auto &columnName : columnNames) {
+      const auto fieldIdx = schema->GetFieldIndex(columnName);
+      if (fieldIdx < 0)
+         throw std::runtime_error("FromArrowFile: file " + fname + " does not have column " + columnName);
+      options.included_fields.push_back(fieldIdx);
+   }
+   auto reader = ValueOrThrow(arrow::ipc::RecordBatchFileReader::Open(file, options), "could not read " + fname);
+
+   arrow::RecordBatchVector batches;
+   for (int i = 0; i < reader->num_record_batches(); ++i)
+      batches.emplace_back(ValueOrThrow(reader->ReadRecordBatch(i), "could not read record batch " +
+                                                                       std::to_string(i) + " of " + fname));
+   // the buffers of the record batches keep the memory mapping alive
+   auto table = ValueOrThrow(arrow::Table::FromRecordBatches(reader->schema(), batches),
+                             "could not create a table from " + fname);
+
+   ROOT::RDataFrame tdf(std::make_unique<RArrowDS>(table, columnNames));
+   return tdf;
+}
+
 } // namespace RDF
 
 } // namespace ROOT
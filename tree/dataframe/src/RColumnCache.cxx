@@ -0,0 +1,95 @@
+/*************************************************************************
+ * Copyright (C) 1995-2023, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/RDF/RColumnCache.hxx"
+#include "TString.h"
+#include "TSystem.h"
+
+#include <stdexcept>
+#include <string>
+
+namespace ROOT {
+namespace Internal {
+namespace RDF {
+
+RColumnCache::RColumnCache(const ROOT::RDF::RCacheOptions &options)
+   : fMemoryBudget(options.fMemoryBudget), fSpillDirectory(options.fSpillDirectory)
+{
+}
+
+RColumnCache::~RColumnCache()
+{
+   if (fSpillFile != nullptr) {
+      fclose(fSpillFile);
+      gSystem->Unlink(fSpillFileName.c_str());
+   }
+}
+
+bool RColumnCache::ReserveMemory(ULong64_t bytes)
+{
+   if (fMemoryBudget == 0) {
+      fMemoryUsage += bytes;
+      return true;
+   }
+
+   auto usage = fMemoryUsage.load();
+   do {
+      if (usage + bytes > fMemoryBudget)
+         return false;
+   } while (!fMemoryUsage.compare_exchange_weak(usage, usage + bytes));
+   return true;
+}
+
+RColumnCache::RSpilledColumn RColumnCache::Spill(const char *buffer, std::uint64_t size)
+{
+   std::lock_guard<std::mutex> lock(fMutex);
+
+   if (fSpillFile == nullptr) {
+      TString fileName = "rdfcache_";
+      fSpillFile = gSystem->TempFileName(fileName, fSpillDirectory.empty() ? nullptr : fSpillDirectory.c_str());
+      if (fSpillFile == nullptr)
+         throw std::runtime_error("Cache: could not create a temporary file to store the values that exceed the "
+                                  "memory budget.");
+      fSpillFileName = fileName.Data();
+   }
+
+   if (size > 0 && fwrite(buffer, 1, size, fSpillFile) != size)
+      throw std::runtime_error("Cache: could not write to the temporary file " + fSpillFileName);
+
+   RSpilledColumn column;
+   column.fOffset = fSpillFileSize;
+   column.fSize = size;
+   fSpillFileSize += size;
+   return column;
+}
+
+void RColumnCache::ReadSpilled(std::ifstream &spillFile, const RSpilledColumn &column, char *buffer) const
+{
+   spillFile.seekg(column.fOffset);
+   spillFile.read(buffer, column.fSize);
+   if (!spillFile)
+      throw std::runtime_error("Cache: could not read from the temporary file " + fSpillFileName);
+}
+
+void RColumnCache::AddChunk(RChunk &&chunk)
+{
+   std::lock_guard<std::mutex> lock(fMutex);
+   fNEntries += chunk.fNEntries;
+   fChunks.emplace_back(std::move(chunk));
+}
+
+void RColumnCache::Flush()
+{
+   std::lock_guard<std::mutex> lock(fMutex);
+   if (fSpillFile != nullptr && fflush(fSpillFile) != 0)
+      throw std::runtime_error("Cache: could not write to the temporary file " + fSpillFileName);
+}
+
+} // namespace RDF
+} // namespace Internal
+} // namespace ROOT
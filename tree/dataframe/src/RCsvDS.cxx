@@ -71,6 +71,10 @@ double-quote characters must be represented by a pair of double-quote characters
 The current implementation of RCsvDS reads the entire CSV file content into memory before
 RDataFrame starts processing it. Therefore, before creating a CSV RDataFrame, it is
 important to check both how much memory is available and the size of the CSV file.
+For large files, the chunk size parameter bounds the memory usage: the file is then read and processed
+in chunks of the given number of lines.
+
+When implicit multi-threading is enabled, the lines of each chunk are parsed in parallel.
 
 RCsvDS can handle empty cells and also allows the usage of the special keywords "NaN" and "nan" to
 indicate `nan` values. If the column is of type double, these cells are stored internally as `nan`.
@@ -81,9 +85,15 @@ Empty cells and explicit `nan`-s inside columns of type Long64_t/bool are stored
 #include <ROOT/TSeq.hxx>
 #include <ROOT/RCsvDS.hxx>
 #include <ROOT/RRawFile.hxx>
+#include <RConfigure.h> // R__USE_IMT
 #include <TError.h>
+#include <TROOT.h> // IsImplicitMTEnabled
+#ifdef R__USE_IMT
+#include <ROOT/TThreadExecutor.hxx>
+#endif
 
 #include <algorithm>
+#include <cstring>
 #include <memory>
 #include <sstream>
 #include <string>
@@ -117,14 +127,14 @@ void RCsvDS::FillHeaders(const std::string &line)
    }
 }
 
-void RCsvDS::FillRecord(const std::string &line, Record_t &record)
+void RCsvDS::FillRecord(const std::string &line, Record_t &record, std::set<std::string> &colContainingEmpty) const
 {
    auto i = 0U;
 
    auto columns = ParseColumns(line);
 
    for (auto &col : columns) {
-      auto colType = fColTypes[fHeaders[i]];
+      auto colType = fColTypesList[i];
 
       switch (colType) {
       case 'D': {
@@ -135,7 +145,7 @@ void RCsvDS::FillRecord(const std::string &line, Record_t &record)
          if (col != "nan") {
             record.emplace_back(new Long64_t(std::stoll(col)));
          } else {
-            fColContainingEmpty.insert(fHeaders[i]);
+            colContainingEmpty.insert(fHeaders[i]);
             record.emplace_back(new Long64_t(0));
          }
          break;
@@ -146,7 +156,7 @@ void RCsvDS::FillRecord(const std::string &line, Record_t &record)
          if (col != "nan") {
             std::istringstream(col) >> std::boolalpha >> *b;
          } else {
-            fColContainingEmpty.insert(fHeaders[i]);
+            colContainingEmpty.insert(fHeaders[i]);
             *b = false;
          }
          break;
@@ -160,6 +170,37 @@ void RCsvDS::FillRecord(const std::string &line, Record_t &record)
    }
 }
 
+/// Parse the lines of a chunk of the CSV file into fRecords.
+/// If implicit multi-threading is enabled, large chunks are split in blocks of lines that are parsed in parallel.
+void RCsvDS::FillRecords(const std::vector<std::string> &lines)
+{
+   const auto nLines = lines.size();
+   fRecords.resize(nLines);
+
+#ifdef R__USE_IMT
+   // below this number of lines per task, parsing is cheaper than scheduling
+   constexpr std::size_t minLinesPerTask = 1024;
+   if (ROOT::IsImplicitMTEnabled() && nLines >= 2 * minLinesPerTask) {
+      const auto nTasks = std::min(nLines / minLinesPerTask, std::size_t(4 * ROOT::GetThreadPoolSize()));
+      // the columns with empty cells are collected per task to avoid contention
+      std::vector<std::set<std::string>> colContainingEmpty(nTasks);
+      auto parseBlock = [&](unsigned int task) {
+         const auto end = nLines * (task + 1) / nTasks;
+         for (auto i = nLines * task / nTasks; i < end; ++i)
+            FillRecord(lines[i], fRecords[i], colContainingEmpty[task]);
+      };
+      ROOT::TThreadExecutor pool;
+      pool.Foreach(parseBlock, ROOT::TSeqU(nTasks));
+      for (auto &cols : colContainingEmpty)
+         fColContainingEmpty.insert(cols.begin(), cols.end());
+      return;
+   }
+#endif
+
+   for (auto i = 0u; i < nLines; ++i)
+      FillRecord(lines[i], fRecords[i], fColContainingEmpty);
+}
+
 void RCsvDS::GenerateHeaders(size_t size)
 {
    fHeaders.reserve(size);
@@ -273,9 +314,30 @@ void RCsvDS::InferType(const std::string &col, unsigned int idxCol)
    fColTypesList.push_back(type);
 }
 
-std::vector<std::string> RCsvDS::ParseColumns(const std::string &line)
+std::vector<std::string> RCsvDS::ParseColumns(const std::string &line) const
 {
    std::vector<std::string> columns;
+   columns.reserve(fHeaders.size());
+
+   // Fast path for lines without quotes: fields are delimited by the delimiter only, so we can look for it with
+   // memchr, which scans many characters at a time, and copy whole fields at once.
+   if (std::memchr(line.data(), '"', line.size()) == nullptr) {
+      const char *begin = line.data();
+      const char *const end = begin + line.size();
+      while (true) {
+         const auto *delim = static_cast<const char *>(std::memchr(begin, fDelimiter, end - begin));
+         const auto *fieldEnd = delim != nullptr ? delim : end;
+         const std::size_t size = fieldEnd - begin;
+         if (size == 0 || (size == 3 && (std::strncmp(begin, "nan", 3) == 0 || std::strncmp(begin, "NaN", 3) == 0)))
+            columns.emplace_back("nan"); // empty cell or explicit nan/NaN
+         else
+            columns.emplace_back(begin, size);
+         if (delim == nullptr)
+            break;
+         begin = delim + 1;
+      }
+      return columns;
+   }
 
    for (size_t i = 0; i < line.size(); ++i) {
       i = ParseValue(line, columns, i);
@@ -284,7 +346,7 @@ std::vector<std::string> RCsvDS::ParseColumns(const std::string &line)
    return columns;
 }
 
-size_t RCsvDS::ParseValue(const std::string &line, std::vector<std::string> &columns, size_t i)
+size_t RCsvDS::ParseValue(const std::string &line, std::vector<std::string> &columns, size_t i) const
 {
    std::string val;
    bool quoted = false;
@@ -429,13 +491,15 @@ std::vector<std::pair<ULong64_t, ULong64_t>> RCsvDS::GetEntryRanges()
    auto linesToRead = fLinesChunkSize;
    FreeRecords();
 
+   // Reading is sequential, parsing the lines of the chunk can happen in parallel
+   std::vector<std::string> lines;
    std::string line;
    while ((-1LL == fLinesChunkSize || 0 != linesToRead) && fCsvFile->Readln(line)) {
       if (line.empty()) continue; // skip empty lines
-      fRecords.emplace_back();
-      FillRecord(line, fRecords.back());
+      lines.emplace_back(std::move(line));
       --linesToRead;
    }
+   FillRecords(lines);
 
    if (!fColContainingEmpty.empty()) {
       std::string msg = "";
@@ -254,6 +254,17 @@ void ValidateSnapshotOutput(const RSnapshotOptions &opts, const std::string &tre
    }
 }
 
+#ifndef R__RDF_HAS_RNTUPLE
+// RNTupleSnapshot.cxx provides the implementation when ROOT is built with root7
+std::unique_ptr<RNTupleSnapshotWriterBase>
+MakeRNTupleSnapshotWriter(unsigned int, const std::string &, const std::string &, const std::string &,
+                          const ColumnNames_t &, const std::vector<std::string> &, const RSnapshotOptions &,
+                          const std::shared_ptr<ROOT::RDataFrame> &)
+{
+   throw std::runtime_error("Snapshot: writing an RNTuple requires ROOT to be built with root7.");
+}
+#endif
+
 } // end NS RDF
 } // end NS Internal
 } // end NS ROOT
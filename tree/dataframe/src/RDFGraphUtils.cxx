@@ -43,8 +43,11 @@ GraphDrawing::CreateFilterNode(const ROOT::Detail::RDF::RFilterBase *filterPtr,
       return duplicateFilterIt->second;
    }
 
-   auto node = std::make_shared<GraphNode>((filterPtr->HasName() ? filterPtr->GetName() : "Filter"), visitedMap.size(),
-                                           ENodeType::kFilter);
+   std::string name = filterPtr->HasName() ? filterPtr->GetName() : "Filter";
+   // the position chosen by the optimizer, if this filter was reordered (see SetFilterReordering)
+   if (!filterPtr->GetPlanInfo().empty())
+      name += "\\n" + filterPtr->GetPlanInfo();
+   auto node = std::make_shared<GraphNode>(name, visitedMap.size(), ENodeType::kFilter);
    visitedMap[(void *)filterPtr] = node;
    return node;
 }
@@ -26,7 +26,7 @@
 
 using ROOT::RDF::RResultHandle;
 
-void ROOT::RDF::RunGraphs(std::vector<RResultHandle> handles)
+void ROOT::RDF::RunGraphs(std::vector<RResultHandle> handles, bool fuseGraphs)
 {
    if (handles.empty()) {
       Warning("RunGraphs", "Got an empty list of handles, now quitting.");
@@ -47,6 +47,7 @@ void ROOT::RDF::RunGraphs(std::vector<RResultHandle> handles)
    auto sameGraph = [](const RResultHandle &a, const RResultHandle &b) { return a.fLoopManager < b.fLoopManager; };
    std::set<RResultHandle, decltype(sameGraph)> s(handles.begin(), handles.end(), sameGraph);
    std::vector<RResultHandle> uniqueLoops(s.begin(), s.end());
+   const auto nGraphs = uniqueLoops.size();
 
    // Trigger jitting. One call is enough to jit the code required by all computation graphs.
    TStopwatch sw;
@@ -67,10 +68,28 @@ void ROOT::RDF::RunGraphs(std::vector<RResultHandle> handles)
    }
    sw.Stop();
    R__LOG_INFO(ROOT::Detail::RDF::RDFLogChannel())
-      << "Just-in-time compilation phase for RunGraphs (" << uniqueLoops.size()
+      << "Just-in-time compilation phase for RunGraphs (" << nGraphs
       << " unique computation graphs) completed"
       << (sw.RealTime() > 1e-3 ? " in " + std::to_string(sw.RealTime()) + " seconds." : " in less than 1ms.");
 
+   // Let the first of each group of computation graphs that read the same dataset run the whole group
+   if (fuseGraphs) {
+      std::vector<RResultHandle> fusedLoops;
+      for (auto &h : uniqueLoops) {
+         auto leader = std::find_if(fusedLoops.begin(), fusedLoops.end(), [&h](const RResultHandle &l) {
+            return l.fLoopManager->HasSameDataset(*h.fLoopManager);
+         });
+         if (leader == fusedLoops.end())
+            fusedLoops.emplace_back(h);
+         else
+            leader->fLoopManager->Fuse(*h.fLoopManager);
+      }
+      R__LOG_INFO(ROOT::Detail::RDF::RDFLogChannel())
+         << "RunGraphs fused " << nGraphs << " unique computation graphs into " << fusedLoops.size()
+         << " event loops.";
+      uniqueLoops = std::move(fusedLoops);
+   }
+
    // Trigger the unique event loops
    auto run = [](RResultHandle &h) {
       if (h.fLoopManager)
@@ -89,6 +108,6 @@ void ROOT::RDF::RunGraphs(std::vector<RResultHandle> handles)
 #endif
    sw.Stop();
    R__LOG_INFO(ROOT::Detail::RDF::RDFLogChannel())
-      << "Finished RunGraphs run (" << uniqueLoops.size() << " unique computation graphs, " << sw.CpuTime() << "s CPU, "
+      << "Finished RunGraphs run (" << nGraphs << " unique computation graphs, " << sw.CpuTime() << "s CPU, "
       << sw.RealTime() << "s elapsed).";
 }
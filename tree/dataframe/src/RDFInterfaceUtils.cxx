@@ -9,6 +9,7 @@
  *************************************************************************/
 
 #include <ROOT/RDataSource.hxx>
+#include <ROOT/RDFHelpers.hxx>
 #include <ROOT/RDF/InterfaceUtils.hxx>
 #include <ROOT/RDF/RColumnRegister.hxx>
 #include <ROOT/RDF/RDisplay.hxx>
@@ -19,17 +20,22 @@
 #include <ROOT/RDF/RLoopManager.hxx>
 #include <ROOT/RDF/RNodeBase.hxx>
 #include <ROOT/RDF/Utils.hxx>
+#include <ROOT/RLogger.hxx>
 #include <ROOT/RStringView.hxx>
+#include <RVersion.h>
 #include <TBranch.h>
 #include <TClass.h>
 #include <TClassEdit.h>
 #include <TDataType.h>
+#include <TEnv.h>
 #include <TError.h>
 #include <TLeaf.h>
+#include <TMD5.h>
 #include <TObjArray.h>
 #include <TPRegexp.h>
 #include <TROOT.h>
 #include <TString.h>
+#include <TSystem.h>
 #include <TTree.h>
 #include <TVirtualMutex.h>
 
@@ -48,6 +54,7 @@
 #include <algorithm>
 #include <cassert>
 #include <cstdlib>  // for size_t
+#include <fstream>
 #include <iterator> // for back_insert_iterator
 #include <map>
 #include <memory>
@@ -299,8 +306,86 @@ BuildFunctionString(const std::string &expr, const ColumnNames_t &vars, const Co
    return ss.str();
 }
 
+/// State of the persistent cache of jitted expressions, see ROOT::RDF::Experimental::SetJitCacheDir.
+struct RJitCache {
+   /// Directory of the cache, empty if the cache is disabled
+   std::string fDir;
+   /// Base name and code of the functions jitted by this process that were not found in the cache
+   std::vector<std::pair<std::string, std::string>> fPending;
+   /// Cache libraries loaded by this process
+   std::set<std::string> fLoadedLibs;
+   /// Number of functions looked up in the cache by this process, by outcome of the lookup
+   ROOT::Internal::RDF::RJitCacheCounters fCounters;
+};
+
+static RJitCache &GetJitCache()
+{
+   static RJitCache cache{gEnv->GetValue("RDataFrame.JitCacheDir", ""), {}, {}, {}};
+   return cache;
+}
+
+/// The cache key of a function is the md5 digest of its code, of the ROOT version and of the command used to
+/// compile shared libraries, so that a cache directory shared by different ROOT installations stays consistent.
+static std::string GetJitCacheKey(const std::string &funcCode)
+{
+   const std::string keySource =
+      std::string(ROOT_RELEASE) + "\n" + gSystem->GetMakeSharedLib() + "\n" + gSystem->GetIncludePath() + "\n" + funcCode;
+   TMD5 md5;
+   md5.Update(reinterpret_cast<const UChar_t *>(keySource.data()), keySource.size());
+   md5.Final();
+   return md5.AsString();
+}
+
+static std::string GetJitCacheIndexPath(const std::string &key)
+{
+   return GetJitCache().fDir + "/" + key + ".rdfjit";
+}
+
+/// Outcome of the lookup of a function in the persistent cache of jitted expressions
+enum class EJitCacheLookup {
+   kLoaded,      ///< the function was taken from the cache
+   kUncacheable, ///< the cache knows that the function cannot be compiled in a library, it must be jitted as usual
+   kMiss         ///< the function is not in the cache
+};
+
+/// Look for the function in the persistent cache. If it is there, load the library that contains it and only declare
+/// its prototype to the interpreter: its body is neither parsed nor compiled again.
+static EJitCacheLookup
+DeclareCachedFunction(const std::string &funcBaseName, const std::string &funcCode, const std::string &key)
+{
+   auto &cache = GetJitCache();
+
+   // The index file contains the path of the library with the compiled function and its return type.
+   // An empty library path marks a function that could not be compiled, see FlushJitCache.
+   std::ifstream index(GetJitCacheIndexPath(key));
+   std::string libPath, retType;
+   if (!std::getline(index, libPath) || !std::getline(index, retType) || retType.empty())
+      return EJitCacheLookup::kMiss;
+   if (libPath.empty())
+      return EJitCacheLookup::kUncacheable;
+
+   if (cache.fLoadedLibs.count(libPath) == 0) {
+      if (gSystem->Load(libPath.c_str()) < 0)
+         return EJitCacheLookup::kMiss;
+      cache.fLoadedLibs.insert(libPath);
+   }
+
+   // funcCode is of the form "(params){body}" and the parameter types cannot contain braces
+   const auto signature = funcCode.substr(0, funcCode.find("){") + 1);
+   const auto toDeclare = "namespace R_rdf {\n" + retType + " " + funcBaseName + signature + ";\nusing " +
+                          funcBaseName + "_ret_t = " + retType + ";\n}";
+   try {
+      ROOT::Internal::RDF::InterpreterDeclare(toDeclare);
+   } catch (const std::runtime_error &) {
+      return EJitCacheLookup::kMiss;
+   }
+   return EJitCacheLookup::kLoaded;
+}
+
 /// Declare a function to the interpreter in namespace R_rdf, return the name of the jitted function.
 /// If the function is already in GetJittedExprs, return the name for the function that has already been jitted.
+/// If the persistent cache of jitted expressions is enabled, the function is taken from the cache if possible,
+/// otherwise it is scheduled to be added to the cache at the next call to FlushJitCache.
 static std::string DeclareFunction(const std::string &expr, const ColumnNames_t &vars, const ColumnNames_t &varTypes)
 {
    R__LOCKGUARD(gROOTMutex);
@@ -315,9 +400,20 @@ static std::string DeclareFunction(const std::string &expr, const ColumnNames_t
    }
 
    // new expression
-   const auto funcBaseName = "func" + std::to_string(exprMap.size());
+   auto &cache = GetJitCache();
+   const auto cacheKey = cache.fDir.empty() ? std::string() : GetJitCacheKey(funcCode);
+   // functions that go through the cache need a name that is stable across processes
+   const auto funcBaseName = cacheKey.empty() ? "func" + std::to_string(exprMap.size()) : "func_" + cacheKey;
    const auto funcFullName = "R_rdf::" + funcBaseName;
 
+   const auto lookup =
+      cacheKey.empty() ? EJitCacheLookup::kMiss : DeclareCachedFunction(funcBaseName, funcCode, cacheKey);
+   if (lookup == EJitCacheLookup::kLoaded) {
+      ++cache.fCounters.fNLoaded;
+      exprMap.insert({funcCode, funcFullName});
+      return funcFullName;
+   }
+
    const auto toDeclare = "namespace R_rdf {\nauto " + funcBaseName + funcCode + "\nusing " + funcBaseName +
                           "_ret_t = typename ROOT::TypeTraits::CallableTraits<decltype(" + funcBaseName +
                           ")>::ret_type;\n}";
@@ -325,6 +421,13 @@ static std::string DeclareFunction(const std::string &expr, const ColumnNames_t
 
    // InterpreterDeclare could throw. If it doesn't, mark the function as already jitted
    exprMap.insert({funcCode, funcFullName});
+   if (lookup == EJitCacheLookup::kUncacheable) {
+      // do not try to compile it again, it would fail as it did in the process that added it to the cache
+      ++cache.fCounters.fNUncacheable;
+   } else if (!cacheKey.empty()) {
+      ++cache.fCounters.fNPending;
+      cache.fPending.emplace_back(funcBaseName, funcCode);
+   }
 
    return funcFullName;
 }
@@ -1016,6 +1119,83 @@ AddSizeBranches(const std::vector<std::string> &branches, TTree *tree, std::vect
    return {std::move(colsWithoutAliases), std::move(colsWithAliases)};
 }
 
+void FlushJitCache()
+{
+   R__LOCKGUARD(gROOTMutex);
+
+   auto &cache = GetJitCache();
+   if (cache.fDir.empty() || cache.fPending.empty())
+      return;
+
+   auto pending = std::move(cache.fPending);
+   cache.fPending.clear();
+
+   // All functions jitted since the last flush go in the same library, so that the compiler is invoked only once
+   std::string keys;
+   std::stringstream source;
+   source << "// Expressions jitted by RDataFrame, see ROOT::RDF::Experimental::SetJitCacheDir\n"
+          << "#include \"ROOT/RVec.hxx\"\n#include \"ROOT/RDF/RSampleInfo.hxx\"\n#include \"TMath.h\"\n\n"
+          << "namespace R_rdf {\n";
+   std::vector<std::pair<std::string, std::string>> indexEntries; // cache key, return type
+   for (const auto &func : pending) {
+      const auto retType = RetTypeOfFunc("R_rdf::" + func.first);
+      source << retType << " " << func.first << func.second << "\n";
+      indexEntries.emplace_back(func.first.substr(5 /* "func_" */), retType);
+      keys += indexEntries.back().first;
+   }
+   source << "} // namespace R_rdf\n";
+
+   TMD5 md5;
+   md5.Update(reinterpret_cast<const UChar_t *>(keys.data()), keys.size());
+   md5.Final();
+   // The source and the library are built under a name unique to this process and the library is then renamed, so
+   // that concurrent processes that flush the same functions never read or load partially written files
+   const auto libBaseName = cache.fDir + "/rdfjit_" + md5.AsString();
+   const auto buildBaseName = libBaseName + "_" + std::to_string(gSystem->GetPid());
+   const auto sourcePath = buildBaseName + ".C";
+   {
+      std::ofstream sourceFile(sourcePath);
+      sourceFile << source.str();
+      if (!sourceFile) {
+         R__LOG_WARNING(RDFLogChannel()) << "Could not write to the cache of jitted expressions in " << cache.fDir;
+         return;
+      }
+   }
+
+   // The functions are already declared in this process: only compile the library, it is loaded by later processes
+   std::string libPath;
+   if (gSystem->CompileMacro(sourcePath.c_str(), "kcOs", buildBaseName.c_str()) == 1) {
+      libPath = libBaseName + "." + gSystem->GetSoExt();
+      const auto buildPath = buildBaseName + "." + gSystem->GetSoExt();
+      if (gSystem->Rename(buildPath.c_str(), libPath.c_str()) != 0) {
+         R__LOG_WARNING(RDFLogChannel()) << "Could not write to the cache of jitted expressions in " << cache.fDir;
+         return;
+      }
+   } else {
+      // Entries with no library mark the functions as not cacheable, e.g. because they use entities only known to
+      // the interpreter, so that later processes do not try to compile them again
+      R__LOG_WARNING(RDFLogChannel()) << "Could not compile " << sourcePath
+                                      << ": the corresponding jitted expressions will not be cached.";
+   }
+
+   for (const auto &entry : indexEntries) {
+      // Write to a temporary file and rename it, so that concurrent processes never see partially written entries
+      const auto indexPath = GetJitCacheIndexPath(entry.first);
+      const auto tmpPath = indexPath + "." + std::to_string(gSystem->GetPid());
+      {
+         std::ofstream index(tmpPath);
+         index << libPath << "\n" << entry.second << "\n";
+      }
+      gSystem->Rename(tmpPath.c_str(), indexPath.c_str());
+   }
+}
+
+RJitCacheCounters GetJitCacheCounters()
+{
+   R__LOCKGUARD(gROOTMutex);
+   return GetJitCache().fCounters;
+}
+
 void RemoveDuplicates(ColumnNames_t &columnNames)
 {
    std::set<std::string> uniqueCols;
@@ -1028,3 +1208,12 @@ void RemoveDuplicates(ColumnNames_t &columnNames)
 } // namespace RDF
 } // namespace Internal
 } // namespace ROOT
+
+void ROOT::RDF::Experimental::SetJitCacheDir(std::string_view dir)
+{
+   R__LOCKGUARD(gROOTMutex);
+   auto &cache = GetJitCache();
+   cache.fDir = std::string(dir);
+   if (!cache.fDir.empty())
+      gSystem->mkdir(cache.fDir.c_str(), /*recursive=*/true);
+}
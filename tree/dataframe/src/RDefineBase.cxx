@@ -25,6 +25,7 @@ RDefineBase::RDefineBase(std::string_view name, std::string_view type, const RDF
                          ROOT::Detail::RDF::RLoopManager &lm, const ROOT::RDF::ColumnNames_t &columnNames,
                          const std::string &variationName)
    : fName(name), fType(type), fLastCheckedEntry(lm.GetNSlots() * RDFInternal::CacheLineStep<Long64_t>(), -1),
+     fLastCheckedBlock(lm.GetNSlots() * RDFInternal::CacheLineStep<Long64_t>(), -1), fBlockDone(lm.GetNSlots()),
      fColRegister(colRegister), fLoopManager(&lm), fColumnNames(columnNames), fIsDefine(columnNames.size()),
      fVariationDeps(fColRegister.GetVariationDeps(fColumnNames)), fVariation(variationName)
 {
@@ -11,6 +11,7 @@
 #include "ROOT/RDF/RCutFlowReport.hxx"
 #include "ROOT/RDF/RDefineBase.hxx"
 #include "ROOT/RDF/RFilterBase.hxx"
+#include "ROOT/RDF/RFilterChain.hxx"
 #include "ROOT/RDF/Utils.hxx"
 #include <numeric> // std::accumulate
 
@@ -23,7 +24,9 @@ RFilterBase::RFilterBase(RLoopManager *implPtr, std::string_view name, const uns
      fLastCheckedEntry(nSlots * RDFInternal::CacheLineStep<Long64_t>(), -1),
      fLastResult(nSlots * RDFInternal::CacheLineStep<int>()),
      fAccepted(nSlots * RDFInternal::CacheLineStep<ULong64_t>()),
-     fRejected(nSlots * RDFInternal::CacheLineStep<ULong64_t>()), fName(name), fColumnNames(columns),
+     fRejected(nSlots * RDFInternal::CacheLineStep<ULong64_t>()),
+     fLastCheckedBlock(nSlots * RDFInternal::CacheLineStep<Long64_t>(), -1), fBlockMasks(nSlots), fName(name),
+     fColumnNames(columns),
      fColRegister(colRegister), fIsDefine(columns.size()), fVariation(variation)
 {
    const auto nColumns = fColumnNames.size();
@@ -37,6 +40,11 @@ RFilterBase::RFilterBase(RLoopManager *implPtr, std::string_view name, const uns
 // outlined to pin virtual table
 RFilterBase::~RFilterBase() {}
 
+void RFilterBase::SetFilterChain(std::unique_ptr<RDFInternal::RFilterChain> chain)
+{
+   fFilterChain = std::move(chain);
+}
+
 bool RFilterBase::HasName() const
 {
    return !fName.empty();
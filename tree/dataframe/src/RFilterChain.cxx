@@ -0,0 +1,94 @@
+/*************************************************************************
+ * Copyright (C) 1995-2023, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/RDF/RFilterChain.hxx"
+#include "ROOT/RDF/Utils.hxx" // RDFLogChannel
+#include "ROOT/RLogger.hxx"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio> // snprintf
+#include <limits>
+#include <numeric> // std::iota
+#include <string>
+
+namespace ROOT {
+namespace Internal {
+namespace RDF {
+
+RFilterChain::RFilterChain(const std::vector<ROOT::Detail::RDF::RFilterBase *> &filters,
+                           ROOT::Detail::RDF::RNodeBase &prevNode, unsigned int nSlots, ULong64_t nProfileEntries)
+   : fFilters(filters), fPrevNode(prevNode), fNProfileEntries(nProfileEntries)
+{
+   for (auto i = 0u; i < nSlots; ++i) {
+      fSlotProfiles.emplace_back(std::make_unique<RSlotProfile>());
+      fSlotProfiles.back()->fFilters.resize(fFilters.size());
+   }
+}
+
+/// Evaluate all the filters of the chain, in declaration order, and record how long each of them takes and whether
+/// it passes. Choose the evaluation order once this slot has profiled enough entries.
+bool RFilterChain::Profile(unsigned int slot, Long64_t entry)
+{
+   auto &profile = *fSlotProfiles[slot];
+   bool passed = true;
+   for (std::size_t i = 0; i < fFilters.size(); ++i) {
+      const auto start = std::chrono::steady_clock::now();
+      const bool filterPassed = fFilters[i]->EvaluateFilter(slot, entry);
+      const auto end = std::chrono::steady_clock::now();
+      auto &filterProfile = profile.fFilters[i];
+      filterProfile.fTime += std::chrono::duration<double, std::nano>(end - start).count();
+      ++filterProfile.fNEvaluated;
+      filterProfile.fNPassed += filterPassed;
+      passed = passed && filterPassed;
+   }
+
+   if (++profile.fNEntries == fNProfileEntries)
+      ChoosePlan(profile);
+   return passed;
+}
+
+/// Order the filters by increasing cost per rejected entry, i.e. the average evaluation time divided by the fraction
+/// of rejected entries. This is the order that minimizes the expected cost of the chain if the filters are independent.
+void RFilterChain::ChoosePlan(const RSlotProfile &profile)
+{
+   std::lock_guard<std::mutex> lock(fMutex);
+   if (fHasPlan)
+      return; // another slot got there first
+
+   const auto nFilters = fFilters.size();
+   std::vector<double> ranks(nFilters);
+   for (std::size_t i = 0; i < nFilters; ++i) {
+      const auto &p = profile.fFilters[i];
+      const double cost = p.fTime / p.fNEvaluated;
+      const double rejected = double(p.fNEvaluated - p.fNPassed) / p.fNEvaluated;
+      ranks[i] = rejected > 0. ? cost / rejected : std::numeric_limits<double>::infinity();
+   }
+   std::vector<std::size_t> order(nFilters);
+   std::iota(order.begin(), order.end(), 0);
+   // filters that never reject keep their relative order at the end of the chain
+   std::stable_sort(order.begin(), order.end(), [&ranks](std::size_t a, std::size_t b) { return ranks[a] < ranks[b]; });
+
+   for (std::size_t pos = 0; pos < nFilters; ++pos) {
+      const auto idx = order[pos];
+      const auto &p = profile.fFilters[idx];
+      char info[128];
+      snprintf(info, sizeof(info), "evaluated %zu of %zu\\npass %.1f%%, %.0f ns", pos + 1, nFilters,
+               100. * p.fNPassed / p.fNEvaluated, p.fTime / p.fNEvaluated);
+      fFilters[idx]->SetPlanInfo(info);
+   }
+   R__LOG_INFO(ROOT::Detail::RDF::RDFLogChannel())
+      << "Reordered a chain of " << nFilters << " filters after profiling " << fNProfileEntries << " entries.";
+
+   fOrder = std::move(order);
+   fHasPlan.store(true, std::memory_order_release);
+}
+
+} // namespace RDF
+} // namespace Internal
+} // namespace ROOT
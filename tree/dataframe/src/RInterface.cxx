@@ -10,9 +10,47 @@
 
 #include "ROOT/RDF/RInterface.hxx"
 
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
 void ROOT::Internal::RDF::ChangeEmptyEntryRange(const ROOT::RDF::RNode &node,
                                                 std::pair<ULong64_t, ULong64_t> &&newRange)
 {
    R__ASSERT(newRange.second >= newRange.first && "end is less than begin in the passed entry range!");
    node.GetLoopManager()->SetEmptyEntryRange(std::move(newRange));
 }
+
+void ROOT::RDF::Experimental::SetBatchSize(const ROOT::RDF::RNode &node, std::size_t batchSize)
+{
+   node.GetLoopManager()->SetBatchSize(batchSize);
+}
+
+void ROOT::RDF::Experimental::SetFilterReordering(const ROOT::RDF::RNode &node, ULong64_t nProfileEntries)
+{
+   node.GetLoopManager()->SetFilterProfileEntries(nProfileEntries);
+}
+
+void ROOT::RDF::Experimental::SetProfiling(const ROOT::RDF::RNode &node, bool enable)
+{
+   node.GetLoopManager()->SetProfiling(enable);
+}
+
+std::string ROOT::RDF::Experimental::SaveProfile(const ROOT::RDF::RNode &node, EProfileFormat format)
+{
+   const auto *profile = node.GetLoopManager()->GetLastProfile();
+   if (profile == nullptr)
+      throw std::runtime_error("SaveProfile: no event loop of this computation graph has been profiled. Call "
+                               "ROOT::RDF::Experimental::SetProfiling before running the event loop.");
+   return format == EProfileFormat::kChromeTrace ? profile->ToChromeTrace() : profile->ToJSON();
+}
+
+void ROOT::RDF::Experimental::SaveProfile(const ROOT::RDF::RNode &node, const std::string &outputFile,
+                                          EProfileFormat format)
+{
+   const auto profile = SaveProfile(node, format);
+   std::ofstream out(outputFile);
+   if (!out.is_open())
+      throw std::runtime_error("SaveProfile: could not open output file \"" + outputFile + "\"");
+   out << profile;
+}
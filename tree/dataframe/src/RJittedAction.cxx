@@ -73,6 +73,24 @@ void RJittedAction::Run(unsigned int slot, Long64_t entry)
    fConcreteAction->Run(slot, entry);
 }
 
+void RJittedAction::RunBlock(unsigned int slot, REntryBlock &block)
+{
+   assert(fConcreteAction != nullptr);
+   fConcreteAction->RunBlock(slot, block);
+}
+
+bool RJittedAction::SupportsBatchMode() const
+{
+   assert(fConcreteAction != nullptr);
+   return fConcreteAction->SupportsBatchMode();
+}
+
+std::string RJittedAction::GetActionName()
+{
+   assert(fConcreteAction != nullptr);
+   return fConcreteAction->GetActionName();
+}
+
 void RJittedAction::Initialize()
 {
    assert(fConcreteAction != nullptr);
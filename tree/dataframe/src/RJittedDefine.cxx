@@ -45,6 +45,12 @@ void RJittedDefine::Update(unsigned int slot, Long64_t entry)
    fConcreteDefine->Update(slot, entry);
 }
 
+void *RJittedDefine::UpdateBlock(unsigned int slot, RDFInternal::REntryBlock &block, const char *mask)
+{
+   assert(fConcreteDefine != nullptr);
+   return fConcreteDefine->UpdateBlock(slot, block, mask);
+}
+
 void RJittedDefine::Update(unsigned int slot, const ROOT::RDF::RSampleInfo &id)
 {
    assert(fConcreteDefine != nullptr);
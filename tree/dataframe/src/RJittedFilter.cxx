@@ -59,6 +59,30 @@ bool RJittedFilter::CheckFilters(unsigned int slot, Long64_t entry)
    return fConcreteFilter->CheckFilters(slot, entry);
 }
 
+bool RJittedFilter::EvaluateFilter(unsigned int slot, Long64_t entry)
+{
+   assert(fConcreteFilter != nullptr);
+   return fConcreteFilter->EvaluateFilter(slot, entry);
+}
+
+RNodeBase *RJittedFilter::GetPrevNode()
+{
+   assert(fConcreteFilter != nullptr);
+   return fConcreteFilter->GetPrevNode();
+}
+
+RFilterBase *RJittedFilter::GetConcreteFilter()
+{
+   assert(fConcreteFilter != nullptr);
+   return fConcreteFilter.get();
+}
+
+const char *RJittedFilter::CheckFiltersBlock(unsigned int slot, ROOT::Internal::RDF::REntryBlock &block)
+{
+   assert(fConcreteFilter != nullptr);
+   return fConcreteFilter->CheckFiltersBlock(slot, block);
+}
+
 void RJittedFilter::Report(ROOT::RDF::RCutFlowReport &cr) const
 {
    assert(fConcreteFilter != nullptr);
@@ -9,10 +9,11 @@
 #include "RConfigure.h" // R__USE_IMT
 #include "ROOT/RDataSource.hxx"
 #include "ROOT/RDF/GraphNode.hxx"
-#include "ROOT/InternalTreeUtils.hxx" // GetTreeFullPaths
+#include "ROOT/InternalTreeUtils.hxx" // GetTreeFullPaths, GetFileNamesFromTree
 #include "ROOT/RDF/RActionBase.hxx"
 #include "ROOT/RDF/RDefineBase.hxx"
 #include "ROOT/RDF/RFilterBase.hxx"
+#include "ROOT/RDF/RFilterChain.hxx"
 #include "ROOT/RDF/RLoopManager.hxx"
 #include "ROOT/RDF/RRangeBase.hxx"
 #include "ROOT/RDF/RVariationBase.hxx"
@@ -32,12 +33,15 @@
 #ifdef R__USE_IMT
 #include "ROOT/TThreadExecutor.hxx"
 #include "ROOT/TTreeProcessorMT.hxx"
+#include "ROOT/RRangeScheduler.hxx"
 #include "ROOT/RSlotStack.hxx"
+#include "ROOT/TSeq.hxx"
 #endif
 
 #include <algorithm>
 #include <atomic>
 #include <cassert>
+#include <chrono>
 #include <functional>
 #include <iostream>
 #include <memory>
@@ -248,6 +252,14 @@ struct MaxTreeSizeRAII {
    ~MaxTreeSizeRAII() { TTree::SetMaxTreeSize(fOldMaxTreeSize); }
 };
 
+/// A RAII object that clears a list of fused loop managers at destruction, so that graphs fused to an event loop that
+/// throws do not run again as part of the next event loop of the same loop manager (see RLoopManager::Fuse)
+struct ClearFusedLoopsRAII {
+   std::vector<ROOT::Detail::RDF::RLoopManager *> &fFusedLoops;
+
+   ~ClearFusedLoopsRAII() { fFusedLoops.clear(); }
+};
+
 struct DatasetLogInfo {
    std::string fDataSet;
    ULong64_t fRangeStart;
@@ -299,6 +311,66 @@ DatasetLogInfo TreeDatasetLogInfo(const TTreeReader &r, unsigned int slot)
    return {std::move(what), static_cast<ULong64_t>(entryRange.first), end, slot};
 }
 
+#ifdef R__USE_IMT
+/// Accumulate the time each processing slot spends working during a multi-thread event loop.
+class RSlotBusyTimer {
+   using Clock_t = std::chrono::steady_clock;
+   Clock_t::time_point fLoopStart = Clock_t::now();
+   /// One element every CacheLineStep<double>() to avoid false sharing
+   std::vector<double> fBusyTimes;
+
+public:
+   explicit RSlotBusyTimer(unsigned int nSlots)
+      : fBusyTimes(nSlots * ROOT::Internal::RDF::CacheLineStep<double>(), 0.)
+   {
+   }
+
+   static Clock_t::time_point Now() { return Clock_t::now(); }
+
+   void AddBusyTime(unsigned int slot, Clock_t::time_point start)
+   {
+      fBusyTimes[slot * ROOT::Internal::RDF::CacheLineStep<double>()] +=
+         std::chrono::duration<double>(Clock_t::now() - start).count();
+   }
+
+   std::vector<ROOT::Detail::RDF::RSlotTiming> GetTimings() const
+   {
+      const auto wallTime = std::chrono::duration<double>(Clock_t::now() - fLoopStart).count();
+      const auto nSlots = fBusyTimes.size() / ROOT::Internal::RDF::CacheLineStep<double>();
+      std::vector<ROOT::Detail::RDF::RSlotTiming> timings(nSlots);
+      for (auto slot = 0u; slot < nSlots; ++slot) {
+         timings[slot].fBusyTime = fBusyTimes[slot * ROOT::Internal::RDF::CacheLineStep<double>()];
+         timings[slot].fIdleTime = std::max(0., wallTime - timings[slot].fBusyTime);
+      }
+      return timings;
+   }
+};
+
+std::string LogSlotTimings(const std::vector<ROOT::Detail::RDF::RSlotTiming> &timings)
+{
+   std::stringstream msg;
+   msg << "Busy/idle time of each slot during the event loop (s):";
+   for (auto slot = 0u; slot < timings.size(); ++slot)
+      msg << ' ' << slot << ": " << timings[slot].fBusyTime << '/' << timings[slot].fIdleTime;
+   return msg.str();
+}
+
+/// The number of entries that a slot processes at a time in a multi-thread event loop with no data source: small enough
+/// that slots that finish early can take over part of the work of the others, large enough to amortize the per-range
+/// overhead (initialization of the nodes of the computation graph, sample callbacks).
+ULong64_t GetEmptySourceGrainSize(ULong64_t nEntries, unsigned int nSlots)
+{
+   constexpr ULong64_t maxGrainSize = 100000;
+   return std::max(ULong64_t(1), std::min(nEntries / (nSlots * 32ull), maxGrainSize));
+}
+#endif // R__USE_IMT
+
+/// The name of a Filter or Define in the profile of an event loop, including the variation it belongs to
+std::string GetProfiledNodeName(const std::string &name, const std::string &variation)
+{
+   return variation == "nominal" ? name : name + " [" + variation + ']';
+}
+
 static auto MakeDatasetColReadersKey(const std::string &colName, const std::type_info &ti)
 {
    // We use a combination of column name and column type name as the key because in some cases we might end up
@@ -411,45 +483,47 @@ void RLoopManager::RunEmptySourceMT()
 {
 #ifdef R__USE_IMT
    ROOT::Internal::RSlotStack slotStack(fNSlots);
+   RSlotBusyTimer timer(fNSlots);
    // Working with an empty tree.
-   // Evenly partition the entries according to fNSlots. Produce around 2 tasks per slot.
-   const auto nEmptyEntries = GetNEmptyEntries();
-   const auto nEntriesPerSlot = nEmptyEntries / (fNSlots * 2);
-   auto remainder = nEmptyEntries % (fNSlots * 2);
-   std::vector<std::pair<ULong64_t, ULong64_t>> entryRanges;
-   ULong64_t begin = fEmptyEntryRange.first;
-   while (begin < fEmptyEntryRange.second) {
-      ULong64_t end = begin + nEntriesPerSlot;
-      if (remainder > 0) {
-         ++end;
-         --remainder;
-      }
-      entryRanges.emplace_back(begin, end);
-      begin = end;
-   }
+   // Each slot starts from an even share of the entries and processes it in small sub-ranges. Slots that run out of
+   // entries take over half of the remaining entries of the busiest slot, so that no slot idles at the end of the loop.
+   ROOT::Internal::RRangeScheduler scheduler(fEmptyEntryRange, fNSlots,
+                                             GetEmptySourceGrainSize(GetNEmptyEntries(), fNSlots));
 
-   // Each task will generate a subrange of entries
-   auto genFunction = [this, &slotStack](const std::pair<ULong64_t, ULong64_t> &range) {
+   // Each task will generate subranges of entries until there are none left
+   auto genFunction = [this, &slotStack, &timer, &scheduler](unsigned int) {
       ROOT::Internal::RSlotStackRAII slotRAII(slotStack);
       auto slot = slotRAII.fSlot;
-      RCallCleanUpTask cleanup(*this, slot);
-      InitNodeSlots(nullptr, slot);
-      R__LOG_DEBUG(0, RDFLogChannel()) << LogRangeProcessing({"an empty source", range.first, range.second, slot});
-      try {
-         UpdateSampleInfo(slot, range);
-         for (auto currEntry = range.first; currEntry < range.second; ++currEntry) {
-            RunAndCheckFilters(slot, currEntry);
+      std::pair<ULong64_t, ULong64_t> range;
+      while (scheduler.Next(slot, range)) {
+         const auto start = timer.Now();
+         {
+            RCallCleanUpTask cleanup(*this, slot);
+            InitNodeSlots(nullptr, slot);
+            R__LOG_DEBUG(0, RDFLogChannel())
+               << LogRangeProcessing({"an empty source", range.first, range.second, slot});
+            try {
+               UpdateSampleInfo(slot, range);
+               for (auto currEntry = range.first; currEntry < range.second; ++currEntry) {
+                  RunAndCheckFilters(slot, currEntry);
+               }
+               FlushEntryBlock(slot);
+            } catch (...) {
+               // Error might throw in experiment frameworks like CMSSW
+               std::cerr << "RDataFrame::Run: event loop was interrupted\n";
+               throw;
+            }
          }
-      } catch (...) {
-         // Error might throw in experiment frameworks like CMSSW
-         std::cerr << "RDataFrame::Run: event loop was interrupted\n";
-         throw;
+         timer.AddBusyTime(slot, start);
       }
    };
 
    ROOT::TThreadExecutor pool;
-   pool.Foreach(genFunction, entryRanges);
+   pool.Foreach(genFunction, ROOT::TSeqU(fNSlots));
 
+   fSlotTimings = timer.GetTimings();
+   R__LOG_INFO(RDFLogChannel()) << LogSlotTimings(fSlotTimings);
+   R__LOG_DEBUG(0, RDFLogChannel()) << "Entries were moved between slots " << scheduler.GetNSteals() << " times.";
 #endif // not implemented otherwise
 }
 
@@ -463,9 +537,10 @@ void RLoopManager::RunEmptySource()
    try {
       UpdateSampleInfo(/*slot*/ 0, fEmptyEntryRange);
       for (ULong64_t currEntry = fEmptyEntryRange.first;
-           currEntry < fEmptyEntryRange.second && fNStopsReceived < fNChildren; ++currEntry) {
+           currEntry < fEmptyEntryRange.second && HasActiveChildren(); ++currEntry) {
          RunAndCheckFilters(0, currEntry);
       }
+      FlushEntryBlock(0);
    } catch (...) {
       std::cerr << "RDataFrame::Run: event loop was interrupted\n";
       throw;
@@ -479,6 +554,7 @@ void RLoopManager::RunTreeProcessorMT()
    if (fEndEntry == fBeginEntry) // empty range => no work needed
       return;
    ROOT::Internal::RSlotStack slotStack(fNSlots);
+   RSlotBusyTimer timer(fNSlots);
    const auto &entryList = fTree->GetEntryList() ? *fTree->GetEntryList() : TEntryList();
    auto tp = (fBeginEntry != 0 || fEndEntry != std::numeric_limits<Long64_t>::max())
                 ? std::make_unique<ROOT::TTreeProcessorMT>(*fTree, fNSlots, std::make_pair(fBeginEntry, fEndEntry))
@@ -486,9 +562,12 @@ void RLoopManager::RunTreeProcessorMT()
 
    std::atomic<ULong64_t> entryCount(0ull);
 
-   tp->Process([this, &slotStack, &entryCount](TTreeReader &r) -> void {
+   // TTreeProcessorMT hands out cluster-aligned ranges to the slots, and slots that run out of clusters take over part
+   // of the remaining clusters of the others
+   tp->Process([this, &slotStack, &timer, &entryCount](TTreeReader &r) -> void {
       ROOT::Internal::RSlotStackRAII slotRAII(slotStack);
       auto slot = slotRAII.fSlot;
+      const auto start = timer.Now();
       RCallCleanUpTask cleanup(*this, slot, &r);
       InitNodeSlots(&r, slot);
       R__LOG_DEBUG(0, RDFLogChannel()) << LogRangeProcessing(TreeDatasetLogInfo(r, slot));
@@ -503,18 +582,23 @@ void RLoopManager::RunTreeProcessorMT()
             }
             RunAndCheckFilters(slot, count++);
          }
+         FlushEntryBlock(slot);
       } catch (...) {
          std::cerr << "RDataFrame::Run: event loop was interrupted\n";
          throw;
       }
-      // fNStopsReceived < fNChildren is always true at the moment as we don't support event loop early quitting in
+      // HasActiveChildren() is always true at the moment as we don't support event loop early quitting in
       // multi-thread runs, but it costs nothing to be safe and future-proof in case we add support for that later.
-      if (r.GetEntryStatus() != TTreeReader::kEntryBeyondEnd && fNStopsReceived < fNChildren) {
+      if (r.GetEntryStatus() != TTreeReader::kEntryBeyondEnd && HasActiveChildren()) {
          // something went wrong in the TTreeReader event loop
          throw std::runtime_error("An error was encountered while processing the data. TTreeReader status code is: " +
                                   std::to_string(r.GetEntryStatus()));
       }
+      timer.AddBusyTime(slot, start);
    });
+
+   fSlotTimings = timer.GetTimings();
+   R__LOG_INFO(RDFLogChannel()) << LogSlotTimings(fSlotTimings);
 #endif // no-op otherwise (will not be called)
 }
 
@@ -536,19 +620,20 @@ void RLoopManager::RunTreeReader()
    R__LOG_DEBUG(0, RDFLogChannel()) << LogRangeProcessing(TreeDatasetLogInfo(r, 0u));
 
    // recursive call to check filters and conditionally execute actions
-   // in the non-MT case processing can be stopped early by ranges, hence the check on fNStopsReceived
+   // in the non-MT case processing can be stopped early by ranges, hence the check on HasActiveChildren
    try {
-      while (r.Next() && fNStopsReceived < fNChildren) {
+      while (r.Next() && HasActiveChildren()) {
          if (fNewSampleNotifier.CheckFlag(0)) {
             UpdateSampleInfo(/*slot*/0, r);
          }
          RunAndCheckFilters(0, r.GetCurrentEntry());
       }
+      FlushEntryBlock(0);
    } catch (...) {
       std::cerr << "RDataFrame::Run: event loop was interrupted\n";
       throw;
    }
-   if (r.GetEntryStatus() != TTreeReader::kEntryBeyondEnd && fNStopsReceived < fNChildren) {
+   if (r.GetEntryStatus() != TTreeReader::kEntryBeyondEnd && HasActiveChildren()) {
       // something went wrong in the TTreeReader event loop
       throw std::runtime_error("An error was encountered while processing the data. TTreeReader status code is: " +
                                std::to_string(r.GetEntryStatus()));
@@ -576,6 +661,7 @@ void RLoopManager::RunDataSource()
                }
             }
          }
+         FlushEntryBlock(0u);
       } catch (...) {
          std::cerr << "RDataFrame::Run: event loop was interrupted\n";
          throw;
@@ -592,12 +678,11 @@ void RLoopManager::RunDataSourceMT()
 #ifdef R__USE_IMT
    assert(fDataSource != nullptr);
    ROOT::Internal::RSlotStack slotStack(fNSlots);
+   RSlotBusyTimer timer(fNSlots);
    ROOT::TThreadExecutor pool;
 
-   // Each task works on a subrange of entries
-   auto runOnRange = [this, &slotStack](const std::pair<ULong64_t, ULong64_t> &range) {
-      ROOT::Internal::RSlotStackRAII slotRAII(slotStack);
-      const auto slot = slotRAII.fSlot;
+   // Each call works on a subrange of entries
+   auto runOnRange = [this](unsigned int slot, const std::pair<ULong64_t, ULong64_t> &range) {
       InitNodeSlots(nullptr, slot);
       RCallCleanUpTask cleanup(*this, slot);
       fDataSource->InitSlot(slot, range.first);
@@ -610,6 +695,7 @@ void RLoopManager::RunDataSourceMT()
                RunAndCheckFilters(slot, entry);
             }
          }
+         FlushEntryBlock(slot);
       } catch (...) {
          std::cerr << "RDataFrame::Run: event loop was interrupted\n";
          throw;
@@ -620,10 +706,28 @@ void RLoopManager::RunDataSourceMT()
    fDataSource->Initialize();
    auto ranges = fDataSource->GetEntryRanges();
    while (!ranges.empty()) {
-      pool.Foreach(runOnRange, ranges);
+      // The ranges of the data source are handed out whole, as their boundaries might be meaningful to the data source
+      // (e.g. clusters): the scheduler distributes range indices. Slots that run out of ranges take over half of the
+      // remaining ranges of the busiest slot.
+      ROOT::Internal::RRangeScheduler scheduler({0ull, ranges.size()}, fNSlots, /*grainSize=*/1);
+      auto runTask = [&slotStack, &timer, &scheduler, &ranges, &runOnRange](unsigned int) {
+         ROOT::Internal::RSlotStackRAII slotRAII(slotStack);
+         const auto slot = slotRAII.fSlot;
+         std::pair<ULong64_t, ULong64_t> rangeIdxs;
+         while (scheduler.Next(slot, rangeIdxs)) {
+            const auto start = timer.Now();
+            for (auto idx = rangeIdxs.first; idx < rangeIdxs.second; ++idx)
+               runOnRange(slot, ranges[idx]);
+            timer.AddBusyTime(slot, start);
+         }
+      };
+      pool.Foreach(runTask, ROOT::TSeqU(fNSlots));
       ranges = fDataSource->GetEntryRanges();
    }
    fDataSource->Finalize();
+
+   fSlotTimings = timer.GetTimings();
+   R__LOG_INFO(RDFLogChannel()) << LogSlotTimings(fSlotTimings);
 #endif // not implemented otherwise (never called)
 }
 
@@ -631,19 +735,76 @@ void RLoopManager::RunDataSourceMT()
 /// Named filters must be called even if the analysis logic would not require it, lest they report confusing results.
 void RLoopManager::RunAndCheckFilters(unsigned int slot, Long64_t entry)
 {
-   // data-block callbacks run before the rest of the graph
+   if (fBatchSize > 0) {
+      StageEntry(slot, entry);
+   } else {
+      // data-block callbacks run before the rest of the graph
+      if (fNewSampleNotifier.CheckFlag(slot)) {
+         for (auto &callback : fSampleCallbacks)
+            callback.second(slot, fSampleInfos[slot]);
+         fNewSampleNotifier.UnsetFlag(slot);
+      }
+
+      for (auto *actionPtr : fBookedActions)
+         actionPtr->Run(slot, entry);
+      for (auto *namedFilterPtr : fBookedNamedFilters)
+         namedFilterPtr->CheckFilters(slot, entry);
+      for (auto &callback : fCallbacks)
+         callback(slot);
+   }
+
+   for (auto *lm : fFusedLoops)
+      lm->RunAndCheckFilters(slot, entry);
+}
+
+/// Batch-mode counterpart of RunAndCheckFilters: copy the values of the dataset columns for this entry into the block
+/// of the slot, and process the block once it is full.
+void RLoopManager::StageEntry(unsigned int slot, Long64_t entry)
+{
+   // data-block callbacks run before the rest of the graph, so the entries of the previous data block are processed
+   // before they are invoked
    if (fNewSampleNotifier.CheckFlag(slot)) {
+      FlushEntryBlock(slot);
       for (auto &callback : fSampleCallbacks)
          callback.second(slot, fSampleInfos[slot]);
       fNewSampleNotifier.UnsetFlag(slot);
    }
 
+   auto &block = fEntryBlocks[slot];
+   const auto idx = block.fEntries.size();
+   for (auto &reader : fBlockColumnReaders[slot])
+      reader.second->Stage(idx, entry);
+   block.fEntries.push_back(entry);
+   if (block.fEntries.size() == fBatchSize)
+      RunAndCheckFiltersBlock(slot);
+}
+
+/// Execute actions on a full block of entries and make sure named filters are called for each event.
+void RLoopManager::RunAndCheckFiltersBlock(unsigned int slot)
+{
+   auto &block = fEntryBlocks[slot];
+   ++block.fId;
+   block.fCurrent = 0;
+
    for (auto *actionPtr : fBookedActions)
-      actionPtr->Run(slot, entry);
+      actionPtr->RunBlock(slot, block);
    for (auto *namedFilterPtr : fBookedNamedFilters)
-      namedFilterPtr->CheckFilters(slot, entry);
+      namedFilterPtr->CheckFiltersBlock(slot, block);
+   const auto nEntries = block.fEntries.size();
    for (auto &callback : fCallbacks)
-      callback(slot);
+      for (std::size_t i = 0u; i < nEntries; ++i)
+         callback(slot);
+
+   block.fEntries.clear();
+}
+
+/// Process the entries staged so far in the block of this slot, if any. Called at the end of each task in batch mode.
+void RLoopManager::FlushEntryBlock(unsigned int slot)
+{
+   if (fBatchSize > 0 && !fEntryBlocks[slot].fEntries.empty())
+      RunAndCheckFiltersBlock(slot);
+   for (auto *lm : fFusedLoops)
+      lm->FlushEntryBlock(slot);
 }
 
 /// Build TTreeReaderValues for all nodes
@@ -651,6 +812,8 @@ void RLoopManager::RunAndCheckFilters(unsigned int slot, Long64_t entry)
 /// calls their `InitSlot` method, to get them ready for running a task.
 void RLoopManager::InitNodeSlots(TTreeReader *r, unsigned int slot)
 {
+   if (fProfiler)
+      fProfiler->BeginTask(slot);
    SetupSampleCallbacks(r, slot);
    for (auto *ptr : fBookedActions)
       ptr->InitSlot(r, slot);
@@ -663,6 +826,11 @@ void RLoopManager::InitNodeSlots(TTreeReader *r, unsigned int slot)
 
    for (auto &callback : fCallbacksOnce)
       callback(slot);
+
+   // the computation graphs fused with this one read their dataset columns through the same TTreeReader, which shares
+   // the underlying branches among all of its readers: each branch is read and decompressed once per entry
+   for (auto *lm : fFusedLoops)
+      lm->InitNodeSlots(r, slot);
 }
 
 void RLoopManager::SetupSampleCallbacks(TTreeReader *r, unsigned int slot) {
@@ -682,6 +850,8 @@ void RLoopManager::SetupSampleCallbacks(TTreeReader *r, unsigned int slot) {
 void RLoopManager::UpdateSampleInfo(unsigned int slot, const std::pair<ULong64_t, ULong64_t> &range) {
    fSampleInfos[slot] = RSampleInfo(
       "Empty source, range: {" + std::to_string(range.first) + ", " + std::to_string(range.second) + "}", range);
+   for (auto *lm : fFusedLoops)
+      lm->UpdateSampleInfo(slot, range);
 }
 
 void RLoopManager::UpdateSampleInfo(unsigned int slot, TTreeReader &r) {
@@ -699,6 +869,15 @@ void RLoopManager::UpdateSampleInfo(unsigned int slot, TTreeReader &r) {
    }
    const std::string &id = fname + '/' + treename;
    fSampleInfos[slot] = fSampleMap.empty() ? RSampleInfo(id, range) : RSampleInfo(id, range, fSampleMap[id]);
+   for (auto *lm : fFusedLoops)
+      lm->UpdateSampleInfo(slot, r);
+}
+
+/// Whether some node of this computation graph, or of one fused with it, still needs to process entries.
+bool RLoopManager::HasActiveChildren() const
+{
+   return fNStopsReceived < fNChildren ||
+          std::any_of(fFusedLoops.begin(), fFusedLoops.end(), [](RLoopManager *lm) { return lm->HasActiveChildren(); });
 }
 
 /// Initialize all nodes of the functional graph before running the event loop.
@@ -708,17 +887,52 @@ void RLoopManager::UpdateSampleInfo(unsigned int slot, TTreeReader &r) {
 void RLoopManager::InitNodes()
 {
    EvalChildrenCounts();
+   BuildFilterChains();
    for (auto *filter : fBookedFilters)
       filter->InitNode();
    for (auto *range : fBookedRanges)
       range->InitNode();
    for (auto *ptr : fBookedActions)
       ptr->Initialize();
+   InitProfiler();
+   for (auto *lm : fFusedLoops)
+      lm->InitNodes();
+}
+
+/// Enable the node timers and create the profiler if this event loop is profiled. The timers are reset at every event
+/// loop, so that they stop measuring when profiling is disabled.
+void RLoopManager::InitProfiler()
+{
+   for (auto *filter : fBookedFilters)
+      filter->GetTimer().Reset(fNSlots, fProfiling);
+   for (auto *define : fBookedDefines)
+      define->GetTimer().Reset(fNSlots, fProfiling);
+   for (auto *action : fBookedActions)
+      action->GetTimer().Reset(fNSlots, fProfiling);
+
+   if (fProfiling) {
+      fProfiler = std::make_unique<RDFInternal::RProfiler>(fNSlots, fJitTime);
+      for (auto *filter : fBookedFilters)
+         fProfiler->AddNode("Filter", GetProfiledNodeName(filter->GetName(), filter->GetVariation()),
+                            filter->GetTimer());
+      for (auto *define : fBookedDefines)
+         fProfiler->AddNode("Define", GetProfiledNodeName(define->GetName(), define->GetVariation()),
+                            define->GetTimer());
+      for (auto *action : fBookedActions)
+         fProfiler->AddNode("Action", action->GetActionName(), action->GetTimer());
+      fProfiler->BeginLoop();
+   }
+   fJitTime = 0.;
 }
 
 /// Perform clean-up operations. To be called at the end of each event loop.
 void RLoopManager::CleanUpNodes()
 {
+   if (fProfiler) {
+      fProfiler->EndLoop();
+      fLastProfile = std::move(fProfiler);
+   }
+
    fMustRunNamedFilters = false;
 
    // forget RActions and detach TResultProxies
@@ -731,19 +945,29 @@ void RLoopManager::CleanUpNodes()
    // reset children counts
    fNChildren = 0;
    fNStopsReceived = 0;
-   for (auto *ptr : fBookedFilters)
+   for (auto *ptr : fBookedFilters) {
       ptr->ResetChildrenCount();
+      ptr->SetFilterChain(nullptr);
+   }
    for (auto *ptr : fBookedRanges)
       ptr->ResetChildrenCount();
 
    fCallbacks.clear();
    fCallbacksOnce.clear();
    fSampleCallbacks.clear();
+
+   for (auto *lm : fFusedLoops) {
+      lm->CleanUpNodes();
+      lm->fNRuns++;
+   }
+   fFusedLoops.clear();
 }
 
 /// Perform clean-up operations. To be called at the end of each task execution.
 void RLoopManager::CleanUpTask(TTreeReader *r, unsigned int slot)
 {
+   if (fProfiler)
+      fProfiler->EndTask(slot);
    if (r != nullptr)
       fNewSampleNotifier.GetChainNotifyLink(slot).RemoveLink(*r->GetTree());
    for (auto *ptr : fBookedActions)
@@ -759,6 +983,19 @@ void RLoopManager::CleanUpTask(TTreeReader *r, unsigned int slot)
       for (auto &v : fDatasetColumnReaders[slot])
          v.second.reset();
    }
+
+   if (fBatchSize > 0) {
+      // block readers are re-created at every task as the dataset column readers they wrap might change
+      fBlockColumnReaders[slot].clear();
+      fEntryBlocks[slot].fEntries.clear();
+   }
+
+   // profiled readers wrap the dataset column readers, which might be re-created at the next task
+   if (fProfiler)
+      fProfiledColumnReaders[slot].clear();
+
+   for (auto *lm : fFusedLoops)
+      lm->CleanUpTask(r, slot);
 }
 
 /// Add RDF nodes that require just-in-time compilation to the computation graph.
@@ -778,9 +1015,13 @@ void RLoopManager::Jit()
    s.Start();
    RDFInternal::InterpreterCalc(code, "RLoopManager::Run");
    s.Stop();
+   fJitTime += s.RealTime();
    R__LOG_INFO(RDFLogChannel()) << "Just-in-time compilation phase completed"
                                 << (s.RealTime() > 1e-3 ? " in " + std::to_string(s.RealTime()) + " seconds."
                                                         : " in less than 1ms.");
+
+   // only functions used by code that was jitted successfully end up in the cache
+   RDFInternal::FlushJitCache();
 }
 
 /// Trigger counting of number of children nodes for each node of the functional graph.
@@ -797,6 +1038,58 @@ void RLoopManager::EvalChildrenCounts()
       namedFilterPtr->TriggerChildrenCount();
 }
 
+/// Group consecutive unnamed filters into chains whose evaluation order is chosen at runtime, see RFilterChain.
+/// A filter is appended to the chain of the filter upstream if that filter is unnamed and has no other active
+/// children, so that no other node depends on the result of the filters in the middle of the chain. Filters that are
+/// not used in this event loop are ignored.
+/// Named filters are never part of a chain, as their cut-flow report depends on the order of evaluation.
+/// Must be called after EvalChildrenCounts().
+void RLoopManager::BuildFilterChains()
+{
+   for (auto *filter : fBookedFilters) {
+      filter->SetFilterChain(nullptr);
+      filter->SetPlanInfo("");
+   }
+   if (fFilterProfileEntries == 0 || fBatchSize > 0)
+      return;
+
+   // the filter upstream of `filter` if the two can be part of the same chain, nullptr otherwise
+   auto getChainablePrev = [](RFilterBase *filter) -> RFilterBase * {
+      if (filter->HasName() || filter->GetNChildren() == 0)
+         return nullptr;
+      auto *prev = dynamic_cast<RFilterBase *>(filter->GetPrevNode());
+      if (prev == nullptr)
+         return nullptr;
+      prev = prev->GetConcreteFilter();
+      if (prev->HasName() || prev->GetNChildren() != 1)
+         return nullptr;
+      return prev;
+   };
+
+   std::vector<RFilterBase *> filters;
+   for (auto *filter : fBookedFilters)
+      filters.emplace_back(filter->GetConcreteFilter());
+   std::vector<RFilterBase *> notLast;
+   for (auto *filter : filters) {
+      if (auto *prev = getChainablePrev(filter))
+         notLast.emplace_back(prev);
+   }
+
+   for (auto *last : filters) {
+      if (last->HasName() || std::find(notLast.begin(), notLast.end(), last) != notLast.end())
+         continue;
+      std::vector<RFilterBase *> chain{last};
+      while (auto *prev = getChainablePrev(chain.back()))
+         chain.emplace_back(prev);
+      if (chain.size() < 2)
+         continue;
+      std::reverse(chain.begin(), chain.end());
+      auto &prevNode = *chain.front()->GetPrevNode();
+      last->SetFilterChain(
+         std::make_unique<RDFInternal::RFilterChain>(chain, prevNode, fNSlots, fFilterProfileEntries));
+   }
+}
+
 /// Start the event loop with a different mechanism depending on IMT/no IMT, data source/no data source.
 /// Also perform a few setup and clean-up operations (jit actions if necessary, clear booked actions after the loop...).
 /// The jitting phase is skipped if the `jit` parameter is `false` (unsafe, use with care).
@@ -804,6 +1097,8 @@ void RLoopManager::Run(bool jit)
 {
    // Change value of TTree::GetMaxTreeSize only for this scope. Revert when #6640 will be solved.
    MaxTreeSizeRAII ctxtmts;
+   // The fused graphs are only run by this event loop, also if it throws
+   ClearFusedLoopsRAII clearFusedLoops{fFusedLoops};
 
    R__LOG_INFO(RDFLogChannel()) << "Starting event loop number " << fNRuns << '.';
 
@@ -812,6 +1107,17 @@ void RLoopManager::Run(bool jit)
    if (jit)
       Jit();
 
+   std::vector<RLoopManager *> loops{this};
+   loops.insert(loops.end(), fFusedLoops.begin(), fFusedLoops.end());
+   for (auto *lm : loops) {
+      if (lm->fBatchSize == 0)
+         continue;
+      for (auto *actionPtr : lm->fBookedActions)
+         if (!actionPtr->SupportsBatchMode())
+            throw std::runtime_error("RDataFrame::Run: one of the booked actions does not support batch mode. Call "
+                                     "ROOT::RDF::Experimental::SetBatchSize(df, 0) to disable it.");
+   }
+
    InitNodes();
 
    TStopwatch s;
@@ -834,6 +1140,53 @@ void RLoopManager::Run(bool jit)
                                 << s.RealTime() << "s elapsed).";
 }
 
+/// Whether `other` processes exactly the same entries of the same dataset as this loop manager, in which case their
+/// computation graphs can run in the same event loop (see Fuse()).
+/// Event loops over data sources are never fused, as data sources keep per-loop state. Trees and chains are considered
+/// the same dataset if they are the same object, or if they read the same trees from the same files with the same
+/// entry range and have no friends or entry lists.
+bool RLoopManager::HasSameDataset(const RLoopManager &other) const
+{
+   if (this == &other)
+      return true;
+   if (fDataSource || other.fDataSource || fLoopType != other.fLoopType || fNSlots != other.fNSlots)
+      return false;
+   if (!fTree || !other.fTree)
+      return !fTree && !other.fTree && fEmptyEntryRange == other.fEmptyEntryRange;
+   if (fBeginEntry != other.fBeginEntry || fEndEntry != other.fEndEntry)
+      return false;
+   if (fTree == other.fTree)
+      return true;
+
+   auto hasFriendsOrEntryList = [](TTree &t) {
+      return t.GetEntryList() != nullptr || (t.GetListOfFriends() && t.GetListOfFriends()->GetEntries() > 0);
+   };
+   if (hasFriendsOrEntryList(*fTree) || hasFriendsOrEntryList(*other.fTree))
+      return false;
+   try {
+      return ROOT::Internal::TreeUtils::GetTreeFullPaths(*fTree) ==
+                ROOT::Internal::TreeUtils::GetTreeFullPaths(*other.fTree) &&
+             ROOT::Internal::TreeUtils::GetFileNamesFromTree(*fTree) ==
+                ROOT::Internal::TreeUtils::GetFileNamesFromTree(*other.fTree);
+   } catch (const std::runtime_error &) {
+      // e.g. in-memory trees: we cannot tell whether they hold the same data
+      return false;
+   }
+}
+
+/// Run the computation graph of `other` as part of the next event loop of this loop manager.
+/// The two loop managers must read the same dataset (see HasSameDataset()). The booked actions of `other` are
+/// executed and its number of runs is incremented as if its own event loop had run, but the dataset is only traversed
+/// once, and columns read by both computation graphs are only read from disk once.
+void RLoopManager::Fuse(RLoopManager &other)
+{
+   if (&other == this || std::find(fFusedLoops.begin(), fFusedLoops.end(), &other) != fFusedLoops.end())
+      return;
+   if (!HasSameDataset(other))
+      throw std::logic_error("RLoopManager::Fuse: the two computation graphs do not read the same dataset.");
+   fFusedLoops.emplace_back(&other);
+}
+
 /// Return the list of default columns -- empty if none was provided when constructing the RDataFrame
 const ColumnNames_t &RLoopManager::GetDefaultColumnNames() const
 {
@@ -910,6 +1263,34 @@ bool RLoopManager::CheckFilters(unsigned int, Long64_t)
    return true;
 }
 
+// end of recursive chain of calls, all entries pass
+const char *RLoopManager::CheckFiltersBlock(unsigned int, RDFInternal::REntryBlock &)
+{
+   return fAllPassMask.data();
+}
+
+/// Enable batch mode with blocks of batchSize entries, or disable it if batchSize is 0.
+/// See ROOT::RDF::Experimental::SetBatchSize().
+void RLoopManager::SetBatchSize(std::size_t batchSize)
+{
+   fBatchSize = batchSize;
+   fAllPassMask.assign(batchSize, 1);
+   // blocks are never re-allocated as block column readers keep references to them
+   fEntryBlocks.resize(fNSlots);
+   for (auto &block : fEntryBlocks) {
+      block.fEntries.clear();
+      block.fEntries.reserve(batchSize);
+   }
+   fBlockColumnReaders.resize(fNSlots);
+}
+
+/// See ROOT::RDF::Experimental::SetProfiling().
+void RLoopManager::SetProfiling(bool enable)
+{
+   fProfiling = enable;
+   fProfiledColumnReaders.resize(fNSlots);
+}
+
 /// Call `FillReport` on all booked filters
 void RLoopManager::Report(ROOT::RDF::RCutFlowReport &rep) const
 {
@@ -1049,6 +1430,54 @@ RLoopManager::GetDatasetColumnReader(unsigned int slot, const std::string &col,
       return nullptr;
 }
 
+/// \brief Register a new RBlockColumnReader with this RLoopManager.
+/// \return A pointer to the inserted column reader.
+RColumnReaderBase *RLoopManager::AddBlockColumnReader(unsigned int slot, const std::string &col,
+                                                      std::unique_ptr<RDFInternal::RBlockColumnReaderBase> &&reader,
+                                                      const std::type_info &ti)
+{
+   auto &readers = fBlockColumnReaders[slot];
+   const auto key = MakeDatasetColReadersKey(col, ti);
+   assert(readers.find(key) == readers.end());
+   auto *rptr = reader.get();
+   readers[key] = std::move(reader);
+   return rptr;
+}
+
+RColumnReaderBase *
+RLoopManager::GetBlockColumnReader(unsigned int slot, const std::string &col, const std::type_info &ti) const
+{
+   const auto key = MakeDatasetColReadersKey(col, ti);
+   auto it = fBlockColumnReaders[slot].find(key);
+   if (it != fBlockColumnReaders[slot].end())
+      return it->second.get();
+   else
+      return nullptr;
+}
+
+RColumnReaderBase *RLoopManager::AddProfiledColumnReader(unsigned int slot, const std::string &col,
+                                                         std::unique_ptr<RColumnReaderBase> &&reader,
+                                                         const std::type_info &ti)
+{
+   auto &readers = fProfiledColumnReaders[slot];
+   const auto key = MakeDatasetColReadersKey(col, ti);
+   assert(readers.find(key) == readers.end());
+   auto *rptr = reader.get();
+   readers[key] = std::move(reader);
+   return rptr;
+}
+
+RColumnReaderBase *
+RLoopManager::GetProfiledColumnReader(unsigned int slot, const std::string &col, const std::type_info &ti) const
+{
+   const auto key = MakeDatasetColReadersKey(col, ti);
+   auto it = fProfiledColumnReaders[slot].find(key);
+   if (it != fProfiledColumnReaders[slot].end())
+      return it->second.get();
+   else
+      return nullptr;
+}
+
 void RLoopManager::AddSampleCallback(void *nodePtr, SampleCallback_t &&callback)
 {
    if (callback)
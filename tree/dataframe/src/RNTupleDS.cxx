@@ -26,6 +26,7 @@
 
 #include <TError.h>
 
+#include <algorithm>
 #include <string>
 #include <vector>
 #include <typeinfo>
@@ -313,6 +314,21 @@ std::vector<std::pair<ULong64_t, ULong64_t>> RNTupleDS::GetEntryRanges()
    if (fHasSeenAllRanges)
       return ranges;
 
+   if (!fValueRangeCuts.empty()) {
+      const auto candidates = fSources[0]->GetSharedDescriptorGuard()->FindEntryRanges(fValueRangeCuts);
+      // Split large candidate ranges such that all the slots get work
+      NTupleSize_t nCandidateEntries = 0;
+      for (const auto &c : candidates)
+         nCandidateEntries += c.second - c.first;
+      const NTupleSize_t maxChunkSize = std::max(NTupleSize_t(1), nCandidateEntries / fNSlots);
+      for (const auto &c : candidates) {
+         for (auto start = c.first; start < c.second; start += maxChunkSize)
+            ranges.emplace_back(start, std::min(start + maxChunkSize, c.second));
+      }
+      fHasSeenAllRanges = true;
+      return ranges;
+   }
+
    auto nEntries = fSources[0]->GetNEntries();
    const auto chunkSize = nEntries / fNSlots;
    const auto reminder = 1U == fNSlots ? 0 : nEntries % fNSlots;
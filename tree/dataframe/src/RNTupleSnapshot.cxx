@@ -0,0 +1,188 @@
+/*************************************************************************
+ * Copyright (C) 1995-2023, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/RDF/ActionHelpers.hxx"
+#include "ROOT/RDataFrame.hxx"
+#include "ROOT/RNTupleDS.hxx"
+#include <ROOT/REntry.hxx>
+#include <ROOT/RField.hxx>
+#include <ROOT/RNTuple.hxx>
+#include <ROOT/RNTupleModel.hxx>
+#include <ROOT/RNTupleOptions.hxx>
+#include <ROOT/RPageSinkMem.hxx>
+#include <ROOT/RPageStorageFile.hxx>
+#include "TError.h" // Warning
+#include "TFile.h"
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+using ROOT::Experimental::NTupleSize_t;
+using ROOT::Experimental::REntry;
+using ROOT::Experimental::RNTupleModel;
+using ROOT::Experimental::RNTupleWriteOptions;
+using ROOT::Experimental::RNTupleWriter;
+using ROOT::Experimental::Detail::RPageSinkFile;
+using ROOT::Experimental::Detail::RPageSinkMem;
+
+/// Every slot writes its entries to an RPageSinkMem. The clusters are compressed by the slot that fills them and
+/// then appended, under a lock, to the page sink of the output file. The clusters of different slots can interleave.
+class RNTupleSnapshotWriter final : public ROOT::Internal::RDF::RNTupleSnapshotWriterBase {
+   struct RSlotWriter {
+      std::deque<RPageSinkMem::RSealedCluster> fClusters; ///< Committed by fWriter, not yet written to the output
+      std::unique_ptr<RNTupleWriter> fWriter;
+      std::unique_ptr<REntry> fEntry; ///< Bare entry, bound to the input values before every Fill()
+      ULong64_t fNEntries = 0;
+   };
+
+   unsigned int fNSlots;
+   std::string fFileName;
+   std::string fNTupleName;
+   std::vector<std::string> fFieldNames;
+   std::vector<std::string> fTypeNames;
+   ROOT::RDF::RSnapshotOptions fOptions;
+   std::shared_ptr<ROOT::RDataFrame> fOutputDF;
+   RNTupleWriteOptions fWriteOptions;
+   std::unique_ptr<TFile> fOutputFile;
+   std::unique_ptr<RPageSinkFile> fSink;
+   /// The fields of fModel are connected to fSink, hence the model must be destructed first
+   std::unique_ptr<RNTupleModel> fModel;
+   NTupleSize_t fNEntriesCommitted = 0;
+   std::mutex fSinkMutex;
+   std::vector<std::unique_ptr<RSlotWriter>> fSlotWriters;
+
+   /// The output sink and the writers of all the slots use models created by this function, so that the physical
+   /// column ids of their pages match
+   std::unique_ptr<RNTupleModel> MakeModel() const
+   {
+      auto model = RNTupleModel::CreateBare();
+      for (std::size_t i = 0; i < fFieldNames.size(); ++i) {
+         if (fTypeNames[i].empty())
+            throw std::runtime_error("Snapshot: cannot write column \"" + fFieldNames[i] +
+                                     "\" to an RNTuple, its type is not known to ROOT.");
+         auto field = ROOT::Experimental::Detail::RFieldBase::Create(fFieldNames[i], fTypeNames[i]);
+         if (!field)
+            throw std::runtime_error("Snapshot: cannot write column \"" + fFieldNames[i] + "\" of type " +
+                                     fTypeNames[i] + " to an RNTuple: " + field.GetError()->GetReport());
+         model->AddField(field.Unwrap());
+      }
+      model->Freeze();
+      return model;
+   }
+
+   void CommitClusters(RSlotWriter &slotWriter)
+   {
+      std::lock_guard<std::mutex> lock(fSinkMutex);
+      for (const auto &cluster : slotWriter.fClusters)
+         RPageSinkMem::CommitSealedCluster(cluster, *fSink, fNEntriesCommitted);
+      slotWriter.fClusters.clear();
+   }
+
+public:
+   RNTupleSnapshotWriter(unsigned int nSlots, const std::string &fileName, const std::string &ntupleName,
+                         const std::vector<std::string> &fieldNames, const std::vector<std::string> &typeNames,
+                         const ROOT::RDF::RSnapshotOptions &options, const std::shared_ptr<ROOT::RDataFrame> &outputDF)
+      : fNSlots(nSlots), fFileName(fileName), fNTupleName(ntupleName), fFieldNames(fieldNames), fTypeNames(typeNames),
+        fOptions(options), fOutputDF(outputDF)
+   {
+      fWriteOptions.SetCompression(
+         ROOT::CompressionSettings(fOptions.fCompressionAlgorithm, fOptions.fCompressionLevel));
+   }
+
+   void Initialize() final
+   {
+      fOutputFile.reset(TFile::Open(fFileName.c_str(), fOptions.fMode.c_str(), /*ftitle=*/"",
+                                    ROOT::CompressionSettings(fOptions.fCompressionAlgorithm,
+                                                              fOptions.fCompressionLevel)));
+      if (!fOutputFile)
+         throw std::runtime_error("Snapshot: could not create output file " + fFileName);
+
+      fSink = std::make_unique<RPageSinkFile>(fNTupleName, *fOutputFile, fWriteOptions);
+      fModel = MakeModel();
+      fSink->Create(*fModel);
+      fNEntriesCommitted = 0;
+
+      fSlotWriters.clear();
+      for (unsigned int i = 0; i < fNSlots; ++i) {
+         auto slotWriter = std::make_unique<RSlotWriter>();
+         auto model = MakeModel();
+         slotWriter->fEntry = model->CreateBareEntry();
+         auto sink = std::make_unique<RPageSinkMem>(fNTupleName, fWriteOptions, slotWriter->fClusters);
+         slotWriter->fWriter = std::make_unique<RNTupleWriter>(std::move(model), std::move(sink));
+         fSlotWriters.emplace_back(std::move(slotWriter));
+      }
+   }
+
+   void Exec(unsigned int slot, void *const *values) final
+   {
+      auto &slotWriter = *fSlotWriters[slot];
+      // The values of the entry are in the order of the fields of the model
+      auto value = slotWriter.fEntry->begin();
+      for (std::size_t i = 0; i < fFieldNames.size(); ++i, ++value)
+         *value = value->GetField()->CaptureValue(values[i]);
+      slotWriter.fWriter->Fill(*slotWriter.fEntry);
+
+      ++slotWriter.fNEntries;
+      if (fOptions.fAutoFlush > 0 && slotWriter.fNEntries % fOptions.fAutoFlush == 0)
+         slotWriter.fWriter->CommitCluster();
+      if (!slotWriter.fClusters.empty())
+         CommitClusters(slotWriter);
+   }
+
+   void Finalize() final
+   {
+      for (auto &slotWriter : fSlotWriters) {
+         slotWriter->fWriter->CommitCluster();
+         CommitClusters(*slotWriter);
+      }
+      fSlotWriters.clear();
+
+      if (fNEntriesCommitted == 0)
+         Warning("Snapshot", "No input entries (input was empty or no entry passed the Filters). Output RNTuple is "
+                             "empty.");
+
+      fSink->CommitClusterGroup();
+      fSink->CommitDataset();
+      fModel.reset();
+      fSink.reset();
+      fOutputFile->Close();
+      fOutputFile.reset();
+
+      if (fOutputDF)
+         *fOutputDF = ROOT::RDF::Experimental::FromRNTuple(fNTupleName, fFileName);
+   }
+};
+
+} // anonymous namespace
+
+namespace ROOT {
+namespace Internal {
+namespace RDF {
+
+std::unique_ptr<RNTupleSnapshotWriterBase>
+MakeRNTupleSnapshotWriter(unsigned int nSlots, const std::string &fileName, const std::string &dirName,
+                          const std::string &ntupleName, const ColumnNames_t &fieldNames,
+                          const std::vector<std::string> &typeNames, const RSnapshotOptions &options,
+                          const std::shared_ptr<ROOT::RDataFrame> &outputDF)
+{
+   if (!dirName.empty())
+      throw std::runtime_error("Snapshot: writing an RNTuple to a sub-directory is not supported.");
+   ValidateSnapshotOutput(options, ntupleName, fileName);
+   return std::make_unique<RNTupleSnapshotWriter>(nSlots, fileName, ntupleName, fieldNames, typeNames, options,
+                                                  outputDF);
+}
+
+} // namespace RDF
+} // namespace Internal
+} // namespace ROOT
@@ -0,0 +1,208 @@
+/*************************************************************************
+ * Copyright (C) 1995-2023, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/RDF/RProfiler.hxx"
+
+#include <algorithm>
+#include <cstdio> // snprintf
+#include <sstream>
+
+namespace {
+
+std::string EscapeJSON(const std::string &str)
+{
+   std::string escaped;
+   escaped.reserve(str.size());
+   for (const char c : str) {
+      switch (c) {
+      case '"': escaped += "\\\""; break;
+      case '\\': escaped += "\\\\"; break;
+      case '\n': escaped += "\\n"; break;
+      case '\t': escaped += "\\t"; break;
+      default:
+         if (static_cast<unsigned char>(c) < 0x20) {
+            char code[8];
+            snprintf(code, sizeof(code), "\\u%04x", c);
+            escaped += code;
+         } else {
+            escaped += c;
+         }
+      }
+   }
+   return escaped;
+}
+
+std::string GetLabel(const std::string &kind, const std::string &name)
+{
+   return name.empty() ? kind : kind + ' ' + name;
+}
+
+} // anonymous namespace
+
+namespace ROOT {
+namespace Internal {
+namespace RDF {
+
+RProfiler::RProfiler(unsigned int nSlots, double jitTime) : fNSlots(nSlots), fJitTime(jitTime)
+{
+   for (auto i = 0u; i < fNSlots; ++i)
+      fSlots.emplace_back(std::make_unique<RSlotInfo>());
+}
+
+void RProfiler::AddNode(const std::string &kind, const std::string &name, RNodeTimer &timer)
+{
+   fNodes.push_back({kind, name, &timer, {}, 0});
+}
+
+void RProfiler::BeginLoop()
+{
+   for (auto &slot : fSlots)
+      slot->fNodeTimesAtTaskStart.resize(fNodes.size());
+   fLoopStart = Clock_t::now();
+}
+
+/// Remember the time spent so far by the slot in each node, to compute the time spent during the task
+void RProfiler::BeginTask(unsigned int slot)
+{
+   auto &slotInfo = *fSlots[slot];
+   for (std::size_t i = 0; i < fNodes.size(); ++i)
+      slotInfo.fNodeTimesAtTaskStart[i] = fNodes[i].fTimer->GetTime(slot);
+   slotInfo.fInTask = true;
+   slotInfo.fTaskStart = Clock_t::now();
+}
+
+void RProfiler::EndTask(unsigned int slot)
+{
+   auto &slotInfo = *fSlots[slot];
+   if (!slotInfo.fInTask)
+      return; // the initialization of the task failed
+   slotInfo.fInTask = false;
+
+   RTaskInfo task{ToSeconds(slotInfo.fTaskStart - fLoopStart), ToSeconds(Clock_t::now() - fLoopStart), {}};
+   for (std::size_t i = 0; i < fNodes.size(); ++i) {
+      const auto time = fNodes[i].fTimer->GetTime(slot) - slotInfo.fNodeTimesAtTaskStart[i];
+      if (time > 0)
+         task.fNodeTimes.emplace_back(i, time);
+   }
+   slotInfo.fTasks.emplace_back(std::move(task));
+}
+
+/// Copy the totals of the node timers: the nodes might be destroyed before the profile is exported
+void RProfiler::EndLoop()
+{
+   fLoopTime = ToSeconds(Clock_t::now() - fLoopStart);
+   for (auto &node : fNodes) {
+      node.fTimes.resize(fNSlots);
+      for (auto slot = 0u; slot < fNSlots; ++slot) {
+         node.fTimes[slot] = node.fTimer->GetTime(slot);
+         node.fNCalls += node.fTimer->GetNCalls(slot);
+      }
+      node.fTimer = nullptr;
+   }
+}
+
+RColumnProfile &RProfiler::GetColumnProfile(const std::string &colName, unsigned int slot)
+{
+   std::lock_guard<std::mutex> lock(fColumnsMutex);
+   auto &profiles = fColumns[colName];
+   if (profiles.empty()) {
+      for (auto i = 0u; i < fNSlots; ++i)
+         profiles.emplace_back(std::make_unique<RColumnProfile>());
+   }
+   return *profiles[slot];
+}
+
+std::string RProfiler::ToJSON() const
+{
+   std::ostringstream json;
+   json << "{\n  \"nSlots\": " << fNSlots << ",\n  \"jitTime\": " << fJitTime << ",\n  \"loopTime\": " << fLoopTime
+        << ",\n  \"nodes\": [";
+   for (std::size_t i = 0; i < fNodes.size(); ++i) {
+      const auto &node = fNodes[i];
+      ULong64_t total = 0;
+      for (auto time : node.fTimes)
+         total += time;
+      json << (i == 0 ? "\n" : ",\n") << "    {\"kind\": \"" << node.fKind << "\", \"name\": \""
+           << EscapeJSON(node.fName) << "\", \"time\": " << total * 1e-9 << ", \"calls\": " << node.fNCalls
+           << ", \"slotTimes\": [";
+      for (auto slot = 0u; slot < node.fTimes.size(); ++slot)
+         json << (slot == 0 ? "" : ", ") << node.fTimes[slot] * 1e-9;
+      json << "]}";
+   }
+   json << "\n  ],\n  \"columns\": [";
+   bool first = true;
+   for (const auto &column : fColumns) {
+      RColumnProfile total;
+      for (const auto &profile : column.second) {
+         total.fNReads += profile->fNReads;
+         total.fBytes += profile->fBytes;
+         total.fTime += profile->fTime;
+      }
+      json << (first ? "\n" : ",\n") << "    {\"name\": \"" << EscapeJSON(column.first)
+           << "\", \"reads\": " << total.fNReads << ", \"bytes\": " << total.fBytes
+           << ", \"time\": " << total.fTime * 1e-9 << "}";
+      first = false;
+   }
+   json << "\n  ],\n  \"slots\": [";
+   for (auto slot = 0u; slot < fNSlots; ++slot) {
+      const auto &tasks = fSlots[slot]->fTasks;
+      double busyTime = 0.;
+      for (const auto &task : tasks)
+         busyTime += task.fEnd - task.fStart;
+      json << (slot == 0 ? "\n" : ",\n") << "    {\"slot\": " << slot << ", \"tasks\": " << tasks.size()
+           << ", \"busyTime\": " << busyTime
+           << ", \"utilization\": " << (fLoopTime > 0. ? std::min(1., busyTime / fLoopTime) : 0.) << "}";
+   }
+   json << "\n  ]\n}\n";
+   return json.str();
+}
+
+/// The jitting phase and the event loop are shown on the first thread, the tasks of each slot on the following
+/// threads. The node timers accumulate many short intervals, so within each task the time spent in each node is shown
+/// as a single event, and the events of the nodes of a task are laid out one after the other from the task start.
+/// As node times include the nodes they trigger (e.g. the Defines used by a Filter), they can add up to more than the
+/// duration of the task.
+std::string RProfiler::ToChromeTrace() const
+{
+   std::ostringstream trace;
+   trace << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n";
+   auto addEvent = [&trace](const std::string &name, const char *cat, unsigned int tid, double start, double duration) {
+      trace << ",\n{\"name\": \"" << EscapeJSON(name) << "\", \"cat\": \"" << cat
+            << "\", \"ph\": \"X\", \"pid\": 0, \"tid\": " << tid << ", \"ts\": " << start * 1e6
+            << ", \"dur\": " << duration * 1e6 << '}';
+   };
+
+   trace << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 0, \"tid\": 0, \"args\": {\"name\": \"RDataFrame\"}}";
+   for (auto slot = 0u; slot < fNSlots; ++slot)
+      trace << ",\n{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 0, \"tid\": " << slot + 1
+            << ", \"args\": {\"name\": \"slot " << slot << "\"}}";
+
+   if (fJitTime > 0.)
+      addEvent("Jitting", "jit", 0, 0., fJitTime);
+   addEvent("Event loop", "loop", 0, fJitTime, fLoopTime);
+
+   for (auto slot = 0u; slot < fNSlots; ++slot) {
+      for (const auto &task : fSlots[slot]->fTasks) {
+         const auto start = fJitTime + task.fStart;
+         addEvent("Task", "task", slot + 1, start, task.fEnd - task.fStart);
+         auto nodeStart = start;
+         for (const auto &nodeTime : task.fNodeTimes) {
+            const auto &node = fNodes[nodeTime.first];
+            const auto duration = nodeTime.second * 1e-9;
+            addEvent(GetLabel(node.fKind, node.fName), "node", slot + 1, nodeStart, duration);
+            nodeStart += duration;
+         }
+      }
+   }
+   trace << "\n]}\n";
+   return trace.str();
+}
+
+} // namespace RDF
+} // namespace Internal
+} // namespace ROOT
@@ -21,6 +21,7 @@ RRangeBase::RRangeBase(RLoopManager *implPtr, unsigned int start, unsigned int s
 void RRangeBase::InitNode()
 {
    fLastCheckedEntry = -1;
+   fLastCheckedBlock = -1;
    fNProcessedEntries = 0;
    fHasStopped = false;
 }
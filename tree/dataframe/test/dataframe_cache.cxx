@@ -8,6 +8,7 @@
 #include "gtest/gtest.h"
 
 #include <algorithm>
+#include <cstring>
 
 using namespace ROOT::RDF;
 using namespace ROOT::VecOps;
@@ -336,3 +337,62 @@ TEST(Cache, Alias)
    auto df4 = df3.Cache({"y"});
    EXPECT_EQ(df4.Sum("y").GetValue(), 3u);
 }
+
+TEST(Cache, MemoryBudget)
+{
+   ROOT::RDataFrame df(1000);
+   auto d = df.Define("x", [](ULong64_t e) { return int(e); }, {"rdfentry_"})
+               .Define("v", [](int x) { return RVec<float>(x % 4, float(x)); }, {"x"})
+               .Define("s", [](int x) { return std::to_string(x); }, {"x"});
+
+   // the number of spill files in the directory and their total size
+   const std::string spillDir = "dataframe_cache_memorybudget";
+   gSystem->mkdir(spillDir.c_str());
+   auto getSpillFiles = [&spillDir]() {
+      std::pair<int, Long64_t> spillFiles{0, 0};
+      void *dir = gSystem->OpenDirectory(spillDir.c_str());
+      while (const char *entry = gSystem->GetDirEntry(dir)) {
+         FileStat_t stat;
+         if (strncmp(entry, "rdfcache_", 9) == 0 && gSystem->GetPathInfo((spillDir + "/" + entry).c_str(), stat) == 0) {
+            ++spillFiles.first;
+            spillFiles.second += stat.fSize;
+         }
+      }
+      gSystem->FreeDirectory(dir);
+      return spillFiles;
+   };
+
+   ROOT::RDF::RCacheOptions opts;
+   // enough for a few hundred entries: the others are written to disk
+   opts.fMemoryBudget = 16 * 1024;
+   opts.fSpillDirectory = spillDir;
+   {
+      auto cached = d.Cache<int, RVec<float>, std::string>({"x", "v", "s"}, opts);
+      // the cache is only filled, and spilled, by the first event loop of the cached data frame
+      EXPECT_EQ(getSpillFiles().first, 0);
+      EXPECT_EQ(*cached.Count(), 1000u);
+      const auto spillFiles = getSpillFiles();
+      EXPECT_EQ(spillFiles.first, 1);
+      EXPECT_GT(spillFiles.second, 0);
+
+      auto check = [](int x, const RVec<float> &v, const std::string &s) {
+         return v.size() == std::size_t(x % 4) && ROOT::VecOps::All(v == float(x)) && s == std::to_string(x);
+      };
+      for (auto i : {0, 1}) { // run twice, spilled chunks are read back at each event loop
+         auto nGood = cached.Filter(check, {"x", "v", "s"}).Count();
+         auto sum = cached.Sum<int>("x");
+         EXPECT_EQ(*nGood, 1000u) << "event loop " << i;
+         EXPECT_EQ(*sum, 999 * 1000 / 2) << "event loop " << i;
+      }
+      // reading the spilled chunks back does not write to the spill file
+      EXPECT_EQ(getSpillFiles(), spillFiles);
+   }
+   // the spill file is removed with the cache
+   EXPECT_EQ(getSpillFiles().first, 0);
+   gSystem->Unlink(spillDir.c_str());
+
+   // jitted version, without a budget
+   auto cachedJit = d.Cache({"x", "v"}, ROOT::RDF::RCacheOptions());
+   EXPECT_EQ(*cachedJit.Sum<int>("x"), 999 * 1000 / 2);
+   EXPECT_EQ(*cachedJit.Define("n", "v.size()").Sum<std::size_t>("n"), 250u * (0 + 1 + 2 + 3));
+}
@@ -4,11 +4,16 @@
 #include <ROOT/RVec.hxx>
 #include <ROOT/RDFHelpers.hxx>
 #include <ROOT/RResultHandle.hxx>
+#include <TInterpreter.h>
+#include <TROOT.h>
 #include <TSystem.h>
+#include <TTree.h>
 #include <RConfigure.h>
 
 #include <algorithm>
+#include <cstring>
 #include <deque>
+#include <fstream>
 #include <vector>
 #include <string>
 
@@ -574,6 +579,186 @@ TEST(RDFHelpers, GraphAsymmErrorsRunTimeErrors)
    EXPECT_THROW(gr2.GetValue(), std::runtime_error);
 }
 
+TEST(RDFHelpers, SetBatchSize)
+{
+   TTree t("t", "t");
+   int x = 0;
+   t.Branch("x", &x);
+   for (x = 0; x < 100; ++x)
+      t.Fill();
+   t.ResetBranchAddresses();
+
+   auto run = [&t](std::size_t batchSize) {
+      ROOT::RDataFrame df(t);
+      ROOT::RDF::Experimental::SetBatchSize(df, batchSize);
+      auto f = df.Filter([](int v) { return v % 3 == 0; }, {"x"}, "mult3");
+      auto d = f.Define("y", [](int v) { return v * 0.5; }, {"x"});
+      auto sum = d.Sum<double>("y");
+      auto count = f.Count();
+      auto entries = d.Filter([](double y) { return y > 10; }, {"y"}).Take<ULong64_t>("rdfentry_");
+      auto range = df.Range(5, 50, 7).Take<int>("x");
+      auto report = df.Report();
+      EXPECT_EQ(report->At("mult3").GetAll(), 100u);
+      return std::make_tuple(*sum, *count, *entries, *range, report->At("mult3").GetPass());
+   };
+
+   const auto expected = run(0);
+   EXPECT_EQ(std::get<1>(expected), 34u);
+   // the batch size does not divide the number of entries, the last block is partially filled
+   EXPECT_EQ(run(7), expected);
+   EXPECT_EQ(run(1), expected);
+   EXPECT_EQ(run(1000), expected);
+
+   ROOT::RDataFrame df(t);
+   ROOT::RDF::Experimental::SetBatchSize(df, 16);
+   EXPECT_THROW(df.Snapshot<int>("t", "dataframe_helpers_batchsnapshot.root", {"x"}), std::runtime_error);
+}
+
+TEST(RDFHelpers, SetFilterReordering)
+{
+   auto run = [](ULong64_t nProfileEntries) {
+      ROOT::RDataFrame df(1000);
+      ROOT::RDF::Experimental::SetFilterReordering(df, nProfileEntries);
+      auto nAlwaysPassCalls = std::make_shared<int>(0);
+      auto nSelectiveCalls = std::make_shared<int>(0);
+      auto alwaysPass = [nAlwaysPassCalls](ULong64_t) { ++*nAlwaysPassCalls; return true; };
+      auto selective = [nSelectiveCalls](ULong64_t e) { ++*nSelectiveCalls; return e % 10 == 0; };
+      auto f = df.Filter(alwaysPass, {"rdfentry_"}).Filter(selective, {"rdfentry_"});
+      auto count = f.Count();
+      auto passOdd = f.Filter([](ULong64_t e) { return e % 20 == 0; }, {"rdfentry_"}, "mult20").Count();
+      auto report = df.Report();
+      EXPECT_EQ(*count, 100u);
+      EXPECT_EQ(*passOdd, 50u);
+      EXPECT_EQ(report->At("mult20").GetAll(), 100u);
+      EXPECT_EQ(*nSelectiveCalls, 1000);
+      return std::make_pair(*nAlwaysPassCalls, ROOT::RDF::SaveGraph(df));
+   };
+
+   const auto declarationOrder = run(0);
+   EXPECT_EQ(declarationOrder.first, 1000);
+   EXPECT_EQ(declarationOrder.second.find("evaluated"), std::string::npos);
+
+   // all filters are evaluated for the first 100 entries, then the selective filter is evaluated first
+   const auto reordered = run(100);
+   EXPECT_EQ(reordered.first, 100 + 90);
+   EXPECT_NE(reordered.second.find("evaluated 1 of 2\\npass 10.0%"), std::string::npos);
+   EXPECT_NE(reordered.second.find("evaluated 2 of 2\\npass 100.0%"), std::string::npos);
+}
+
+TEST(RDFHelpers, SetProfiling)
+{
+   TTree t("t", "t");
+   int x = 0;
+   t.Branch("x", &x);
+   for (x = 0; x < 100; ++x)
+      t.Fill();
+
+   ROOT::RDataFrame df(t);
+   EXPECT_THROW(ROOT::RDF::Experimental::SaveProfile(df), std::runtime_error);
+
+   ROOT::RDF::Experimental::SetProfiling(df);
+   auto sum = df.Filter([](int v) { return v % 2 == 0; }, {"x"}, "even")
+                 .Define("y", [](int v) { return v * 2; }, {"x"})
+                 .Sum<int>("y");
+   EXPECT_EQ(*sum, 4900);
+
+   const auto json = ROOT::RDF::Experimental::SaveProfile(df);
+   EXPECT_NE(json.find("{\"kind\": \"Filter\", \"name\": \"even\", "), std::string::npos);
+   EXPECT_NE(json.find("{\"kind\": \"Define\", \"name\": \"y\", "), std::string::npos);
+   EXPECT_NE(json.find("{\"kind\": \"Action\", \"name\": \"Sum\", "), std::string::npos);
+   // the filter and the define read the same values of x: each entry is counted once
+   EXPECT_NE(json.find("{\"name\": \"x\", \"reads\": 100, \"bytes\": 400, "), std::string::npos);
+
+   const auto trace = ROOT::RDF::Experimental::SaveProfile(df, ROOT::RDF::Experimental::EProfileFormat::kChromeTrace);
+   EXPECT_NE(trace.find("\"name\": \"Event loop\""), std::string::npos);
+   EXPECT_NE(trace.find("\"name\": \"Task\""), std::string::npos);
+   EXPECT_NE(trace.find("\"name\": \"Filter even\""), std::string::npos);
+
+   // the profile of the last profiled event loop is kept
+   ROOT::RDF::Experimental::SetProfiling(df, false);
+   EXPECT_EQ(*df.Count(), 100u);
+   EXPECT_EQ(ROOT::RDF::Experimental::SaveProfile(df), json);
+}
+
+TEST(RDFHelpers, SetJitCacheDir)
+{
+   const std::string cacheDir = "dataframe_helpers_jitcache";
+   const auto countersBefore = ROOT::Internal::RDF::GetJitCacheCounters();
+   ROOT::RDF::Experimental::SetJitCacheDir(cacheDir);
+
+   ROOT::RDataFrame df(10);
+   auto sum = df.Define("x", "int(rdfentry_) * 3 + 1").Filter("x % 2 == 0").Sum<int>("x");
+   EXPECT_EQ(*sum, 4 + 10 + 16 + 22 + 28);
+
+   // a function only known to the interpreter cannot be compiled in a library: it is marked as not cacheable
+   gInterpreter->Declare("int dataframe_helpers_jitcache_interp_only(int x) { return x + 1; }");
+   {
+      ROOT::TestSupport::CheckDiagsRAII diagRAII;
+      diagRAII.requiredDiag(kWarning, "FlushJitCache", "the corresponding jitted expressions will not be cached.",
+                            /*matchFullMessage=*/false);
+      diagRAII.optionalDiag(kError, "ACLiC", "", /*matchFullMessage=*/false);
+      auto sumY = df.Define("y", "dataframe_helpers_jitcache_interp_only(int(rdfentry_))").Sum<int>("y");
+      EXPECT_EQ(*sumY, 55);
+   }
+   ROOT::RDF::Experimental::SetJitCacheDir("");
+
+   const auto counters = ROOT::Internal::RDF::GetJitCacheCounters();
+   EXPECT_EQ(counters.fNLoaded - countersBefore.fNLoaded, 0u);
+   EXPECT_EQ(counters.fNUncacheable - countersBefore.fNUncacheable, 0u);
+   EXPECT_EQ(counters.fNPending - countersBefore.fNPending, 3u);
+
+   // the expressions have been added to the cache: one index entry per expression and one source per event loop
+   int nIndexEntries = 0;
+   int nSources = 0;
+   void *dir = gSystem->OpenDirectory(cacheDir.c_str());
+   ASSERT_NE(dir, nullptr);
+   while (const char *entry = gSystem->GetDirEntry(dir)) {
+      const std::string name = entry;
+      if (name.size() > 7 && name.compare(name.size() - 7, 7, ".rdfjit") == 0)
+         ++nIndexEntries;
+      else if (name.compare(0, 7, "rdfjit_") == 0 && name.compare(name.size() - 2, 2, ".C") == 0)
+         ++nSources;
+   }
+   gSystem->FreeDirectory(dir);
+   EXPECT_EQ(nIndexEntries, 3);
+   EXPECT_EQ(nSources, 2);
+
+   // A second process takes the compiled expressions from the cache and does not try to compile the other one again.
+   // The expressions jitted by this process cannot be looked up in the cache again by this process.
+   const std::string macroName = "dataframe_helpers_jitcache_run.C";
+   {
+      std::ofstream macro(macroName);
+      macro << "int dataframe_helpers_jitcache_interp_only(int x) { return x + 1; }\n"
+            << "void dataframe_helpers_jitcache_run() {\n"
+            << "   ROOT::RDF::Experimental::SetJitCacheDir(\"" << cacheDir << "\");\n"
+            << "   ROOT::RDataFrame df(10);\n"
+            << "   auto sum = df.Define(\"x\", \"int(rdfentry_) * 3 + 1\").Filter(\"x % 2 == 0\").Sum<int>(\"x\");\n"
+            << "   auto sumY = df.Define(\"y\", \"dataframe_helpers_jitcache_interp_only(int(rdfentry_))\")"
+            << ".Sum<int>(\"y\");\n"
+            << "   const auto c = ROOT::Internal::RDF::GetJitCacheCounters();\n"
+            << "   std::cout << \"result: \" << *sum << ' ' << *sumY << ' ' << c.fNLoaded << ' ' << c.fNUncacheable\n"
+            << "             << ' ' << c.fNPending << std::endl;\n"
+            << "}\n";
+   }
+   const std::string cmd = std::string(TROOT::GetBinDir().Data()) + "/root.exe -l -b -q " + macroName;
+   const std::string output = gSystem->GetFromPipe(cmd.c_str()).Data();
+   // two functions loaded from the library, one marked as not cacheable, nothing scheduled to be compiled
+   EXPECT_NE(output.find("result: 80 55 2 1 0"), std::string::npos) << output;
+
+   gSystem->Unlink(macroName.c_str());
+   dir = gSystem->OpenDirectory(cacheDir.c_str());
+   ASSERT_NE(dir, nullptr);
+   std::vector<std::string> toRemove;
+   while (const char *entry = gSystem->GetDirEntry(dir)) {
+      if (strcmp(entry, ".") != 0 && strcmp(entry, "..") != 0)
+         toRemove.emplace_back(cacheDir + "/" + entry);
+   }
+   gSystem->FreeDirectory(dir);
+   for (const auto &path : toRemove)
+      gSystem->Unlink(path.c_str());
+   gSystem->Unlink(cacheDir.c_str());
+}
+
 TEST(RunGraphs, RunGraphs)
 {
 #ifdef R__USE_IMT
@@ -656,6 +841,59 @@ TEST(RunGraphs, RunGraphsWithDisabledIMT)
    EXPECT_EQ(*r2, 3u);
 }
 
+TEST(RunGraphs, FuseGraphs)
+{
+   const auto fname = "dataframe_helpers_fusegraphs.root";
+   ROOT::RDataFrame(10).Define("x", [](ULong64_t e) { return int(e); }, {"rdfentry_"}).Snapshot<int>("t", fname, {"x"});
+
+   // which graph processed each entry, in the order of processing
+   std::vector<int> order;
+   ROOT::RDataFrame df1("t", fname);
+   auto r1 = df1.Filter(
+                   [&order](int x) {
+                      order.push_back(1);
+                      return x < 5;
+                   },
+                   {"x"})
+                .Count();
+   ROOT::RDataFrame df2("t", fname);
+   auto r2 = df2.Define("y",
+                        [&order](int x) {
+                           order.push_back(2);
+                           return x;
+                        },
+                        {"x"})
+                .Sum<int>("y");
+   auto r3 = df2.Filter("x >= 5").Count();
+   // empty sources with a different number of entries are not fused
+   ROOT::RDataFrame df3(3);
+   auto r4 = df3.Count();
+   ROOT::RDataFrame df4(4);
+   auto r5 = df4.Count();
+
+   ROOT::RDF::RunGraphs({r1, r2, r3, r4, r5}, /*fuseGraphs=*/true);
+
+   for (auto *df : {&df1, &df2, &df3, &df4})
+      EXPECT_EQ(df->GetNRuns(), 1u);
+   EXPECT_EQ(*r1, 5u);
+   EXPECT_EQ(*r2, 45);
+   EXPECT_EQ(*r3, 5u);
+   EXPECT_EQ(*r4, 3u);
+   EXPECT_EQ(*r5, 4u);
+   // the two graphs processed each entry in turn: the dataset was traversed once
+   ASSERT_EQ(order.size(), 20u);
+   for (std::size_t i = 0; i < order.size(); i += 2)
+      EXPECT_NE(order[i], order[i + 1]) << i;
+
+   // the fused graphs can still run their own event loops afterwards
+   auto r6 = df2.Max<int>("x");
+   EXPECT_EQ(*r6, 9);
+   EXPECT_EQ(df1.GetNRuns(), 1u);
+   EXPECT_EQ(df2.GetNRuns(), 2u);
+
+   gSystem->Unlink(fname);
+}
+
 TEST(RunGraphs, EmptyListOfHandles)
 {
 #ifdef R__USE_IMT
@@ -2,12 +2,15 @@
 #include <ROOT/RArrowDS.hxx>
 #include <ROOT/TSeq.hxx>
 #include <TROOT.h>
+#include <TSystem.h>
 
 #if defined(__GNUC__)
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wshadow"
 #endif
 #include <arrow/builder.h>
+#include <arrow/io/file.h>
+#include <arrow/ipc/writer.h>
 #include <arrow/memory_pool.h>
 #include <arrow/record_batch.h>
 #include <arrow/table.h>
@@ -113,6 +116,24 @@ TEST(RArrowDS, EntryRanges)
    EXPECT_EQ(6U, ranges[2].second);
 }
 
+TEST(RArrowDS, EntryRangesChunks)
+{
+   // one range per chunk if all columns share the same chunks
+   auto table = createTestTable();
+   auto chunkedTable = arrow::ConcatenateTables({table->Slice(0, 2), table->Slice(2, 4)}).ValueOrDie();
+   RArrowDS tds(chunkedTable, {"Age", "Name"});
+   tds.SetNSlots(3U);
+   tds.Initialize();
+
+   auto ranges = tds.GetEntryRanges();
+
+   ASSERT_EQ(2U, ranges.size());
+   EXPECT_EQ(0U, ranges[0].first);
+   EXPECT_EQ(2U, ranges[0].second);
+   EXPECT_EQ(2U, ranges[1].first);
+   EXPECT_EQ(6U, ranges[1].second);
+}
+
 TEST(RArrowDS, ColumnReaders)
 {
    RArrowDS tds(createTestTable(), {});
@@ -202,6 +223,37 @@ TEST(RArrowDS, FromARDFWithJitting)
    EXPECT_EQ(40, *min);
 }
 
+TEST(RArrowDS, FromArrowFile)
+{
+   const auto fname = "datasource_arrow_fromarrowfile.arrow";
+   {
+      auto table = createTestTable();
+      auto out = arrow::io::FileOutputStream::Open(fname).ValueOrDie();
+      auto writer = arrow::ipc::MakeFileWriter(out, table->schema()).ValueOrDie();
+      ASSERT_TRUE(writer->WriteTable(*table, /*max_chunksize=*/4).ok());
+      ASSERT_TRUE(writer->Close().ok());
+      ASSERT_TRUE(out->Close().ok());
+   }
+
+   {
+      auto rdf = FromArrowFile(fname, {"Height", "Age"});
+      // only the requested columns are read
+      EXPECT_EQ(rdf.GetColumnNames(), std::vector<std::string>({"Age", "Height"}));
+      auto max = rdf.Max<double>("Height");
+      auto sum = rdf.Sum<Long64_t>("Age");
+      auto c = rdf.Count();
+
+      EXPECT_EQ(6U, *c);
+      EXPECT_DOUBLE_EQ(200.5, *max);
+      EXPECT_EQ(186, *sum);
+   }
+
+   EXPECT_THROW(FromArrowFile(fname, {"Address"}), std::runtime_error);
+   EXPECT_THROW(FromArrowFile("does_not_exist.arrow", {}), std::runtime_error);
+
+   gSystem->Unlink(fname);
+}
+
 // NOW MT!-------------
 #ifdef R__USE_IMT
 
@@ -3,9 +3,13 @@
 #include <ROOT/TSeq.hxx>
 #include <ROOT/TestSupport.hxx>
 #include <TROOT.h>
+#include <TSystem.h>
 
 #include <gtest/gtest.h>
 
+#include <cmath>
+#include <fstream>
+
 using namespace ROOT::RDF;
 
 auto fileName0 = "RCsvDS_test_headers.csv";
@@ -320,6 +324,46 @@ TEST(RCsvDS, ProgressiveReadingRDFMT)
    EXPECT_EQ(6U, *c2);
 }
 
+TEST(RCsvDS, ParallelParsingMT)
+{
+   // enough lines to be parsed by several tasks, with quoted and unquoted lines and empty cells
+   const auto fname = "RCsvDS_test_parallelparsing.csv";
+   const auto nLines = 10000ll;
+   {
+      std::ofstream f(fname);
+      f << "x,y,s\n";
+      for (auto i = 0ll; i < nLines; ++i) {
+         if (i % 3 == 0)
+            f << i << ",\"" << std::to_string(0.5 * i) << "\",\"a, \"\"b\"\"\"\n";
+         else
+            f << i << ',' << (i % 7 == 0 ? "" : std::to_string(0.5 * i)) << ",c\n";
+      }
+   }
+
+   for (auto chunkSize : {-1ll, 3000ll}) {
+      auto df = ROOT::RDF::FromCSV(fname, true, ',', chunkSize);
+      auto sumX = df.Sum<Long64_t>("x");
+      auto sumY = df.Filter([](double y) { return !std::isnan(y); }, {"y"}).Sum<double>("y");
+      auto nQuoted = df.Filter([](const std::string &s) { return s == "a, \"b\""; }, {"s"}).Count();
+      auto nEmpty = df.Filter([](double y) { return std::isnan(y); }, {"y"}).Count();
+
+      double expectedSumY = 0.;
+      ULong64_t expectedNEmpty = 0ull;
+      for (auto i = 0ll; i < nLines; ++i) {
+         if (i % 3 != 0 && i % 7 == 0)
+            ++expectedNEmpty;
+         else
+            expectedSumY += 0.5 * i;
+      }
+      EXPECT_EQ(*sumX, nLines * (nLines - 1) / 2);
+      EXPECT_DOUBLE_EQ(*sumY, expectedSumY);
+      EXPECT_EQ(*nQuoted, ULong64_t((nLines + 2) / 3));
+      EXPECT_EQ(*nEmpty, expectedNEmpty);
+   }
+
+   gSystem->Unlink(fname);
+}
+
 TEST(RCsvDS, SpecifyColumnTypes)
 {
    RCsvDS tds0(fileName0, true, ',', -1LL, {{"Age", 'D'}, {"Name", 'T'}}); // with headers
@@ -8,7 +8,10 @@
 
 #include <gtest/gtest.h>
 
+#include <limits>
+
 using ROOT::Experimental::RNTupleDS;
+using ROOT::Experimental::RNTupleReader;
 using ROOT::Experimental::RNTupleWriter;
 using ROOT::Experimental::RNTupleModel;
 using ROOT::Experimental::Detail::RPageSource;
@@ -124,6 +127,72 @@ TEST_F(RNTupleDSTest, Read)
    ReadTest(fNtplName, fFileName);
 }
 
+void SnapshotTest(const std::string &fname)
+{
+   ROOT::RDF::RSnapshotOptions opts;
+   opts.fOutputFormat = ROOT::RDF::ESnapshotOutputFormat::kRNTuple;
+   opts.fAutoFlush = 10;
+   auto df = ROOT::RDataFrame(100)
+                .Define("x", [](ULong64_t e) { return int(e); }, {"rdfentry_"})
+                .Define("v", [](int x) { return ROOT::RVecF(x % 3, x); }, {"x"});
+   auto out = df.Snapshot<int, ROOT::RVecF>("ntuple", fname, {"x", "v"}, opts);
+
+   EXPECT_EQ(100ull, *out->Count());
+   EXPECT_EQ(4950, *out->Sum<int>("x"));
+   auto checkV = [](int x, const ROOT::RVecF &v) { return v.size() == std::size_t(x % 3) && All(v == float(x)); };
+   EXPECT_EQ(100ull, *out->Filter(checkV, {"x", "v"}).Count());
+
+   auto reader = RNTupleReader::Open("ntuple", fname);
+   EXPECT_EQ(100u, reader->GetNEntries());
+   EXPECT_LE(10u, reader->GetDescriptor()->GetNClusters());
+   EXPECT_EQ("ROOT::VecOps::RVec<float>", reader->GetModel()->GetField("v")->GetType());
+
+   // the types of the fields are inferred if not specified
+   auto outJitted = df.Define("y", "x * 0.5").Snapshot("ntuple", fname, {"x", "y"}, opts);
+   EXPECT_EQ(2475., *outJitted->Sum<double>("y"));
+}
+
+TEST_F(RNTupleDSTest, Snapshot)
+{
+   const std::string fname = "RNTupleDS_test_snapshot.root";
+   SnapshotTest(fname);
+   std::remove(fname.c_str());
+}
+
+TEST(RNTupleDS, ValueRangeCuts)
+{
+   const std::string fileName = "RNTupleDS_test_valuerangecuts.root";
+   {
+      auto model = RNTupleModel::Create();
+      auto wrPt = model->MakeField<float>("pt");
+      ROOT::Experimental::RNTupleWriteOptions options;
+      options.SetHasPageStatistics(true);
+      options.SetApproxUnzippedPageSize(200);
+      auto ntuple = RNTupleWriter::Recreate(std::move(model), "ntuple", fileName, options);
+      for (int i = 0; i < 200; i++) {
+         *wrPt = static_cast<float>(i);
+         ntuple->Fill();
+         if (i == 99)
+            ntuple->CommitCluster();
+      }
+   }
+
+   auto ds = std::make_unique<RNTupleDS>(RPageSource::Create("ntuple", fileName));
+   ds->SetValueRangeCuts({{"pt", 175., std::numeric_limits<double>::infinity()}});
+   ROOT::RDataFrame df(std::move(ds));
+   auto nProcessed = df.Count();
+   auto nPassed = df.Filter([](float pt) { return pt >= 175.f; }, {"pt"}).Count();
+   auto minPt = df.Min<float>("pt");
+   // the first cluster is skipped as a whole; in the second cluster, only the pages that contain pt >= 175 are read
+   EXPECT_EQ(25u, *nPassed);
+   EXPECT_LT(*nProcessed, 100u);
+   EXPECT_GE(*nProcessed, 25u);
+   EXPECT_GT(*minPt, 100.f);
+   EXPECT_LE(*minPt, 175.f);
+
+   std::remove(fileName.c_str());
+}
+
 #ifdef R__USE_IMT
 struct IMTRAII {
    IMTRAII() { ROOT::EnableImplicitMT(); }
@@ -136,4 +205,13 @@ TEST_F(RNTupleDSTest, ReadMT)
 
    ReadTest(fNtplName, fFileName);
 }
+
+TEST_F(RNTupleDSTest, SnapshotMT)
+{
+   IMTRAII _;
+
+   const std::string fname = "RNTupleDS_test_snapshotmt.root";
+   SnapshotTest(fname);
+   std::remove(fname.c_str());
+}
 #endif
@@ -212,6 +212,11 @@ protected:
    /// Called by `ConnectPageSource()` only once connected; derived classes may override this
    /// as appropriate
    virtual void OnConnectPageSource() {}
+   /// Called by `ConnectPageSink()` before the columns are connected.  `firstElementIndex` is the number of items
+   /// written before the field was added (late model extension); the return value is used as the first element index
+   /// of the principal column.  Derived classes whose principal column does not have one element per item may
+   /// override this.
+   virtual NTupleSize_t OnConnectPageSink(NTupleSize_t firstElementIndex) { return firstElementIndex; }
    /// When connecting a field to a page sink, the field's default column representation is subject
    /// to adjustment according to the write options. E.g., if compression is turned off, encoded columns
    /// are changed to their unencoded counterparts.
@@ -825,6 +830,9 @@ public:
 /// representation.  The on-disk representation can be "dense" or "sparse". Dense nullable fields have a bitmask
 /// (true: item available, false: item missing) and serialize a default-constructed item for missing items.
 /// Sparse nullable fields use a (Split)Index[64|32] column to point to the available items.
+/// Entry-list nullable fields use a (Split)UInt64 column that only stores the global indexes of the available items.
+/// Unlike the other representations, no element is written for missing items, which makes it the representation of
+/// choice for fields that are almost always empty.
 /// By default, items whose size is smaller or equal to 4 bytes (size of (Split)Index32 column element) are stored
 /// densely.
 class RNullableField : public Detail::RFieldBase {
@@ -832,11 +840,27 @@ class RNullableField : public Detail::RFieldBase {
    Detail::RFieldValue fDefaultItemValue;
    /// For a sparse nullable field, the number of written non-null items in this cluster
    ClusterSize_t fNWritten{0};
+   /// For an entry-list nullable field, the global index of the next item to be written
+   NTupleSize_t fNextIndex = 0;
+   /// For an entry-list nullable field, the lower bound found by the previous call to `GetItemIndex()`.
+   /// Used to avoid a binary search through the index column when reading sequentially.
+   NTupleSize_t fItemHint = 0;
+   /// For an entry-list nullable field, the index column range [fClusterFirstItem, fClusterEndItem) of the cluster
+   /// that contains the previous lower bound.  Lookups within this cluster only search its range.
+   NTupleSize_t fClusterFirstItem = 0;
+   NTupleSize_t fClusterEndItem = 0;
+
+   /// For an entry-list nullable field, sets the current cluster range to the one containing the given item
+   void SetItemCluster(NTupleSize_t itemIndex);
+   /// For an entry-list nullable field, returns the position of the first available item whose global index is
+   /// larger or equal than `globalIndex`
+   NTupleSize_t FindItem(NTupleSize_t globalIndex);
 
 protected:
    const Detail::RFieldBase::RColumnRepresentations &GetColumnRepresentations() const final;
    void GenerateColumnsImpl() final;
    void GenerateColumnsImpl(const RNTupleDescriptor &) final;
+   NTupleSize_t OnConnectPageSink(NTupleSize_t firstElementIndex) final;
 
    std::size_t AppendNull();
    std::size_t AppendValue(const Detail::RFieldValue &value);
@@ -852,9 +876,19 @@ public:
    ~RNullableField() override;
 
    bool IsDense() const { return GetColumnRepresentative()[0] ==  EColumnType::kBit; }
-   bool IsSparse() const { return !IsDense(); }
+   bool IsEntryList() const
+   {
+      return GetColumnRepresentative()[0] == EColumnType::kSplitUInt64 ||
+             GetColumnRepresentative()[0] == EColumnType::kUInt64;
+   }
+   bool IsSparse() const { return !IsDense() && !IsEntryList(); }
    void SetDense() { SetColumnRepresentative({EColumnType::kBit}); }
    void SetSparse() { SetColumnRepresentative({EColumnType::kSplitIndex32}); }
+   void SetEntryList() { SetColumnRepresentative({EColumnType::kSplitUInt64}); }
+
+   /// Returns the global indexes of the available items in the range [first, last). For entry-list nullable fields,
+   /// only the index column is read, i.e. the cost is proportional to the number of available items.
+   std::vector<NTupleSize_t> GetNonNullIndexes(NTupleSize_t first, NTupleSize_t last);
 
    void CommitCluster() final { fNWritten = 0; }
 
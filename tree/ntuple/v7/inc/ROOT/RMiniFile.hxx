@@ -135,6 +135,9 @@ A stand-alone version of RNTuple can remove the TFile based writer.
 // clang-format on
 class RNTupleFileWriter {
 private:
+   /// Performs the writes of an RFileSimple in a background thread, see EnableAsyncWrite()
+   class RAsyncWriter;
+
    struct RFileProper {
       TFile *fFile = nullptr;
       /// Low-level writing using a TFile
@@ -151,6 +154,8 @@ private:
       std::uint64_t fFilePos = 0;
       /// Keeps track of TFile control structures, which need to be updated on committing the data set
       std::unique_ptr<ROOT::Experimental::Internal::RTFileControlBlock> fControlBlock;
+      /// If set, the writes are queued to a background thread and fFilePos is the logical position of the stream
+      std::unique_ptr<RAsyncWriter> fAsyncWriter;
 
       RFileSimple() = default;
       RFileSimple(const RFileSimple &other) = delete;
@@ -161,6 +166,8 @@ private:
 
       /// Writes bytes in the open stream, either at fFilePos or at the given offset
       void Write(const void *buffer, size_t nbytes, std::int64_t offset = -1);
+      /// Waits for the outstanding asynchronous writes and flushes the stream
+      void Flush();
       /// Writes a TKey including the data record, given by buffer, into fFile; returns the file offset to the payload.
       /// The payload is already compressed
       std::uint64_t WriteKey(const void *buffer, std::size_t nbytes, std::size_t len, std::int64_t offset = -1,
@@ -227,6 +234,10 @@ public:
    std::uint64_t WriteBlob(const void *data, size_t nbytes, size_t len);
    /// Writes the RNTuple key to the file so that the header and footer keys can be found
    void Commit();
+   /// Subsequent writes to a file written by a C file stream are copied and performed by a background thread, so that
+   /// the caller does not block on the write system calls. At most `maxInFlightBytes` are queued at any time.
+   /// Writing through a TFile object is not affected.
+   void EnableAsyncWrite(std::size_t maxInFlightBytes);
 };
 
 } // namespace Internal
@@ -34,6 +34,7 @@
 #include <memory>
 #include <sstream>
 #include <utility>
+#include <vector>
 
 class TFile;
 
@@ -275,6 +276,27 @@ public:
    /// ~~~
    RNTupleGlobalRange GetEntryRange() { return RNTupleGlobalRange(0, GetNEntries()); }
 
+   /// Returns the entry ranges that may contain entries passing all the given value range cuts. The cuts are
+   /// evaluated against the min/max statistics of the clusters and pages (see
+   /// RNTupleWriteOptions::SetHasPageStatistics()), so that clusters and pages that cannot match are skipped.
+   /// Entries inside the returned ranges still need to be checked.
+   ///
+   /// **Example: iterate only over the pages that can contain entries with pt > 50**
+   /// ~~~ {.cpp}
+   /// #include <ROOT/RNTuple.hxx>
+   /// using ROOT::Experimental::RNTupleReader;
+   ///
+   /// auto ntuple = RNTupleReader::Open("myNTuple", "some/file.root");
+   /// auto pt = ntuple->GetView<float>("pt");
+   /// for (auto range : ntuple->GetEntryRanges({{"pt", 50., std::numeric_limits<double>::infinity()}})) {
+   ///    for (auto i : range) {
+   ///       if (pt(i) > 50.)
+   ///          ntuple->Show(i);
+   ///    }
+   /// }
+   /// ~~~
+   std::vector<RNTupleGlobalRange> GetEntryRanges(const std::vector<RNTupleDescriptor::RValueRangeCut> &cuts);
+
    /// Provides access to an individual field that can contain either a scalar value or a collection, e.g.
    /// GetView<double>("particles.pt") or GetView<std::vector<double>>("particle").  It can as well be the index
    /// field of a collection itself, like GetView<NTupleSize_t>("particle").
@@ -28,6 +28,7 @@
 #include <chrono>
 #include <functional>
 #include <iterator>
+#include <limits>
 #include <map>
 #include <memory>
 #include <ostream>
@@ -35,6 +36,7 @@
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 
 namespace ROOT {
 namespace Experimental {
@@ -212,6 +214,37 @@ class RClusterDescriptor {
    friend class RClusterDescriptorBuilder;
 
 public:
+   /// Summary of the values of a numerical column in a page or in a cluster. Statistics are optional; they are only
+   /// available if the ntuple was written with RNTupleWriteOptions::SetHasPageStatistics(). Integer values are
+   /// stored as doubles; values that cannot be represented exactly widen the [fMin, fMax] interval.
+   struct RStatistics {
+      /// If false, nothing is known about the values and MayContain() always returns true
+      bool fIsAvailable = false;
+      double fMin = std::numeric_limits<double>::infinity();
+      double fMax = -std::numeric_limits<double>::infinity();
+      /// The number of elements that are not covered by [fMin, fMax], i.e. NaN values of floating-point columns
+      std::uint64_t fNNulls = 0;
+
+      bool operator==(const RStatistics &other) const
+      {
+         if (fIsAvailable != other.fIsAvailable)
+            return false;
+         return !fIsAvailable || (fMin == other.fMin && fMax == other.fMax && fNNulls == other.fNNulls);
+      }
+
+      /// Returns false only if none of the summarized values can be in the closed interval [min, max]
+      bool MayContain(double min, double max) const { return !fIsAvailable || (fMin <= max && fMax >= min); }
+
+      /// Combines the statistics of two value sets; the result is only available if both inputs are available
+      void Merge(const RStatistics &other)
+      {
+         fIsAvailable = fIsAvailable && other.fIsAvailable;
+         fMin = std::min(fMin, other.fMin);
+         fMax = std::max(fMax, other.fMax);
+         fNNulls += other.fNNulls;
+      }
+   };
+
    /// The window of element indexes of a particular column in a particular cluster
    struct RColumnRange {
       DescriptorId_t fPhysicalColumnId = kInvalidDescriptorId;
@@ -222,9 +255,9 @@ public:
       /// The usual format for ROOT compression settings (see Compression.h).
       /// The pages of a particular column in a particular cluster are all compressed with the same settings.
       std::int64_t fCompressionSettings = 0;
-
-      // TODO(jblomer): we perhaps want to store summary information, such as average, min/max, etc.
-      // Should this be done on the field level?
+      /// The merged statistics of all the pages of the column in the cluster; not stored on disk but computed
+      /// from the page statistics when the column range is committed.
+      RStatistics fStatistics{};
 
       bool operator==(const RColumnRange &other) const {
          return fPhysicalColumnId == other.fPhysicalColumnId && fFirstElementIndex == other.fFirstElementIndex &&
@@ -245,9 +278,11 @@ public:
          std::uint32_t fNElements = std::uint32_t(-1);
          /// The meaning of fLocator depends on the storage backend.
          RNTupleLocator fLocator;
+         /// Optional min/max summary of the page values, used to skip pages that cannot match a selection
+         RStatistics fStatistics{};
 
          bool operator==(const RPageInfo &other) const {
-            return fNElements == other.fNElements && fLocator == other.fLocator;
+            return fNElements == other.fNElements && fLocator == other.fLocator && fStatistics == other.fStatistics;
          }
       };
       struct RPageInfoExtended : RPageInfo {
@@ -443,6 +478,14 @@ private:
    std::unique_ptr<RHeaderExtension> fHeaderExtension;
 
 public:
+   /// A cut on the values of a numerical field that can be evaluated against the page statistics, e.g.
+   /// `{"pt", 20., std::numeric_limits<double>::infinity()}`. Entries pass the cut if fMin <= value <= fMax.
+   struct RValueRangeCut {
+      std::string fFieldName;
+      double fMin = -std::numeric_limits<double>::infinity();
+      double fMax = std::numeric_limits<double>::infinity();
+   };
+
    // clang-format off
    /**
    \class ROOT::Experimental::RNTupleDescriptor::RHeaderExtension
@@ -775,6 +818,14 @@ public:
    DescriptorId_t FindNextClusterId(DescriptorId_t clusterId) const;
    DescriptorId_t FindPrevClusterId(DescriptorId_t clusterId) const;
 
+   /// Returns the sorted, non-overlapping entry ranges [first, last) of the clusters and pages that may contain
+   /// entries passing all the given cuts. Entries outside the returned ranges are guaranteed to fail at least one of
+   /// the cuts; entries inside the ranges still need to be checked. The selection uses the page statistics and thus
+   /// requires the page locations of the clusters. Fields without statistics do not restrict the entry ranges.
+   /// Throws an RException if a field does not exist or if its values do not map one-to-one to the entries, i.e.
+   /// cuts are supported on numerical fields that are not (part of) a collection.
+   std::vector<std::pair<NTupleSize_t, NTupleSize_t>> FindEntryRanges(const std::vector<RValueRangeCut> &cuts) const;
+
    /// Walks up the parents of the field ID and returns a field name of the form a.b.c.d
    /// In case of invalid field ID, an empty string is returned.
    std::string GetQualifiedFieldName(DescriptorId_t fieldId) const;
@@ -61,9 +61,15 @@ protected:
    /// fApproxUnzippedPageSize/2 and fApproxUnzippedPageSize * 1.5 in size.
    std::size_t fApproxUnzippedPageSize = 64 * 1024;
    bool fUseBufferedWrite = true;
+   /// If set, pages are written by a background thread so that the compression of the next cluster overlaps with
+   /// writing the previous one. Only applies to files written by a C file stream (i.e., not through a TFile object).
+   bool fUseAsyncWrite = false;
    /// If set, 64bit index columns are replaced by 32bit index columns. This limits the cluster size to 512MB
    /// but it can result in smaller file sizes for data sets with many collections and lz4 or no compression.
    bool fHasSmallClusters = false;
+   /// If set, the page list stores the minimum and maximum value (and the number of NaN values) of every page of
+   /// numerical columns. Readers can use these statistics to skip clusters and pages that cannot pass a selection.
+   bool fHasPageStatistics = false;
 
 public:
    /// A maximum size of 512MB still allows for a vector of bool to be stored in a small cluster.  This is the
@@ -95,8 +101,14 @@ public:
    bool GetUseBufferedWrite() const { return fUseBufferedWrite; }
    void SetUseBufferedWrite(bool val) { fUseBufferedWrite = val; }
 
+   bool GetUseAsyncWrite() const { return fUseAsyncWrite; }
+   void SetUseAsyncWrite(bool val) { fUseAsyncWrite = val; }
+
    bool GetHasSmallClusters() const { return fHasSmallClusters; }
    void SetHasSmallClusters(bool val) { fHasSmallClusters = val; }
+
+   bool GetHasPageStatistics() const { return fHasPageStatistics; }
+   void SetHasPageStatistics(bool val) { fHasPageStatistics = val; }
 };
 
 // clang-format off
@@ -151,12 +163,17 @@ public:
 private:
    EClusterCache fClusterCache = EClusterCache::kDefault;
    unsigned int fClusterBunchSize = 1;
+   /// If set, unzipped pages are shared through the process-wide RSharedPageCache with all other page sources
+   /// reading the same ntuple, e.g. the clones of a page source that are used by different threads
+   bool fUseSharedPageCache = false;
 
 public:
    EClusterCache GetClusterCache() const { return fClusterCache; }
    void SetClusterCache(EClusterCache val) { fClusterCache = val; }
    unsigned int GetClusterBunchSize() const  { return fClusterBunchSize; }
    void SetClusterBunchSize(unsigned int val) { fClusterBunchSize = val; }
+   bool GetUseSharedPageCache() const { return fUseSharedPageCache; }
+   void SetUseSharedPageCache(bool val) { fUseSharedPageCache = val; }
 };
 
 } // namespace Experimental
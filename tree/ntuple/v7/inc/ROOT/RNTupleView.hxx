@@ -25,6 +25,7 @@
 #include <type_traits>
 #include <utility>
 #include <unordered_map>
+#include <vector>
 
 namespace ROOT {
 namespace Experimental {
@@ -209,6 +210,14 @@ public:
    {
       return fField.MapV(clusterIndex, nItems);
    }
+
+   /// For nullable fields, e.g. `std::unique_ptr<T>`, returns the global indexes in [first, last) for which a value
+   /// is present.  Combined with an entry-list representation, this allows for iterating over the present values only.
+   template <typename C = T, std::enable_if_t<std::is_base_of_v<RNullableField, RField<C>>, C *> = nullptr>
+   std::vector<NTupleSize_t> GetNonNullIndexes(NTupleSize_t first, NTupleSize_t last)
+   {
+      return fField.GetNonNullIndexes(first, last);
+   }
 };
 
 
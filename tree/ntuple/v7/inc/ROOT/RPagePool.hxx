@@ -21,7 +21,12 @@
 #include <ROOT/RNTupleUtil.hxx>
 
 #include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
 #include <mutex>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace ROOT {
@@ -77,6 +82,106 @@ public:
    void ReturnPage(const RPage &page);
 };
 
+// clang-format off
+/**
+\class ROOT::Experimental::Detail::RSharedPageCache
+\ingroup NTuple
+\brief A process-wide, reference-counted cache of unzipped page buffers
+
+Page sources that read the same ntuple, such as the clones of a page source used by different threads, can share
+unzipped pages through this cache instead of decompressing the same pages repeatedly. Pages are identified by the
+storage (e.g., the file URL and the ntuple name), the physical column id, the cluster id and the page number in the
+cluster. Page buffers that are in use are never evicted. Unused page buffers are kept until the memory budget is
+exceeded, in which case the least recently used ones are freed.
+
+The per-source RPagePool keeps track of the page windows and hands out pages whose buffers are owned by the cache.
+*/
+// clang-format on
+class RSharedPageCache {
+public:
+   struct RKey {
+      std::uint64_t fStorageId = 0;
+      DescriptorId_t fPhysicalColumnId = kInvalidDescriptorId;
+      DescriptorId_t fClusterId = kInvalidDescriptorId;
+      NTupleSize_t fPageNo = 0;
+
+      RKey() = default;
+      RKey(std::uint64_t storageId, DescriptorId_t physicalColumnId, DescriptorId_t clusterId, NTupleSize_t pageNo)
+         : fStorageId(storageId), fPhysicalColumnId(physicalColumnId), fClusterId(clusterId), fPageNo(pageNo)
+      {
+      }
+      bool operator==(const RKey &other) const
+      {
+         return fStorageId == other.fStorageId && fPhysicalColumnId == other.fPhysicalColumnId &&
+                fClusterId == other.fClusterId && fPageNo == other.fPageNo;
+      }
+   };
+
+   /// By default, unused pages are kept up to a total of 256MB
+   static constexpr std::size_t kDefaultMemoryBudget = 256 * 1024 * 1024;
+
+private:
+   struct RKeyHash {
+      std::size_t operator()(const RKey &key) const
+      {
+         std::size_t h = std::hash<std::uint64_t>()(key.fStorageId);
+         h = h * 31 + std::hash<DescriptorId_t>()(key.fPhysicalColumnId);
+         h = h * 31 + std::hash<DescriptorId_t>()(key.fClusterId);
+         return h * 31 + std::hash<NTupleSize_t>()(key.fPageNo);
+      }
+   };
+
+   struct REntry {
+      std::unique_ptr<unsigned char[]> fBuffer;
+      std::size_t fNBytes = 0;
+      std::int32_t fReferences = 0;
+      /// Position in fUnused if the entry is not referenced
+      std::list<RKey>::iterator fUnusedPos;
+   };
+
+   std::unordered_map<RKey, REntry, RKeyHash> fEntries;
+   /// Keys of the entries with zero references, least recently used first
+   std::list<RKey> fUnused;
+   /// Maps the storage identity to the storage id used in the page keys
+   std::unordered_map<std::string, std::uint64_t> fStorageIds;
+   std::size_t fMemoryBudget = kDefaultMemoryBudget;
+   std::size_t fMemoryUsage = 0;
+   std::mutex fLock;
+
+   RSharedPageCache() = default;
+   /// Frees unused entries until the memory usage fits the budget. The lock must be held by the caller.
+   void EvictUnused();
+
+public:
+   RSharedPageCache(const RSharedPageCache &) = delete;
+   RSharedPageCache &operator=(const RSharedPageCache &) = delete;
+   ~RSharedPageCache() = default;
+
+   static RSharedPageCache &Instance();
+
+   /// Returns the id for the given storage identity, e.g. "<file URL>:<ntuple name>". Identical identities
+   /// result in identical ids.
+   std::uint64_t GetStorageId(const std::string &identity);
+
+   /// Returns true if the page is in the cache, without changing its reference counter
+   bool Contains(const RKey &key);
+   /// Returns the buffer of the page and increases its reference counter, or nullptr if the page is not cached
+   unsigned char *Acquire(const RKey &key);
+   /// Hands over the ownership of an unzipped page buffer. If the page is already in the cache, the given buffer is
+   /// freed and the cached buffer is used instead. Returns the cached buffer; if `acquire` is true, its reference
+   /// counter is increased, otherwise the page is immediately eligible for eviction.
+   unsigned char *Insert(const RKey &key, std::unique_ptr<unsigned char[]> buffer, std::size_t nbytes, bool acquire);
+   /// Decreases the reference counter of a page obtained by Acquire() or Insert()
+   void Release(const RKey &key);
+   /// Evicts all the pages that are not in use
+   void Clear();
+
+   std::size_t GetMemoryBudget() const { return fMemoryBudget; }
+   void SetMemoryBudget(std::size_t budget);
+   /// The total size of the cached page buffers, both in use and unused
+   std::size_t GetMemoryUsage();
+};
+
 } // namespace Detail
 
 } // namespace Experimental
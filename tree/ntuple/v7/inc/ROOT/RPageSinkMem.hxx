@@ -0,0 +1,86 @@
+/// \file ROOT/RPageSinkMem.hxx
+/// \ingroup NTuple ROOT7
+/// \date 2026-10-18
+/// \warning This is part of the ROOT 7 prototype! It will change without notice. It might trigger earthquakes. Feedback
+/// is welcome!
+
+/*************************************************************************
+ * Copyright (C) 1995-2023, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT7_RPageSinkMem
+#define ROOT7_RPageSinkMem
+
+#include <ROOT/RNTupleUtil.hxx>
+#include <ROOT/RPageStorage.hxx>
+#include <ROOT/RStringView.hxx>
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <vector>
+
+namespace ROOT {
+namespace Experimental {
+namespace Detail {
+
+// clang-format off
+/**
+\class ROOT::Experimental::Detail::RPageSinkMem
+\ingroup NTuple
+\brief Keeps the sealed pages of the committed clusters in memory
+
+Used to fill parts of an RNTuple concurrently: every writer fills its own RPageSinkMem, which compresses the pages
+of the writer's clusters and keeps them in memory. The clusters are then appended one by one, in any order, to the
+page sink of the output RNTuple with CommitSealedCluster(), without compressing the pages again. All the writers
+must use models with the same fields, in the same order, as the model of the output RNTuple.
+*/
+// clang-format on
+class RPageSinkMem : public RPageSink {
+public:
+   /// The sealed pages of a committed cluster
+   struct RSealedCluster {
+      NTupleSize_t fNEntries = 0;
+      /// Indexed by physical column id
+      std::vector<RPageStorage::SealedPageSequence_t> fSealedPages;
+      /// Owns the memory of the sealed pages
+      std::vector<std::unique_ptr<unsigned char[]>> fBuffers;
+   };
+
+private:
+   RSealedCluster fOpenCluster;
+   std::deque<RSealedCluster> &fClusters;
+   std::uint64_t fNBytesCurrentCluster = 0;
+
+protected:
+   void CreateImpl(const RNTupleModel &, unsigned char *, std::uint32_t) final {}
+   RNTupleLocator CommitPageImpl(ColumnHandle_t columnHandle, const RPage &page) final;
+   RNTupleLocator CommitSealedPageImpl(DescriptorId_t physicalColumnId, const RSealedPage &sealedPage) final;
+   std::uint64_t CommitClusterImpl(NTupleSize_t nEntries) final;
+   RNTupleLocator CommitClusterGroupImpl(unsigned char *, std::uint32_t) final { return RNTupleLocator(); }
+   void CommitDatasetImpl(unsigned char *, std::uint32_t) final {}
+
+public:
+   /// The committed clusters are appended to `clusters`
+   RPageSinkMem(std::string_view ntupleName, const RNTupleWriteOptions &options, std::deque<RSealedCluster> &clusters);
+   RPageSinkMem(const RPageSinkMem &) = delete;
+   RPageSinkMem &operator=(const RPageSinkMem &) = delete;
+   ~RPageSinkMem() override = default;
+
+   RPage ReservePage(ColumnHandle_t columnHandle, std::size_t nElements) final;
+   void ReleasePage(RPage &page) final;
+
+   /// Writes the sealed pages of `cluster` to `sink` and commits them as a new cluster of `sink`. `nEntries` is the
+   /// number of entries committed to `sink` so far; it is increased by the number of entries of the cluster.
+   static void CommitSealedCluster(const RSealedCluster &cluster, RPageSink &sink, NTupleSize_t &nEntries);
+};
+
+} // namespace Detail
+} // namespace Experimental
+} // namespace ROOT
+
+#endif
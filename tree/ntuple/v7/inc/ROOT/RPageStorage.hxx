@@ -88,6 +88,8 @@ public:
       const void *fBuffer = nullptr;
       std::uint32_t fSize = 0;
       std::uint32_t fNElements = 0;
+      /// Optional page statistics that are recorded in the page list when the sealed page is committed
+      RClusterDescriptor::RStatistics fStatistics;
 
       RSealedPage() = default;
       RSealedPage(const void *b, std::uint32_t s, std::uint32_t n) : fBuffer(b), fSize(s), fNElements(n) {}
@@ -209,6 +211,9 @@ protected:
    /// Keeps track of the written pages in the currently open cluster. Indexed by column id.
    std::vector<RClusterDescriptor::RPageRange> fOpenPageRanges;
    RNTupleDescriptorBuilder fDescriptorBuilder;
+   /// Whether CommitPage() computes the page statistics; initialized from the write options. Wrapper sinks that
+   /// forward the pages to an inner sink can disable it.
+   bool fComputePageStatistics = false;
 
    virtual void CreateImpl(const RNTupleModel &model, unsigned char *serializedHeader, std::uint32_t length) = 0;
    virtual RNTupleLocator CommitPageImpl(ColumnHandle_t columnHandle, const RPage &page) = 0;
@@ -239,6 +244,10 @@ protected:
    static RSealedPage SealPage(const RPage &page, const RColumnElementBase &element,
       int compressionSetting, void *buf);
 
+   /// Computes the min/max statistics of an in-memory page of the given column. For columns of non-numerical type,
+   /// such as index and switch columns, the returned statistics are marked as unavailable.
+   static RClusterDescriptor::RStatistics ComputeStatistics(const RPage &page, const RColumn &column);
+
    /// Enables the default set of metrics provided by RPageSink. `prefix` will be used as the prefix for
    /// the counters registered in the internal RNTupleMetrics object.
    /// This set of counters can be extended by a subclass by calling `fMetrics.MakeCounter<...>()`.
@@ -142,9 +142,14 @@ private:
    RNTupleDescriptorBuilder fDescriptorBuilder;
    /// The cluster pool asynchronously preloads the next few clusters
    std::unique_ptr<RClusterPool> fClusterPool;
+   /// Identifies the ntuple in the RSharedPageCache; only used if the read options enable the shared page cache
+   std::uint64_t fSharedPageCacheId = 0;
 
    /// Deserialized header and footer into a minimal descriptor held by fDescriptorBuilder
    void InitDescriptor(const Internal::RFileNTupleAnchor &anchor);
+   /// Registers a page in fPagePool whose buffer is owned by the RSharedPageCache. The page's reference in the
+   /// shared cache is released when the page is returned to the page pool.
+   RPage RegisterSharedPage(ColumnHandle_t columnHandle, const RClusterInfo &clusterInfo, unsigned char *buffer);
 
    RPageSourceFile(std::string_view ntupleName, const RNTupleReadOptions &options);
    /// Used from the RNTuple class to build a datasource if the anchor is already available
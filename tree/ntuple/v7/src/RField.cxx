@@ -568,8 +568,9 @@ void ROOT::Experimental::Detail::RFieldBase::ConnectPageSink(RPageSink &pageSink
    GenerateColumnsImpl();
    if (!fColumns.empty())
       fPrincipalColumn = fColumns[0].get();
+   const auto firstPrincipalElementIndex = OnConnectPageSink(EntryToColumnElementIndex(firstEntry));
    for (auto &column : fColumns) {
-      auto firstElementIndex = (column.get() == fPrincipalColumn) ? EntryToColumnElementIndex(firstEntry) : 0;
+      auto firstElementIndex = (column.get() == fPrincipalColumn) ? firstPrincipalElementIndex : 0;
       column->Connect(fOnDiskId, &pageSink, firstElementIndex);
    }
 }
@@ -2415,7 +2416,7 @@ ROOT::Experimental::RNullableField::GetColumnRepresentations() const
 {
    static RColumnRepresentations representations(
       {{EColumnType::kSplitIndex64}, {EColumnType::kIndex64}, {EColumnType::kSplitIndex32}, {EColumnType::kIndex32},
-       {EColumnType::kBit}}, {});
+       {EColumnType::kBit}, {EColumnType::kSplitUInt64}, {EColumnType::kUInt64}}, {});
    return representations;
 }
 
@@ -2429,6 +2430,9 @@ void ROOT::Experimental::RNullableField::GenerateColumnsImpl()
    if (IsDense()) {
       fDefaultItemValue = fSubFields[0]->GenerateValue();
       fColumns.emplace_back(Detail::RColumn::Create<bool>(RColumnModel(EColumnType::kBit), 0));
+   } else if (IsEntryList()) {
+      fColumns.emplace_back(
+         Detail::RColumn::Create<std::uint64_t>(RColumnModel(GetColumnRepresentative()[0], true /* isSorted */), 0));
    } else {
       fColumns.emplace_back(Detail::RColumn::Create<ClusterSize_t>(RColumnModel(GetColumnRepresentative()[0]), 0));
    }
@@ -2439,13 +2443,30 @@ void ROOT::Experimental::RNullableField::GenerateColumnsImpl(const RNTupleDescri
    auto onDiskTypes = EnsureCompatibleColumnTypes(desc);
    if (onDiskTypes[0] == EColumnType::kBit) {
       fColumns.emplace_back(Detail::RColumn::Create<bool>(RColumnModel(EColumnType::kBit), 0));
+   } else if (onDiskTypes[0] == EColumnType::kSplitUInt64 || onDiskTypes[0] == EColumnType::kUInt64) {
+      fColumns.emplace_back(Detail::RColumn::Create<std::uint64_t>(RColumnModel(onDiskTypes[0], true), 0));
    } else {
       fColumns.emplace_back(Detail::RColumn::Create<ClusterSize_t>(RColumnModel(onDiskTypes[0]), 0));
    }
 }
 
+ROOT::Experimental::NTupleSize_t
+ROOT::Experimental::RNullableField::OnConnectPageSink(NTupleSize_t firstElementIndex)
+{
+   if (!IsEntryList())
+      return firstElementIndex;
+   // The index column only has elements for the available items; it is never deferred.  Instead, the indexes
+   // of the items written from now on are offset by the number of items of the previous entries.
+   fNextIndex = firstElementIndex;
+   return 0;
+}
+
 std::size_t ROOT::Experimental::RNullableField::AppendNull()
 {
+   if (IsEntryList()) {
+      fNextIndex++;
+      return 0;
+   }
    if (IsDense()) {
       bool mask = false;
       Detail::RColumnElement<bool> maskElement(&mask);
@@ -2466,6 +2487,11 @@ std::size_t ROOT::Experimental::RNullableField::AppendValue(const Detail::RField
       Detail::RColumnElement<bool> maskElement(&mask);
       fPrincipalColumn->Append(maskElement);
       return 1 + nbytesItem;
+   } else if (IsEntryList()) {
+      Detail::RColumnElement<std::uint64_t> indexElement(&fNextIndex);
+      fPrincipalColumn->Append(indexElement);
+      fNextIndex++;
+      return sizeof(std::uint64_t) + nbytesItem;
    } else {
       fNWritten++;
       Detail::RColumnElement<ClusterSize_t> offsetElement(&fNWritten);
@@ -2480,6 +2506,14 @@ ROOT::Experimental::RClusterIndex ROOT::Experimental::RNullableField::GetItemInd
    if (IsDense()) {
       const bool isValidItem = *fPrincipalColumn->Map<bool>(globalIndex);
       return isValidItem ? fPrincipalColumn->GetClusterIndex(globalIndex) : nullIndex;
+   } else if (IsEntryList()) {
+      // The item column and the index column have the same number of elements in every cluster
+      const auto itemIndex = FindItem(globalIndex);
+      if (itemIndex < fPrincipalColumn->GetNElements() &&
+          *fPrincipalColumn->Map<std::uint64_t>(itemIndex) == globalIndex) {
+         return fPrincipalColumn->GetClusterIndex(itemIndex);
+      }
+      return nullIndex;
    } else {
       RClusterIndex collectionStart;
       ClusterSize_t collectionSize;
@@ -2488,6 +2522,97 @@ ROOT::Experimental::RClusterIndex ROOT::Experimental::RNullableField::GetItemInd
    }
 }
 
+void ROOT::Experimental::RNullableField::SetItemCluster(NTupleSize_t itemIndex)
+{
+   const auto clusterId = fPrincipalColumn->GetClusterIndex(itemIndex).GetClusterId();
+   const auto descriptorGuard = fPrincipalColumn->GetPageSource()->GetSharedDescriptorGuard();
+   const auto &columnRange =
+      descriptorGuard->GetClusterDescriptor(clusterId).GetColumnRange(fPrincipalColumn->GetColumnIdSource());
+   fClusterFirstItem = columnRange.fFirstElementIndex;
+   fClusterEndItem = columnRange.fFirstElementIndex + columnRange.fNElements;
+}
+
+ROOT::Experimental::NTupleSize_t ROOT::Experimental::RNullableField::FindItem(NTupleSize_t globalIndex)
+{
+   const auto nItems = fPrincipalColumn->GetNElements();
+   if (nItems == 0)
+      return 0;
+   auto fnIndexAt = [this](NTupleSize_t i) { return *fPrincipalColumn->Map<std::uint64_t>(i); };
+
+   if (fClusterFirstItem == fClusterEndItem)
+      SetItemCluster(std::min(fItemHint, nItems - 1));
+
+   // The lower bound is searched in [lo, hi].  Usually, that is the range of the current cluster.  If the item is
+   // beyond the boundaries of the current cluster, the neighboring cluster is the most likely candidate (sequential
+   // reading); only if it is not the one either, the remainder of the index column is searched.
+   NTupleSize_t lo = fClusterFirstItem;
+   NTupleSize_t hi = fClusterEndItem;
+   if (fnIndexAt(hi - 1) < globalIndex) {
+      if (hi == nItems)
+         return nItems;
+      SetItemCluster(hi);
+      lo = fClusterFirstItem;
+      hi = fClusterEndItem;
+      if (fnIndexAt(hi - 1) < globalIndex) {
+         lo = hi;
+         hi = nItems;
+      }
+   } else if ((lo > 0) && (fnIndexAt(lo - 1) >= globalIndex)) {
+      SetItemCluster(lo - 1);
+      lo = fClusterFirstItem;
+      hi = fClusterEndItem;
+      if ((lo > 0) && (fnIndexAt(lo - 1) >= globalIndex)) {
+         hi = lo;
+         lo = 0;
+      }
+   }
+
+   // For sequential reads, the lower bound moves by at most one item from one call to the next.  Check this case
+   // before falling back to a binary search.
+   if ((fItemHint >= lo) && (fItemHint < hi)) {
+      if (fnIndexAt(fItemHint) < globalIndex) {
+         if ((fItemHint + 1 == hi) || (fnIndexAt(fItemHint + 1) >= globalIndex))
+            lo = hi = fItemHint + 1;
+      } else if ((fItemHint == lo) || (fnIndexAt(fItemHint - 1) < globalIndex)) {
+         lo = hi = fItemHint;
+      }
+   }
+   while (lo < hi) {
+      const auto mid = lo + (hi - lo) / 2;
+      if (fnIndexAt(mid) < globalIndex)
+         lo = mid + 1;
+      else
+         hi = mid;
+   }
+
+   fItemHint = lo;
+   if ((lo < nItems) && ((lo < fClusterFirstItem) || (lo >= fClusterEndItem)))
+      SetItemCluster(lo);
+   return lo;
+}
+
+std::vector<ROOT::Experimental::NTupleSize_t>
+ROOT::Experimental::RNullableField::GetNonNullIndexes(NTupleSize_t first, NTupleSize_t last)
+{
+   std::vector<NTupleSize_t> result;
+   if (IsEntryList()) {
+      const auto nItems = fPrincipalColumn->GetNElements();
+      for (auto i = FindItem(first); i < nItems; ++i) {
+         const auto index = *fPrincipalColumn->Map<std::uint64_t>(i);
+         if (index >= last)
+            break;
+         result.emplace_back(index);
+      }
+      return result;
+   }
+
+   for (auto i = first; i < last; ++i) {
+      if (GetItemIndex(i).GetIndex() != kInvalidClusterIndex)
+         result.emplace_back(i);
+   }
+   return result;
+}
+
 void ROOT::Experimental::RNullableField::AcceptVisitor(Detail::RFieldVisitor &visitor) const
 {
    visitor.VisitNullableField(*this);
@@ -17,8 +17,10 @@
 
 #include "ROOT/RMiniFile.hxx"
 
+#include <ROOT/RLogger.hxx>
 #include <ROOT/RRawFile.hxx>
 #include <ROOT/RNTuple.hxx> // For converting an anchor to an RNTuple object
+#include <ROOT/RNTupleUtil.hxx>
 #include <ROOT/RNTupleZip.hxx>
 
 #include <TError.h>
@@ -26,11 +28,16 @@
 #include <TKey.h>
 
 #include <algorithm>
+#include <condition_variable>
 #include <cstdio>
 #include <cstring>
+#include <deque>
 #include <iostream>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <utility>
+#include <vector>
 #include <chrono>
 
 namespace {
@@ -1087,17 +1094,202 @@ void ROOT::Experimental::Internal::RMiniFileReader::ReadBuffer(void *buffer, siz
 ////////////////////////////////////////////////////////////////////////////////
 
 
+// clang-format off
+/**
+\class ROOT::Experimental::Internal::RNTupleFileWriter::RAsyncWriter
+\ingroup NTuple
+\brief Background thread that writes the queued buffers, in order, into a C file stream
+
+The buffers are copied on queuing, such that the caller can immediately reuse its buffer. Queuing blocks while more than
+the given maximum number of bytes are in flight. Small buffers are not worth the copy and the hand-over to the writer
+thread: they are written inline if the writer thread is idle, or else appended to the last queued small request if they
+continue it in the file. Write errors are reported by the next call to Write() or Drain().
+*/
+// clang-format on
+class ROOT::Experimental::Internal::RNTupleFileWriter::RAsyncWriter {
+private:
+   struct RRequest {
+      std::vector<unsigned char> fBuffer;
+      std::uint64_t fOffset = 0;
+      /// Small requests can be extended by subsequent, contiguous small writes
+      bool fIsCoalescing = false;
+   };
+
+   /// Buffers up to this size are written inline or coalesced rather than queued on their own
+   static constexpr std::size_t kMaxInlineBytes = 16 * 1024;
+   /// Upper bound for a request assembled from coalesced small buffers
+   static constexpr std::size_t kMaxCoalescedBytes = 256 * 1024;
+
+   FILE *fFile;
+   /// The position of the stream, only accessed by the writer thread
+   std::uint64_t fStreamPos;
+   std::size_t fMaxInFlightBytes;
+   /// The number of bytes queued or being written
+   std::size_t fInFlightBytes = 0;
+   std::deque<RRequest> fQueue;
+   bool fIsStopping = false;
+   std::string fError;
+   std::mutex fLock;
+   /// Signals new requests to the writer thread
+   std::condition_variable fCvRequest;
+   /// Signals completed requests to the queuing thread
+   std::condition_variable fCvDone;
+   std::thread fThread;
+
+   /// Writes the buffer at the given offset of the stream and returns the error message, if any. Must only be called
+   /// either by the writer thread or with the lock held while no bytes are in flight.
+   std::string WriteAt(const void *buffer, std::size_t nbytes, std::uint64_t offset)
+   {
+      std::string error;
+      if (offset != fStreamPos) {
+#ifdef R__SEEK64
+         auto retval = fseeko64(fFile, offset, SEEK_SET);
+#else
+         auto retval = fseek(fFile, offset, SEEK_SET);
+#endif
+         if (retval != 0)
+            error = "cannot seek to " + std::to_string(offset);
+      }
+      if (error.empty() && (fwrite(buffer, 1, nbytes, fFile) != nbytes))
+         error = "cannot write " + std::to_string(nbytes) + " bytes";
+      fStreamPos = offset + nbytes;
+      return error;
+   }
+
+   void Run()
+   {
+      std::unique_lock<std::mutex> lock(fLock);
+      while (true) {
+         fCvRequest.wait(lock, [this] { return fIsStopping || !fQueue.empty(); });
+         if (fQueue.empty())
+            return;
+         auto request = std::move(fQueue.front());
+         fQueue.pop_front();
+         const bool hasError = !fError.empty();
+         lock.unlock();
+
+         std::string error;
+         if (!hasError)
+            error = WriteAt(request.fBuffer.data(), request.fBuffer.size(), request.fOffset);
+
+         lock.lock();
+         if (!error.empty() && fError.empty())
+            fError = error;
+         fInFlightBytes -= request.fBuffer.size();
+         fCvDone.notify_all();
+      }
+   }
+
+   /// Must be called with the lock held
+   void ThrowOnError()
+   {
+      if (!fError.empty())
+         throw RException(R__FAIL("asynchronous write failed: " + fError));
+   }
+
+public:
+   RAsyncWriter(FILE *file, std::uint64_t streamPos, std::size_t maxInFlightBytes)
+      : fFile(file), fStreamPos(streamPos), fMaxInFlightBytes(maxInFlightBytes)
+   {
+      fThread = std::thread([this] { Run(); });
+   }
+   RAsyncWriter(const RAsyncWriter &other) = delete;
+   RAsyncWriter &operator=(const RAsyncWriter &other) = delete;
+   ~RAsyncWriter()
+   {
+      {
+         std::lock_guard<std::mutex> lock(fLock);
+         fIsStopping = true;
+      }
+      fCvRequest.notify_one();
+      fThread.join();
+   }
+
+   void Write(const void *buffer, std::size_t nbytes, std::uint64_t offset)
+   {
+      if (nbytes <= kMaxInlineBytes) {
+         std::unique_lock<std::mutex> lock(fLock);
+         ThrowOnError();
+         if (fInFlightBytes == 0) {
+            // The writer thread is idle and cannot touch the stream while we hold the lock
+            fError = WriteAt(buffer, nbytes, offset);
+            ThrowOnError();
+            return;
+         }
+         if (!fQueue.empty() && (fInFlightBytes + nbytes <= fMaxInFlightBytes)) {
+            auto &last = fQueue.back();
+            if (last.fIsCoalescing && (last.fOffset + last.fBuffer.size() == offset) &&
+                (last.fBuffer.size() + nbytes <= kMaxCoalescedBytes)) {
+               auto bytes = static_cast<const unsigned char *>(buffer);
+               last.fBuffer.insert(last.fBuffer.end(), bytes, bytes + nbytes);
+               fInFlightBytes += nbytes;
+               return;
+            }
+         }
+      }
+
+      RRequest request;
+      request.fIsCoalescing = (nbytes <= kMaxInlineBytes);
+      auto bytes = static_cast<const unsigned char *>(buffer);
+      request.fBuffer.assign(bytes, bytes + nbytes);
+      request.fOffset = offset;
+
+      std::unique_lock<std::mutex> lock(fLock);
+      // A single request larger than the limit is accepted once the queue has run empty
+      fCvDone.wait(lock, [&] { return !fError.empty() || (fInFlightBytes == 0) ||
+                                      (fInFlightBytes + nbytes <= fMaxInFlightBytes); });
+      ThrowOnError();
+      fInFlightBytes += nbytes;
+      fQueue.emplace_back(std::move(request));
+      lock.unlock();
+      fCvRequest.notify_one();
+   }
+
+   /// Waits until all the queued buffers are written
+   void Drain()
+   {
+      std::unique_lock<std::mutex> lock(fLock);
+      fCvDone.wait(lock, [this] { return fInFlightBytes == 0; });
+      ThrowOnError();
+   }
+};
+
+
 ROOT::Experimental::Internal::RNTupleFileWriter::RFileSimple::~RFileSimple()
 {
+   if (fAsyncWriter) {
+      try {
+         fAsyncWriter->Drain();
+      } catch (const RException &e) {
+         R__LOG_ERROR(NTupleLog()) << e.GetError().GetReport();
+      }
+      fAsyncWriter = nullptr;
+   }
    if (fFile)
       fclose(fFile);
 }
 
 
+void ROOT::Experimental::Internal::RNTupleFileWriter::RFileSimple::Flush()
+{
+   if (fAsyncWriter)
+      fAsyncWriter->Drain();
+   fflush(fFile);
+}
+
+
 void ROOT::Experimental::Internal::RNTupleFileWriter::RFileSimple::Write(
    const void *buffer, size_t nbytes, std::int64_t offset)
 {
    R__ASSERT(fFile);
+   if (fAsyncWriter) {
+      if (offset >= 0)
+         fFilePos = offset;
+      fAsyncWriter->Write(buffer, nbytes, fFilePos);
+      fFilePos += nbytes;
+      return;
+   }
+
    size_t retval;
    if ((offset >= 0) && (static_cast<std::uint64_t>(offset) != fFilePos)) {
 #ifdef R__SEEK64
@@ -1272,7 +1464,7 @@ void ROOT::Experimental::Internal::RNTupleFileWriter::Commit()
    if (fIsBare) {
       RTFNTuple ntupleOnDisk(fNTupleAnchor);
       fFileSimple.Write(&ntupleOnDisk, ntupleOnDisk.GetSize(), fFileSimple.fControlBlock->fSeekNTuple);
-      fflush(fFileSimple.fFile);
+      fFileSimple.Flush();
       return;
    }
 
@@ -1285,7 +1477,15 @@ void ROOT::Experimental::Internal::RNTupleFileWriter::Commit()
    fFileSimple.Write(&fFileSimple.fControlBlock->fHeader, fFileSimple.fControlBlock->fHeader.GetSize(), 0);
    fFileSimple.Write(&fFileSimple.fControlBlock->fFileRecord, fFileSimple.fControlBlock->fFileRecord.GetSize(),
                      fFileSimple.fControlBlock->fSeekFileRecord);
-   fflush(fFileSimple.fFile);
+   fFileSimple.Flush();
+}
+
+
+void ROOT::Experimental::Internal::RNTupleFileWriter::EnableAsyncWrite(std::size_t maxInFlightBytes)
+{
+   if (!fFileSimple || fFileSimple.fAsyncWriter)
+      return;
+   fFileSimple.fAsyncWriter = std::make_unique<RAsyncWriter>(fFileSimple.fFile, fFileSimple.fFilePos, maxInFlightBytes);
 }
 
 
@@ -260,6 +260,15 @@ const ROOT::Experimental::RNTupleDescriptor *ROOT::Experimental::RNTupleReader::
    return fCachedDescriptor.get();
 }
 
+std::vector<ROOT::Experimental::RNTupleGlobalRange>
+ROOT::Experimental::RNTupleReader::GetEntryRanges(const std::vector<RNTupleDescriptor::RValueRangeCut> &cuts)
+{
+   std::vector<RNTupleGlobalRange> ranges;
+   for (const auto &r : fSource->GetSharedDescriptorGuard()->FindEntryRanges(cuts))
+      ranges.emplace_back(r.first, r.second);
+   return ranges;
+}
+
 //------------------------------------------------------------------------------
 
 ROOT::Experimental::RNTupleWriter::RNTupleWriter(std::unique_ptr<ROOT::Experimental::RNTupleModel> model,
@@ -358,6 +358,85 @@ ROOT::Experimental::RNTupleDescriptor::FindPrevClusterId(DescriptorId_t clusterI
    return kInvalidDescriptorId;
 }
 
+std::vector<std::pair<ROOT::Experimental::NTupleSize_t, ROOT::Experimental::NTupleSize_t>>
+ROOT::Experimental::RNTupleDescriptor::FindEntryRanges(const std::vector<RValueRangeCut> &cuts) const
+{
+   using EntryRange_t = std::pair<NTupleSize_t, NTupleSize_t>;
+
+   // Appends [first, last) to a sorted list of entry ranges; adjacent ranges are coalesced
+   auto fnAppend = [](std::vector<EntryRange_t> &ranges, NTupleSize_t first, NTupleSize_t last) {
+      if (first == last)
+         return;
+      if (!ranges.empty() && ranges.back().second == first)
+         ranges.back().second = last;
+      else
+         ranges.emplace_back(first, last);
+   };
+
+   std::vector<const RClusterDescriptor *> clusters;
+   for (const auto &cd : fClusterDescriptors)
+      clusters.emplace_back(&cd.second);
+   std::sort(clusters.begin(), clusters.end(),
+             [](const auto *a, const auto *b) { return a->GetFirstEntryIndex() < b->GetFirstEntryIndex(); });
+
+   std::vector<EntryRange_t> result;
+   for (const auto *cd : clusters)
+      fnAppend(result, cd->GetFirstEntryIndex(), cd->GetFirstEntryIndex() + cd->GetNEntries());
+
+   const auto fieldZeroId = GetFieldZeroId();
+   for (const auto &cut : cuts) {
+      const auto fieldId = FindFieldId(cut.fFieldName);
+      if (fieldId == kInvalidDescriptorId)
+         throw RException(R__FAIL("no field named '" + cut.fFieldName + "' in RNTuple '" + fName + "'"));
+      // The elements of the principal column must correspond to the entries, i.e. the field must be a leaf that is
+      // only nested in (non-repetitive) records
+      for (auto id = fieldId; id != fieldZeroId; id = GetFieldDescriptor(id).GetParentId()) {
+         const auto &fieldDesc = GetFieldDescriptor(id);
+         const auto expectedStructure = (id == fieldId) ? ENTupleStructure::kLeaf : ENTupleStructure::kRecord;
+         if (fieldDesc.GetStructure() != expectedStructure || fieldDesc.GetNRepetitions() > 0)
+            throw RException(R__FAIL("value range cuts are unsupported for field '" + cut.fFieldName + "'"));
+      }
+      const auto columnId = FindPhysicalColumnId(fieldId, 0);
+      if (columnId == kInvalidDescriptorId)
+         throw RException(R__FAIL("value range cuts are unsupported for field '" + cut.fFieldName + "'"));
+
+      std::vector<EntryRange_t> candidates;
+      for (const auto *cd : clusters) {
+         const auto firstEntry = cd->GetFirstEntryIndex();
+         if (!cd->HasPageLocations() || !cd->ContainsColumn(columnId)) {
+            fnAppend(candidates, firstEntry, firstEntry + cd->GetNEntries());
+            continue;
+         }
+         if (!cd->GetColumnRange(columnId).fStatistics.MayContain(cut.fMin, cut.fMax))
+            continue;
+         NTupleSize_t firstInPage = firstEntry;
+         for (const auto &pi : cd->GetPageRange(columnId).fPageInfos) {
+            if (pi.fStatistics.MayContain(cut.fMin, cut.fMax))
+               fnAppend(candidates, firstInPage, firstInPage + pi.fNElements);
+            firstInPage += pi.fNElements;
+         }
+      }
+
+      // Intersect the candidate ranges of this cut with the ranges of the previous cuts
+      std::vector<EntryRange_t> intersection;
+      auto itResult = result.begin();
+      auto itCandidates = candidates.begin();
+      while (itResult != result.end() && itCandidates != candidates.end()) {
+         const auto first = std::max(itResult->first, itCandidates->first);
+         const auto last = std::min(itResult->second, itCandidates->second);
+         if (first < last)
+            fnAppend(intersection, first, last);
+         if (itResult->second < itCandidates->second)
+            ++itResult;
+         else
+            ++itCandidates;
+      }
+      std::swap(result, intersection);
+   }
+
+   return result;
+}
+
 std::vector<ROOT::Experimental::DescriptorId_t>
 ROOT::Experimental::RNTupleDescriptor::RHeaderExtension::GetTopLevelFields(const RNTupleDescriptor &desc) const
 {
@@ -467,8 +546,10 @@ ROOT::Experimental::RClusterDescriptorBuilder::CommitColumnRange(DescriptorId_t
       return R__FAIL("column ID conflict");
    RClusterDescriptor::RColumnRange columnRange{physicalId, firstElementIndex, RClusterSize(0)};
    columnRange.fCompressionSettings = compressionSettings;
+   columnRange.fStatistics.fIsAvailable = !pageRange.fPageInfos.empty();
    for (const auto &pi : pageRange.fPageInfos) {
       columnRange.fNElements += pi.fNElements;
+      columnRange.fStatistics.Merge(pi.fStatistics);
    }
    fCluster.fPageRanges[physicalId] = pageRange.Clone();
    fCluster.fColumnRanges[physicalId] = columnRange;
@@ -504,9 +585,12 @@ ROOT::Experimental::RClusterDescriptorBuilder::AddDeferredColumnRanges(const RNT
                const DescriptorId_t physicalId = c.GetPhysicalId();
                auto &columnRange = fCluster.fColumnRanges[physicalId];
                auto &pageRange = fCluster.fPageRanges[physicalId];
-               // Initialize a RColumnRange for `physicalId` if it was not there
+               // Initialize a RColumnRange for `physicalId` if it was not there.  Columns that are not deferred
+               // (e.g., the index column of entry-list nullable fields) have no elements before the extension.
                if (columnRange.fPhysicalColumnId == kInvalidDescriptorId) {
                   columnRange.fPhysicalColumnId = physicalId;
+                  columnRange.fFirstElementIndex = 0;
+                  columnRange.fNElements = 0;
                   pageRange.fPhysicalColumnId = physicalId;
                }
                // Fixup the RColumnRange and RPageRange in deferred columns.  We know what the first element index and
@@ -519,7 +603,9 @@ ROOT::Experimental::RClusterDescriptorBuilder::AddDeferredColumnRanges(const RNT
                   columnRange.fFirstElementIndex = fCluster.GetFirstEntryIndex() * nRepetitions;
                   columnRange.fNElements = fCluster.GetNEntries() * nRepetitions;
                   const auto element = Detail::RColumnElementBase::Generate<void>(c.GetModel().GetType());
-                  pageRange.ExtendToFitColumnRange(columnRange, *element, Detail::RPage::kPageZeroSize);
+                  // The synthesized pages do not carry statistics, neither does the column range as a whole then
+                  if (pageRange.ExtendToFitColumnRange(columnRange, *element, Detail::RPage::kPageZeroSize) > 0)
+                     columnRange.fStatistics = RClusterDescriptor::RStatistics();
                }
             }
          },
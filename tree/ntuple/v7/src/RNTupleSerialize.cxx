@@ -23,6 +23,7 @@
 #include <RVersion.h>
 #include <RZip.h> // for R__crc32
 
+#include <algorithm>
 #include <cstring> // for memcpy
 #include <deque>
 #include <set>
@@ -471,6 +472,22 @@ std::uint32_t ROOT::Experimental::Internal::RNTupleSerializer::DeserializeUInt64
    return DeserializeInt64(buffer, *reinterpret_cast<std::int64_t *>(&val));
 }
 
+std::uint32_t ROOT::Experimental::Internal::RNTupleSerializer::SerializeDouble(double val, void *buffer)
+{
+   static_assert(sizeof(double) == sizeof(std::uint64_t), "IEEE-754 double precision required");
+   std::uint64_t bits;
+   memcpy(&bits, &val, sizeof(bits));
+   return SerializeUInt64(bits, buffer);
+}
+
+std::uint32_t ROOT::Experimental::Internal::RNTupleSerializer::DeserializeDouble(const void *buffer, double &val)
+{
+   std::uint64_t bits;
+   auto nbytes = DeserializeUInt64(buffer, bits);
+   memcpy(&val, &bits, sizeof(val));
+   return nbytes;
+}
+
 std::uint32_t ROOT::Experimental::Internal::RNTupleSerializer::SerializeString(const std::string &val, void *buffer)
 {
    if (buffer) {
@@ -1284,6 +1301,22 @@ std::uint32_t ROOT::Experimental::Internal::RNTupleSerializer::SerializePageList
          pos += SerializeUInt64(columnRange.fFirstElementIndex, *where);
          pos += SerializeUInt32(columnRange.fCompressionSettings, *where);
 
+         // Optional page statistics, only written if all the pages of the column range have them
+         const bool hasStatistics =
+            !pageRange.fPageInfos.empty() &&
+            std::all_of(pageRange.fPageInfos.begin(), pageRange.fPageInfos.end(),
+                        [](const auto &pi) { return pi.fStatistics.fIsAvailable; });
+         if (hasStatistics) {
+            auto statisticsFrame = pos;
+            pos += SerializeListFramePreamble(pageRange.fPageInfos.size(), *where);
+            for (const auto &pi : pageRange.fPageInfos) {
+               pos += SerializeDouble(pi.fStatistics.fMin, *where);
+               pos += SerializeDouble(pi.fStatistics.fMax, *where);
+               pos += SerializeUInt64(pi.fStatistics.fNNulls, *where);
+            }
+            pos += SerializeFramePostscript(buffer ? statisticsFrame : nullptr, pos - statisticsFrame);
+         }
+
          pos += SerializeFramePostscript(buffer ? innerFrame : nullptr, pos - innerFrame);
       }
       pos += SerializeFramePostscript(buffer ? outerFrame : nullptr, pos - outerFrame);
@@ -1606,6 +1639,31 @@ ROOT::Experimental::RResult<void> ROOT::Experimental::Internal::RNTupleSerialize
          std::uint32_t compressionSettings;
          bytes += DeserializeUInt32(bytes, compressionSettings);
 
+         // Older writers did not store page statistics; the inner frame ends after the compression settings then
+         if (fnInnerFrameSizeLeft() > 0) {
+            std::uint32_t statisticsFrameSize;
+            auto statisticsFrame = bytes;
+            auto fnStatisticsFrameSizeLeft = [&]() { return statisticsFrameSize - (bytes - statisticsFrame); };
+
+            std::uint32_t nStatistics;
+            result = DeserializeFrameHeader(bytes, fnInnerFrameSizeLeft(), statisticsFrameSize, nStatistics);
+            if (!result)
+               return R__FORWARD_ERROR(result);
+            bytes += result.Unwrap();
+            if (nStatistics != nPages)
+               return R__FAIL("mismatch of page statistics and page list");
+
+            constexpr int kStatisticsSize = 3 * sizeof(std::uint64_t);
+            for (auto &pi : pageRange.fPageInfos) {
+               if (fnStatisticsFrameSizeLeft() < kStatisticsSize)
+                  return R__FAIL("page statistics frame too short");
+               bytes += DeserializeDouble(bytes, pi.fStatistics.fMin);
+               bytes += DeserializeDouble(bytes, pi.fStatistics.fMax);
+               bytes += DeserializeUInt64(bytes, pi.fStatistics.fNNulls);
+               pi.fStatistics.fIsAvailable = true;
+            }
+         }
+
          clusters[i].CommitColumnRange(j, columnOffset, compressionSettings, pageRange);
          bytes = innerFrame + innerFrameSize;
       }
@@ -19,6 +19,7 @@
 #include <TError.h>
 
 #include <cstdlib>
+#include <utility>
 
 void ROOT::Experimental::Detail::RPagePool::RegisterPage(const RPage &page, const RPageDeleter &deleter)
 {
@@ -88,3 +89,108 @@ ROOT::Experimental::Detail::RPage ROOT::Experimental::Detail::RPagePool::GetPage
    }
    return RPage();
 }
+
+ROOT::Experimental::Detail::RSharedPageCache &ROOT::Experimental::Detail::RSharedPageCache::Instance()
+{
+   static RSharedPageCache instance;
+   return instance;
+}
+
+std::uint64_t ROOT::Experimental::Detail::RSharedPageCache::GetStorageId(const std::string &identity)
+{
+   std::lock_guard<std::mutex> lockGuard(fLock);
+   return fStorageIds.emplace(identity, fStorageIds.size()).first->second;
+}
+
+bool ROOT::Experimental::Detail::RSharedPageCache::Contains(const RKey &key)
+{
+   std::lock_guard<std::mutex> lockGuard(fLock);
+   return fEntries.count(key) > 0;
+}
+
+unsigned char *ROOT::Experimental::Detail::RSharedPageCache::Acquire(const RKey &key)
+{
+   std::lock_guard<std::mutex> lockGuard(fLock);
+   auto itr = fEntries.find(key);
+   if (itr == fEntries.end())
+      return nullptr;
+   auto &entry = itr->second;
+   if (entry.fReferences++ == 0)
+      fUnused.erase(entry.fUnusedPos);
+   return entry.fBuffer.get();
+}
+
+unsigned char *ROOT::Experimental::Detail::RSharedPageCache::Insert(const RKey &key,
+                                                                     std::unique_ptr<unsigned char[]> buffer,
+                                                                     std::size_t nbytes, bool acquire)
+{
+   std::lock_guard<std::mutex> lockGuard(fLock);
+   auto [itr, isNew] = fEntries.try_emplace(key);
+   auto &entry = itr->second;
+   if (isNew) {
+      entry.fBuffer = std::move(buffer);
+      entry.fNBytes = nbytes;
+      fMemoryUsage += nbytes;
+   } else if (entry.fReferences == 0) {
+      // Another page source unzipped the same page concurrently; keep the existing buffer
+      fUnused.erase(entry.fUnusedPos);
+   } else {
+      entry.fReferences += acquire ? 1 : 0;
+      return entry.fBuffer.get();
+   }
+
+   if (acquire) {
+      entry.fReferences = 1;
+   } else {
+      entry.fUnusedPos = fUnused.insert(fUnused.end(), key);
+   }
+   auto result = entry.fBuffer.get();
+   EvictUnused();
+   return result;
+}
+
+void ROOT::Experimental::Detail::RSharedPageCache::Release(const RKey &key)
+{
+   std::lock_guard<std::mutex> lockGuard(fLock);
+   auto itr = fEntries.find(key);
+   R__ASSERT(itr != fEntries.end() && itr->second.fReferences > 0);
+   auto &entry = itr->second;
+   if (--entry.fReferences == 0) {
+      entry.fUnusedPos = fUnused.insert(fUnused.end(), key);
+      EvictUnused();
+   }
+}
+
+void ROOT::Experimental::Detail::RSharedPageCache::EvictUnused()
+{
+   while ((fMemoryUsage > fMemoryBudget) && !fUnused.empty()) {
+      auto itr = fEntries.find(fUnused.front());
+      fMemoryUsage -= itr->second.fNBytes;
+      fEntries.erase(itr);
+      fUnused.pop_front();
+   }
+}
+
+void ROOT::Experimental::Detail::RSharedPageCache::Clear()
+{
+   std::lock_guard<std::mutex> lockGuard(fLock);
+   for (const auto &key : fUnused) {
+      auto itr = fEntries.find(key);
+      fMemoryUsage -= itr->second.fNBytes;
+      fEntries.erase(itr);
+   }
+   fUnused.clear();
+}
+
+void ROOT::Experimental::Detail::RSharedPageCache::SetMemoryBudget(std::size_t budget)
+{
+   std::lock_guard<std::mutex> lockGuard(fLock);
+   fMemoryBudget = budget;
+   EvictUnused();
+}
+
+std::size_t ROOT::Experimental::Detail::RSharedPageCache::GetMemoryUsage()
+{
+   std::lock_guard<std::mutex> lockGuard(fLock);
+   return fMemoryUsage;
+}
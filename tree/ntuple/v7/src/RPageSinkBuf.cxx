@@ -32,6 +32,8 @@ ROOT::Experimental::Detail::RPageSinkBuf::RPageSinkBuf(std::unique_ptr<RPageSink
          "compressing pages in parallel")
    });
    fMetrics.ObserveMetrics(fInnerSink->GetMetrics());
+   // Page statistics are recorded by the inner sink, either from the sealed pages or when committing unsealed pages
+   fComputePageStatistics = false;
 }
 
 ROOT::Experimental::Detail::RPageSinkBuf::~RPageSinkBuf()
@@ -112,8 +114,11 @@ ROOT::Experimental::Detail::RPageSinkBuf::CommitPageImpl(ColumnHandle_t columnHa
    R__ASSERT(zipItem.fBuf);
    auto &sealedPage = fBufferedColumns.at(columnHandle.fPhysicalId).RegisterSealedPage();
    fTaskScheduler->AddTask([this, &zipItem, &sealedPage, colId = columnHandle.fPhysicalId] {
-      sealedPage = SealPage(zipItem.fPage, *fBufferedColumns.at(colId).GetHandle().fColumn->GetElement(),
-                            GetWriteOptions().GetCompression(), zipItem.fBuf.get());
+      const auto &column = *fBufferedColumns.at(colId).GetHandle().fColumn;
+      sealedPage = SealPage(zipItem.fPage, *column.GetElement(), GetWriteOptions().GetCompression(),
+                            zipItem.fBuf.get());
+      if (GetWriteOptions().GetHasPageStatistics())
+         sealedPage.fStatistics = ComputeStatistics(zipItem.fPage, column);
       zipItem.fSealedPage = &sealedPage;
    });
 
@@ -0,0 +1,99 @@
+/// \file RPageSinkMem.cxx
+/// \ingroup NTuple ROOT7
+/// \date 2026-10-18
+/// \warning This is part of the ROOT 7 prototype! It will change without notice. It might trigger earthquakes. Feedback
+/// is welcome!
+
+/*************************************************************************
+ * Copyright (C) 1995-2023, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include <ROOT/RColumn.hxx>
+#include <ROOT/RError.hxx>
+#include <ROOT/RNTupleOptions.hxx>
+#include <ROOT/RPageAllocator.hxx>
+#include <ROOT/RPageSinkMem.hxx>
+
+#include <cstring>
+#include <utility>
+
+ROOT::Experimental::Detail::RPageSinkMem::RPageSinkMem(std::string_view ntupleName,
+                                                       const RNTupleWriteOptions &options,
+                                                       std::deque<RSealedCluster> &clusters)
+   : RPageSink(ntupleName, options), fClusters(clusters)
+{
+   // The statistics are attached to the sealed pages and recorded by the output sink
+   fComputePageStatistics = false;
+}
+
+ROOT::Experimental::RNTupleLocator
+ROOT::Experimental::Detail::RPageSinkMem::CommitPageImpl(ColumnHandle_t columnHandle, const RPage &page)
+{
+   const auto compression = GetWriteOptions().GetCompression();
+   auto buffer = std::make_unique<unsigned char[]>(page.GetNBytes());
+   auto sealedPage = SealPage(page, *columnHandle.fColumn->GetElement(), compression, buffer.get());
+   // Uncompressed, mappable pages are not copied by SealPage()
+   if (sealedPage.fBuffer != buffer.get()) {
+      memcpy(buffer.get(), sealedPage.fBuffer, sealedPage.fSize);
+      sealedPage.fBuffer = buffer.get();
+   }
+   if (GetWriteOptions().GetHasPageStatistics())
+      sealedPage.fStatistics = ComputeStatistics(page, *columnHandle.fColumn);
+   fNBytesCurrentCluster += sealedPage.fSize;
+
+   auto &sealedPages = fOpenCluster.fSealedPages;
+   if (columnHandle.fPhysicalId >= sealedPages.size())
+      sealedPages.resize(columnHandle.fPhysicalId + 1);
+   sealedPages[columnHandle.fPhysicalId].emplace_back(std::move(sealedPage));
+   fOpenCluster.fBuffers.emplace_back(std::move(buffer));
+   return RNTupleLocator();
+}
+
+ROOT::Experimental::RNTupleLocator
+ROOT::Experimental::Detail::RPageSinkMem::CommitSealedPageImpl(DescriptorId_t, const RSealedPage &)
+{
+   throw RException(R__FAIL("not implemented"));
+}
+
+std::uint64_t ROOT::Experimental::Detail::RPageSinkMem::CommitClusterImpl(NTupleSize_t nEntries)
+{
+   // nEntries is the total number of entries written so far
+   fOpenCluster.fNEntries = nEntries - fPrevClusterNEntries;
+   fClusters.emplace_back(std::move(fOpenCluster));
+   fOpenCluster = RSealedCluster();
+   auto result = fNBytesCurrentCluster;
+   fNBytesCurrentCluster = 0;
+   return result;
+}
+
+ROOT::Experimental::Detail::RPage
+ROOT::Experimental::Detail::RPageSinkMem::ReservePage(ColumnHandle_t columnHandle, std::size_t nElements)
+{
+   if (nElements == 0)
+      throw RException(R__FAIL("invalid call: request empty page"));
+   auto elementSize = columnHandle.fColumn->GetElement()->GetSize();
+   return RPageAllocatorHeap::NewPage(columnHandle.fPhysicalId, elementSize, nElements);
+}
+
+void ROOT::Experimental::Detail::RPageSinkMem::ReleasePage(RPage &page)
+{
+   RPageAllocatorHeap::DeletePage(page);
+}
+
+void ROOT::Experimental::Detail::RPageSinkMem::CommitSealedCluster(const RSealedCluster &cluster, RPageSink &sink,
+                                                                   NTupleSize_t &nEntries)
+{
+   std::vector<RSealedPageGroup> groups;
+   for (std::size_t i = 0; i < cluster.fSealedPages.size(); ++i) {
+      const auto &sealedPages = cluster.fSealedPages[i];
+      if (!sealedPages.empty())
+         groups.emplace_back(i, sealedPages.cbegin(), sealedPages.cend());
+   }
+   sink.CommitSealedPageV(groups);
+   nEntries += cluster.fNEntries;
+   sink.CommitCluster(nEntries);
+}
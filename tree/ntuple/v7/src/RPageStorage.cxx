@@ -31,9 +31,57 @@
 #include <Compression.h>
 #include <TError.h>
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <type_traits>
 #include <utility>
 
 
+namespace {
+
+/// Computes min/max of the non-NaN values in the memory buffer. The loop over the values is kept free of data
+/// dependent branches (except for the NaN check of floating-point types) so that it can be auto-vectorized.
+template <typename T>
+ROOT::Experimental::RClusterDescriptor::RStatistics ComputeStatisticsImpl(const void *buffer, std::size_t nElements)
+{
+   ROOT::Experimental::RClusterDescriptor::RStatistics statistics;
+   statistics.fIsAvailable = true;
+
+   const auto values = reinterpret_cast<const T *>(buffer);
+   T min = std::numeric_limits<T>::max();
+   T max = std::numeric_limits<T>::lowest();
+   std::uint64_t nNulls = 0;
+   for (std::size_t i = 0; i < nElements; ++i) {
+      if constexpr (std::is_floating_point_v<T>) {
+         if (std::isnan(values[i])) {
+            nNulls++;
+            continue;
+         }
+      }
+      min = std::min(min, values[i]);
+      max = std::max(max, values[i]);
+   }
+   statistics.fNNulls = nNulls;
+   // If there are no values, the [+inf, -inf] default interval does not contain any value
+   if (nNulls == nElements)
+      return statistics;
+
+   statistics.fMin = static_cast<double>(min);
+   statistics.fMax = static_cast<double>(max);
+   if constexpr (std::is_integral_v<T> && (sizeof(T) == sizeof(std::uint64_t))) {
+      // Above 2^53, the conversion to double may round towards the inside of the interval
+      constexpr double kMaxExactInteger = 9007199254740992.;
+      if (std::abs(statistics.fMin) > kMaxExactInteger)
+         statistics.fMin = std::nextafter(statistics.fMin, -std::numeric_limits<double>::infinity());
+      if (std::abs(statistics.fMax) > kMaxExactInteger)
+         statistics.fMax = std::nextafter(statistics.fMax, std::numeric_limits<double>::infinity());
+   }
+   return statistics;
+}
+
+} // anonymous namespace
+
 ROOT::Experimental::Detail::RPageStorage::RPageStorage(std::string_view name) : fNTupleName(name)
 {
 }
@@ -269,6 +317,7 @@ void ROOT::Experimental::Detail::RPageSource::EnableDefaultMetrics(const std::st
 ROOT::Experimental::Detail::RPageSink::RPageSink(std::string_view name, const RNTupleWriteOptions &options)
    : RPageStorage(name), fMetrics(""), fOptions(options.Clone())
 {
+   fComputePageStatistics = fOptions->GetHasPageStatistics();
 }
 
 ROOT::Experimental::Detail::RPageSink::~RPageSink()
@@ -399,6 +448,8 @@ void ROOT::Experimental::Detail::RPageSink::CommitPage(ColumnHandle_t columnHand
    RClusterDescriptor::RPageRange::RPageInfo pageInfo;
    pageInfo.fNElements = page.GetNElements();
    pageInfo.fLocator = CommitPageImpl(columnHandle, page);
+   if (fComputePageStatistics)
+      pageInfo.fStatistics = ComputeStatistics(page, *columnHandle.fColumn);
    fOpenPageRanges.at(columnHandle.fPhysicalId).fPageInfos.emplace_back(pageInfo);
 }
 
@@ -411,6 +462,7 @@ void ROOT::Experimental::Detail::RPageSink::CommitSealedPage(
    RClusterDescriptor::RPageRange::RPageInfo pageInfo;
    pageInfo.fNElements = sealedPage.fNElements;
    pageInfo.fLocator = CommitSealedPageImpl(physicalColumnId, sealedPage);
+   pageInfo.fStatistics = sealedPage.fStatistics;
    fOpenPageRanges.at(physicalColumnId).fPageInfos.emplace_back(pageInfo);
 }
 
@@ -437,6 +489,7 @@ void ROOT::Experimental::Detail::RPageSink::CommitSealedPageV(std::span<RPageSto
          RClusterDescriptor::RPageRange::RPageInfo pageInfo;
          pageInfo.fNElements = sealedPageIt->fNElements;
          pageInfo.fLocator = locators[i++];
+         pageInfo.fStatistics = sealedPageIt->fStatistics;
          fOpenPageRanges.at(range.fPhysicalColumnId).fPageInfos.emplace_back(pageInfo);
       }
    }
@@ -541,6 +594,38 @@ ROOT::Experimental::Detail::RPageSink::SealPage(
    return SealPage(page, element, compressionSetting, fCompressor->GetZipBuffer());
 }
 
+ROOT::Experimental::RClusterDescriptor::RStatistics
+ROOT::Experimental::Detail::RPageSink::ComputeStatistics(const RPage &page, const RColumn &column)
+{
+   const void *buffer = page.GetBuffer();
+   const auto nElements = page.GetNElements();
+   // The in-memory type of Double32_t columns is double although the on-disk type is a 32bit float
+   const bool isDoubleInMemory = column.GetElement()->GetSize() == sizeof(double);
+   switch (column.GetModel().GetType()) {
+   case EColumnType::kReal64:
+   case EColumnType::kSplitReal64: return ComputeStatisticsImpl<double>(buffer, nElements);
+   case EColumnType::kReal32:
+   case EColumnType::kSplitReal32:
+      return isDoubleInMemory ? ComputeStatisticsImpl<double>(buffer, nElements)
+                              : ComputeStatisticsImpl<float>(buffer, nElements);
+   case EColumnType::kInt64:
+   case EColumnType::kSplitInt64: return ComputeStatisticsImpl<std::int64_t>(buffer, nElements);
+   case EColumnType::kUInt64:
+   case EColumnType::kSplitUInt64: return ComputeStatisticsImpl<std::uint64_t>(buffer, nElements);
+   case EColumnType::kInt32:
+   case EColumnType::kSplitInt32: return ComputeStatisticsImpl<std::int32_t>(buffer, nElements);
+   case EColumnType::kUInt32:
+   case EColumnType::kSplitUInt32: return ComputeStatisticsImpl<std::uint32_t>(buffer, nElements);
+   case EColumnType::kInt16:
+   case EColumnType::kSplitInt16: return ComputeStatisticsImpl<std::int16_t>(buffer, nElements);
+   case EColumnType::kUInt16:
+   case EColumnType::kSplitUInt16: return ComputeStatisticsImpl<std::uint16_t>(buffer, nElements);
+   case EColumnType::kInt8: return ComputeStatisticsImpl<std::int8_t>(buffer, nElements);
+   case EColumnType::kUInt8: return ComputeStatisticsImpl<std::uint8_t>(buffer, nElements);
+   default: return RClusterDescriptor::RStatistics();
+   }
+}
+
 void ROOT::Experimental::Detail::RPageSink::EnableDefaultMetrics(const std::string &prefix)
 {
    fMetrics = RNTupleMetrics(prefix);
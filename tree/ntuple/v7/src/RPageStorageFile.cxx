@@ -62,6 +62,10 @@ ROOT::Experimental::Detail::RPageSinkFile::RPageSinkFile(std::string_view ntuple
 {
    fWriter = std::unique_ptr<Internal::RNTupleFileWriter>(Internal::RNTupleFileWriter::Recreate(
       ntupleName, path, options.GetCompression(), options.GetContainerFormat()));
+   if (options.GetUseAsyncWrite()) {
+      // Allow for one cluster being written while the next one is committed
+      fWriter->EnableAsyncWrite(2 * options.GetApproxZippedClusterSize());
+   }
 }
 
 
@@ -246,6 +250,12 @@ void ROOT::Experimental::Detail::RPageSourceFile::InitDescriptor(const Internal:
    fReader.ReadBuffer(zipBuffer.get(), anchor.fNBytesFooter, anchor.fSeekFooter);
    fDecompressor->Unzip(zipBuffer.get(), anchor.fNBytesFooter, anchor.fLenFooter, buffer.get());
    Internal::RNTupleSerializer::DeserializeFooterV1(buffer.get(), anchor.fLenFooter, fDescriptorBuilder);
+
+   if (fOptions.GetUseSharedPageCache()) {
+      // The footer position distinguishes different ntuples that were subsequently written to the same location
+      fSharedPageCacheId = RSharedPageCache::Instance().GetStorageId(
+         fFile->GetUrl() + ":" + fDescriptorBuilder.GetDescriptor().GetName() + ":" + std::to_string(anchor.fSeekFooter));
+   }
 }
 
 std::unique_ptr<ROOT::Experimental::Detail::RPageSourceFile>
@@ -306,6 +316,7 @@ void ROOT::Experimental::Detail::RPageSourceFile::LoadSealedPage(DescriptorId_t
    const auto bytesOnStorage = pageInfo.fLocator.fBytesOnStorage;
    sealedPage.fSize = bytesOnStorage;
    sealedPage.fNElements = pageInfo.fNElements;
+   sealedPage.fStatistics = pageInfo.fStatistics;
    if (!sealedPage.fBuffer)
       return;
    if (pageInfo.fLocator.fType != RNTupleLocator::kTypePageZero) {
@@ -341,6 +352,13 @@ ROOT::Experimental::Detail::RPageSourceFile::PopulatePageFromCluster(ColumnHandl
       return pageZero;
    }
 
+   const bool useSharedPageCache = fOptions.GetUseSharedPageCache();
+   const RSharedPageCache::RKey sharedKey(fSharedPageCacheId, columnId, clusterId, pageInfo.fPageNo);
+   if (useSharedPageCache) {
+      if (auto sharedBuffer = RSharedPageCache::Instance().Acquire(sharedKey))
+         return RegisterSharedPage(columnHandle, clusterInfo, sharedBuffer);
+   }
+
    if (fOptions.GetClusterCache() == RNTupleReadOptions::EClusterCache::kOff) {
       directReadBuffer = std::make_unique<unsigned char[]>(bytesOnStorage);
       fReader.ReadBuffer(directReadBuffer.get(), bytesOnStorage, pageInfo.fLocator.GetPosition<std::uint64_t>());
@@ -356,6 +374,11 @@ ROOT::Experimental::Detail::RPageSourceFile::PopulatePageFromCluster(ColumnHandl
       auto cachedPage = fPagePool->GetPage(columnId, RClusterIndex(clusterId, idxInCluster));
       if (!cachedPage.IsNull())
          return cachedPage;
+      // Loading the cluster may have put the page into the shared cache
+      if (useSharedPageCache) {
+         if (auto sharedBuffer = RSharedPageCache::Instance().Acquire(sharedKey))
+            return RegisterSharedPage(columnHandle, clusterInfo, sharedBuffer);
+      }
 
       ROnDiskPage::Key key(columnId, pageInfo.fPageNo);
       auto onDiskPage = fCurrentCluster->GetOnDiskPage(key);
@@ -370,6 +393,13 @@ ROOT::Experimental::Detail::RPageSourceFile::PopulatePageFromCluster(ColumnHandl
       fCounters->fSzUnzip.Add(elementSize * pageInfo.fNElements);
    }
 
+   if (useSharedPageCache) {
+      fCounters->fNPagePopulated.Inc();
+      auto sharedBuffer = RSharedPageCache::Instance().Insert(sharedKey, std::move(pageBuffer),
+                                                              elementSize * pageInfo.fNElements, true /* acquire */);
+      return RegisterSharedPage(columnHandle, clusterInfo, sharedBuffer);
+   }
+
    auto newPage = fPageAllocator->NewPage(columnId, pageBuffer.release(), elementSize, pageInfo.fNElements);
    newPage.SetWindow(clusterInfo.fColumnOffset + pageInfo.fFirstInPage,
                      RPage::RClusterInfo(clusterId, clusterInfo.fColumnOffset));
@@ -383,6 +413,24 @@ ROOT::Experimental::Detail::RPageSourceFile::PopulatePageFromCluster(ColumnHandl
 }
 
 
+ROOT::Experimental::Detail::RPage
+ROOT::Experimental::Detail::RPageSourceFile::RegisterSharedPage(ColumnHandle_t columnHandle,
+                                                                const RClusterInfo &clusterInfo, unsigned char *buffer)
+{
+   const auto columnId = columnHandle.fPhysicalId;
+   const auto &pageInfo = clusterInfo.fPageInfo;
+   const RSharedPageCache::RKey sharedKey(fSharedPageCacheId, columnId, clusterInfo.fClusterId, pageInfo.fPageNo);
+
+   auto newPage =
+      fPageAllocator->NewPage(columnId, buffer, columnHandle.fColumn->GetElement()->GetSize(), pageInfo.fNElements);
+   newPage.SetWindow(clusterInfo.fColumnOffset + pageInfo.fFirstInPage,
+                     RPage::RClusterInfo(clusterInfo.fClusterId, clusterInfo.fColumnOffset));
+   fPagePool->RegisterPage(newPage, RPageDeleter([sharedKey](const RPage & /*page*/, void * /*userData*/) {
+                              RSharedPageCache::Instance().Release(sharedKey);
+                           }));
+   return newPage;
+}
+
 ROOT::Experimental::Detail::RPage ROOT::Experimental::Detail::RPageSourceFile::PopulatePage(
    ColumnHandle_t columnHandle, NTupleSize_t globalIndex)
 {
@@ -622,14 +670,27 @@ void ROOT::Experimental::Detail::RPageSourceFile::UnzipClusterImpl(RCluster *clu
          R__ASSERT(onDiskPage && (onDiskPage->GetSize() == pi.fLocator.fBytesOnStorage));
 
          auto taskFunc =
-            [this, columnId, clusterId, firstInPage, onDiskPage,
+            [this, columnId, clusterId, firstInPage, onDiskPage, pageNo,
              element = allElements.back().get(),
              nElements = pi.fNElements,
              indexOffset = clusterDescriptor.GetColumnRange(columnId).fFirstElementIndex
             ] () {
+               // With the shared page cache, unzipped pages are not preloaded into the page pool but they are handed
+               // over to the shared cache, where PopulatePage() picks them up
+               const RSharedPageCache::RKey sharedKey(fSharedPageCacheId, columnId, clusterId, pageNo);
+               const bool useSharedPageCache = fOptions.GetUseSharedPageCache();
+               if (useSharedPageCache && RSharedPageCache::Instance().Contains(sharedKey))
+                  return;
+
                auto pageBuffer = UnsealPage({onDiskPage->GetAddress(), onDiskPage->GetSize(), nElements}, *element);
                fCounters->fSzUnzip.Add(element->GetSize() * nElements);
 
+               if (useSharedPageCache) {
+                  RSharedPageCache::Instance().Insert(sharedKey, std::move(pageBuffer), element->GetSize() * nElements,
+                                                      false /* acquire */);
+                  return;
+               }
+
                auto newPage = fPageAllocator->NewPage(columnId, pageBuffer.release(), element->GetSize(), nElements);
                newPage.SetWindow(indexOffset + firstInPage, RPage::RClusterInfo(clusterId, indexOffset));
                fPagePool->PreloadPage(newPage,
@@ -87,6 +87,50 @@ TEST(MiniFile, Stream)
 }
 
 
+TEST(MiniFile, AsyncStream)
+{
+   FileRaii fileGuard("test_ntuple_minifile_async_stream.root");
+
+   auto writer = std::unique_ptr<RNTupleFileWriter>(
+      RNTupleFileWriter::Recreate("MyNTuple", fileGuard.GetPath(), 0, ENTupleContainerFormat::kTFile));
+   // A small limit of in-flight bytes forces the writer to wait for the background thread
+   writer->EnableAsyncWrite(16);
+   char header = 'h';
+   char footer = 'f';
+   auto offHeader = writer->WriteNTupleHeader(&header, 1, 1);
+   std::vector<std::uint64_t> offBlobs;
+   std::vector<char> blob(10);
+   for (char i = 0; i < 100; ++i) {
+      std::fill(blob.begin(), blob.end(), i);
+      offBlobs.emplace_back(writer->WriteBlob(blob.data(), blob.size(), blob.size()));
+   }
+   auto offFooter = writer->WriteNTupleFooter(&footer, 1, 1);
+   writer->Commit();
+
+   auto rawFile = RRawFile::Create(fileGuard.GetPath());
+   RMiniFileReader reader(rawFile.get());
+   auto ntuple = reader.GetNTuple("MyNTuple").Inspect();
+   EXPECT_EQ(offHeader, ntuple.fSeekHeader);
+   EXPECT_EQ(offFooter, ntuple.fSeekFooter);
+
+   char buf;
+   reader.ReadBuffer(&buf, 1, offHeader);
+   EXPECT_EQ(header, buf);
+   reader.ReadBuffer(&buf, 1, offFooter);
+   EXPECT_EQ(footer, buf);
+   std::vector<char> blobBuf(10);
+   for (char i = 0; i < 100; ++i) {
+      reader.ReadBuffer(blobBuf.data(), blobBuf.size(), offBlobs[i]);
+      EXPECT_EQ(std::vector<char>(10, i), blobBuf);
+   }
+
+   auto file = std::unique_ptr<TFile>(TFile::Open(fileGuard.GetPath().c_str(), "READ"));
+   ASSERT_TRUE(file);
+   auto k = std::unique_ptr<ROOT::Experimental::RNTuple>(file->Get<ROOT::Experimental::RNTuple>("MyNTuple"));
+   EXPECT_TRUE(IsEqual(ntuple, ROOT::Experimental::Internal::RNTupleTester(*k).GetAnchor()));
+}
+
+
 TEST(MiniFile, Proper)
 {
    FileRaii fileGuard("test_ntuple_minifile_proper.root");
@@ -113,6 +113,67 @@ TEST(RNTuple, ModelExtensionInvalidUse)
    EXPECT_EQ(3U, ntuple->GetDescriptor()->GetNFields());
 }
 
+TEST(RNTuple, ModelExtensionEntryList)
+{
+   FileRaii fileGuard("test_ntuple_modelext_entrylist.root");
+   {
+      auto model = RNTupleModel::Create();
+      model->MakeField<float>("pt", 42.0);
+
+      auto ntuple = RNTupleWriter::Recreate(std::move(model), "myNTuple", fileGuard.GetPath());
+      for (unsigned i = 0; i < 10; ++i)
+         ntuple->Fill();
+      ntuple->CommitCluster();
+
+      auto modelUpdater = ntuple->CreateModelUpdater();
+      modelUpdater->BeginUpdate();
+      auto field = std::make_unique<RField<std::unique_ptr<float>>>("trigger");
+      field->SetEntryList();
+      modelUpdater->AddField(std::move(field));
+      modelUpdater->CommitUpdate();
+
+      auto trigger = ntuple->GetModel()->GetDefaultEntry()->Get<std::unique_ptr<float>>("trigger");
+      for (unsigned i = 10; i < 1000; ++i) {
+         *trigger = (i % 100 == 0) ? std::make_unique<float>(i) : nullptr;
+         ntuple->Fill();
+         if (i % 300 == 0)
+            ntuple->CommitCluster();
+      }
+   }
+
+   auto ntuple = RNTupleReader::Open("myNTuple", fileGuard.GetPath());
+   EXPECT_EQ(1000U, ntuple->GetNEntries());
+   // Only the available items are stored
+   const auto &desc = *ntuple->GetDescriptor();
+   const auto fieldId = desc.FindFieldId("trigger");
+   const auto columnId = desc.FindPhysicalColumnId(fieldId, 0);
+   EXPECT_EQ(EColumnType::kSplitUInt64, desc.GetColumnDescriptor(columnId).GetModel().GetType());
+   EXPECT_EQ(9U, desc.GetNElements(columnId));
+
+   auto trigger = ntuple->GetView<std::unique_ptr<float>>("trigger");
+   for (auto i : ntuple->GetEntryRange()) {
+      if (i >= 100 && i % 100 == 0) {
+         ASSERT_TRUE(trigger(i));
+         EXPECT_FLOAT_EQ(static_cast<float>(i), *trigger(i));
+      } else {
+         EXPECT_FALSE(trigger(i));
+      }
+   }
+   // Random access, jumping back and forth across clusters
+   EXPECT_FLOAT_EQ(900.0, *trigger(900));
+   EXPECT_FLOAT_EQ(100.0, *trigger(100));
+   EXPECT_FALSE(trigger(650));
+   EXPECT_FLOAT_EQ(500.0, *trigger(500));
+   EXPECT_FLOAT_EQ(600.0, *trigger(600));
+   EXPECT_FALSE(trigger(999));
+   EXPECT_FALSE(trigger(5));
+   EXPECT_FLOAT_EQ(300.0, *trigger(300));
+
+   std::vector<NTupleSize_t> expected{100, 200, 300, 400, 500, 600, 700, 800, 900};
+   EXPECT_EQ(expected, trigger.GetNonNullIndexes(0, ntuple->GetNEntries()));
+   EXPECT_EQ((std::vector<NTupleSize_t>{300, 400}), trigger.GetNonNullIndexes(250, 500));
+}
+
 TEST(RNTuple, ModelExtensionMultiple)
 {
    FileRaii fileGuard("test_ntuple_modelext_multiple.root");
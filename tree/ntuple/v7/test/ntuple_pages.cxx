@@ -56,3 +56,82 @@ TEST(Pages, Pool)
    page = pool.GetPage(1, 55);
    EXPECT_TRUE(page.IsNull());
 }
+
+TEST(Pages, SharedPageCache)
+{
+   auto &cache = RSharedPageCache::Instance();
+   const auto budget = cache.GetMemoryBudget();
+   cache.Clear();
+   const auto usage = cache.GetMemoryUsage();
+
+   const auto storageId = cache.GetStorageId("test_shared_page_cache");
+   EXPECT_EQ(storageId, cache.GetStorageId("test_shared_page_cache"));
+   EXPECT_NE(storageId, cache.GetStorageId("test_shared_page_cache_other"));
+
+   RSharedPageCache::RKey key1(storageId, 0, 0, 0);
+   RSharedPageCache::RKey key2(storageId, 0, 0, 1);
+   EXPECT_EQ(nullptr, cache.Acquire(key1));
+   EXPECT_FALSE(cache.Contains(key1));
+
+   auto buffer1 = cache.Insert(key1, std::make_unique<unsigned char[]>(100), 100, true /* acquire */);
+   EXPECT_NE(nullptr, buffer1);
+   // A second insert of the same page keeps the first buffer
+   EXPECT_EQ(buffer1, cache.Insert(key1, std::make_unique<unsigned char[]>(100), 100, true /* acquire */));
+   EXPECT_EQ(buffer1, cache.Acquire(key1));
+   EXPECT_EQ(usage + 100, cache.GetMemoryUsage());
+
+   cache.Insert(key2, std::make_unique<unsigned char[]>(50), 50, false /* acquire */);
+   EXPECT_TRUE(cache.Contains(key2));
+   EXPECT_EQ(usage + 150, cache.GetMemoryUsage());
+
+   // Pages in use are not evicted
+   cache.SetMemoryBudget(0);
+   EXPECT_FALSE(cache.Contains(key2));
+   EXPECT_TRUE(cache.Contains(key1));
+   cache.Release(key1);
+   cache.Release(key1);
+   EXPECT_TRUE(cache.Contains(key1));
+   cache.Release(key1);
+   EXPECT_FALSE(cache.Contains(key1));
+   EXPECT_EQ(usage, cache.GetMemoryUsage());
+
+   cache.SetMemoryBudget(budget);
+}
+
+TEST(Pages, SharedPageCacheReaders)
+{
+   FileRaii fileGuard("test_ntuple_shared_page_cache.root");
+   {
+      auto model = RNTupleModel::Create();
+      auto fldPt = model->MakeField<float>("pt");
+      auto ntuple = RNTupleWriter::Recreate(std::move(model), "ntuple", fileGuard.GetPath());
+      for (int i = 0; i < 100; ++i) {
+         *fldPt = i;
+         ntuple->Fill();
+      }
+   }
+
+   RNTupleReadOptions options;
+   options.SetUseSharedPageCache(true);
+   auto reader1 = RNTupleReader::Open("ntuple", fileGuard.GetPath(), options);
+   auto reader2 = RNTupleReader::Open("ntuple", fileGuard.GetPath(), options);
+   reader1->EnableMetrics();
+   reader2->EnableMetrics();
+
+   auto viewPt1 = reader1->GetView<float>("pt");
+   auto viewPt2 = reader2->GetView<float>("pt");
+   for (auto i : reader1->GetEntryRange()) {
+      EXPECT_FLOAT_EQ(static_cast<float>(i), viewPt1(i));
+   }
+   for (auto i : reader2->GetEntryRange()) {
+      EXPECT_FLOAT_EQ(static_cast<float>(i), viewPt2(i));
+   }
+
+   auto ctrPopulated1 = reader1->GetMetrics().GetCounter("RNTupleReader.RPageSourceFile.nPagePopulated");
+   auto ctrPopulated2 = reader2->GetMetrics().GetCounter("RNTupleReader.RPageSourceFile.nPagePopulated");
+   ASSERT_NE(nullptr, ctrPopulated1);
+   ASSERT_NE(nullptr, ctrPopulated2);
+   EXPECT_GT(ctrPopulated1->GetValueAsInt(), 0);
+   // The second reader uses the pages unzipped by the first reader
+   EXPECT_EQ(0, ctrPopulated2->GetValueAsInt());
+}
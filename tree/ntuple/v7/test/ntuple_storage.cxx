@@ -527,3 +527,120 @@ TEST(RPageSink, MultipleClusterGroups)
    ntuple->LoadEntry(2);
    EXPECT_EQ(12.0, *rdPt);
 }
+
+TEST(RPageSink, PageStatistics)
+{
+   FileRaii fileGuard("test_ntuple_page_statistics.root");
+
+   auto model = RNTupleModel::Create();
+   auto wrPt = model->MakeField<float>("pt");
+   auto wrId = model->MakeField<std::int64_t>("id");
+   auto wrTag = model->MakeField<std::string>("tag");
+
+   {
+      RNTupleWriteOptions options;
+      options.SetHasPageStatistics(true);
+      options.SetApproxUnzippedPageSize(200);
+      auto ntuple = RNTupleWriter::Recreate(std::move(model), "ntuple", fileGuard.GetPath(), options);
+      for (int i = 0; i < 200; i++) {
+         *wrPt = (i == 100) ? std::numeric_limits<float>::quiet_NaN() : static_cast<float>(i);
+         *wrId = -i;
+         *wrTag = "abc";
+         ntuple->Fill();
+         if (i == 99)
+            ntuple->CommitCluster();
+      }
+   }
+
+   auto ntuple = RNTupleReader::Open("ntuple", fileGuard.GetPath());
+   const auto desc = ntuple->GetDescriptor();
+   ASSERT_EQ(2U, desc->GetNClusters());
+   const auto ptColumnId = desc->FindPhysicalColumnId(desc->FindFieldId("pt"), 0);
+   const auto idColumnId = desc->FindPhysicalColumnId(desc->FindFieldId("id"), 0);
+   const auto tagColumnId = desc->FindPhysicalColumnId(desc->FindFieldId("tag"), 0);
+
+   const auto &ptStats0 = desc->GetClusterDescriptor(0).GetColumnRange(ptColumnId).fStatistics;
+   EXPECT_TRUE(ptStats0.fIsAvailable);
+   EXPECT_EQ(0., ptStats0.fMin);
+   EXPECT_EQ(99., ptStats0.fMax);
+   EXPECT_EQ(0U, ptStats0.fNNulls);
+   const auto &ptStats1 = desc->GetClusterDescriptor(1).GetColumnRange(ptColumnId).fStatistics;
+   EXPECT_TRUE(ptStats1.fIsAvailable);
+   EXPECT_EQ(101., ptStats1.fMin);
+   EXPECT_EQ(199., ptStats1.fMax);
+   EXPECT_EQ(1U, ptStats1.fNNulls);
+   const auto &idStats0 = desc->GetClusterDescriptor(0).GetColumnRange(idColumnId).fStatistics;
+   EXPECT_EQ(-99., idStats0.fMin);
+   EXPECT_EQ(0., idStats0.fMax);
+   // No statistics for index columns
+   EXPECT_FALSE(desc->GetClusterDescriptor(0).GetColumnRange(tagColumnId).fStatistics.fIsAvailable);
+
+   // 50 elements per page
+   const auto &ptPages = desc->GetClusterDescriptor(1).GetPageRange(ptColumnId).fPageInfos;
+   ASSERT_LT(1U, ptPages.size());
+   NTupleSize_t firstInPage = 100;
+   for (const auto &pi : ptPages) {
+      EXPECT_TRUE(pi.fStatistics.fIsAvailable);
+      EXPECT_LE(static_cast<double>(firstInPage), pi.fStatistics.fMin);
+      EXPECT_GE(static_cast<double>(firstInPage + pi.fNElements - 1), pi.fStatistics.fMax);
+      firstInPage += pi.fNElements;
+   }
+
+   auto ranges = ntuple->GetEntryRanges({{"pt", 120., 130.}});
+   ASSERT_EQ(1U, ranges.size());
+   EXPECT_LE(100U, *ranges[0].begin());
+   EXPECT_GE(120U, *ranges[0].begin());
+   EXPECT_LE(131U, *ranges[0].end());
+   EXPECT_GE(200U, *ranges[0].end());
+
+   // The NaN value at entry 100 is not part of the value range of its page
+   EXPECT_TRUE(ntuple->GetEntryRanges({{"pt", 99.5, 100.5}}).empty());
+   EXPECT_TRUE(ntuple->GetEntryRanges({{"pt", 120., 130.}, {"id", -10., 0.}}).empty());
+   ranges = ntuple->GetEntryRanges({{"id", -5., 0.}});
+   ASSERT_EQ(1U, ranges.size());
+   EXPECT_EQ(0U, *ranges[0].begin());
+   // Fields without statistics do not restrict the entry ranges
+   ranges = ntuple->GetEntryRanges({{"tag", 0., 0.}});
+   ASSERT_EQ(1U, ranges.size());
+   EXPECT_EQ(0U, *ranges[0].begin());
+   EXPECT_EQ(200U, *ranges[0].end());
+
+   EXPECT_THROW(ntuple->GetEntryRanges({{"nonexistent", 0., 1.}}), RException);
+}
+
+TEST(RPageSinkFile, AsyncWrite)
+{
+   FileRaii fileGuard("test_ntuple_async_write.root");
+
+   auto model = RNTupleModel::Create();
+   auto wrPt = model->MakeField<float>("pt");
+   auto wrJets = model->MakeField<std::vector<std::int32_t>>("jets");
+   auto wrTag = model->MakeField<std::string>("tag");
+
+   {
+      RNTupleWriteOptions options;
+      options.SetUseAsyncWrite(true);
+      options.SetCompression(0);
+      // Mix pages that are written inline or coalesced with pages that are queued on their own
+      options.SetApproxZippedClusterSize(200 * 1000);
+      auto ntuple = RNTupleWriter::Recreate(std::move(model), "ntuple", fileGuard.GetPath(), options);
+      for (int i = 0; i < 100000; i++) {
+         *wrPt = static_cast<float>(i);
+         *wrJets = std::vector<std::int32_t>(i % 4, i);
+         *wrTag = (i % 1000 == 0) ? std::string("tag") + std::to_string(i) : "";
+         ntuple->Fill();
+      }
+   }
+
+   auto ntuple = RNTupleReader::Open("ntuple", fileGuard.GetPath());
+   ASSERT_EQ(100000U, ntuple->GetNEntries());
+   EXPECT_LT(1U, ntuple->GetDescriptor()->GetNClusters());
+   auto viewPt = ntuple->GetView<float>("pt");
+   auto viewJets = ntuple->GetView<std::vector<std::int32_t>>("jets");
+   auto viewTag = ntuple->GetView<std::string>("tag");
+   for (auto i : ntuple->GetEntryRange()) {
+      ASSERT_EQ(static_cast<float>(i), viewPt(i));
+      ASSERT_EQ(std::vector<std::int32_t>(i % 4, i), viewJets(i));
+      ASSERT_EQ((i % 1000 == 0) ? std::string("tag") + std::to_string(i) : "", viewTag(i));
+   }
+}
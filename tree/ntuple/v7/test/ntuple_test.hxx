@@ -105,6 +105,7 @@ using RPageSinkBuf = ROOT::Experimental::Detail::RPageSinkBuf;
 using RPageSinkFile = ROOT::Experimental::Detail::RPageSinkFile;
 using RPageSource = ROOT::Experimental::Detail::RPageSource;
 using RPageSourceFile = ROOT::Experimental::Detail::RPageSourceFile;
+using RSharedPageCache = ROOT::Experimental::Detail::RSharedPageCache;
 using RPageSourceFriends = ROOT::Experimental::Detail::RPageSourceFriends;
 using RPageStorage = ROOT::Experimental::Detail::RPageStorage;
 using RPrepareVisitor = ROOT::Experimental::RPrepareVisitor;
@@ -499,7 +499,9 @@ TEST(RNTuple, Bitset)
 struct RTagNullableFieldDefault {};
 struct RTagNullableFieldSparse {};
 struct RTagNullableFieldDense {};
-using UniquePtrTags = ::testing::Types<RTagNullableFieldDefault, RTagNullableFieldSparse, RTagNullableFieldDense>;
+struct RTagNullableFieldEntryList {};
+using UniquePtrTags = ::testing::Types<RTagNullableFieldDefault, RTagNullableFieldSparse, RTagNullableFieldDense,
+                                       RTagNullableFieldEntryList>;
 
 template <typename TagT>
 class UniquePtr : public ::testing::Test {
@@ -519,6 +521,9 @@ static void AddUniquePtrField(RNTupleModel &model, const std::string &fieldName)
    if constexpr (std::is_same_v<TagT, RTagNullableFieldDense>) {
       fld->SetDense();
    }
+   if constexpr (std::is_same_v<TagT, RTagNullableFieldEntryList>) {
+      fld->SetEntryList();
+   }
    model.AddField(std::move(fld));
 }
 
@@ -564,6 +569,16 @@ TYPED_TEST(UniquePtr, Basics)
          EXPECT_TRUE(dynamic_cast<const RUniquePtrField *>(writer->GetModel()->GetField("PPString"))->IsDense());
          EXPECT_TRUE(dynamic_cast<const RUniquePtrField *>(writer->GetModel()->GetField("PArray"))->IsDense());
       }
+      if constexpr (std::is_same_v<typename TestFixture::Tag_t, RTagNullableFieldEntryList>) {
+         auto fnGetField = [&writer](const std::string &name) {
+            return dynamic_cast<const RUniquePtrField *>(writer->GetModel()->GetField(name));
+         };
+         EXPECT_TRUE(fnGetField("PBool")->IsEntryList());
+         EXPECT_TRUE(fnGetField("PCustomStruct")->IsEntryList());
+         EXPECT_TRUE(fnGetField("PIOConstructor")->IsEntryList());
+         EXPECT_TRUE(fnGetField("PPString")->IsEntryList());
+         EXPECT_TRUE(fnGetField("PArray")->IsEntryList());
+      }
 
       auto pBool = writer->GetModel()->Get<std::unique_ptr<bool>>("PBool");
       auto pCustomStruct = writer->GetModel()->Get<std::unique_ptr<CustomStruct>>("PCustomStruct");
@@ -650,6 +665,36 @@ TYPED_TEST(UniquePtr, Basics)
    EXPECT_EQ(nullptr, pIOConstructor->get());
    EXPECT_EQ("de", *(ppString->get()->get()));
    EXPECT_EQ(nullptr, pArray->get());
+
+   // Random access after sequential reading, across the two clusters
+   reader->LoadEntry(1);
+   EXPECT_EQ(nullptr, pBool->get());
+   EXPECT_TRUE(ppString->get()->get()->empty());
+   reader->LoadEntry(4);
+   EXPECT_FALSE(*(pBool->get()));
+   EXPECT_EQ("de", *(ppString->get()->get()));
+   reader->LoadEntry(0);
+   EXPECT_TRUE(*(pBool->get()));
+   EXPECT_EQ(nullptr, ppString->get());
+   reader->LoadEntry(2);
+   EXPECT_EQ(nullptr, pBool->get());
+   EXPECT_EQ("abc", *(ppString->get()->get()));
+
+   if constexpr (std::is_same_v<typename TestFixture::Tag_t, RTagNullableFieldEntryList>) {
+      // Only the available items are stored: 3 for PBool, 2 for PCustomStruct, 3 for PPString
+      const auto &desc = *reader->GetDescriptor();
+      const auto boolColumnId = desc.FindPhysicalColumnId(desc.FindFieldId("PBool"), 0);
+      EXPECT_EQ(EColumnType::kSplitUInt64, desc.GetColumnDescriptor(boolColumnId).GetModel().GetType());
+      EXPECT_EQ(3U, desc.GetNElements(boolColumnId));
+      EXPECT_EQ(2U, desc.GetNElements(desc.FindPhysicalColumnId(desc.FindFieldId("PCustomStruct"), 0)));
+      EXPECT_EQ(3U, desc.GetNElements(desc.FindPhysicalColumnId(desc.FindFieldId("PPString"), 0)));
+   }
+
+   auto viewPString = reader->GetView<std::unique_ptr<std::unique_ptr<std::string>>>("PPString");
+   EXPECT_EQ((std::vector<NTupleSize_t>{1, 2, 4}), viewPString.GetNonNullIndexes(0, 5));
+   EXPECT_EQ((std::vector<NTupleSize_t>{2}), viewPString.GetNonNullIndexes(2, 4));
+   auto viewBool = reader->GetView<std::unique_ptr<bool>>("PBool");
+   EXPECT_EQ((std::vector<NTupleSize_t>{0, 3, 4}), viewBool.GetNonNullIndexes(0, 5));
 }
 
 TEST(RNTuple, UnsupportedStdTypes)
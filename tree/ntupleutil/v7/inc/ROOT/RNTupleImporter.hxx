@@ -30,6 +30,7 @@
 #include <cstdlib>
 #include <map>
 #include <memory>
+#include <utility>
 #include <vector>
 
 class TLeaf;
@@ -87,6 +88,20 @@ Most RNTuple fields have a type identical to the corresponding TTree input branc
       ROOT::RVec<float> jet_eta (projected from _collection0.jet_eta)
     These projections are meta-data only operations and don't involve duplicating the data.
 
+If implicit multi-threading is enabled and the parallel import is switched on by `SetIsParallel()`, the input tree is
+split at its cluster boundaries into ranges of roughly the size of an output cluster. Every range is converted by a
+separate task that reads from its own instance of the input file. The resulting clusters are appended to the output
+RNTuple in the order of the input entries, such that the entry order of the tree is preserved. Only a limited number of
+ranges, by default twice the size of the thread pool, are converted or wait in memory to be written at any time
+(see `SetMaxRangesInFlight()`).
+
+~~~ {.cpp}
+ROOT::EnableImplicitMT();
+auto importer = RNTupleImporter::Create("data.root", "TreeName", "output.root");
+importer->SetIsParallel(true);
+importer->Import();
+~~~
+
 Current limitations of the importer:
   - No support for trees containing TObject (or derived classes) or TClonesArray collections
   - Due to RNTuple currently storing data fully split, "don't split" markers are ignored
@@ -216,6 +231,10 @@ private:
 
    std::unique_ptr<TFile> fSourceFile;
    TTree *fSourceTree;
+   /// The file and the tree name from which the tasks of the parallel import open their own copy of the input tree.
+   /// Empty if the input tree is not backed by a file.
+   std::string fSourceFileName;
+   std::string fSourceTreeName;
 
    std::string fDestFileName;
    std::string fNTupleName;
@@ -231,6 +250,11 @@ private:
 
    /// No standard output, conversely if set to false, schema information and progress is printed.
    bool fIsQuiet = false;
+   /// Whether or not to convert the clusters of the input tree in parallel, which requires implicit multi-threading
+   bool fIsParallel = false;
+   /// In parallel mode, the maximum number of ranges that are converted or that wait for the previous ranges to be
+   /// written; zero means twice the size of the thread pool
+   std::size_t fMaxRangesInFlight = 0;
    std::unique_ptr<RProgressCallback> fProgressCallback;
 
    std::vector<RImportBranch> fImportBranches;
@@ -249,6 +273,18 @@ private:
    /// buffers used for reading and writing.
    RResult<void> PrepareSchema();
    void ReportSchema();
+   /// Reads the entries [firstEntry, lastEntry) from the source tree and fills them into the writer. If given,
+   /// `ctrZippedBytes` is used to report the progress.
+   void FillEntries(RNTupleWriter &writer, std::int64_t firstEntry, std::int64_t lastEntry,
+                    const Detail::RNTuplePerfCounter *ctrZippedBytes);
+   /// Creates a copy of the importer that reads from its own instance of the source tree, to be used by a single
+   /// task of the parallel import. Returns nullptr if the source tree is not backed by a file.
+   std::unique_ptr<RNTupleImporter> CloneForTask() const;
+   /// Splits the first nEntries of the source tree at the tree cluster boundaries into ranges that are
+   /// about the size of an output cluster.
+   std::vector<std::pair<std::int64_t, std::int64_t>> GetImportRanges(std::int64_t nEntries) const;
+   void ImportSequential(std::int64_t nEntries);
+   void ImportParallel(std::int64_t nEntries);
 
 public:
    RNTupleImporter(const RNTupleImporter &other) = delete;
@@ -276,11 +312,20 @@ public:
    /// Whether or not information and progress is printed to stdout.
    void SetIsQuiet(bool value) { fIsQuiet = value; }
 
+   /// Whether or not to convert the input tree in parallel. Only takes effect if implicit multi-threading is enabled
+   /// and the input tree is stored in a file; otherwise, the entries are imported sequentially.
+   void SetIsParallel(bool value) { fIsParallel = value; }
+   /// In parallel mode, converted ranges are kept in memory until all the previous ranges are written. This limits the
+   /// number of ranges that are converted or kept in memory at any time, and thus the memory usage of the import.
+   /// Zero (the default) means twice the size of the thread pool.
+   void SetMaxRangesInFlight(std::size_t value) { fMaxRangesInFlight = value; }
+
    /// Import works in two steps:
    /// 1. PrepareSchema() calls SetBranchAddress() on all the TTree branches and creates the corresponding RNTuple
    ///    fields and the model
    /// 2. An event loop reads every entry from the TTree, applies transformations where necessary, and writes the
-   ///    output entry to the RNTuple.
+   ///    output entry to the RNTuple. In parallel mode, every task runs the event loop for its range of entries
+   ///    and the resulting sealed pages are committed in order to the output RNTuple.
    void Import();
 }; // class RNTupleImporter
 
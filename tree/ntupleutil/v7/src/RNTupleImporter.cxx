@@ -19,9 +19,13 @@
 #include <ROOT/RNTupleImporter.hxx>
 #include <ROOT/RNTupleOptions.hxx>
 #include <ROOT/RNTupleUtil.hxx>
+#include <ROOT/RPageSinkMem.hxx>
 #include <ROOT/RPageStorage.hxx>
 #include <ROOT/RPageStorageFile.hxx>
 #include <ROOT/RStringView.hxx>
+#ifdef R__USE_IMT
+#include <ROOT/TTaskGroup.hxx>
+#endif
 
 #include <TBranch.h>
 #include <TClass.h>
@@ -30,11 +34,17 @@
 #include <TLeafC.h>
 #include <TLeafElement.h>
 #include <TLeafObject.h>
+#include <TROOT.h> // for IsImplicitMTEnabled()
 
+#include <algorithm>
 #include <cassert>
 #include <cstdint>
 #include <cstring>
+#include <deque>
+#include <exception>
+#include <functional>
 #include <iostream>
+#include <mutex>
 #include <utility>
 
 namespace {
@@ -95,6 +105,8 @@ ROOT::Experimental::RNTupleImporter::Create(std::string_view sourceFileName, std
    if (!importer->fSourceTree) {
       throw RException(R__FAIL("cannot read TTree " + std::string(treeName) + " from " + std::string(sourceFileName)));
    }
+   importer->fSourceFileName = sourceFileName;
+   importer->fSourceTreeName = treeName;
 
    // If we have IMT enabled, its best use is for parallel page compression
    importer->fSourceTree->SetImplicitMT(false);
@@ -112,6 +124,15 @@ ROOT::Experimental::RNTupleImporter::Create(TTree *sourceTree, std::string_view
    auto importer = std::unique_ptr<RNTupleImporter>(new RNTupleImporter());
    importer->fNTupleName = sourceTree->GetName();
    importer->fSourceTree = sourceTree;
+   // Only plain trees stored in a file can be opened again by the tasks of the parallel import
+   auto sourceDir = sourceTree->GetDirectory();
+   if (sourceDir && sourceDir->GetFile() && (sourceTree->IsA() == TTree::Class())) {
+      importer->fSourceFileName = sourceDir->GetFile()->GetName();
+      // The directory path has the form "file.root:/path/to/dir"
+      std::string dirPath = sourceDir->GetPath();
+      dirPath = dirPath.substr(dirPath.find(":/") + 2);
+      importer->fSourceTreeName = dirPath.empty() ? sourceTree->GetName() : dirPath + "/" + sourceTree->GetName();
+   }
 
    // If we have IMT enabled, its best use is for parallel page compression
    importer->fSourceTree->SetImplicitMT(false);
@@ -357,29 +378,63 @@ ROOT::Experimental::RResult<void> ROOT::Experimental::RNTupleImporter::PrepareSc
    return RResult<void>::Success();
 }
 
-void ROOT::Experimental::RNTupleImporter::Import()
+std::unique_ptr<ROOT::Experimental::RNTupleImporter> ROOT::Experimental::RNTupleImporter::CloneForTask() const
 {
-   if (fDestFile->FindKey(fNTupleName.c_str()) != nullptr)
-      throw RException(R__FAIL("Key '" + fNTupleName + "' already exists in file " + fDestFileName));
-
-   PrepareSchema();
-
-   auto sink = std::make_unique<Detail::RPageSinkFile>(fNTupleName, *fDestFile, fWriteOptions);
-   sink->GetMetrics().Enable();
-   auto ctrZippedBytes = sink->GetMetrics().GetCounter("RPageSinkFile.szWritePayload");
+   if (fSourceFileName.empty())
+      return nullptr;
 
-   auto ntplWriter = std::make_unique<RNTupleWriter>(std::move(fModel), std::move(sink));
-   fModel = nullptr;
-
-   fProgressCallback = fIsQuiet ? nullptr : std::make_unique<RDefaultProgressCallback>();
+   auto importer = std::unique_ptr<RNTupleImporter>(new RNTupleImporter());
+   importer->fSourceFile = std::unique_ptr<TFile>(TFile::Open(fSourceFileName.c_str()));
+   if (!importer->fSourceFile || importer->fSourceFile->IsZombie())
+      throw RException(R__FAIL("cannot open source file " + fSourceFileName));
+   importer->fSourceTree = importer->fSourceFile->Get<TTree>(fSourceTreeName.c_str());
+   if (!importer->fSourceTree)
+      throw RException(R__FAIL("cannot read TTree " + fSourceTreeName + " from " + fSourceFileName));
+   // Parallelism comes from the concurrent tasks
+   importer->fSourceTree->SetImplicitMT(false);
 
-   auto nEntries = fSourceTree->GetEntries();
+   importer->fNTupleName = fNTupleName;
+   importer->fWriteOptions = fWriteOptions;
+   importer->fConvertDotsInBranchNames = fConvertDotsInBranchNames;
+   importer->fIsQuiet = true;
+   auto result = importer->PrepareSchema();
+   if (!result)
+      throw RException(R__FORWARD_ERROR(result));
+   return importer;
+}
 
-   if (fMaxEntries >= 0 && fMaxEntries < nEntries) {
-      nEntries = fMaxEntries;
+std::vector<std::pair<std::int64_t, std::int64_t>>
+ROOT::Experimental::RNTupleImporter::GetImportRanges(std::int64_t nEntries) const
+{
+   std::vector<std::pair<std::int64_t, std::int64_t>> ranges;
+   if (nEntries <= 0)
+      return ranges;
+
+   // Estimate the number of entries per output cluster from the compressed size of the input tree
+   const auto nTotalEntries = std::max(fSourceTree->GetEntries(), Long64_t(1));
+   const double bytesPerEntry = static_cast<double>(fSourceTree->GetZipBytes()) / nTotalEntries;
+   const auto targetBytes = static_cast<double>(fWriteOptions.GetApproxZippedClusterSize());
+
+   auto clusterIter = fSourceTree->GetClusterIterator(0);
+   std::int64_t rangeStart = 0;
+   Long64_t clusterStart;
+   while ((clusterStart = clusterIter()) < nEntries) {
+      const auto clusterEnd = std::min<std::int64_t>(clusterIter.GetNextEntry(), nEntries);
+      if ((clusterEnd == nEntries) || (bytesPerEntry * (clusterEnd - rangeStart) >= targetBytes)) {
+         ranges.emplace_back(rangeStart, clusterEnd);
+         rangeStart = clusterEnd;
+      }
    }
+   if (rangeStart < nEntries)
+      ranges.emplace_back(rangeStart, nEntries);
+   return ranges;
+}
 
-   for (decltype(nEntries) i = 0; i < nEntries; ++i) {
+void ROOT::Experimental::RNTupleImporter::FillEntries(RNTupleWriter &writer, std::int64_t firstEntry,
+                                                      std::int64_t lastEntry,
+                                                      const Detail::RNTuplePerfCounter *ctrZippedBytes)
+{
+   for (auto i = firstEntry; i < lastEntry; ++i) {
       fSourceTree->GetEntry(i);
 
       for (const auto &[_, c] : fLeafCountCollections) {
@@ -402,11 +457,131 @@ void ROOT::Experimental::RNTupleImporter::Import()
          t->ResetEntry();
       }
 
-      ntplWriter->Fill(*fEntry);
+      writer.Fill(*fEntry);
 
-      if (fProgressCallback)
+      if (fProgressCallback && ctrZippedBytes)
          fProgressCallback->Call(ctrZippedBytes->GetValueAsInt(), i);
    }
+}
+
+void ROOT::Experimental::RNTupleImporter::ImportSequential(std::int64_t nEntries)
+{
+   auto sink = std::make_unique<Detail::RPageSinkFile>(fNTupleName, *fDestFile, fWriteOptions);
+   sink->GetMetrics().Enable();
+   auto ctrZippedBytes = sink->GetMetrics().GetCounter("RPageSinkFile.szWritePayload");
+
+   auto ntplWriter = std::make_unique<RNTupleWriter>(std::move(fModel), std::move(sink));
+   fModel = nullptr;
+
+   FillEntries(*ntplWriter, 0, nEntries, ctrZippedBytes);
+   if (fProgressCallback)
+      fProgressCallback->Finish(ctrZippedBytes->GetValueAsInt(), nEntries);
+}
+
+void ROOT::Experimental::RNTupleImporter::ImportParallel(std::int64_t nEntries)
+{
+#ifdef R__USE_IMT
+   auto sink = std::make_unique<Detail::RPageSinkFile>(fNTupleName, *fDestFile, fWriteOptions);
+   sink->GetMetrics().Enable();
+   auto ctrZippedBytes = sink->GetMetrics().GetCounter("RPageSinkFile.szWritePayload");
+   sink->Create(*fModel);
+
+   const auto ranges = GetImportRanges(nEntries);
+   // The converted clusters of every range; a range is committed to the sink once all previous ranges are committed
+   std::vector<std::unique_ptr<std::deque<Detail::RPageSinkMem::RSealedCluster>>> results(ranges.size());
+   std::size_t nextRange = 0;
+   // The ranges [nextRange, nScheduled) are being converted or wait in memory for the previous ranges to be committed.
+   // Their number is capped, such that a slow range does not hold back the converted output of all subsequent ranges.
+   std::size_t nScheduled = 0;
+   const std::size_t maxRangesInFlight =
+      (fMaxRangesInFlight > 0) ? fMaxRangesInFlight : 2 * std::max(ROOT::GetThreadPoolSize(), 1u);
+   NTupleSize_t nEntriesCommitted = 0;
+   std::exception_ptr error;
+   std::mutex lock;
+   RNTupleImtTaskScheduler taskScheduler;
+   std::function<void(std::size_t)> fnImportRange;
+
+   // Must be called with the lock held
+   auto fnScheduleRanges = [&]() {
+      while (!error && (nScheduled < ranges.size()) && (nScheduled < nextRange + maxRangesInFlight)) {
+         const auto idx = nScheduled++;
+         taskScheduler.AddTask([&fnImportRange, idx]() { fnImportRange(idx); });
+      }
+   };
+
+   auto fnCommitRange = [&](std::deque<Detail::RPageSinkMem::RSealedCluster> &clusters) {
+      for (const auto &cluster : clusters)
+         Detail::RPageSinkMem::CommitSealedCluster(cluster, *sink, nEntriesCommitted);
+   };
+
+   fnImportRange = [&](std::size_t idx) {
+      try {
+         auto clusters = std::make_unique<std::deque<Detail::RPageSinkMem::RSealedCluster>>();
+         {
+            auto importer = CloneForTask();
+            auto taskSink = std::make_unique<Detail::RPageSinkMem>(fNTupleName, fWriteOptions, *clusters);
+            RNTupleWriter writer(std::move(importer->fModel), std::move(taskSink));
+            importer->FillEntries(writer, ranges[idx].first, ranges[idx].second, nullptr);
+            // The destructor of the writer commits the last cluster
+         }
+
+         std::lock_guard<std::mutex> guard(lock);
+         if (error)
+            return;
+         results[idx] = std::move(clusters);
+         while ((nextRange < ranges.size()) && results[nextRange]) {
+            fnCommitRange(*results[nextRange]);
+            results[nextRange] = nullptr;
+            nextRange++;
+            if (fProgressCallback)
+               fProgressCallback->Call(ctrZippedBytes->GetValueAsInt(), nEntriesCommitted);
+         }
+         fnScheduleRanges();
+      } catch (...) {
+         std::lock_guard<std::mutex> guard(lock);
+         if (!error)
+            error = std::current_exception();
+      }
+   };
+
+   {
+      std::lock_guard<std::mutex> guard(lock);
+      fnScheduleRanges();
+   }
+   // Finished tasks schedule the next ranges, so the task group only runs empty once all ranges are imported
+   taskScheduler.Wait();
+   if (error)
+      std::rethrow_exception(error);
+
+   sink->CommitClusterGroup();
+   sink->CommitDataset();
+   fModel = nullptr;
+
    if (fProgressCallback)
       fProgressCallback->Finish(ctrZippedBytes->GetValueAsInt(), nEntries);
+#else
+   ImportSequential(nEntries);
+#endif
+}
+
+void ROOT::Experimental::RNTupleImporter::Import()
+{
+   if (fDestFile->FindKey(fNTupleName.c_str()) != nullptr)
+      throw RException(R__FAIL("Key '" + fNTupleName + "' already exists in file " + fDestFileName));
+
+   PrepareSchema();
+
+   fProgressCallback = fIsQuiet ? nullptr : std::make_unique<RDefaultProgressCallback>();
+
+   auto nEntries = fSourceTree->GetEntries();
+
+   if (fMaxEntries >= 0 && fMaxEntries < nEntries) {
+      nEntries = fMaxEntries;
+   }
+
+   if (fIsParallel && ROOT::IsImplicitMTEnabled() && !fSourceFileName.empty()) {
+      ImportParallel(nEntries);
+   } else {
+      ImportSequential(nEntries);
+   }
 }
@@ -3,6 +3,7 @@
 #include <TFile.h>
 #include <TTree.h>
 #include <TChain.h>
+#include <TROOT.h>
 
 #include <cstdio>
 #include <string>
@@ -638,3 +639,94 @@ TEST(RNTUpleImporter, MaxEntries)
    reader = RNTupleReader::Open("ntuple4", fileGuard.GetPath());
    EXPECT_EQ(5U, reader->GetNEntries());
 }
+
+#ifdef R__USE_IMT
+TEST(RNTupleImporter, Parallel)
+{
+   FileRaii fileGuardTree("test_ntuple_importer_parallel_tree.root");
+   FileRaii fileGuardNTuple("test_ntuple_importer_parallel_ntuple.root");
+   {
+      std::unique_ptr<TFile> file(TFile::Open(fileGuardTree.GetPath().c_str(), "RECREATE"));
+      auto tree = std::make_unique<TTree>("tree", "");
+      tree->SetAutoFlush(100);
+      Int_t a;
+      Int_t njets;
+      float jet_pt[3];
+      tree->Branch("a", &a);
+      tree->Branch("njets", &njets);
+      tree->Branch("jet_pt", jet_pt, "jet_pt[njets]");
+      for (Int_t i = 0; i < 1000; ++i) {
+         a = i;
+         njets = i % 4;
+         for (Int_t j = 0; j < njets; ++j)
+            jet_pt[j] = i + j;
+         tree->Fill();
+      }
+      tree->Write();
+   }
+
+   ROOT::EnableImplicitMT(4);
+   auto importer = RNTupleImporter::Create(fileGuardTree.GetPath(), "tree", fileGuardNTuple.GetPath());
+   importer->SetIsQuiet(true);
+   importer->SetIsParallel(true);
+   auto writeOptions = importer->GetWriteOptions();
+   writeOptions.SetApproxUnzippedPageSize(64);
+   writeOptions.SetApproxZippedClusterSize(1000);
+   importer->SetWriteOptions(writeOptions);
+   importer->Import();
+   ROOT::DisableImplicitMT();
+
+   auto reader = RNTupleReader::Open("tree", fileGuardNTuple.GetPath());
+   EXPECT_EQ(1000U, reader->GetNEntries());
+   EXPECT_LT(1U, reader->GetDescriptor()->GetNClusters());
+   auto viewA = reader->GetView<std::int32_t>("a");
+   auto viewNjets = reader->GetView<ROOT::Experimental::RNTupleCardinality<std::uint32_t>>("njets");
+   auto viewJetPt = reader->GetView<ROOT::RVec<float>>("jet_pt");
+   for (auto i : reader->GetEntryRange()) {
+      EXPECT_EQ(static_cast<std::int32_t>(i), viewA(i));
+      EXPECT_EQ(i % 4, viewNjets(i));
+      const auto jetPt = viewJetPt(i);
+      ASSERT_EQ(i % 4, jetPt.size());
+      for (std::size_t j = 0; j < jetPt.size(); ++j)
+         EXPECT_FLOAT_EQ(static_cast<float>(i + j), jetPt[j]);
+   }
+}
+
+TEST(RNTupleImporter, ParallelMaxRangesInFlight)
+{
+   FileRaii fileGuardTree("test_ntuple_importer_parallel_window_tree.root");
+   FileRaii fileGuardNTuple("test_ntuple_importer_parallel_window_ntuple.root");
+   {
+      std::unique_ptr<TFile> file(TFile::Open(fileGuardTree.GetPath().c_str(), "RECREATE"));
+      auto tree = std::make_unique<TTree>("tree", "");
+      tree->SetAutoFlush(10);
+      Int_t a;
+      tree->Branch("a", &a);
+      for (Int_t i = 0; i < 2000; ++i) {
+         a = i;
+         tree->Fill();
+      }
+      tree->Write();
+   }
+
+   ROOT::EnableImplicitMT(4);
+   auto importer = RNTupleImporter::Create(fileGuardTree.GetPath(), "tree", fileGuardNTuple.GetPath());
+   importer->SetIsQuiet(true);
+   importer->SetIsParallel(true);
+   // Many more ranges than can be in flight at the same time
+   importer->SetMaxRangesInFlight(2);
+   auto writeOptions = importer->GetWriteOptions();
+   writeOptions.SetApproxUnzippedPageSize(32);
+   writeOptions.SetApproxZippedClusterSize(100);
+   importer->SetWriteOptions(writeOptions);
+   importer->Import();
+   ROOT::DisableImplicitMT();
+
+   auto reader = RNTupleReader::Open("tree", fileGuardNTuple.GetPath());
+   EXPECT_EQ(2000U, reader->GetNEntries());
+   EXPECT_LT(10U, reader->GetDescriptor()->GetNClusters());
+   auto viewA = reader->GetView<std::int32_t>("a");
+   for (auto i : reader->GetEntryRange())
+      EXPECT_EQ(static_cast<std::int32_t>(i), viewA(i));
+}
+#endif
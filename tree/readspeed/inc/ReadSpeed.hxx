@@ -19,6 +19,14 @@
 
 namespace ReadSpeed {
 
+/// How the values of the branches (or of the RNTuple fields) are read.
+enum class EReadMethod {
+   kRaw,        ///< TBranch::GetEntry, entry by entry
+   kTreeReader, ///< TTreeReader, the interface RDataFrame uses to read TTrees
+   kBulk,       ///< The bulk interface of TBranch, one basket at a time
+   kNTuple      ///< RNTupleReader::LoadEntry, on RNTuples instead of TTrees
+};
+
 struct Data {
    /// Either a single tree name common for all files, or one tree name per file.
    std::vector<std::string> fTreeNames;
@@ -28,6 +36,12 @@ struct Data {
    std::vector<std::string> fBranchNames;
    /// If the branch names should use regex matching.
    bool fUseRegex = false;
+   /// How the data is read. With EReadMethod::kNTuple, fTreeNames are RNTuple names and fBranchNames field names.
+   EReadMethod fReadMethod = EReadMethod::kRaw;
+   /// Size of the TTreeCache in bytes, 0 to disable it, -1 to read without setting up a TTreeCache.
+   Long64_t fCacheSize = -1;
+   /// Number of clusters RNTuple reads in one go, 0 for the default.
+   unsigned int fClusterBunchSize = 0;
 };
 
 struct Result {
@@ -45,6 +59,11 @@ struct Result {
    ULong64_t fCompressedBytesRead;
    /// Size of ROOT's thread pool for the run (0 indicates a single-thread run with no thread pool present).
    unsigned int fThreadPoolSize;
+   /// Compression settings of the data read (of the first branch or RNTuple), -1 if unknown.
+   int fCompressionSettings = -1;
+   /// Whether fUncompressedBytesRead is estimated from the size of the branches instead of measured, as for
+   /// EReadMethod::kTreeReader which does not report the bytes it reads.
+   bool fUncompressedBytesEstimated = false;
 };
 
 struct EntryRange {
@@ -65,11 +84,22 @@ struct ReadSpeedRegex {
 };
 
 std::vector<std::string> GetMatchingBranchNames(const std::string &fileName, const std::string &treeName,
-                                                const std::vector<ReadSpeedRegex> &regexes);
+                                                const std::vector<ReadSpeedRegex> &regexes,
+                                                EReadMethod method = EReadMethod::kRaw);
 
 // Read branches listed in branchNames in tree treeName in file fileName, return number of uncompressed bytes read.
 ByteData ReadTree(TFile *file, const std::string &treeName, const std::vector<std::string> &branchNames,
-                  EntryRange range = {-1, -1});
+                  EntryRange range = {-1, -1}, EReadMethod method = EReadMethod::kRaw, Long64_t cacheSize = -1);
+
+// Read fields listed in fieldNames in RNTuple ntupleName in file fileName, return the number of bytes read.
+ByteData ReadNTuple(const std::string &fileName, const std::string &ntupleName,
+                    const std::vector<std::string> &fieldNames, EntryRange range = {-1, -1},
+                    unsigned int clusterBunchSize = 0);
+
+// Return the compression settings of the first branch (or of the RNTuple) read from the first file.
+int GetCompressionSettings(const Data &d);
+
+std::string GetReadMethodName(EReadMethod method);
 
 Result EvalThroughputST(const Data &d);
 
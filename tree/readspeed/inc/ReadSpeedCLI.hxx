@@ -16,6 +16,7 @@
 
 #include "ReadSpeed.hxx"
 
+#include <string>
 #include <vector>
 
 namespace ReadSpeed {
@@ -27,11 +28,30 @@ struct Args {
    unsigned int fNThreads = 0;
    bool fAllBranches = false;
    bool fShouldRun = false;
+   /// Number of threads of each run, if several were given to measure the thread scaling.
+   std::vector<unsigned int> fThreadScan;
+   /// File the results are appended to, in CSV format.
+   std::string fOutputFile;
+   /// File with the results of previous runs (e.g. with an older ROOT release) to compare to, in CSV format.
+   std::string fBaselineFile;
+   /// Largest relative decrease of throughput with respect to the baseline that is not reported as a regression.
+   double fTolerance = 0.1;
 };
 
 Args ParseArgs(const std::vector<std::string> &args);
 Args ParseArgs(int argc, char **argv);
 
+/// The CSV header of the results written by WriteResults.
+std::string GetCSVHeader();
+/// One line of CSV with the configuration of the run and its results, in the columns of GetCSVHeader().
+std::string FormatCSVRecord(const Data &d, const Result &r);
+/// Append the results to the CSV file, writing the header first if the file is new.
+void WriteResults(const std::string &fileName, const Data &d, const std::vector<Result> &results);
+/// Compare the uncompressed throughput of the results to the ones of the runs with the same configuration in the
+/// baseline CSV file, print them and return the number of regressions larger than the tolerance.
+unsigned int CompareToBaseline(const std::string &fileName, const Data &d, const std::vector<Result> &results,
+                               double tolerance);
+
 } // namespace ReadSpeed
 
 #endif // ROOTREADSPEEDCLI
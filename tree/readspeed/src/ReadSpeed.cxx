@@ -18,10 +18,24 @@
 #include <ROOT/RSlotStack.hxx>
 #endif
 
+#ifdef R__READSPEED_HAS_RNTUPLE
+#include <ROOT/RField.hxx>
+#include <ROOT/RNTuple.hxx>
+#include <ROOT/RNTupleDescriptor.hxx>
+#include <ROOT/RNTupleModel.hxx>
+#include <ROOT/RNTupleOptions.hxx>
+#endif
+
 #include <ROOT/InternalTreeUtils.hxx> // for ROOT::Internal::TreeUtils::GetTopLevelBranchNames
 #include <TBranch.h>
+#include <TBufferFile.h>
+#include <TClass.h>
+#include <TDataType.h>
+#include <TLeaf.h>
 #include <TStopwatch.h>
 #include <TTree.h>
+#include <TTreeReader.h>
+#include <TTreeReaderValue.h>
 
 #include <algorithm>
 #include <cassert>
@@ -34,8 +48,34 @@
 
 using namespace ReadSpeed;
 
-std::vector<std::string> ReadSpeed::GetMatchingBranchNames(const std::string &fileName, const std::string &treeName,
-                                                           const std::vector<ReadSpeedRegex> &regexes)
+namespace {
+
+/// A TTreeReaderValue for a branch whose type is only known at runtime, from the branch itself.
+class UntypedTreeReaderValue : public ROOT::Internal::TTreeReaderValueBase {
+   std::string fTypeName;
+
+public:
+   UntypedTreeReaderValue(TTreeReader &reader, const char *branchName, TDictionary *dict)
+      : TTreeReaderValueBase(&reader, branchName, dict), fTypeName(dict ? dict->GetName() : "")
+   {
+   }
+
+   const char *GetDerivedTypeName() const final { return fTypeName.c_str(); }
+};
+
+/// Return the dictionary of the type of the values of the branch, nullptr if there is none.
+TDictionary *GetBranchDictionary(TBranch &branch)
+{
+   TClass *cl = nullptr;
+   EDataType type = kOther_t;
+   if (branch.GetExpectedType(cl, type) != 0)
+      return nullptr;
+   if (cl)
+      return cl;
+   return TDataType::GetDataType(type);
+}
+
+std::vector<std::string> GetTopLevelTreeBranchNames(const std::string &fileName, const std::string &treeName)
 {
    const auto f = std::unique_ptr<TFile>(TFile::Open(fileName.c_str(), "READ_WITHOUT_GLOBALREGISTRATION"));
    if (f == nullptr || f->IsZombie())
@@ -44,7 +84,112 @@ std::vector<std::string> ReadSpeed::GetMatchingBranchNames(const std::string &fi
    if (t == nullptr)
       throw std::runtime_error("Could not retrieve tree '" + treeName + "' from file '" + fileName + '\'');
 
-   const auto unfilteredBranchNames = ROOT::Internal::TreeUtils::GetTopLevelBranchNames(*t);
+   return ROOT::Internal::TreeUtils::GetTopLevelBranchNames(*t);
+}
+
+#ifdef R__READSPEED_HAS_RNTUPLE
+std::unique_ptr<ROOT::Experimental::RNTupleReader>
+OpenNTuple(const std::string &fileName, const std::string &ntupleName,
+           std::unique_ptr<ROOT::Experimental::RNTupleModel> model, unsigned int clusterBunchSize)
+{
+   ROOT::Experimental::RNTupleReadOptions options;
+   if (clusterBunchSize > 0)
+      options.SetClusterBunchSize(clusterBunchSize);
+   try {
+      if (model)
+         return ROOT::Experimental::RNTupleReader::Open(std::move(model), ntupleName, fileName, options);
+      return ROOT::Experimental::RNTupleReader::Open(ntupleName, fileName, options);
+   } catch (const std::exception &e) {
+      throw std::runtime_error("Could not open RNTuple '" + ntupleName + "' from file '" + fileName +
+                               "': " + e.what());
+   }
+}
+
+std::vector<std::string> GetTopLevelFieldNames(const std::string &fileName, const std::string &ntupleName)
+{
+   auto reader = OpenNTuple(fileName, ntupleName, nullptr, 0);
+   const auto *desc = reader->GetDescriptor();
+   std::vector<std::string> fieldNames;
+   for (const auto &field : desc->GetTopLevelFields())
+      fieldNames.emplace_back(field.GetFieldName());
+   return fieldNames;
+}
+
+/// Names and on-disk type names of the fields to read
+using FieldTypes_t = std::vector<std::pair<std::string, std::string>>;
+
+FieldTypes_t
+GetFieldTypes(const std::string &fileName, const std::string &ntupleName, const std::vector<std::string> &fieldNames)
+{
+   auto reader = OpenNTuple(fileName, ntupleName, nullptr, 0);
+   const auto *desc = reader->GetDescriptor();
+   FieldTypes_t fieldTypes;
+   for (const auto &fieldName : fieldNames) {
+      const auto fieldId = desc->FindFieldId(fieldName);
+      if (fieldId == ROOT::Experimental::kInvalidDescriptorId)
+         throw std::runtime_error("Could not retrieve field '" + fieldName + "' from RNTuple '" + ntupleName +
+                                  "' in file '" + fileName + '\'');
+      fieldTypes.emplace_back(fieldName, desc->GetFieldDescriptor(fieldId).GetTypeName());
+   }
+   return fieldTypes;
+}
+
+// Open the RNTuple with a model that only has the fields to read, with metrics enabled
+std::unique_ptr<ROOT::Experimental::RNTupleReader> OpenNTupleFields(const std::string &fileName,
+                                                                    const std::string &ntupleName,
+                                                                    const FieldTypes_t &fieldTypes,
+                                                                    unsigned int clusterBunchSize)
+{
+   auto model = ROOT::Experimental::RNTupleModel::Create();
+   for (const auto &fieldType : fieldTypes)
+      model->AddField(ROOT::Experimental::Detail::RFieldBase::Create(fieldType.first, fieldType.second).Unwrap());
+   auto reader = OpenNTuple(fileName, ntupleName, std::move(model), clusterBunchSize);
+   reader->EnableMetrics();
+   return reader;
+}
+
+// Read the entries in range with a reader opened by OpenNTupleFields, return the number of bytes read for them.
+// The reader can be used for several ranges: the bytes are the increase of its counters.
+ByteData ReadNTupleRange(ROOT::Experimental::RNTupleReader &reader, EntryRange range, const std::string &fileName,
+                         const std::string &ntupleName)
+{
+   const auto nEntries = static_cast<Long64_t>(reader.GetNEntries());
+   if (range.fStart == -1ll)
+      range = EntryRange{0ll, nEntries};
+   else if (range.fEnd > nEntries)
+      throw std::runtime_error("Range end (" + std::to_string(range.fEnd) + ") is beyond the end of RNTuple '" +
+                               ntupleName + "' in file '" + fileName + "' with " + std::to_string(nEntries) +
+                               " entries.");
+
+   const auto &metrics = reader.GetMetrics();
+   const auto *szUnzip = metrics.GetCounter("RNTupleReader.RPageSourceFile.szUnzip");
+   const auto *szRead = metrics.GetCounter("RNTupleReader.RPageSourceFile.szReadPayload");
+   auto fnGetValue = [](const ROOT::Experimental::Detail::RNTuplePerfCounter *counter) {
+      return counter ? static_cast<ULong64_t>(counter->GetValueAsInt()) : 0ull;
+   };
+   const auto unzipBefore = fnGetValue(szUnzip);
+   const auto readBefore = fnGetValue(szRead);
+
+   for (auto e = range.fStart; e < range.fEnd; ++e)
+      reader.LoadEntry(e);
+
+   return {fnGetValue(szUnzip) - unzipBefore, fnGetValue(szRead) - readBefore};
+}
+#endif
+
+} // anonymous namespace
+
+std::vector<std::string> ReadSpeed::GetMatchingBranchNames(const std::string &fileName, const std::string &treeName,
+                                                           const std::vector<ReadSpeedRegex> &regexes,
+                                                           EReadMethod method)
+{
+#ifdef R__READSPEED_HAS_RNTUPLE
+   const auto unfilteredBranchNames = method == EReadMethod::kNTuple ? GetTopLevelFieldNames(fileName, treeName)
+                                                                     : GetTopLevelTreeBranchNames(fileName, treeName);
+#else
+   (void)method;
+   const auto unfilteredBranchNames = GetTopLevelTreeBranchNames(fileName, treeName);
+#endif
    std::set<ReadSpeedRegex> usedRegexes;
    std::vector<std::string> branchNames;
 
@@ -102,7 +247,7 @@ std::vector<std::vector<std::string>> GetPerFileBranchNames(const Data &d)
    for (const auto &fName : d.fFileNames) {
       std::vector<std::string> branchNames;
       if (d.fUseRegex)
-         branchNames = GetMatchingBranchNames(fName, d.fTreeNames[treeIdx], regexes);
+         branchNames = GetMatchingBranchNames(fName, d.fTreeNames[treeIdx], regexes, d.fReadMethod);
       else
          branchNames = d.fBranchNames;
 
@@ -128,7 +273,7 @@ ByteData SumBytes(const std::vector<ByteData> &bytesData) {
 
 // Read branches listed in branchNames in tree treeName in file fileName, return number of uncompressed bytes read.
 ByteData ReadSpeed::ReadTree(TFile *f, const std::string &treeName, const std::vector<std::string> &branchNames,
-                             EntryRange range)
+                             EntryRange range, EReadMethod method, Long64_t cacheSize)
 {
    std::unique_ptr<TTree> t(f->Get<TTree>(treeName.c_str()));
    if (t == nullptr)
@@ -155,16 +300,89 @@ ByteData ReadSpeed::ReadTree(TFile *f, const std::string &treeName, const std::v
                                t->GetName() + "' in file '" + t->GetCurrentFile()->GetName() + "' with " +
                                std::to_string(nEntries) + " entries.");
 
+   if (cacheSize >= 0) {
+      t->SetCacheSize(cacheSize);
+      if (cacheSize > 0) {
+         for (auto *b : branches)
+            t->AddBranchToCache(b, /*subbranches=*/true);
+         t->StopCacheLearningPhase();
+         t->SetCacheEntryRange(range.fStart, range.fEnd);
+      }
+   }
+
    ULong64_t bytesRead = 0;
    const ULong64_t fileStartBytes = f->GetBytesRead();
-   for (auto e = range.fStart; e < range.fEnd; ++e)
+   switch (method) {
+   case EReadMethod::kRaw:
+      for (auto e = range.fStart; e < range.fEnd; ++e)
+         for (auto *b : branches)
+            bytesRead += b->GetEntry(e);
+      break;
+   case EReadMethod::kTreeReader: {
+      TTreeReader reader(t.get());
+      std::vector<std::unique_ptr<UntypedTreeReaderValue>> values;
+      for (auto *b : branches)
+         values.emplace_back(new UntypedTreeReaderValue(reader, b->GetName(), GetBranchDictionary(*b)));
+      reader.SetEntriesRange(range.fStart, range.fEnd);
+      while (reader.Next()) {
+         for (auto &v : values) {
+            if (v->GetAddress() == nullptr)
+               throw std::runtime_error("Could not read branch '" + std::string(v->GetBranchName()) +
+                                        "' with TTreeReader from tree '" + treeName + "' in file '" + f->GetName() +
+                                        '\'');
+         }
+      }
+      // TTreeReader does not report the bytes it reads: take the share of the range in the uncompressed size
       for (auto *b : branches)
-         bytesRead += b->GetEntry(e);
+         bytesRead += b->GetTotBytes("*") * (range.fEnd - range.fStart) / std::max(nEntries, 1ll);
+      break;
+   }
+   case EReadMethod::kBulk: {
+      TBufferFile buffer(TBuffer::kWrite, 10000);
+      for (auto *b : branches) {
+         auto *leaf = static_cast<TLeaf *>(b->GetListOfLeaves()->At(0));
+         if (!b->GetBulkRead().SupportsBulkRead() || leaf->GetLeafCount() != nullptr)
+            throw std::runtime_error("Branch '" + std::string(b->GetName()) + "' in tree '" + treeName +
+                                     "' cannot be read with the bulk interface");
+         const Long64_t entrySize = leaf->GetLenType() * leaf->GetLenStatic();
+         for (auto e = range.fStart; e < range.fEnd;) {
+            const auto nRead = b->GetBulkRead().GetBulkEntries(e, buffer);
+            if (nRead <= 0)
+               throw std::runtime_error("Could not read branch '" + std::string(b->GetName()) +
+                                        "' in bulk from entry " + std::to_string(e) + " of tree '" + treeName + '\'');
+            const auto nInRange = std::min<Long64_t>(nRead, range.fEnd - e);
+            bytesRead += nInRange * entrySize;
+            e += nInRange;
+         }
+      }
+      break;
+   }
+   case EReadMethod::kNTuple: throw std::runtime_error("Cannot read a TTree as an RNTuple");
+   }
 
    const ULong64_t fileBytesRead = f->GetBytesRead() - fileStartBytes;
    return {bytesRead, fileBytesRead};
 }
 
+ByteData ReadSpeed::ReadNTuple(const std::string &fileName, const std::string &ntupleName,
+                               const std::vector<std::string> &fieldNames, EntryRange range,
+                               unsigned int clusterBunchSize)
+{
+#ifdef R__READSPEED_HAS_RNTUPLE
+   // a model with only the fields to read, of the types found on disk
+   auto reader =
+      OpenNTupleFields(fileName, ntupleName, GetFieldTypes(fileName, ntupleName, fieldNames), clusterBunchSize);
+   return ReadNTupleRange(*reader, range, fileName, ntupleName);
+#else
+   (void)fileName;
+   (void)ntupleName;
+   (void)fieldNames;
+   (void)range;
+   (void)clusterBunchSize;
+   throw std::runtime_error("ROOT was built without RNTuple support (root7)");
+#endif
+}
+
 Result ReadSpeed::EvalThroughputST(const Data &d)
 {
    auto treeIdx = 0;
@@ -176,13 +394,27 @@ Result ReadSpeed::EvalThroughputST(const Data &d)
    const auto fileBranchNames = GetPerFileBranchNames(d);
 
    for (const auto &fileName : d.fFileNames) {
+      if (d.fReadMethod == EReadMethod::kNTuple) {
+         sw.Start(kFALSE);
+         const auto byteData = ReadNTuple(fileName, d.fTreeNames[treeIdx], fileBranchNames[fileIdx], {-1, -1},
+                                          d.fClusterBunchSize);
+         uncompressedBytesRead += byteData.fUncompressedBytesRead;
+         compressedBytesRead += byteData.fCompressedBytesRead;
+         if (d.fTreeNames.size() > 1)
+            ++treeIdx;
+         ++fileIdx;
+         sw.Stop();
+         continue;
+      }
+
       auto f = std::unique_ptr<TFile>(TFile::Open(fileName.c_str(), "READ_WITHOUT_GLOBALREGISTRATION"));
       if (f == nullptr || f->IsZombie())
          throw std::runtime_error("Could not open file '" + fileName + '\'');
 
       sw.Start(kFALSE);
 
-      const auto byteData = ReadTree(f.get(), d.fTreeNames[treeIdx], fileBranchNames[fileIdx]);
+      const auto byteData = ReadTree(f.get(), d.fTreeNames[treeIdx], fileBranchNames[fileIdx], {-1, -1},
+                                     d.fReadMethod, d.fCacheSize);
       uncompressedBytesRead += byteData.fUncompressedBytesRead;
       compressedBytesRead += byteData.fCompressedBytesRead;
 
@@ -204,6 +436,21 @@ std::vector<std::vector<EntryRange>> ReadSpeed::GetClusters(const Data &d)
    std::vector<std::vector<EntryRange>> ranges(nFiles);
    for (auto fileIdx = 0u; fileIdx < nFiles; ++fileIdx) {
       const auto &fileName = d.fFileNames[fileIdx];
+#ifdef R__READSPEED_HAS_RNTUPLE
+      if (d.fReadMethod == EReadMethod::kNTuple) {
+         const auto &ntupleName = d.fTreeNames.size() > 1 ? d.fTreeNames[fileIdx] : d.fTreeNames[0];
+         auto reader = OpenNTuple(fileName, ntupleName, nullptr, 0);
+         std::vector<EntryRange> rangesInFile;
+         for (const auto &cluster : reader->GetDescriptor()->GetClusterIterable()) {
+            const auto start = static_cast<Long64_t>(cluster.GetFirstEntryIndex());
+            rangesInFile.emplace_back(EntryRange{start, start + static_cast<Long64_t>(cluster.GetNEntries())});
+         }
+         std::sort(rangesInFile.begin(), rangesInFile.end(),
+                   [](const EntryRange &a, const EntryRange &b) { return a.fStart < b.fStart; });
+         ranges[fileIdx] = std::move(rangesInFile);
+         continue;
+      }
+#endif
       std::unique_ptr<TFile> f(TFile::Open(fileName.c_str(), "READ_WITHOUT_GLOBALREGISTRATION"));
       if (f == nullptr || f->IsZombie())
          throw std::runtime_error("There was a problem opening file '" + fileName + '\'');
@@ -288,6 +535,18 @@ Result ReadSpeed::EvalThroughputMT(const Data &d, unsigned nThreads)
 
    const auto fileBranchNames = GetPerFileBranchNames(d);
 
+#ifdef R__READSPEED_HAS_RNTUPLE
+   // The types of the fields to read are looked up once per file, outside of the timed region
+   std::vector<FieldTypes_t> fileFieldTypes;
+   if (d.fReadMethod == EReadMethod::kNTuple) {
+      for (auto fileIdx = 0u; fileIdx < d.fFileNames.size(); ++fileIdx) {
+         const auto &ntupleName = d.fTreeNames.size() > 1 ? d.fTreeNames[fileIdx] : d.fTreeNames[0];
+         fileFieldTypes.emplace_back(GetFieldTypes(d.fFileNames[fileIdx], ntupleName, fileBranchNames[fileIdx]));
+      }
+   }
+   std::vector<std::unique_ptr<ROOT::Experimental::RNTupleReader>> lastNTupleReaders(actualThreads);
+#endif
+
    ROOT::Internal::RSlotStack slotStack(actualThreads);
    std::vector<int> lastFileIdxs(actualThreads, -1);
    std::vector<std::unique_ptr<TFile>> lastTFiles(actualThreads);
@@ -303,6 +562,20 @@ Result ReadSpeed::EvalThroughputMT(const Data &d, unsigned nThreads)
          auto &file = lastTFiles[slotIndex];
          auto &lastIndex = lastFileIdxs[slotIndex];
 
+         if (d.fReadMethod == EReadMethod::kNTuple) {
+#ifdef R__READSPEED_HAS_RNTUPLE
+            // like the TFiles, the RNTuple is opened once per file by each slot
+            auto &reader = lastNTupleReaders[slotIndex];
+            if (lastIndex != fileIdx) {
+               reader = OpenNTupleFields(fileName, treeName, fileFieldTypes[fileIdx], d.fClusterBunchSize);
+               lastIndex = fileIdx;
+            }
+            return ReadNTupleRange(*reader, range, fileName, treeName);
+#else
+            return ReadNTuple(fileName, treeName, branchNames, range, d.fClusterBunchSize);
+#endif
+         }
+
          if (lastIndex != fileIdx) {
             file.reset(TFile::Open(fileName.c_str(), "READ_WITHOUT_GLOBALREGISTRATION"));
             lastIndex = fileIdx;
@@ -311,7 +584,7 @@ Result ReadSpeed::EvalThroughputMT(const Data &d, unsigned nThreads)
          if (file == nullptr || file->IsZombie())
             throw std::runtime_error("Could not open file '" + fileName + '\'');
 
-         auto result = ReadTree(file.get(), treeName, branchNames, range);
+         auto result = ReadTree(file.get(), treeName, branchNames, range, d.fReadMethod, d.fCacheSize);
 
          return result;
       };
@@ -359,14 +632,69 @@ Result ReadSpeed::EvalThroughput(const Data &d, unsigned nThreads)
       std::terminate();
    }
 
+#ifndef R__READSPEED_HAS_RNTUPLE
+   if (d.fReadMethod == EReadMethod::kNTuple) {
+      std::cerr << "RNTuple data was requested, but ROOT was built without RNTuple support (root7).\n";
+      std::terminate();
+   }
+#endif
+
 #ifdef R__USE_IMT
-   return nThreads > 0 ? EvalThroughputMT(d, nThreads) : EvalThroughputST(d);
+   auto result = nThreads > 0 ? EvalThroughputMT(d, nThreads) : EvalThroughputST(d);
 #else
    if (nThreads > 0) {
       std::cerr << nThreads
                 << " threads were requested, but ROOT was built without implicit multi-threading (IMT) support.\n";
       std::terminate();
    }
-   return EvalThroughputST(d);
+   auto result = EvalThroughputST(d);
 #endif
+   result.fCompressionSettings = GetCompressionSettings(d);
+   result.fUncompressedBytesEstimated = d.fReadMethod == EReadMethod::kTreeReader;
+   return result;
+}
+
+int ReadSpeed::GetCompressionSettings(const Data &d)
+{
+   if (d.fFileNames.empty() || d.fTreeNames.empty())
+      return -1;
+   const auto &fileName = d.fFileNames[0];
+   std::unique_ptr<TFile> f(TFile::Open(fileName.c_str(), "READ_WITHOUT_GLOBALREGISTRATION"));
+   if (f == nullptr || f->IsZombie())
+      return -1;
+   const auto branchNames = GetPerFileBranchNames(d)[0];
+   if (d.fReadMethod == EReadMethod::kNTuple) {
+#ifdef R__READSPEED_HAS_RNTUPLE
+      // the compression of the pages of the first column of the first field, in the first cluster
+      auto reader = OpenNTuple(fileName, d.fTreeNames[0], nullptr, 0);
+      const auto *desc = reader->GetDescriptor();
+      const auto fieldId = branchNames.empty() ? ROOT::Experimental::kInvalidDescriptorId
+                                               : desc->FindFieldId(branchNames[0]);
+      if (fieldId != ROOT::Experimental::kInvalidDescriptorId && desc->GetNClusters() > 0) {
+         auto columns = desc->GetColumnIterable(fieldId);
+         auto column = columns.begin();
+         if (column != columns.end()) {
+            const auto &cluster = *desc->GetClusterIterable().begin();
+            return cluster.GetColumnRange((*column).GetPhysicalId()).fCompressionSettings;
+         }
+      }
+#endif
+      return f->GetCompressionSettings();
+   }
+   std::unique_ptr<TTree> t(f->Get<TTree>(d.fTreeNames[0].c_str()));
+   if (t == nullptr)
+      return -1;
+   auto *b = branchNames.empty() ? nullptr : t->GetBranch(branchNames[0].c_str());
+   return b ? b->GetCompressionSettings() : f->GetCompressionSettings();
+}
+
+std::string ReadSpeed::GetReadMethodName(EReadMethod method)
+{
+   switch (method) {
+   case EReadMethod::kRaw: return "raw";
+   case EReadMethod::kTreeReader: return "treereader";
+   case EReadMethod::kBulk: return "bulk";
+   case EReadMethod::kNTuple: return "ntuple";
+   }
+   return "unknown";
 }
@@ -14,8 +14,14 @@
 #include <ROOT/TTreeProcessorMT.hxx> // for TTreeProcessorMT::SetTasksPerWorkerHint
 #endif
 
-#include <iostream>
+#include <TROOT.h> // for gROOT->GetVersion
+
+#include <algorithm>
 #include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
 
 using namespace ReadSpeed;
 
@@ -24,8 +30,11 @@ const auto usageText = "Usage:\n"
                        "               --trees tname1 [tname2 ...]\n"
                        "               (--all-branches | --branches bname1 [bname2 ...] | --branches-regex bregex1 "
                        "[bregex2 ...])\n"
-                       "               [--threads nthreads]\n"
+                       "               [--threads nthreads [nthreads2 ...]]\n"
                        "               [--tasks-per-worker ntasks]\n"
+                       "               [--read-method (raw|treereader|bulk|ntuple)]\n"
+                       "               [--cache-size bytes] [--cluster-bunch-size nclusters]\n"
+                       "               [--output results.csv] [--baseline baseline.csv [--tolerance fraction]]\n"
                        " rootreadspeed (--help|-h)\n"
                        " \n"
                        " Use -h for usage help, --help for detailed information.\n";
@@ -56,13 +65,42 @@ const auto argUsageText =
    "    regex does not match at least one branch."
    "\n"
    "\n"
+   " Specifying how the data is read:\n"
+   "   --read-method (raw|treereader|bulk|ntuple)\n"
+   "    'raw' (the default) reads the branches entry by entry with TBranch::GetEntry, 'treereader'"
+   "    reads them with TTreeReader, which RDataFrame uses for TTrees, and 'bulk' with the bulk"
+   "    interface of TBranch, one basket at a time (only for branches of fixed size). 'ntuple' reads"
+   "    RNTuples instead of TTrees: --trees are then the RNTuple names and --branches the field names."
+   "\n"
+   "   --cache-size bytes\n"
+   "    The size of the TTreeCache, 0 to disable it. By default no TTreeCache is set up."
+   "\n"
+   "   --cluster-bunch-size nclusters\n"
+   "    The number of clusters RNTuple reads in one go."
+   "\n"
+   "\n"
    " Meta arguments:\n"
-   "   --threads nthreads\n"
+   "   --threads nthreads [nthreads2 ...]\n"
    "    The number of threads to use for file reading. Will automatically cap to the number of"
-   "    available threads on the machine."
+   "    available threads on the machine. If several numbers are given, one run is done for each"
+   "    of them, to measure how the throughput scales with the number of threads."
    "\n"
    "   --tasks-per-worker ntasks\n"
-   "    The number of tasks to generate for each worker thread when using multithreading.";
+   "    The number of tasks to generate for each worker thread when using multithreading."
+   "\n"
+   "\n"
+   " Comparing results:\n"
+   "   --output results.csv\n"
+   "    Append the configuration and the results of each run to the file, in CSV format, together"
+   "    with the ROOT version."
+   "\n"
+   "   --baseline baseline.csv\n"
+   "    Compare the throughput of each run to the last run with the same configuration in the file,"
+   "    e.g. written with --output by an older ROOT release. The exit code is 2 if the throughput"
+   "    of any run is lower by more than the tolerance."
+   "\n"
+   "   --tolerance fraction\n"
+   "    The largest relative decrease of throughput that is not reported as a regression (0.1 by default).";
 
 const auto fullUsageText =
    "Description:\n"
@@ -79,6 +117,8 @@ const auto fullUsageText =
    " saved in compressed format, so these will often differ. Compressed bytes is the total"
    " number of bytes read from TFiles during the readspeed test (possibly including meta-data)."
    " Uncompressed bytes is the number of bytes processed by reading the branch values in the TTree."
+   " TTreeReader does not report them: with --read-method treereader they are estimated from the size of the"
+   " branches."
    " Throughput is calculated as the total number of bytes over the total runtime (including"
    " decompression time) in the uncompressed and compressed cases."
    "\n"
@@ -149,6 +189,8 @@ const auto fullUsageText =
 void ReadSpeed::PrintThroughput(const Result &r)
 {
    std::cout << "Thread pool size:\t\t" << r.fThreadPoolSize << '\n';
+   if (r.fCompressionSettings >= 0)
+      std::cout << "Compression settings:\t\t" << r.fCompressionSettings << '\n';
 
    if (r.fMTSetupRealTime > 0.) {
       std::cout << "Real time to setup MT run:\t" << r.fMTSetupRealTime << " s\n";
@@ -158,7 +200,8 @@ void ReadSpeed::PrintThroughput(const Result &r)
    std::cout << "Real time:\t\t\t" << r.fRealTime << " s\n";
    std::cout << "CPU time:\t\t\t" << r.fCpuTime << " s\n";
 
-   std::cout << "Uncompressed data read:\t\t" << r.fUncompressedBytesRead << " bytes\n";
+   std::cout << "Uncompressed data read:\t\t" << r.fUncompressedBytesRead << " bytes"
+             << (r.fUncompressedBytesEstimated ? " (estimated from the size of the branches)\n" : "\n");
    std::cout << "Compressed data read:\t\t" << r.fCompressedBytesRead << " bytes\n";
 
    const unsigned int effectiveThreads = std::max(r.fThreadPoolSize, 1u);
@@ -204,8 +247,24 @@ Args ReadSpeed::ParseArgs(const std::vector<std::string> &args)
 
    Data d;
    unsigned int nThreads = 0;
+   std::vector<unsigned int> threadScan;
+   std::string outputFile, baselineFile;
+   double tolerance = 0.1;
 
-   enum class EArgState { kNone, kTrees, kFiles, kBranches, kThreads, kTasksPerWorkerHint } argState = EArgState::kNone;
+   enum class EArgState {
+      kNone,
+      kTrees,
+      kFiles,
+      kBranches,
+      kThreads,
+      kTasksPerWorkerHint,
+      kReadMethod,
+      kCacheSize,
+      kClusterBunchSize,
+      kOutput,
+      kBaseline,
+      kTolerance
+   } argState = EArgState::kNone;
    enum class EBranchState { kNone, kRegular, kRegex, kAll } branchState = EBranchState::kNone;
    const auto branchOptionsErrMsg =
       "Options --all-branches, --branches, and --branches-regex are mutually exclusive. You can use only one.\n";
@@ -245,6 +304,18 @@ Args ReadSpeed::ParseArgs(const std::vector<std::string> &args)
          argState = EArgState::kThreads;
       } else if (arg == "--tasks-per-worker") {
          argState = EArgState::kTasksPerWorkerHint;
+      } else if (arg == "--read-method") {
+         argState = EArgState::kReadMethod;
+      } else if (arg == "--cache-size") {
+         argState = EArgState::kCacheSize;
+      } else if (arg == "--cluster-bunch-size") {
+         argState = EArgState::kClusterBunchSize;
+      } else if (arg == "--output") {
+         argState = EArgState::kOutput;
+      } else if (arg == "--baseline") {
+         argState = EArgState::kBaseline;
+      } else if (arg == "--tolerance") {
+         argState = EArgState::kTolerance;
       } else if (arg[0] == '-') {
          std::cerr << "Unrecognized option '" << arg << "'\n";
          return {};
@@ -254,7 +325,43 @@ Args ReadSpeed::ParseArgs(const std::vector<std::string> &args)
          case EArgState::kFiles: d.fFileNames.emplace_back(arg); break;
          case EArgState::kBranches: d.fBranchNames.emplace_back(arg); break;
          case EArgState::kThreads:
-            nThreads = std::stoi(arg);
+            // more numbers of threads may follow
+            threadScan.emplace_back(std::stoi(arg));
+            nThreads = threadScan.front();
+            break;
+         case EArgState::kReadMethod:
+            if (arg == "raw") {
+               d.fReadMethod = EReadMethod::kRaw;
+            } else if (arg == "treereader") {
+               d.fReadMethod = EReadMethod::kTreeReader;
+            } else if (arg == "bulk") {
+               d.fReadMethod = EReadMethod::kBulk;
+            } else if (arg == "ntuple") {
+               d.fReadMethod = EReadMethod::kNTuple;
+            } else {
+               std::cerr << "Unknown read method '" << arg << "'\n";
+               return {};
+            }
+            argState = EArgState::kNone;
+            break;
+         case EArgState::kCacheSize:
+            d.fCacheSize = std::stoll(arg);
+            argState = EArgState::kNone;
+            break;
+         case EArgState::kClusterBunchSize:
+            d.fClusterBunchSize = std::stoi(arg);
+            argState = EArgState::kNone;
+            break;
+         case EArgState::kOutput:
+            outputFile = arg;
+            argState = EArgState::kNone;
+            break;
+         case EArgState::kBaseline:
+            baselineFile = arg;
+            argState = EArgState::kNone;
+            break;
+         case EArgState::kTolerance:
+            tolerance = std::stod(arg);
             argState = EArgState::kNone;
             break;
          case EArgState::kTasksPerWorkerHint:
@@ -271,7 +378,14 @@ Args ReadSpeed::ParseArgs(const std::vector<std::string> &args)
       }
    }
 
-   return Args{std::move(d), nThreads, branchState == EBranchState::kAll, /*fShouldRun=*/true};
+   return Args{std::move(d),
+               nThreads,
+               branchState == EBranchState::kAll,
+               /*fShouldRun=*/true,
+               std::move(threadScan),
+               std::move(outputFile),
+               std::move(baselineFile),
+               tolerance};
 }
 
 Args ReadSpeed::ParseArgs(int argc, char **argv)
@@ -285,3 +399,131 @@ Args ReadSpeed::ParseArgs(int argc, char **argv)
 
    return ParseArgs(args);
 }
+
+namespace {
+
+std::string JoinNames(const std::vector<std::string> &names)
+{
+   std::string joined;
+   for (const auto &name : names)
+      joined += (joined.empty() ? "" : ";") + name;
+   return joined;
+}
+
+// Quote a CSV field, doubling the quotes it contains
+std::string QuoteCSV(const std::string &field)
+{
+   std::string quoted = "\"";
+   for (const auto c : field) {
+      if (c == '"')
+         quoted += '"';
+      quoted += c;
+   }
+   return quoted + '"';
+}
+
+std::vector<std::string> SplitCSVLine(const std::string &line)
+{
+   std::vector<std::string> fields(1);
+   bool inQuotes = false;
+   for (std::size_t i = 0; i < line.size(); ++i) {
+      const auto c = line[i];
+      if (c == '"') {
+         if (inQuotes && i + 1 < line.size() && line[i + 1] == '"')
+            fields.back() += line[++i];
+         else
+            inQuotes = !inQuotes;
+      } else if (c == ',' && !inQuotes) {
+         fields.emplace_back();
+      } else {
+         fields.back() += c;
+      }
+   }
+   return fields;
+}
+
+double GetUncompressedThroughput(const Result &r)
+{
+   return r.fRealTime > 0. ? r.fUncompressedBytesRead / r.fRealTime / 1024 / 1024 : 0.;
+}
+
+double GetCompressedThroughput(const Result &r)
+{
+   return r.fRealTime > 0. ? r.fCompressedBytesRead / r.fRealTime / 1024 / 1024 : 0.;
+}
+
+// The columns of the CSV records that identify the configuration of a run
+const std::vector<std::size_t> configurationColumns{1, 2, 3, 4, 5, 6, 8};
+const std::size_t uncompressedThroughputColumn = 14;
+
+} // anonymous namespace
+
+std::string ReadSpeed::GetCSVHeader()
+{
+   return "root_version,read_method,files,trees,branches,cache_size,cluster_bunch_size,compression,threads,"
+          "real_time,cpu_time,mt_setup_real_time,uncompressed_bytes,compressed_bytes,uncompressed_mb_s,"
+          "compressed_mb_s,uncompressed_bytes_estimated";
+}
+
+std::string ReadSpeed::FormatCSVRecord(const Data &d, const Result &r)
+{
+   std::ostringstream record;
+   record << QuoteCSV(gROOT->GetVersion()) << ',' << GetReadMethodName(d.fReadMethod) << ','
+          << QuoteCSV(JoinNames(d.fFileNames)) << ',' << QuoteCSV(JoinNames(d.fTreeNames)) << ','
+          << QuoteCSV(JoinNames(d.fBranchNames)) << ',' << d.fCacheSize << ',' << d.fClusterBunchSize << ','
+          << r.fCompressionSettings << ',' << r.fThreadPoolSize << ',' << r.fRealTime << ',' << r.fCpuTime << ','
+          << r.fMTSetupRealTime << ',' << r.fUncompressedBytesRead << ',' << r.fCompressedBytesRead << ','
+          << GetUncompressedThroughput(r) << ',' << GetCompressedThroughput(r) << ','
+          << r.fUncompressedBytesEstimated;
+   return record.str();
+}
+
+void ReadSpeed::WriteResults(const std::string &fileName, const Data &d, const std::vector<Result> &results)
+{
+   const bool isNewFile = !std::ifstream(fileName).good();
+   std::ofstream out(fileName, std::ios::app);
+   if (!out)
+      throw std::runtime_error("Could not open file '" + fileName + "' to write the results");
+   if (isNewFile)
+      out << GetCSVHeader() << '\n';
+   for (const auto &r : results)
+      out << FormatCSVRecord(d, r) << '\n';
+}
+
+unsigned int ReadSpeed::CompareToBaseline(const std::string &fileName, const Data &d,
+                                          const std::vector<Result> &results, double tolerance)
+{
+   std::ifstream in(fileName);
+   if (!in)
+      throw std::runtime_error("Could not open baseline file '" + fileName + '\'');
+   std::vector<std::vector<std::string>> baseline;
+   std::string line;
+   while (std::getline(in, line)) {
+      auto fields = SplitCSVLine(line);
+      if (fields.size() > uncompressedThroughputColumn && line != GetCSVHeader())
+         baseline.emplace_back(std::move(fields));
+   }
+
+   unsigned int nRegressions = 0;
+   for (const auto &r : results) {
+      const auto fields = SplitCSVLine(FormatCSVRecord(d, r));
+      // the most recent run with the same configuration
+      auto match = std::find_if(baseline.rbegin(), baseline.rend(), [&fields](const std::vector<std::string> &b) {
+         return std::all_of(configurationColumns.begin(), configurationColumns.end(),
+                            [&](std::size_t column) { return b[column] == fields[column]; });
+      });
+      std::cout << "Threads: " << r.fThreadPoolSize << '\t';
+      if (match == baseline.rend()) {
+         std::cout << "no baseline with the same configuration\n";
+         continue;
+      }
+      const double reference = std::stod((*match)[uncompressedThroughputColumn]);
+      const double throughput = GetUncompressedThroughput(r);
+      const bool isRegression = throughput < (1. - tolerance) * reference;
+      std::cout << "uncompressed throughput " << throughput << " MB/s vs " << reference << " MB/s with ROOT "
+                << (*match)[0] << (isRegression ? "\tREGRESSION\n" : "\tOK\n");
+      if (isRegression)
+         ++nRegressions;
+   }
+   return nRegressions;
+}
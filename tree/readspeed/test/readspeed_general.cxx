@@ -14,10 +14,17 @@
 #include "ROOT/TTreeProcessorMT.hxx" // for TTreeProcessorMT::GetTasksPerWorkerHint
 #endif
 
+#ifdef R__READSPEED_HAS_RNTUPLE
+#include <ROOT/RNTuple.hxx>
+#include <ROOT/RNTupleModel.hxx>
+#endif
+
 #include "TFile.h"
 #include "TSystem.h"
 #include "TTree.h"
 
+#include <fstream>
+
 using namespace ReadSpeed;
 
 // Helper function to generate a .root file with some dummy data in it.
@@ -144,6 +151,121 @@ TEST_F(ReadSpeedIntegration, AllBranches)
    EXPECT_EQ(result.fCompressedBytesRead, 1316837) << "Wrong number of compressed bytes read";
 }
 
+TEST_F(ReadSpeedIntegration, ReadMethods)
+{
+   Data d{{"t"}, {"readspeedinput1.root"}, {"x"}};
+   const auto raw = EvalThroughput(d, 0);
+   EXPECT_EQ(raw.fCompressionSettings, ROOT::RCompressionSetting::EDefaults::kUseCompiledDefault)
+      << "Wrong compression settings";
+
+   d.fReadMethod = EReadMethod::kBulk;
+   const auto bulk = EvalThroughput(d, 0);
+   EXPECT_EQ(bulk.fUncompressedBytesRead, raw.fUncompressedBytesRead) << "Wrong number of uncompressed bytes read";
+   EXPECT_EQ(bulk.fCompressedBytesRead, raw.fCompressedBytesRead) << "Wrong number of compressed bytes read";
+
+   d.fReadMethod = EReadMethod::kTreeReader;
+   const auto treeReader = EvalThroughput(d, 0);
+   // estimated from the size of the baskets, which includes their headers
+   EXPECT_GE(treeReader.fUncompressedBytesRead, raw.fUncompressedBytesRead) << "Wrong number of uncompressed bytes";
+   EXPECT_GE(treeReader.fCompressedBytesRead, raw.fCompressedBytesRead) << "Wrong number of compressed bytes read";
+   EXPECT_TRUE(treeReader.fUncompressedBytesEstimated);
+   EXPECT_FALSE(raw.fUncompressedBytesEstimated);
+
+   d.fReadMethod = EReadMethod::kRaw;
+   d.fCacheSize = 10000000;
+   const auto cached = EvalThroughput(d, 0);
+   EXPECT_EQ(cached.fUncompressedBytesRead, raw.fUncompressedBytesRead) << "Wrong number of uncompressed bytes read";
+   EXPECT_GE(cached.fCompressedBytesRead, raw.fCompressedBytesRead) << "Wrong number of compressed bytes read";
+}
+
+#ifdef R__USE_IMT
+TEST_F(ReadSpeedIntegration, ReadMethodsMultiThread)
+{
+   Data d{{"t"}, {"readspeedinput1.root", "readspeedinput2.root"}, {"x"}};
+   d.fReadMethod = EReadMethod::kBulk;
+   const auto result = EvalThroughput(d, 2);
+
+   EXPECT_EQ(result.fUncompressedBytesRead, 80000000) << "Wrong number of uncompressed bytes read";
+   EXPECT_EQ(result.fCompressedBytesRead, 643934) << "Wrong number of compressed bytes read";
+}
+#endif
+
+#ifdef R__READSPEED_HAS_RNTUPLE
+TEST(ReadSpeedNTuple, SingleThread)
+{
+   const auto fileName = "readspeedinput_ntuple.root";
+   {
+      auto model = ROOT::Experimental::RNTupleModel::Create();
+      auto x = model->MakeField<int>("x");
+      model->MakeField<float>("y");
+      auto writer = ROOT::Experimental::RNTupleWriter::Recreate(std::move(model), "ntpl", fileName);
+      for (int i = 0; i < 100000; ++i) {
+         *x = i;
+         writer->Fill();
+      }
+   }
+
+   Data d{{"ntpl"}, {fileName}, {"x"}};
+   d.fReadMethod = EReadMethod::kNTuple;
+   const auto x = EvalThroughput(d, 0);
+   EXPECT_EQ(x.fUncompressedBytesRead, 400000) << "Wrong number of uncompressed bytes read";
+   EXPECT_GT(x.fCompressedBytesRead, 0) << "Wrong number of compressed bytes read";
+
+   d.fBranchNames = {".*"};
+   d.fUseRegex = true;
+   d.fClusterBunchSize = 2;
+   const auto all = EvalThroughput(d, 0);
+   EXPECT_EQ(all.fUncompressedBytesRead, 800000) << "Wrong number of uncompressed bytes read";
+
+   d.fBranchNames = {"z"};
+   d.fUseRegex = false;
+   EXPECT_THROW(EvalThroughput(d, 0), std::runtime_error) << "Should throw for non-existent field";
+
+#ifdef R__USE_IMT
+   // each slot opens the RNTuple once and reads all of its ranges of the file with the same reader
+   d.fBranchNames = {"x"};
+   d.fClusterBunchSize = 0;
+   const auto mt = EvalThroughput(d, 2);
+   EXPECT_EQ(mt.fUncompressedBytesRead, 400000) << "Wrong number of uncompressed bytes read";
+   EXPECT_EQ(mt.fCompressedBytesRead, x.fCompressedBytesRead) << "Wrong number of compressed bytes read";
+#endif
+
+   gSystem->Unlink(fileName);
+}
+#endif
+
+TEST(ReadSpeedResults, CompareToBaseline)
+{
+   const auto fileName = "readspeed_results.csv";
+   gSystem->Unlink(fileName);
+   const Data d{{"t"}, {"a.root", "b,c.root"}, {"x"}};
+   // 100 MB/s and 50 MB/s with 1 and 2 threads
+   const std::vector<Result> baseline{{1., 1., 0., 0., 100 * 1024 * 1024, 1000, 0, 101},
+                                      {1., 2., 0., 0., 50 * 1024 * 1024, 1000, 2, 101}};
+   WriteResults(fileName, d, baseline);
+   WriteResults(fileName, d, baseline);
+
+   std::ifstream in(fileName);
+   std::string line;
+   std::getline(in, line);
+   EXPECT_EQ(line, GetCSVHeader());
+   std::getline(in, line);
+   EXPECT_EQ(line, FormatCSVRecord(d, baseline[0]));
+
+   const std::vector<Result> results{{1., 1., 0., 0., 95 * 1024 * 1024, 1000, 0, 101},
+                                     {1., 2., 0., 0., 40 * 1024 * 1024, 1000, 2, 101},
+                                     {1., 4., 0., 0., 40 * 1024 * 1024, 1000, 4, 101}};
+   // only the run with 2 threads is slower by more than the tolerance, there is no baseline with 4 threads
+   EXPECT_EQ(CompareToBaseline(fileName, d, results, 0.1), 1u);
+   EXPECT_EQ(CompareToBaseline(fileName, d, results, 0.3), 0u);
+   // different configuration
+   Data other = d;
+   other.fCacheSize = 0;
+   EXPECT_EQ(CompareToBaseline(fileName, other, results, 0.1), 0u);
+
+   gSystem->Unlink(fileName);
+}
+
 TEST(ReadSpeedCLI, CheckFilenames)
 {
    const std::vector<std::string> baseArgs{"root-readspeed", "--trees", "t", "--branches", "x", "--files"};
@@ -272,6 +394,58 @@ TEST(ReadSpeedCLI, MultipleThreads)
    EXPECT_EQ(parsedArgs.fNThreads, threads) << "Program not using the correct amount of threads";
 }
 
+TEST(ReadSpeedCLI, ThreadScan)
+{
+   const std::vector<std::string> allArgs{
+      "root-readspeed", "--files", "doesnotexist.root", "--trees", "t", "--branches", "x", "--threads", "1", "2", "4",
+   };
+   const std::vector<unsigned int> threads{1, 2, 4};
+
+   const auto parsedArgs = ParseArgs(allArgs);
+
+   EXPECT_TRUE(parsedArgs.fShouldRun) << "Program not running when given valid arguments";
+   EXPECT_EQ(parsedArgs.fThreadScan, threads) << "Program not scanning the correct numbers of threads";
+   EXPECT_EQ(parsedArgs.fNThreads, 1u) << "Program not using the first number of threads";
+}
+
+TEST(ReadSpeedCLI, BenchmarkArgs)
+{
+   const std::vector<std::string> allArgs{"root-readspeed",
+                                          "--files",
+                                          "doesnotexist.root",
+                                          "--trees",
+                                          "t",
+                                          "--branches",
+                                          "x",
+                                          "--read-method",
+                                          "bulk",
+                                          "--cache-size",
+                                          "1000000",
+                                          "--cluster-bunch-size",
+                                          "3",
+                                          "--output",
+                                          "out.csv",
+                                          "--baseline",
+                                          "old.csv",
+                                          "--tolerance",
+                                          "0.05"};
+
+   const auto parsedArgs = ParseArgs(allArgs);
+
+   EXPECT_TRUE(parsedArgs.fShouldRun) << "Program not running when given valid arguments";
+   EXPECT_EQ(parsedArgs.fData.fReadMethod, EReadMethod::kBulk);
+   EXPECT_EQ(parsedArgs.fData.fCacheSize, 1000000);
+   EXPECT_EQ(parsedArgs.fData.fClusterBunchSize, 3u);
+   EXPECT_EQ(parsedArgs.fOutputFile, "out.csv");
+   EXPECT_EQ(parsedArgs.fBaselineFile, "old.csv");
+   EXPECT_DOUBLE_EQ(parsedArgs.fTolerance, 0.05);
+
+   const std::vector<std::string> invalidArgs{
+      "root-readspeed", "--files", "doesnotexist.root", "--trees", "t", "--branches", "x", "--read-method", "fast",
+   };
+   EXPECT_FALSE(ParseArgs(invalidArgs).fShouldRun) << "Program running with an unknown read method";
+}
+
 #ifdef R__USE_IMT
 TEST(ReadSpeedCLI, WorkerThreadsHint)
 {
@@ -23,6 +23,10 @@
 
 #include "TTree.h"
 
+#include <memory>
+#include <string>
+#include <vector>
+
 class TFile;
 class TBrowser;
 class TCut;
@@ -30,6 +34,14 @@ class TEntryList;
 class TEventList;
 class TCollection;
 
+#ifdef R__USE_IMT
+namespace ROOT {
+namespace Internal {
+class TChainFilePrefetcher;
+}
+}
+#endif
+
 class TChain : public TTree {
 
 protected:
@@ -44,6 +56,11 @@ protected:
    TList       *fStatus;           ///< -> List of active/inactive branches (TChainElement, owned)
    TChain      *fProofChain;       ///<! chain proxy when going to be processed by PROOF
    bool         fGlobalRegistration;  ///<! if true, bypass use of global lists
+   Int_t        fNFilesToPrefetch; ///<! Number of files opened ahead of the current one, see SetFilePrefetching
+   std::vector<std::string> fCacheBranchNames; ///<! Branches cached for the last tree, see TTreeCache::WarmStart
+#ifdef R__USE_IMT
+   std::unique_ptr<ROOT::Internal::TChainFilePrefetcher> fFilePrefetcher; ///<! Files opened ahead in background tasks
+#endif
 
 private:
    TChain(const TChain&);            // not implemented
@@ -54,6 +71,8 @@ private:
 protected:
    void InvalidateCurrentTree();
    void ReleaseChainProof();
+   void CountEntriesInParallel();
+   void PrefetchFiles(Int_t first);
 
 public:
    // TChain constants
@@ -103,6 +122,7 @@ public:
    Long64_t  GetEntryNumber(Long64_t entry) const override;
    Int_t     GetEntryWithIndex(Int_t major, Int_t minor=0) override;
    TFile            *GetFile() const;
+           Int_t     GetFilePrefetching() const { return fNFilesToPrefetch; }
    TLeaf    *GetLeaf(const char* branchname, const char* leafname) override;
    TLeaf    *GetLeaf(const char* name) override;
    TObjArray *GetListOfBranches() override;
@@ -162,6 +182,7 @@ public:
    void      SetDirectory(TDirectory *dir) override;
    void      SetEntryList(TEntryList *elist, Option_t *opt="") override;
    virtual void      SetEntryListFile(const char *filename="", Option_t *opt="");
+           void      SetFilePrefetching(Int_t nfiles);
    void      SetEventList(TEventList *evlist) override;
    void      SetMakeClass(Int_t make) override { TTree::SetMakeClass(make); if (fTree) fTree->SetMakeClass(make);}
    void      SetName(const char *name) override;
@@ -14,6 +14,9 @@
 
 #include "TNamed.h"
 
+#include <utility>
+#include <vector>
+
 class TTree;
 class TDirectory;
 class TObjArray;
@@ -73,6 +76,7 @@ class TEntryList: public TNamed
    virtual Long64_t    GetEntry(Long64_t index);
    virtual Long64_t    GetEntryAndTree(Long64_t index, Int_t &treenum);
    virtual Long64_t    GetEntriesToProcess() const {return fEntriesToProcess;}
+   std::vector<std::pair<Long64_t, Long64_t>> GetEntryRanges() const;
    virtual TList      *GetLists() const { return fLists; }
    virtual TDirectory *GetDirectory() const { return fDirectory; }
    virtual Long64_t    GetN() const { return fN; }
@@ -87,6 +91,7 @@ class TEntryList: public TNamed
       return kFALSE;
    }
 
+   virtual void        Intersect(const TEntryList *elist);
    virtual Int_t       Merge(TCollection *list);
 
    virtual Long64_t    Next();
@@ -29,6 +29,8 @@
 // - Merge() - adds all entries from one block to the other. If the first block
 //             uses array representation, it's changed to bits representation only
 //             if the total number of passing entries is still less than kBlockSize
+// - Intersect(), Subtract() - keep the entries that are, or are not, in the other block
+// - GetRanges() - appends the ranges of consecutive entries of the block
 // - GetEntry(n) - returns n-th non-zero entry.
 // - Next()      - return next non-zero entry. In case of representation 1), Next()
 //                 is faster than GetEntry()
@@ -40,6 +42,9 @@
 
 #include "TObject.h"
 
+#include <utility>
+#include <vector>
+
 class TEntryListBlock:public TObject
 {
  protected:
@@ -55,6 +60,8 @@ class TEntryListBlock:public TObject
    Int_t    fLastIndexReturned; ///<! to optimize GetEntry() in a loop
 
    void Transform(Bool_t dir, UShort_t *indexnew);
+   void GetBits(UShort_t *bits) const;
+   void SetBits(UShort_t *bits);
 
  public:
 
@@ -69,6 +76,9 @@ class TEntryListBlock:public TObject
    Int_t   Contains(Int_t entry);
    void    OptimizeStorage();
    Int_t   Merge(TEntryListBlock *block);
+   Int_t   Intersect(TEntryListBlock *block);
+   Int_t   Subtract(TEntryListBlock *block);
+   void    GetRanges(std::vector<std::pair<Long64_t, Long64_t>> &ranges, Long64_t offset) const;
    Int_t   Next();
    Int_t   GetEntry(Int_t entry);
    void    ResetIndices() {fLastIndexQueried = -1, fLastIndexReturned = -1;}
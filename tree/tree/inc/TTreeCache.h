@@ -23,6 +23,8 @@
 
 #include "TFileCacheRead.h"
 
+#include <string>
+#include <utility>
 #include <vector>
 
 class TTree;
@@ -48,6 +50,7 @@ protected:
    Int_t        fNMissReadMiss{0};    ///<  Number of blocks read and not found in either cache.
    Int_t        fNReadPref{0};        ///<  Number of blocks that were prefetched
    Int_t        fNMissReadPref{0};    ///<  Number of blocks read into the secondary ("miss") cache.
+   Int_t        fNUnusedBaskets{0};   ///<! Number of baskets put in the cache and dropped without having been used
    TObjArray   *fBranches{nullptr};   ///<! List of branches to be stored in the cache
    TList       *fBrNames{nullptr};    ///<! list of branch names in the cache
    TTree       *fTree{nullptr};       ///<! pointer to the current Tree
@@ -67,6 +70,11 @@ protected:
 
    Bool_t       fLearnPrefilling{kFALSE}; ///<! true if we are in the process of executing LearnPrefill
 
+   /// If not empty, sorted ranges [first, last[ of the entries of the current tree that will be read:
+   /// the baskets without any of these entries are not prefetched
+   std::vector<std::pair<Long64_t, Long64_t>> fSelectedEntries; ///<!
+   std::vector<std::string> fLazyBrNames; ///<! Branches whose baskets are not decompressed ahead of their first use
+
    // These members hold cached data for missed branches when miss optimization
    // is enabled.  Pointers are only initialized if the miss cache is enabled.
    Bool_t   fOptimizeMisses{kFALSE}; ///<! true if we should optimize cache misses.
@@ -104,6 +112,8 @@ protected:
 
    std::unique_ptr<MissCache> fMissCache; ///<! Cache contents for misses
 
+   Bool_t ContainsSelectedEntry(Long64_t first, Long64_t last) const;
+
 private:
    TTreeCache(const TTreeCache &) = delete; ///< this class cannot be copied
    TTreeCache &operator=(const TTreeCache &) = delete;
@@ -137,6 +147,7 @@ public:
    virtual void         Enable() {fEnabled = kTRUE;}
    Bool_t               GetOptimizeMisses() const { return fOptimizeMisses; }
    const TObjArray     *GetCachedBranches() const { return fBranches; }
+   std::vector<std::string> GetCachedBranchNames() const;
    EPrefillType         GetConfiguredPrefillType() const;
    Double_t             GetEfficiency() const;
    Double_t             GetEfficiencyRel() const;
@@ -146,31 +157,38 @@ public:
    virtual EPrefillType GetLearnPrefill() const {return fPrefillType;}
    Double_t             GetMissEfficiency() const;
    Double_t             GetMissEfficiencyRel() const;
+   Int_t                GetNUnusedBaskets() const;
    TTree               *GetTree() const {return fTree;}
    Bool_t               IsAutoCreated() const {return fAutoCreated;}
    virtual Bool_t       IsEnabled() const {return fEnabled;}
    Bool_t               IsLearning() const override {return fIsLearning;}
+   Bool_t               IsLazyBranch(const TBranch *b) const;
 
    virtual Bool_t       FillBuffer();
    Int_t                LearnBranch(TBranch *b, Bool_t subgbranches = kFALSE) override;
    virtual void         LearnPrefill();
+   Int_t                LoadLearnedBranches(const char *filename);
 
    void                 Print(Option_t *option="") const override;
    Int_t                ReadBuffer(char *buf, Long64_t pos, Int_t len) override;
    virtual Int_t        ReadBufferNormal(char *buf, Long64_t pos, Int_t len);
    virtual Int_t        ReadBufferPrefetch(char *buf, Long64_t pos, Int_t len);
    virtual void         ResetCache();
+   Bool_t               SaveLearnedBranches(const char *filename) const;
    void                 ResetMissCache(); // Reset the miss cache.
    void                 SetAutoCreated(Bool_t val) {fAutoCreated = val;}
    Int_t                SetBufferSize(Int_t buffersize) override;
    virtual void         SetEntryRange(Long64_t emin,   Long64_t emax);
+   void                 SetSelectedEntries(std::vector<std::pair<Long64_t, Long64_t>> ranges);
    void                 SetFile(TFile *file, TFile::ECacheAction action=TFile::kDisconnect) override;
+   void                 SetLazyBranch(const char *bname, Bool_t lazy = kTRUE);
    virtual void         SetLearnPrefill(EPrefillType type = kNoPrefill);
    static void          SetLearnEntries(Int_t n = 10);
    void                 SetOptimizeMisses(Bool_t opt);
    void                 StartLearningPhase();
    virtual void         StopLearningPhase();
    virtual void         UpdateBranches(TTree *tree);
+   Int_t                WarmStart(const std::vector<std::string> &branchNames);
 
    ClassDefOverride(TTreeCache,3)  //Specialization of TFileCacheRead for a TTree
 };
@@ -104,6 +104,9 @@ protected:
    Int_t       fNMissed;          ///<! number of blocks that were not found in the cache and were unzipped
    Int_t       fNStalls;          ///<! number of hits which caused a stall
    Int_t       fNUnzip;           ///<! number of blocks that were unzipped
+   Int_t       fNLazy;            ///<! number of blocks of lazy branches that were put in the cache
+   Int_t       fNLazyUnzip;       ///<! number of blocks of lazy branches that were unzipped when used
+   std::vector<Bool_t> fIsLazy;   ///<! [fNseek] whether the block belongs to a lazy branch
 
 private:
    TTreeCacheUnzip(const TTreeCacheUnzip &) = delete;
@@ -114,6 +117,7 @@ private:
 
    // Private methods
    void  Init();
+   Bool_t IsLazy(Int_t index) const { return index >= 0 && index < (Int_t)fIsLazy.size() && fIsLazy[index]; }
 
 public:
    TTreeCacheUnzip();
@@ -152,6 +156,8 @@ public:
    Int_t  GetNUnzip() { return fNUnzip; }
    Int_t  GetNMissed(){ return fNMissed; }
    Int_t  GetNFound() { return fNFound; }
+   Int_t  GetNLazy() { return fNLazy; }
+   Int_t  GetNLazyUnzip() { return fNLazyUnzip; }
 
    void Print(Option_t* option = "") const override;
 
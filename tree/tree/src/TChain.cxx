@@ -63,6 +63,72 @@ the trees in the chain.
 #include "strlcpy.h"
 #include "snprintf.h"
 
+#ifdef R__USE_IMT
+#include "ROOT/TTaskGroup.hxx"
+#include "ROOT/TThreadExecutor.hxx"
+#include <algorithm>
+#include <map>
+#include <vector>
+
+namespace ROOT {
+namespace Internal {
+
+/// Open the files of a chain and read their tree headers in background tasks, ahead of the moment the chain loads
+/// them, see TChain::SetFilePrefetching.
+class TChainFilePrefetcher {
+   struct RFile {
+      std::unique_ptr<TFile> fFile;
+      TTree *fTree = nullptr; ///< Owned by fFile
+      /// Declared last, so that it is destroyed first: waiting for the task before the file is deleted
+      ROOT::Experimental::TTaskGroup fTask;
+   };
+   std::map<Int_t, std::unique_ptr<RFile>> fFiles; ///< Indexed by tree number
+
+public:
+   bool IsPrefetched(Int_t treeNumber) const { return fFiles.count(treeNumber); }
+
+   void Prefetch(Int_t treeNumber, const std::string &fileName, const std::string &treeName, const std::string &option)
+   {
+      auto file = std::make_unique<RFile>();
+      auto f = file.get();
+      f->fTask.Run([f, fileName, treeName, option]() {
+         TDirectory::TContext ctxt;
+         f->fFile.reset(TFile::Open(fileName.c_str(), option.c_str()));
+         if (f->fFile && !f->fFile->IsZombie())
+            f->fTree = dynamic_cast<TTree *>(f->fFile->Get(treeName.c_str()));
+      });
+      fFiles[treeNumber] = std::move(file);
+   }
+
+   /// Hand over the file opened for the tree with the given number, if any. The tree is null if it was not found.
+   bool Take(Int_t treeNumber, TFile *&file, TTree *&tree)
+   {
+      auto it = fFiles.find(treeNumber);
+      if (it == fFiles.end())
+         return false;
+      it->second->fTask.Wait();
+      file = it->second->fFile.release();
+      tree = it->second->fTree;
+      fFiles.erase(it);
+      return true;
+   }
+
+   /// Close the files of the trees out of [first, last)
+   void Discard(Int_t first, Int_t last)
+   {
+      for (auto it = fFiles.begin(); it != fFiles.end();) {
+         if (it->first < first || it->first >= last)
+            it = fFiles.erase(it);
+         else
+            ++it;
+      }
+   }
+};
+
+} // namespace Internal
+} // namespace ROOT
+#endif
+
 ClassImp(TChain);
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -70,7 +136,8 @@ ClassImp(TChain);
 
 TChain::TChain(Mode mode)
    : TTree(), fTreeOffsetLen(100), fNtrees(0), fTreeNumber(-1), fTreeOffset(0), fCanDeleteRefs(kFALSE), fTree(0),
-     fFile(0), fFiles(0), fStatus(0), fProofChain(0), fGlobalRegistration(mode == kWithGlobalRegistration)
+     fFile(0), fFiles(0), fStatus(0), fProofChain(0), fGlobalRegistration(mode == kWithGlobalRegistration),
+     fNFilesToPrefetch(0)
 {
    fTreeOffset = new Long64_t[fTreeOffsetLen];
    fFiles = new TObjArray(fTreeOffsetLen);
@@ -139,7 +206,7 @@ TChain::TChain(Mode mode)
 TChain::TChain(const char *name, const char *title, Mode mode)
    : TTree(name, title, /*splitlevel*/ 99, nullptr), fTreeOffsetLen(100), fNtrees(0), fTreeNumber(-1), fTreeOffset(0),
      fCanDeleteRefs(kFALSE), fTree(0), fFile(0), fFiles(0), fStatus(0), fProofChain(0),
-     fGlobalRegistration(mode == kWithGlobalRegistration)
+     fGlobalRegistration(mode == kWithGlobalRegistration), fNFilesToPrefetch(0)
 {
    //
    //*-*
@@ -178,6 +245,10 @@ TChain::~TChain()
       gROOT->GetListOfCleanups()->Remove(this);
    }
 
+#ifdef R__USE_IMT
+   fFilePrefetcher.reset();
+#endif
+
    SafeDelete(fProofChain);
    fStatus->Delete();
    delete fStatus;
@@ -963,10 +1034,63 @@ Long64_t TChain::GetChainEntryNumber(Long64_t entry) const
    return entry + fTreeOffset[fTreeNumber];
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Read the number of entries of the trees that are not known yet in parallel,
+/// one task per file, and update the offset table.
+/// Only done with file prefetching and implicit multi-threading enabled.
+
+void TChain::CountEntriesInParallel()
+{
+#ifdef R__USE_IMT
+   if (fNFilesToPrefetch <= 0 || !ROOT::IsImplicitMTEnabled() || fNtrees == 0)
+      return;
+
+   std::vector<Int_t> unknown;
+   for (Int_t i = 0; i < fNtrees; ++i) {
+      if (static_cast<TChainElement *>(fFiles->At(i))->GetEntries() == TTree::kMaxEntries)
+         unknown.push_back(i);
+   }
+   std::vector<Long64_t> entries(unknown.size(), 0);
+   std::vector<Int_t> results(unknown.size(), 0);
+
+   // The files are only open for the time of reading the tree header: no need to register them
+   auto countEntries = [&](UInt_t k) {
+      auto element = static_cast<TChainElement *>(fFiles->At(unknown[k]));
+      TDirectory::TContext ctxt;
+      std::unique_ptr<TFile> file(TFile::Open(element->GetTitle(), "READ_WITHOUT_GLOBALREGISTRATION"));
+      if (!file || file->IsZombie()) {
+         results[k] = -3;
+         return;
+      }
+      auto tree = dynamic_cast<TTree *>(file->Get(element->GetName()));
+      if (!tree) {
+         Error("GetEntries", "Cannot find tree with name %s in file %s", element->GetName(), element->GetTitle());
+         results[k] = -4;
+         return;
+      }
+      entries[k] = tree->GetEntries();
+   };
+   ROOT::TThreadExecutor pool;
+   pool.Foreach(countEntries, ROOT::TSeqU(unknown.size()));
+
+   for (std::size_t k = 0; k < unknown.size(); ++k) {
+      auto element = static_cast<TChainElement *>(fFiles->At(unknown[k]));
+      element->SetNumberEntries(entries[k]);
+      if (results[k] != 0)
+         element->SetLoadResult(results[k]);
+   }
+   for (Int_t i = 0; i < fNtrees; ++i)
+      fTreeOffset[i + 1] = fTreeOffset[i] + static_cast<TChainElement *>(fFiles->At(i))->GetEntries();
+   fEntries = fTreeOffset[fNtrees];
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return the total number of entries in the chain.
 /// In case the number of entries in each tree is not yet known,
-/// the offset table is computed.
+/// the offset table is computed. With file prefetching and implicit
+/// multi-threading enabled, the files are opened in parallel to do so,
+/// see SetFilePrefetching().
 
 Long64_t TChain::GetEntries() const
 {
@@ -977,6 +1101,9 @@ Long64_t TChain::GetEntries() const
                                " run TChain::SetProof(kTRUE, kTRUE) first");
       return fProofChain->GetEntries();
    }
+   if (fEntries == TTree::kMaxEntries) {
+      const_cast<TChain*>(this)->CountEntriesInParallel();
+   }
    if (fEntries == TTree::kMaxEntries) {
       const_cast<TChain*>(this)->LoadTree(TTree::kMaxEntries-1);
    }
@@ -1270,6 +1397,10 @@ Bool_t TChain::InPlaceClone(TDirectory * /* new directory */, const char * /* op
 
 void TChain::InvalidateCurrentTree()
 {
+   if (fTree && fFile) {
+      if (TTreeCache *tc = fTree->GetReadCache(fFile))
+         fCacheBranchNames = tc->GetCachedBranchNames();
+   }
    if (fTree && fTree->GetListOfClones()) {
       for (TObjLink* lnk = fTree->GetListOfClones()->FirstLink(); lnk; lnk = lnk->Next()) {
          TTree* clone = (TTree*) lnk->GetObject();
@@ -1456,6 +1587,7 @@ Long64_t TChain::LoadTree(Long64_t entry)
             // the TTreeCache object.
             tpf = fTree->GetReadCache(fFile);
             if (tpf) {
+               fCacheBranchNames = tpf->GetCachedBranchNames();
                tpf->ResetCache();
             }
 
@@ -1506,13 +1638,20 @@ Long64_t TChain::LoadTree(Long64_t entry)
 
    // FIXME: We leak memory here, we've just lost the open file
    //        if we did not delete it above.
-   {
+   // The file and its tree might have been opened ahead in a background task, see SetFilePrefetching.
+   TTree *prefetchedTree = nullptr;
+   bool prefetched = false;
+#ifdef R__USE_IMT
+   if (fFilePrefetcher)
+      prefetched = fFilePrefetcher->Take(treenum, fFile, prefetchedTree);
+#endif
+   if (!prefetched) {
       TDirectory::TContext ctxt;
       const char *option = fGlobalRegistration ? "READ" : "READ_WITHOUT_GLOBALREGISTRATION";
       fFile = TFile::Open(element->GetTitle(), option);
-      if (fFile && fGlobalRegistration)
-         fFile->SetBit(kMustCleanup);
    }
+   if (fFile && fGlobalRegistration)
+      fFile->SetBit(kMustCleanup);
 
    // ----- Begin of modifications by MvL
    Int_t returnCode = 0;
@@ -1529,7 +1668,7 @@ Long64_t TChain::LoadTree(Long64_t entry)
          fPerfStats->SetFile(fFile);
 
       // Note: We do *not* own fTree after this, the file does!
-      fTree = dynamic_cast<TTree*>(fFile->Get(element->GetName()));
+      fTree = prefetched ? prefetchedTree : dynamic_cast<TTree*>(fFile->Get(element->GetName()));
       if (!fTree) {
          // Now that we do not check during the addition, we need to check here!
          Error("LoadTree", "Cannot find tree with name %s in file %s", element->GetName(), element->GetTitle());
@@ -1544,6 +1683,7 @@ Long64_t TChain::LoadTree(Long64_t entry)
    }
 
    fTreeNumber = treenum;
+   PrefetchFiles(treenum + 1);
    // FIXME: We own fFile, we must be careful giving away a pointer to it!
    // FIXME: We may set fDirectory to zero here!
    fDirectory = fFile;
@@ -1566,6 +1706,12 @@ Long64_t TChain::LoadTree(Long64_t entry)
       if (fCacheUserSet) {
          this->SetCacheSize(fCacheSize);
       }
+      // The cache of a previous tree was lost (e.g. a file of the chain is missing):
+      // start the new one with the branches it had learnt rather than learning again.
+      if (fTree && !fCacheBranchNames.empty() && (!fCacheUserSet || fCacheSize != 0)) {
+         if (TTreeCache *tc = fTree->GetReadCache(fFile, kTRUE))
+            tc->WarmStart(fCacheBranchNames);
+      }
    }
 
    // Check if fTreeOffset has really been set.
@@ -1737,6 +1883,34 @@ Long64_t TChain::LoadTree(Long64_t entry)
    return treeReadEntry;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Open the files of the trees [first, first + GetFilePrefetching()) that are
+/// not opened yet in background tasks, and close the files opened ahead that
+/// are out of this window.
+
+void TChain::PrefetchFiles(Int_t first)
+{
+#ifdef R__USE_IMT
+   if (fNFilesToPrefetch <= 0 || !ROOT::IsImplicitMTEnabled()) {
+      fFilePrefetcher.reset();
+      return;
+   }
+   if (!fFilePrefetcher)
+      fFilePrefetcher = std::make_unique<ROOT::Internal::TChainFilePrefetcher>();
+
+   const Int_t last = std::min(first + fNFilesToPrefetch, fNtrees);
+   fFilePrefetcher->Discard(first, last);
+   const char *option = fGlobalRegistration ? "READ" : "READ_WITHOUT_GLOBALREGISTRATION";
+   for (Int_t i = first; i < last; ++i) {
+      auto element = static_cast<TChainElement *>(fFiles->At(i));
+      if (element && !fFilePrefetcher->IsPrefetched(i))
+         fFilePrefetcher->Prefetch(i, element->GetTitle(), element->GetName(), option);
+   }
+#else
+   (void)first;
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Check / locate the files in the chain.
 /// By default only the files not yet looked up are checked.
@@ -2331,6 +2505,9 @@ void TChain::RemoveFriend(TTree* oldFriend)
 
 void TChain::Reset(Option_t*)
 {
+#ifdef R__USE_IMT
+   fFilePrefetcher.reset();
+#endif
    delete fFile;
    fFile = 0;
    fNtrees         = 0;
@@ -2340,6 +2517,7 @@ void TChain::Reset(Option_t*)
    fFiles->Delete();
    fStatus->Delete();
    fTreeOffset[0]  = 0;
+   fCacheBranchNames.clear();
    TChainElement* element = new TChainElement("*", "");
    fStatus->Add(element);
    fDirectory = 0;
@@ -2948,6 +3126,40 @@ void TChain::SetEventList(TEventList *evlist)
    SetEntryList(enlist);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Open the next `nfiles` files of the chain ahead of time.
+///
+/// Opening a file and reading the header of its tree, in particular from a
+/// remote storage, can take a significant fraction of the time spent on a
+/// file when the trees are small. With implicit multi-threading enabled
+/// (ROOT::EnableImplicitMT()) and `nfiles > 0`, every time the chain switches
+/// to a new tree the files of the next `nfiles` trees are opened and their
+/// tree headers are read in background tasks, so that the switch to these
+/// trees only has to wait for what is not done yet. The files that are not
+/// used anymore because the chain jumped to another tree are closed.
+///
+/// In this mode GetEntries() also opens the files whose number of entries is
+/// not known yet in parallel, instead of one after the other.
+///
+/// `nfiles <= 0` (the default) disables the prefetching and closes the files
+/// opened ahead. Without implicit multi-threading this setting has no effect.
+/// ~~~ {.cpp}
+///     ROOT::EnableImplicitMT();
+///     TChain ch("T");
+///     ch.Add("root://server//data/run*.root");
+///     ch.SetFilePrefetching(2);
+///     auto nentries = ch.GetEntries(); // the files are opened in parallel
+/// ~~~
+
+void TChain::SetFilePrefetching(Int_t nfiles)
+{
+   fNFilesToPrefetch = nfiles > 0 ? nfiles : 0;
+#ifdef R__USE_IMT
+   if (fNFilesToPrefetch == 0)
+      fFilePrefetcher.reset();
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Change the name of this TChain.
 
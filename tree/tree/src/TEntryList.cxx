@@ -55,6 +55,15 @@ End_Macro
 - __Subtract__() - if the lists are for the same TTree, removes the entries of the second
                list from the first list. If the lists are for TChains, loops over all
                sub-lists
+- __Intersect__() - if the lists are for the same TTree, keeps only the entries of the first
+                list that are also in the second list. The entries of the trees that are
+                not in the second list are removed. If the lists are for TChains, loops
+                over all sub-lists
+- __GetEntryRanges__() - returns the ranges of consecutive entries of a list for a TTree,
+                     e.g. to process them in batches
+
+Add(), Subtract() and Intersect() of lists for the same TTree work block by block
+(see TEntryListBlock), on 16 entries at a time, rather than entry by entry.
 - __GetEntry(n)__ - returns the n-th entry number
 - __Next__()      - returns next entry number. Note, that this function is
                 much faster than GetEntry, and it's called when GetEntry() is called
@@ -1335,13 +1344,17 @@ void TEntryList::Subtract(const TEntryList *elist)
          //second list is also only for 1 tree
          if (!strcmp(elist->fTreeName.Data(),fTreeName.Data()) &&
              !strcmp(elist->fFileName.Data(),fFileName.Data())){
-            //same tree
-            Long64_t n2 = elist->GetN();
-            Long64_t entry;
-            for (Int_t i=0; i<n2; i++){
-               entry = (const_cast<TEntryList*>(elist))->GetEntry(i);
-               Remove(entry);
+            //same tree, subtract block by block
+            if (!elist->fBlocks) return;
+            Int_t nmin = TMath::Min(fNBlocks, elist->fNBlocks);
+            for (Int_t i=0; i<nmin; i++){
+               TEntryListBlock *block1 = (TEntryListBlock*)fBlocks->UncheckedAt(i);
+               TEntryListBlock *block2 = (TEntryListBlock*)elist->fBlocks->UncheckedAt(i);
+               Long64_t nold = block1->GetNPassed();
+               fN = fN - nold + block1->Subtract(block2);
             }
+            fLastIndexQueried = -1;
+            fLastIndexReturned = 0;
          } else {
             //different trees
             return;
@@ -1376,6 +1389,102 @@ void TEntryList::Subtract(const TEntryList *elist)
    return;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Keep only the entries of this entry list that are also contained in elist
+
+void TEntryList::Intersect(const TEntryList *elist)
+{
+   TEntryList *templist = 0;
+   if (!fLists){
+      if (!fBlocks) return;
+      if (!elist->fLists){
+         if (!strcmp(elist->fTreeName.Data(),fTreeName.Data()) &&
+             !strcmp(elist->fFileName.Data(),fFileName.Data())){
+            //same tree, intersect block by block
+            TEntryListBlock empty;
+            for (Int_t i=0; i<fNBlocks; i++){
+               TEntryListBlock *block1 = (TEntryListBlock*)fBlocks->UncheckedAt(i);
+               TEntryListBlock *block2 = &empty;
+               if (elist->fBlocks && i<elist->fNBlocks)
+                  block2 = (TEntryListBlock*)elist->fBlocks->UncheckedAt(i);
+               Long64_t nold = block1->GetNPassed();
+               fN = fN - nold + block1->Intersect(block2);
+            }
+         } else {
+            //different trees, no entry in common
+            fBlocks->Delete();
+            delete fBlocks;
+            fBlocks = 0;
+            fNBlocks = 0;
+            fN = 0;
+         }
+      } else {
+         //second list has sublists, try to find one for the same tree as this list
+         TIter next1(elist->GetLists());
+         templist = 0;
+         Bool_t found = kFALSE;
+         while ((templist = (TEntryList*)next1())){
+            if (!strcmp(templist->fTreeName.Data(),fTreeName.Data()) &&
+                !strcmp(templist->fFileName.Data(),fFileName.Data())){
+               found = kTRUE;
+               break;
+            }
+         }
+         if (found) {
+            Intersect(templist);
+         } else {
+            TEntryList empty;
+            Intersect(&empty);
+         }
+      }
+      fLastIndexQueried = -1;
+      fLastIndexReturned = 0;
+   } else {
+      //this list has sublists
+      TIter next2(fLists);
+      templist = 0;
+      Long64_t oldn=0;
+      while ((templist = (TEntryList*)next2())){
+         oldn = templist->GetN();
+         templist->Intersect(elist);
+         fN = fN - oldn + templist->GetN();
+      }
+   }
+   return;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the ranges [first, last) of consecutive entries of this entry list,
+/// in increasing order. The list must be for a single TTree: for a list with
+/// sub-lists, use GetEntryRanges() of each of them (see GetLists()).
+///
+/// Compared to a loop on Next(), this function walks each block of the list 16
+/// entries at a time, and is meant to hand batches of entries to the event
+/// loops, e.g.:
+/// ~~~ {.cpp}
+///     for (auto &range : elist->GetEntryRanges()) {
+///        for (auto entry = range.first; entry < range.second; ++entry)
+///           tree->GetEntry(entry);
+///     }
+/// ~~~
+
+std::vector<std::pair<Long64_t, Long64_t>> TEntryList::GetEntryRanges() const
+{
+   std::vector<std::pair<Long64_t, Long64_t>> ranges;
+   if (fLists) {
+      Error("GetEntryRanges", "the entry list has sub-lists, get the ranges of each of them");
+      return ranges;
+   }
+   if (!fBlocks)
+      return ranges;
+   for (Int_t i=0; i<fNBlocks; i++){
+      auto block = (const TEntryListBlock*)fBlocks->UncheckedAt(i);
+      if (block)
+         block->GetRanges(ranges, Long64_t(i)*kBlockSize);
+   }
+   return ranges;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 TEntryList operator||(TEntryList &elist1, TEntryList &elist2)
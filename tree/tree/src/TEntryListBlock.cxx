@@ -38,6 +38,14 @@ End_Macro
  - __Merge__() - adds all entries from one block to the other. If the first block
              uses array representation, it's changed to bits representation only
              if the total number of passing entries is still less than kBlockSize
+ - __Intersect__(), __Subtract__() - keep only the entries that are, or are not,
+             in the other block
+ - __GetRanges__() - appends the ranges of consecutive entries of the block, e.g.
+             to process them in batches
+
+Merge(), Intersect() and Subtract() work on the bits representation of the two
+blocks, 16 entries at a time, and choose the most compact representation for the
+result.
  - __GetEntry(n)__ - returns n-th non-zero entry.
  - __Next__()      - return next non-zero entry. In case of representation 1), Next()
                  is faster than GetEntry()
@@ -46,6 +54,8 @@ End_Macro
 #include "TEntryListBlock.h"
 #include "TString.h"
 
+#include <bitset>
+
 ClassImp(TEntryListBlock);
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -242,7 +252,7 @@ Int_t TEntryListBlock::Contains(Int_t entry)
 
 Int_t TEntryListBlock::Merge(TEntryListBlock *block)
 {
-   Int_t i, j;
+   Int_t i;
    if (block->GetNPassed() == 0) return GetNPassed();
    if (GetNPassed() == 0){
       //this block is empty
@@ -260,34 +270,18 @@ Int_t TEntryListBlock::Merge(TEntryListBlock *block)
    }
    if (fType==0){
       //stored as bits
-      if (block->fType == 0){
-         for (i=0; i<kBlockSize*16; i++){
-            if (block->Contains(i))
-               Enter(i);
+      if (block->fType == 1 && block->fPassing){
+         //the other block stores entries that pass
+         for (i=0; i<block->fNPassed; i++){
+            Enter(block->fIndices[i]);
          }
       } else {
-         if (block->fPassing){
-            //the other block stores entries that pass
-            for (i=0; i<block->fNPassed; i++){
-               Enter(block->fIndices[i]);
-            }
-         } else {
-            //the other block stores entries that don't pass
-            if (block->fNPassed==0){
-               for (i=0; i<kBlockSize*16; i++){
-                  Enter(i);
-               }
-            }
-            for (j=0; j<block->fIndices[0]; j++)
-               Enter(j);
-            for (i=0; i<block->fNPassed-1; i++){
-               for (j=block->fIndices[i]+1; j<block->fIndices[i+1]; j++){
-                  Enter(j);
-               }
-            }
-            for (j=block->fIndices[block->fNPassed-1]+1; j<kBlockSize*16; j++)
-               Enter(j);
-         }
+         UShort_t *bits = new UShort_t[kBlockSize];
+         block->GetBits(bits);
+         for (i=0; i<kBlockSize; i++)
+            bits[i] |= fIndices[i];
+         SetBits(bits);
+         return GetNPassed();
       }
    } else {
       //stored as a list
@@ -363,6 +357,129 @@ Int_t TEntryListBlock::Merge(TEntryListBlock *block)
    return GetNPassed();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Keep only the entries that are also in the other block
+/// Returns the resulting number of entries in the block
+
+Int_t TEntryListBlock::Intersect(TEntryListBlock *block)
+{
+   if (GetNPassed() == 0) return 0;
+   UShort_t *bits = new UShort_t[kBlockSize];
+   UShort_t *otherbits = new UShort_t[kBlockSize];
+   GetBits(bits);
+   block->GetBits(otherbits);
+   for (Int_t i=0; i<kBlockSize; i++)
+      bits[i] &= otherbits[i];
+   delete [] otherbits;
+   SetBits(bits);
+   return GetNPassed();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Remove the entries that are in the other block
+/// Returns the resulting number of entries in the block
+
+Int_t TEntryListBlock::Subtract(TEntryListBlock *block)
+{
+   if (GetNPassed() == 0 || block->GetNPassed() == 0) return GetNPassed();
+   UShort_t *bits = new UShort_t[kBlockSize];
+   UShort_t *otherbits = new UShort_t[kBlockSize];
+   GetBits(bits);
+   block->GetBits(otherbits);
+   for (Int_t i=0; i<kBlockSize; i++)
+      bits[i] &= ~otherbits[i];
+   delete [] otherbits;
+   SetBits(bits);
+   return GetNPassed();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Append the ranges [first, last) of consecutive entries of the block, shifted
+/// by offset, to ranges. A range starting where the last one of ranges ends is
+/// merged with it, so that the ranges of consecutive blocks are joined.
+
+void TEntryListBlock::GetRanges(std::vector<std::pair<Long64_t, Long64_t>> &ranges, Long64_t offset) const
+{
+   auto addEntries = [&ranges](Long64_t first, Long64_t last) {
+      if (!ranges.empty() && ranges.back().second == first)
+         ranges.back().second = last;
+      else
+         ranges.emplace_back(first, last);
+   };
+
+   if (fType==1 && fPassing){
+      for (Int_t i=0; i<fNPassed; i++)
+         addEntries(offset+fIndices[i], offset+fIndices[i]+1);
+      return;
+   }
+   if (fType==-1 && fPassing) return;
+
+   UShort_t *bits = new UShort_t[kBlockSize];
+   GetBits(bits);
+   for (Int_t i=0; i<kBlockSize; i++){
+      const Long64_t first = offset+i*16;
+      if (bits[i]==0) continue;
+      if (bits[i]==0xFFFF){
+         addEntries(first, first+16);
+         continue;
+      }
+      for (Int_t j=0; j<16; j++){
+         if ((bits[i] & (1<<j))!=0)
+            addEntries(first+j, first+j+1);
+      }
+   }
+   delete [] bits;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill bits, an array of kBlockSize elements, with the bits representation of
+/// the block, whatever its current representation
+
+void TEntryListBlock::GetBits(UShort_t *bits) const
+{
+   Int_t i;
+   if (fType==0){
+      for (i=0; i<kBlockSize; i++)
+         bits[i] = fIndices[i];
+      return;
+   }
+   if (fPassing){
+      for (i=0; i<kBlockSize; i++)
+         bits[i] = 0;
+      if (fType!=1) return;
+      for (i=0; i<fNPassed; i++)
+         bits[fIndices[i]>>4] |= 1<<(fIndices[i] & 15);
+   } else {
+      for (i=0; i<kBlockSize; i++)
+         bits[i] = 0xFFFF;
+      if (!fIndices) return;
+      for (i=0; i<fNPassed; i++)
+         bits[fIndices[i]>>4] &= (0xFFFF^(1<<(fIndices[i] & 15)));
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Replace the content of the block by bits, an array of kBlockSize elements
+/// that the block takes ownership of, and optimize the storage
+
+void TEntryListBlock::SetBits(UShort_t *bits)
+{
+   Int_t npassed = 0;
+   for (Int_t i=0; i<kBlockSize; i++)
+      npassed += std::bitset<16>(bits[i]).count();
+   if (fIndices)
+      delete [] fIndices;
+   fIndices = bits;
+   fN = kBlockSize;
+   fNPassed = npassed;
+   fType = 0;
+   fPassing = 1;
+   fCurrent = 0;
+   fLastIndexQueried = -1;
+   fLastIndexReturned = -1;
+   OptimizeStorage();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Returns the number of entries, passing the selection.
 /// In case, when the block stores entries that pass (fPassing=1) returns fNPassed
@@ -4492,6 +4492,18 @@ Long64_t TTree::Draw(const char* varexp, const TCut& selection, Option_t* option
 /// You can use the option "goff" to turn off the graphics output
 /// of TTree::Draw in the above example.
 ///
+/// ### Multi-threaded processing
+///
+/// When implicit multi-threading is enabled (see ROOT::EnableImplicitMT) and
+/// the expression is drawn into a 1-D to 3-D histogram or profile, the entries
+/// are processed in parallel over the clusters of the tree as soon as the limits
+/// of the histogram are known, i.e. after the first `GetEstimate()` selected rows
+/// for a histogram with automatic limits. Each thread fills its own clone of the
+/// histogram and the clones are merged at the end. This is only done if more
+/// entries than `GetEstimate()` are processed, for a chain or a tree in a file
+/// opened for reading, without entry list, and the values of the entries processed
+/// in parallel are not available via GetV1(), GetV2(), GetV3(), GetV4() and GetW().
+///
 /// ### Automatic interface to TTree::Draw via the TTreeViewer
 ///
 /// A complete graphical interface to this function is implemented
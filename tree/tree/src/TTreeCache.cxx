@@ -83,12 +83,21 @@ The usage of TChain or TEventList have influence on the behaviour of the cache:
 
 - Special case of a TChain
   Once the training is done on the first Tree, the list of branches
-  in the cache is kept for the following files.
+  in the cache is kept for the following files. If none of these
+  branches exists in the next Tree, the learning phase is restarted.
+  The list is also kept if the cache of the chain has to be recreated,
+  e.g. after a file that could not be opened, and the new cache starts
+  from it without learning, see TTreeCache::WarmStart.
 
 - Special case of a TEventlist
   if the Tree or TChain has a TEventlist, only the buffers
   referenced by the list are put in the cache.
 
+- Special case of a sparse selection of entries, e.g. by a TEntryList
+  if the entries that will be read are given with SetSelectedEntries,
+  only the baskets containing at least one of them are put in the cache.
+  TTreeReader does so for the TEntryList it processes.
+
 The learning phase is started or restarted when:
    - TTree automatically creates a cache.
    - TTree::SetCacheSize is called with a non-zero size and a cache
@@ -107,6 +116,38 @@ The learning period is stopped (and prefetching is started) when:
    - A 'cached' TChain switches over to a new file.
 
 
+\anchor learnedbranches
+## Reusing the learned branches in another job
+
+The list of branches learned by a cache can be saved in a text file with
+SaveLearnedBranches, and used to start the cache of another job without
+learning phase with LoadLearnedBranches:
+~~~ {.cpp}
+    // at the end of a first job
+    tree->GetReadCache(tree->GetCurrentFile())->SaveLearnedBranches("branches.txt");
+    // at the beginning of the next one, after loading the first tree
+    chain->LoadTree(0);
+    auto tc = chain->GetTree()->GetReadCache(chain->GetCurrentFile(), kTRUE);
+    tc->LoadLearnedBranches("branches.txt");
+~~~
+
+\anchor lazybranches
+## Lazy decompression of branches
+
+The cache holds the baskets in their compressed form: a basket is
+decompressed by the branch when one of its entries is read for the first
+time, so the baskets of a branch which is only read for some entries, e.g.
+after a selection, are fetched but mostly not decompressed. The number of
+baskets which were in the cache but were never used is returned by
+GetNUnusedBaskets.
+TTreeCacheUnzip instead decompresses all the baskets of the cache in parallel,
+ahead of their use. The baskets of the branches marked with SetLazyBranch are
+left out and decompressed on their first use only:
+~~~ {.cpp}
+    tree->GetReadCache(file, kTRUE)->SetLazyBranch("jets");
+~~~
+TTreeReader::SetLazyBranches does so for the branches of a TTreeReader.
+
 \anchor cachemisses
 ## Self-optimization in presence of cache misses
 
@@ -300,6 +341,8 @@ myTreeOrChain.GetTree()->PrintCacheStats();
 #include "TBranchCacheInfo.h"
 #include "TVirtualPerfStats.h"
 #include <limits.h>
+#include <algorithm>
+#include <fstream>
 
 Int_t TTreeCache::fgLearnEntries = 100;
 
@@ -1395,6 +1438,7 @@ Bool_t TTreeCache::FillBuffer()
                // cache but was not used and would be reloaded in the next
                // cluster.
                b->fCacheInfo.GetUnused(potentialVetoes);
+               fNUnusedBaskets += potentialVetoes.size();
                if (showMore || gDebug > 7) {
                   TString vetolist;
                   for(auto v : potentialVetoes) {
@@ -1491,11 +1535,13 @@ Bool_t TTreeCache::FillBuffer()
                if (cursor[i].fClusterStart == -1)
                   cursor[i].fClusterStart = j;
 
-               if (elist) {
+               if (elist || !fSelectedEntries.empty()) {
                   Long64_t emax = fEntryMax;
                   if (j<nb-1)
                      emax = entries[j + 1] - 1;
-                  if (!elist->ContainsRange(entries[j]+chainOffset,emax+chainOffset))
+                  if (elist && !elist->ContainsRange(entries[j]+chainOffset,emax+chainOffset))
+                     continue;
+                  if (!ContainsSelectedEntry(entries[j], emax))
                      continue;
                }
 
@@ -1865,6 +1911,22 @@ Double_t TTreeCache::GetMissEfficiencyRel() const
    return static_cast<double>(fNMissReadOk) / static_cast<double>(fNMissReadOk + fNMissReadMiss);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the names of the branches in the cache, learned or added by the user.
+/// The names of the branches learned on a previous tree of a TChain that do
+/// not exist in the current tree are included.
+
+std::vector<std::string> TTreeCache::GetCachedBranchNames() const
+{
+   std::vector<std::string> names;
+   if (!fBrNames)
+      return names;
+   names.reserve(fBrNames->GetEntries());
+   for (auto name : *fBrNames)
+      names.emplace_back(name->GetName());
+   return names;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Static function returning the number of entries used to train the cache
 /// see SetLearnEntries
@@ -1906,6 +1968,7 @@ void TTreeCache::Print(Option_t *option) const
    printf("Secondary Efficiency ..............: %f\n", GetMissEfficiency());
    printf("Secondary Efficiency Rel ..........: %f\n", GetMissEfficiencyRel());
    printf("Learn entries......................: %d\n",TTreeCache::GetLearnEntries());
+   printf("Unused baskets.....................: %d\n",GetNUnusedBaskets());
    if ( opt.Contains("cachedbranches") ) {
       opt.ReplaceAll("cachedbranches","");
       printf("Cached branches....................:\n");
@@ -2037,12 +2100,15 @@ Int_t TTreeCache::ReadBuffer(char *buf, Long64_t pos, Int_t len)
 
 void TTreeCache::ResetCache()
 {
+   std::vector<Int_t> unused;
    for (Int_t i = 0; i < fNbranches; ++i) {
       TBranch *b = (TBranch*)fBranches->UncheckedAt(i);
       if (b->GetDirectory()==0 || b->TestBit(TBranch::kDoNotProcess))
          continue;
       if (b->GetDirectory()->GetFile() != fFile)
          continue;
+      b->fCacheInfo.GetUnused(unused);
+      fNUnusedBaskets += unused.size();
       b->fCacheInfo.Reset();
    }
    fEntryCurrent = -1;
@@ -2119,6 +2185,91 @@ void TTreeCache::SetEntryRange(Long64_t emin, Long64_t emax)
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of baskets that were put in the cache but were never
+/// used, including the ones currently in the cache. These baskets were read
+/// but, unless the cache is a TTreeCacheUnzip, not decompressed.
+
+Int_t TTreeCache::GetNUnusedBaskets() const
+{
+   Int_t nUnused = fNUnusedBaskets;
+   std::vector<Int_t> unused;
+   for (Int_t i = 0; i < fNbranches; ++i) {
+      TBranch *b = (TBranch *)fBranches->UncheckedAt(i);
+      if (!b->GetDirectory() || b->GetDirectory()->GetFile() != fFile)
+         continue;
+      b->fCacheInfo.GetUnused(unused);
+      nUnused += unused.size();
+   }
+   return nUnused;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if the baskets of the branch, or of its top-level branch, must
+/// not be decompressed before their first use, see SetLazyBranch.
+
+Bool_t TTreeCache::IsLazyBranch(const TBranch *b) const
+{
+   if (fLazyBrNames.empty() || !b)
+      return kFALSE;
+   const TBranch *mother = b->GetMother();
+   for (const auto &name : fLazyBrNames) {
+      if (name == b->GetName() || (mother && name == mother->GetName()))
+         return kTRUE;
+   }
+   return kFALSE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Mark (or unmark) a branch and its sub-branches as lazy: their baskets are
+/// fetched with the others, but only decompressed when one of their entries is
+/// read. This only changes the behavior of TTreeCacheUnzip, which otherwise
+/// decompresses all the baskets of the cache ahead of their use: a TTreeCache
+/// never decompresses baskets itself.
+/// Use it for the branches which are read for a small fraction of the entries.
+/// The branch names are kept for the following trees of a TChain.
+
+void TTreeCache::SetLazyBranch(const char *bname, Bool_t lazy)
+{
+   if (!bname)
+      return;
+   auto it = std::find(fLazyBrNames.begin(), fLazyBrNames.end(), bname);
+   if (lazy && it == fLazyBrNames.end())
+      fLazyBrNames.emplace_back(bname);
+   else if (!lazy && it != fLazyBrNames.end())
+      fLazyBrNames.erase(it);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Restrict the prefetching to the baskets that contain at least one of the
+/// entries that will be read, given as sorted and disjoint ranges [first, last[
+/// of entry numbers of the current tree. This avoids reading the clusters and
+/// the baskets of the entries skipped by a sparse selection, e.g. a TEntryList.
+///
+/// An empty vector disables the selection. The selection is also dropped when
+/// a TChain switches to its next tree, see UpdateBranches. It is applied from
+/// the next filling of the cache.
+
+void TTreeCache::SetSelectedEntries(std::vector<std::pair<Long64_t, Long64_t>> ranges)
+{
+   fSelectedEntries = std::move(ranges);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if there is no selection of entries or if one of the selected
+/// entries is in [first, last].
+
+Bool_t TTreeCache::ContainsSelectedEntry(Long64_t first, Long64_t last) const
+{
+   if (fSelectedEntries.empty())
+      return kTRUE;
+   // the first range that ends after `first`
+   using Range_t = std::pair<Long64_t, Long64_t>;
+   auto range = std::upper_bound(fSelectedEntries.begin(), fSelectedEntries.end(), first,
+                                 [](Long64_t entry, const Range_t &r) { return entry < r.second; });
+   return range != fSelectedEntries.end() && range->first <= last;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Change the file that is being cached.
 
@@ -2212,6 +2363,8 @@ void TTreeCache::UpdateBranches(TTree *tree)
 
    fEntryMin  = 0;
    fEntryMax  = fTree->GetEntries();
+   // the selected entries are numbered within the previous tree
+   fSelectedEntries.clear();
 
    fEntryCurrent = -1;
 
@@ -2236,9 +2389,95 @@ void TTreeCache::UpdateBranches(TTree *tree)
       fNbranches++;
    }
 
+   // None of the branches learnt from the previous file exists in this tree:
+   // learn again rather than running without cached branches.
+   if (fNbranches == 0 && fBrNames->GetEntries() > 0 && !fIsManual) {
+      fBrNames->Delete();
+      fIsLearning = kTRUE;
+      fEntryNext = fEntryMin + fgLearnEntries;
+   }
+
+   auto perfStats = GetTree()->GetPerfStats();
+   if (perfStats)
+      perfStats->UpdateBranchIndices(fBranches);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Start the cache with a list of branches learned elsewhere, e.g. by the cache
+/// of a previous tree of a TChain or by a previous job, instead of learning it.
+///
+/// The names are validated against the branches of the current tree: the
+/// names without a branch are kept for the following trees of a TChain, but if
+/// none of the branches exists the learning phase is started.
+/// The cache is filled at the next read.
+/// Returns the number of branches found in the tree.
+
+Int_t TTreeCache::WarmStart(const std::vector<std::string> &branchNames)
+{
+   if (!fTree || branchNames.empty())
+      return 0;
+
+   StartLearningPhase();
+   Int_t nfound = 0;
+   for (const auto &name : branchNames) {
+      TBranch *b = fTree->GetBranch(name.c_str());
+      if (b && AddBranch(b) == 0) {
+         ++nfound;
+      } else if (!fBrNames->FindObject(name.c_str())) {
+         fBrNames->Add(new TObjString(name.c_str()));
+      }
+   }
+   if (nfound == 0) {
+      fBrNames->Delete();
+      fEntryNext = fEntryMin + fgLearnEntries;
+      return 0;
+   }
+
+   fIsLearning = kFALSE;
+   fEntryNext = -1;
    auto perfStats = GetTree()->GetPerfStats();
    if (perfStats)
       perfStats->UpdateBranchIndices(fBranches);
+   return nfound;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write the names of the branches in the cache to a text file, one per line,
+/// to start the cache of a later job with LoadLearnedBranches.
+/// Returns kFALSE if the file could not be written.
+
+Bool_t TTreeCache::SaveLearnedBranches(const char *filename) const
+{
+   std::ofstream out(filename);
+   if (!out) {
+      Error("SaveLearnedBranches", "Cannot open file %s", filename);
+      return kFALSE;
+   }
+   for (const auto &name : GetCachedBranchNames())
+      out << name << '\n';
+   return out.good();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Start the cache with the branches listed in a file written by
+/// SaveLearnedBranches, see WarmStart.
+/// Returns the number of branches found in the tree, or -1 if the file
+/// could not be read.
+
+Int_t TTreeCache::LoadLearnedBranches(const char *filename)
+{
+   std::ifstream in(filename);
+   if (!in) {
+      Error("LoadLearnedBranches", "Cannot open file %s", filename);
+      return -1;
+   }
+   std::vector<std::string> names;
+   std::string name;
+   while (std::getline(in, name)) {
+      if (!name.empty())
+         names.emplace_back(name);
+   }
+   return WarmStart(names);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
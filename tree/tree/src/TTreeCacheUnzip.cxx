@@ -16,6 +16,10 @@
 
 A TTreeCache which exploits parallelized decompression of its own content.
 
+The baskets of the branches marked with SetLazyBranch are not decompressed in
+parallel, but only when they are used: GetNLazy and GetNLazyUnzip return the
+number of such baskets put in the cache and the number actually decompressed.
+
 */
 
 #include "TTreeCacheUnzip.h"
@@ -166,7 +170,9 @@ TTreeCacheUnzip::TTreeCacheUnzip() : TTreeCache(),
    fNFound(0),
    fNMissed(0),
    fNStalls(0),
-   fNUnzip(0)
+   fNUnzip(0),
+   fNLazy(0),
+   fNLazyUnzip(0)
 {
    // Default Constructor.
    Init();
@@ -185,7 +191,9 @@ TTreeCacheUnzip::TTreeCacheUnzip(TTree *tree, Int_t buffersize) : TTreeCache(tre
    fNFound(0),
    fNMissed(0),
    fNStalls(0),
-   fNUnzip(0)
+   fNUnzip(0),
+   fNLazy(0),
+   fNLazyUnzip(0)
 {
    Init();
 }
@@ -307,12 +315,14 @@ Bool_t TTreeCacheUnzip::FillBuffer()
 
    //clear cache buffer
    TFileCacheRead::Prefetch(0,0);
+   fIsLazy.clear();
 
    //store baskets
    for (Int_t i = 0; i < fNbranches; i++) {
       TBranch *b = (TBranch*)fBranches->UncheckedAt(i);
       if (b->GetDirectory() == 0) continue;
       if (b->GetDirectory()->GetFile() != fFile) continue;
+      const Bool_t lazy = IsLazyBranch(b);
       Int_t nb = b->GetMaxBaskets();
       Int_t *lbaskets   = b->GetBasketBytes();
       Long64_t *entries = b->GetBasketEntry();
@@ -335,9 +345,16 @@ Bool_t TTreeCacheUnzip::FillBuffer()
             if (j < nb - 1) emax = entries[j+1] - 1;
             if (!elist->ContainsRange(entries[j] + chainOffset, emax + chainOffset)) continue;
          }
+         if (!fSelectedEntries.empty()) {
+            Long64_t emax = fEntryMax;
+            if (j < nb - 1) emax = entries[j+1] - 1;
+            if (!ContainsSelectedEntry(entries[j], emax)) continue;
+         }
          fNReadPref++;
+         if (lazy) fNLazy++;
 
          TFileCacheRead::Prefetch(pos, len);
+         fIsLazy.push_back(lazy);
       }
       if (gDebug > 0) printf("Entry: %lld, registering baskets branch %s, fEntryNext=%lld, fNseek=%d, fNtot=%d\n", entry, ((TBranch*)fBranches->UncheckedAt(i))->GetName(), fEntryNext, fNseek, fNtot);
    }
@@ -609,10 +626,11 @@ Int_t TTreeCacheUnzip::UnzipCache(Int_t index)
 /// We create a TTaskGroup and asynchronously maps each group of baskets(> 100 kB in total)
 /// to a task. In TTaskGroup, we use TThreadExecutor to do the actually work of unzipping
 /// a group of basket. The purpose of creating TTaskGroup is to avoid competing with main thread.
+/// The baskets of lazy branches are left to be unzipped when they are used.
 
 Int_t TTreeCacheUnzip::CreateTasks()
 {
-   auto mapFunction = [&]() {
+   auto mapFunction = [&, isLazy = fIsLazy]() {
       auto unzipFunction = [&](const std::vector<Int_t> &indices) {
          // If cache is invalidated and we should return immediately.
          if (!fIsTransferred) return nullptr;
@@ -634,13 +652,16 @@ Int_t TTreeCacheUnzip::CreateTasks()
       if (fUnzipGroupSize <= 0) fUnzipGroupSize = 102400;
       for (Int_t i = 0; i < fNseek; i++) {
          while (accusz < fUnzipGroupSize) {
-            accusz += fSeekLen[i];
-            indices.push_back(i);
+            if (i >= (Int_t)isLazy.size() || !isLazy[i]) {
+               accusz += fSeekLen[i];
+               indices.push_back(i);
+            }
             i++;
             if (i >= fNseek) break;
          }
          if (i < fNseek) i--;
-         basketIndices.push_back(indices);
+         if (!indices.empty())
+            basketIndices.push_back(indices);
          indices.clear();
          accusz = 0;
       }
@@ -680,6 +701,7 @@ Int_t TTreeCacheUnzip::GetUnzipBuffer(char **buf, Long64_t pos, Int_t len, Bool_
    // better to be done in the main thread.
 
    Int_t myCycle = fCycle;
+   Bool_t lazy = kFALSE;
 
    if (fParallel && !fIsLearning) {
 
@@ -697,6 +719,7 @@ Int_t TTreeCacheUnzip::GetUnzipBuffer(char **buf, Long64_t pos, Int_t len, Bool_
          // The buffer is, at minimum, in the file cache. We must know its index in the requests list
          // In order to get its info
          Int_t seekidx = fSeekIndex[loc];
+         lazy = IsLazy(seekidx);
 
          do {
 
@@ -725,7 +748,7 @@ Int_t TTreeCacheUnzip::GetUnzipBuffer(char **buf, Long64_t pos, Int_t len, Bool_
                if (fEmpty) {
                   for (Int_t ii = 0; ii < fNseek; ++ii) {
                      Int_t idx = (seekidx + 1 + ii) % fNseek;
-                     if (fUnzipState.IsUntouched(idx)) {
+                     if (fUnzipState.IsUntouched(idx) && !IsLazy(idx)) {
                         if(fUnzipState.TryUnzipping(idx)) {
                            reqi = idx;
                            break;
@@ -817,7 +840,10 @@ Int_t TTreeCacheUnzip::GetUnzipBuffer(char **buf, Long64_t pos, Int_t len, Bool_
       *free = kTRUE;
    }
 
-   if (!fIsLearning) {
+   if (lazy) {
+      // not a miss: the basket of a lazy branch is unzipped when first used
+      fNLazyUnzip++;
+   } else if (!fIsLearning) {
       fNMissed++;
    }
 
@@ -952,6 +978,8 @@ void  TTreeCacheUnzip::Print(Option_t* option) const {
    printf("Number of hits: %d\n", fNFound);
    printf("Number of stalls: %d\n", fNStalls);
    printf("Number of misses: %d\n", fNMissed);
+   printf("Number of lazy blocks: %d\n", fNLazy);
+   printf("Number of lazy blocks unzipped: %d\n", fNLazyUnzip);
 
    TTreeCache::Print(option);
 }
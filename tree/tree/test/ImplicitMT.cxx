@@ -1,3 +1,4 @@
+#include "TChain.h"
 #include "TFile.h"
 #include "TROOT.h"
 #include "TSystem.h"
@@ -5,6 +6,9 @@
 
 #include "gtest/gtest.h"
 
+#include <string>
+#include <vector>
+
 #ifdef R__USE_IMT
 
 // ROOT-9668
@@ -28,4 +32,56 @@ TEST(TTreeImplicitMT, flushBaskets)
    gSystem->Unlink(ofileName);
 }
 
+TEST(TTreeImplicitMT, TChainFilePrefetching)
+{
+   const int nFiles = 8;
+   std::vector<std::string> fileNames;
+   for (int i = 0; i < nFiles; ++i) {
+      fileNames.emplace_back("chainFilePrefetching_" + std::to_string(i) + ".root");
+      TFile f(fileNames.back().c_str(), "RECREATE");
+      TTree t("t", "t");
+      int x;
+      t.Branch("x", &x);
+      for (x = 0; x < 100 * (i + 1); ++x)
+         t.Fill();
+      t.Write();
+   }
+
+   auto readChain = [&](int nfiles, Long64_t &nentries, Long64_t &sum, int &lastX) {
+      TChain c("t");
+      for (const auto &fileName : fileNames)
+         c.Add(fileName.c_str());
+      c.SetFilePrefetching(nfiles);
+      nentries = c.GetEntries();
+      int x;
+      c.SetBranchAddress("x", &x);
+      sum = 0;
+      for (Long64_t entry = 0; entry < nentries; ++entry) {
+         c.GetEntry(entry);
+         sum += x;
+      }
+      // jump back to the first file, then to the last one
+      c.GetEntry(50);
+      EXPECT_EQ(x, 50);
+      c.GetEntry(nentries - 1);
+      lastX = x;
+   };
+
+   ROOT::EnableImplicitMT(4);
+   Long64_t nentries[2], sum[2];
+   int lastX[2];
+   readChain(0, nentries[0], sum[0], lastX[0]);
+   readChain(3, nentries[1], sum[1], lastX[1]);
+   ROOT::DisableImplicitMT();
+
+   EXPECT_EQ(nentries[0], 100 * nFiles * (nFiles + 1) / 2);
+   EXPECT_EQ(nentries[1], nentries[0]);
+   EXPECT_EQ(sum[1], sum[0]);
+   EXPECT_EQ(lastX[0], 100 * nFiles - 1);
+   EXPECT_EQ(lastX[1], lastX[0]);
+
+   for (const auto &fileName : fileNames)
+      gSystem->Unlink(fileName.c_str());
+}
+
 #endif // R__USE_IMT
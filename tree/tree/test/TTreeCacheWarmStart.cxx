@@ -0,0 +1,112 @@
+#include <TChain.h>
+#include <TFile.h>
+#include <TSystem.h>
+#include <TTree.h>
+#include <TTreeCache.h>
+
+#include "ROOT/TestSupport.hxx"
+#include "gtest/gtest.h"
+
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+void WriteTree(const char *fileName)
+{
+   TFile f(fileName, "RECREATE");
+   TTree t("t", "t");
+   int x, y, z;
+   t.Branch("x", &x);
+   t.Branch("y", &y);
+   t.Branch("z", &z);
+   for (int i = 0; i < 1000; ++i) {
+      x = i;
+      y = 2 * i;
+      z = 3 * i;
+      t.Fill();
+   }
+   t.Write();
+}
+
+} // anonymous namespace
+
+TEST(TTreeCache, SaveAndLoadLearnedBranches)
+{
+   const auto fileName = "ttreecache_saveandloadlearnedbranches.root";
+   const auto branchesFileName = "ttreecache_saveandloadlearnedbranches.txt";
+   WriteTree(fileName);
+
+   {
+      std::unique_ptr<TFile> f(TFile::Open(fileName));
+      auto t = f->Get<TTree>("t");
+      auto bx = t->GetBranch("x");
+      for (Long64_t entry = 0; entry < 500; ++entry) {
+         t->LoadTree(entry);
+         bx->GetEntry(entry);
+      }
+      auto tc = t->GetReadCache(f.get());
+      ASSERT_NE(tc, nullptr);
+      EXPECT_FALSE(tc->IsLearning());
+      EXPECT_EQ(tc->GetCachedBranchNames(), std::vector<std::string>{"x"});
+      EXPECT_TRUE(tc->SaveLearnedBranches(branchesFileName));
+   }
+   {
+      std::ofstream out(branchesFileName, std::ios::app);
+      out << "unknown\n";
+   }
+
+   std::unique_ptr<TFile> f(TFile::Open(fileName));
+   auto t = f->Get<TTree>("t");
+   auto tc = t->GetReadCache(f.get(), kTRUE);
+   ASSERT_NE(tc, nullptr);
+   EXPECT_TRUE(tc->IsLearning());
+   EXPECT_EQ(tc->LoadLearnedBranches(branchesFileName), 1);
+   EXPECT_FALSE(tc->IsLearning());
+   EXPECT_EQ(tc->GetCachedBranches()->GetEntries(), 1);
+   EXPECT_EQ(tc->GetCachedBranchNames(), (std::vector<std::string>{"x", "unknown"}));
+
+   // none of the branches exist: back to learning
+   EXPECT_EQ(tc->WarmStart({"unknown"}), 0);
+   EXPECT_TRUE(tc->IsLearning());
+   EXPECT_TRUE(tc->GetCachedBranchNames().empty());
+
+   f.reset();
+   gSystem->Unlink(fileName);
+   gSystem->Unlink(branchesFileName);
+}
+
+TEST(TTreeCache, ChainKeepsLearnedBranchesAcrossMissingFile)
+{
+   const auto fileName1 = "ttreecache_chainkeepslearnedbranches_1.root";
+   const auto fileName2 = "ttreecache_chainkeepslearnedbranches_2.root";
+   WriteTree(fileName1);
+   WriteTree(fileName2);
+
+   ROOT::TestSupport::CheckDiagsRAII diagRAII;
+   diagRAII.requiredDiag(kSysError, "TFile::TFile", "ttreecache_chainkeepslearnedbranches_missing.root", false);
+
+   TChain c("t");
+   c.Add(fileName1);
+   c.Add("ttreecache_chainkeepslearnedbranches_missing.root");
+   c.Add(fileName2);
+   c.SetBranchStatus("*", false);
+   c.SetBranchStatus("y", true);
+   int y = 0;
+   c.SetBranchAddress("y", &y);
+
+   Long64_t sum = 0;
+   for (Long64_t entry = 0; c.GetEntry(entry) > 0; ++entry)
+      sum += y;
+   EXPECT_EQ(sum, 2 * 999 * 1000);
+
+   auto tc = c.GetReadCache(c.GetCurrentFile());
+   ASSERT_NE(tc, nullptr);
+   EXPECT_FALSE(tc->IsLearning());
+   EXPECT_EQ(tc->GetCachedBranchNames(), std::vector<std::string>{"y"});
+
+   gSystem->Unlink(fileName1);
+   gSystem->Unlink(fileName2);
+}
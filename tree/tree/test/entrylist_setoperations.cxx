@@ -0,0 +1,122 @@
+#include "TEntryList.h"
+#include "TList.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <iterator>
+#include <set>
+#include <vector>
+
+namespace {
+
+std::vector<Long64_t> GetEntriesFromRanges(const TEntryList &elist)
+{
+   std::vector<Long64_t> entries;
+   for (const auto &range : elist.GetEntryRanges()) {
+      EXPECT_LT(range.first, range.second);
+      EXPECT_TRUE(entries.empty() || entries.back() < range.first - 1) << "ranges not merged or not sorted";
+      for (auto entry = range.first; entry < range.second; ++entry)
+         entries.push_back(entry);
+   }
+   return entries;
+}
+
+std::vector<Long64_t> GetEntriesFromNext(TEntryList &elist)
+{
+   std::vector<Long64_t> entries;
+   for (Long64_t i = 0; i < elist.GetN(); ++i)
+      entries.push_back(i == 0 ? elist.GetEntry(0) : elist.Next());
+   return entries;
+}
+
+// Sparse, dense and full blocks, stored as lists of passing entries, bits and lists of non-passing entries
+void FillLists(TEntryList &a, TEntryList &b, std::set<Long64_t> &refA, std::set<Long64_t> &refB)
+{
+   for (Long64_t entry = 0; entry < 300000; entry += 2)
+      refA.insert(entry);
+   for (Long64_t entry = 0; entry < 200000; entry += 3)
+      refB.insert(entry);
+   for (Long64_t entry = 64000; entry < 128000; ++entry)
+      refB.insert(entry);
+   for (Long64_t entry = 250000; entry < 250100; entry += 7)
+      refB.insert(entry);
+   for (auto entry : refA)
+      a.Enter(entry);
+   for (auto entry : refB)
+      b.Enter(entry);
+   a.OptimizeStorage();
+   b.OptimizeStorage();
+}
+
+} // anonymous namespace
+
+TEST(TEntryList, SetOperations)
+{
+   std::set<Long64_t> refA, refB;
+   {
+      TEntryList a("a", "", "t", "f.root"), b("b", "", "t", "f.root");
+      FillLists(a, b, refA, refB);
+      EXPECT_EQ(GetEntriesFromRanges(a), std::vector<Long64_t>(refA.begin(), refA.end()));
+      EXPECT_EQ(GetEntriesFromRanges(b), std::vector<Long64_t>(refB.begin(), refB.end()));
+      EXPECT_EQ(GetEntriesFromNext(b), std::vector<Long64_t>(refB.begin(), refB.end()));
+   }
+
+   std::vector<Long64_t> expected;
+   {
+      TEntryList a("a", "", "t", "f.root"), b("b", "", "t", "f.root");
+      FillLists(a, b, refA, refB);
+      a.Intersect(&b);
+      expected.clear();
+      std::set_intersection(refA.begin(), refA.end(), refB.begin(), refB.end(), std::back_inserter(expected));
+      EXPECT_EQ(a.GetN(), static_cast<Long64_t>(expected.size()));
+      EXPECT_EQ(GetEntriesFromRanges(a), expected);
+      EXPECT_EQ(GetEntriesFromNext(a), expected);
+   }
+   {
+      TEntryList a("a", "", "t", "f.root"), b("b", "", "t", "f.root");
+      FillLists(a, b, refA, refB);
+      a.Subtract(&b);
+      expected.clear();
+      std::set_difference(refA.begin(), refA.end(), refB.begin(), refB.end(), std::back_inserter(expected));
+      EXPECT_EQ(a.GetN(), static_cast<Long64_t>(expected.size()));
+      EXPECT_EQ(GetEntriesFromRanges(a), expected);
+   }
+   {
+      TEntryList a("a", "", "t", "f.root"), b("b", "", "t", "f.root");
+      FillLists(a, b, refA, refB);
+      b.Add(&a);
+      expected.clear();
+      std::set_union(refA.begin(), refA.end(), refB.begin(), refB.end(), std::back_inserter(expected));
+      EXPECT_EQ(b.GetN(), static_cast<Long64_t>(expected.size()));
+      EXPECT_EQ(GetEntriesFromRanges(b), expected);
+      EXPECT_EQ(GetEntriesFromNext(b), expected);
+   }
+}
+
+TEST(TEntryList, IntersectDifferentTrees)
+{
+   TEntryList a("a", "", "t", "f1.root"), b("b", "", "t", "f2.root"), c("c", "", "t", "f2.root");
+   a.EnterRange(0, 100);
+   b.EnterRange(50, 150);
+   c.EnterRange(120, 200);
+
+   // no entry in common between different trees
+   TEntryList single(a);
+   single.Intersect(&b);
+   EXPECT_EQ(single.GetN(), 0);
+
+   // a list for a chain of two trees: only the entries of the second tree are kept
+   TEntryList chain(a);
+   chain.Add(&b);
+   ASSERT_NE(chain.GetLists(), nullptr);
+   EXPECT_EQ(chain.GetN(), 200);
+   chain.Intersect(&c);
+   EXPECT_EQ(chain.GetN(), 30);
+   auto sublist = static_cast<TEntryList *>(chain.GetLists()->At(1));
+   ASSERT_NE(sublist, nullptr);
+   const auto ranges = sublist->GetEntryRanges();
+   ASSERT_EQ(ranges.size(), 1u);
+   EXPECT_EQ(ranges[0].first, 120);
+   EXPECT_EQ(ranges[0].second, 150);
+}
@@ -48,6 +48,7 @@ protected:
    Int_t          fMultiplicity;     ///<  Indicator of the variability of the size of entries
    Int_t          fDimension;        ///<  Dimension of the current expression
    Long64_t       fSelectedRows;     ///<  Number of selected entries
+   Long64_t       fParallelEntries;  ///<! Number of entries of the current loop processed by ProcessParallel()
    Long64_t       fOldEstimate;      ///<  Value of Tree fEstimate when selector is called
    Int_t          fForceRead;        ///<  Force Read flag
    Int_t         *fNbins;            ///<![fDimension] Number of bins per dimension
@@ -77,6 +78,7 @@ public:
    ~TSelectorDraw() override;
 
    void      Begin(TTree *tree) override;
+   virtual Bool_t    CanProcessParallel() const;
    virtual Int_t     GetAction() const {return fAction;}
    virtual Bool_t    GetCleanElist() const {return fCleanElist;}
    virtual Int_t     GetDimension() const {return fDimension;}
@@ -84,6 +86,7 @@ public:
    TObject          *GetObject() const {return fObject;}
    Int_t             GetMultiplicity() const   {return fMultiplicity;}
    virtual Int_t     GetNfill() const {return fNfill;}
+   virtual Long64_t  GetParallelEntries() const {return fParallelEntries;}
    TH1              *GetOldHistogram() const {return fOldHistogram;}
    TTreeFormula     *GetSelect() const    {return fSelect;}
    virtual Long64_t  GetSelectedRows() const {return fSelectedRows;}
@@ -112,6 +115,7 @@ public:
    void      ProcessFill(Long64_t entry) override;
    virtual void      ProcessFillMultiple(Long64_t entry);
    virtual void      ProcessFillObject(Long64_t entry);
+   virtual Bool_t    ProcessParallel(Long64_t firstentry, Long64_t lastentry);
    virtual void      SetEstimate(Long64_t n);
    virtual UInt_t    SplitNames(const TString &varexp, std::vector<TString> &names);
    virtual void      TakeAction();
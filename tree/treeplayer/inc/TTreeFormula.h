@@ -131,6 +131,21 @@ protected:
 
    RealInstanceCache fRealInstanceCache;              ///<! Cache accelerating the GetRealInstance function
 
+   // Signature of the functions compiled from the formula, see JitCompile()
+   using JitFunction_t = Double_t (*)(const void *const *values, const Int_t *realInstances, const Int_t *ndata,
+                                      TObject *const *subFormulas, const Long64_t *entries, Int_t instance,
+                                      Int_t length);
+   enum EJitStatus { kJitNotTried, kJitUnavailable, kJitCompiled };
+
+   EJitStatus                fJitStatus = kJitNotTried;  ///<! Whether the formula was compiled with cling
+   JitFunction_t             fJitFunction = nullptr;     ///<! The compiled formula, if fJitStatus is kJitCompiled
+   std::vector<Int_t>        fJitCodes;                  ///<! The codes of the leaves read by the compiled formula
+   std::vector<const void *> fJitValues;                 ///<! The value pointers of the leaves, per code
+   std::vector<Int_t>        fJitRealInstances;          ///<! The instances of the leaves to read, per code
+   std::vector<Int_t>        fJitSubFormulas;            ///<! The operations evaluating an alias or an alternate
+   Bool_t                    fJitNeedEntries = kFALSE;   ///<! True if the compiled formula uses Entry$ and similar
+   Long64_t                  fJitEntries[4];             ///<! Entry$, LocalEntry$, Entries$ and LocalEntries$
+
    TTreeFormula(const char *name, const char *formula, TTree *tree, const std::vector<std::string>& aliases);
    void Init(const char *name, const char *formula);
    Bool_t      BranchHasMethod(TLeaf* leaf, TBranch* branch, const char* method,const char* params, Long64_t readentry) const;
@@ -154,6 +169,8 @@ protected:
    void              ResetDimensions();
 
    virtual TClass*   EvalClass(Int_t oper) const;
+   Double_t          EvalJitInstance(Int_t instance);
+   Bool_t            JitCompile();
    virtual Bool_t    IsLeafInteger(Int_t code) const;
    Bool_t    IsString(Int_t oper) const override;
    virtual Bool_t    IsLeafString(Int_t code) const;
@@ -210,6 +227,9 @@ public:
    virtual TTree*      GetTree() const {return fTree;}
    virtual void        UpdateFormulaLeaves();
 
+   static  void        SetJitCompilation(Bool_t enable = kTRUE);
+   static  Bool_t      IsJitCompilationEnabled();
+
    ClassDefOverride(TTreeFormula, 10);  //The Tree formula
 };
 
@@ -24,6 +24,7 @@
 
 #include "TVirtualIndex.h"
 
+class TChain;
 class TTreeFormula;
 
 class TTreeIndex : public TVirtualIndex {
@@ -35,6 +36,21 @@ protected:
    Long64_t      *fIndexValues;         ///<[fN] Sorted index values, higher 64bits
    Long64_t      *fIndexValuesMinor;    ///<[fN] Sorted index values, lower 64bits
    Long64_t      *fIndex;               ///<[fN] Index of sorted values
+   Long64_t       fHashSize;            ///< Number of slots of the hash table, 0 if there is no hash index
+   Long64_t      *fHashTable;           ///<[fHashSize] Positions in the sorted values, -1 for empty slots
+   Bool_t         fHashIndexPending;    ///<! The hash index is rebuilt by the sort delayed by Append
+   Long64_t       fNFriendRuns;         ///< Number of runs of the friend entry map, 0 if there is no map
+   Long64_t       fFriendMapEntries;    ///< Number of entries of the parent tree covered by the friend entry map
+   TString        fFriendParentName;    ///< Name of the parent tree the friend entry map was built for
+   Long64_t       fFriendParentEntries; ///< Number of entries of the parent tree the friend entry map was built for
+   TString        fFriendParentId;      ///< Identity of the data of the parent tree, see GetFriendParentId
+   Long64_t      *fFriendRunStarts;     ///<[fNFriendRuns] First entry in the parent tree of each run
+   Long64_t      *fFriendRunEntries;    ///<[fNFriendRuns] Entry in this tree of the first entry of each run, or -1
+   Long64_t       fLastFriendRun;       ///<! Run found by the last lookup in the friend entry map
+   Bool_t         fFriendParentHasUUID; ///<! Whether fFriendParentId is the UUID of the directory of a tree
+   UChar_t        fFriendParentUUID[16]; ///<! fFriendParentId decoded, if it is a UUID
+   const TChain  *fFriendParentChecked; ///<! Last parent chain compared with the one of the friend entry map
+   Bool_t         fFriendParentMatches; ///<! Whether fFriendParentChecked is the parent of the friend entry map
    TTreeFormula  *fMajorFormula;        ///<! Pointer to major TreeFormula
    TTreeFormula  *fMinorFormula;        ///<! Pointer to minor TreeFormula
    TTreeFormula  *fMajorFormulaParent;  ///<! Pointer to major TreeFormula in Parent tree (if any)
@@ -42,6 +58,11 @@ protected:
 
    TTreeFormula  *GetMajorFormulaParent(const TTree *parent);
    TTreeFormula  *GetMinorFormulaParent(const TTree *parent);
+   Long64_t       FindValuesInHash(Long64_t major, Long64_t minor) const;
+   Long64_t       FindInFriendEntryMap(Long64_t parentEntry);
+   Bool_t         IsFriendEntryMapValidFor(const TTree *parent);
+   void           DecodeFriendParentId();
+   static TString GetFriendParentId(const TTree *parent);
 
 private:
    TTreeIndex(const TTreeIndex&) = delete;            // Not implemented.
@@ -52,6 +73,13 @@ public:
    TTreeIndex(const TTree *T, const char *majorname, const char *minorname);
                  ~TTreeIndex() override;
    void           Append(const TVirtualIndex *,Bool_t delaySort = kFALSE) override;
+   Bool_t                 BuildHashIndex();
+   void                   DropHashIndex();
+   Bool_t                 HasHashIndex()    const {return fHashTable != 0;}
+   Long64_t               BuildFriendEntryMap(TTree *parent);
+   void                   DropFriendEntryMap();
+   Bool_t                 HasFriendEntryMap() const {return fFriendRunStarts != 0;}
+   Long64_t               GetNFriendRuns()  const {return fNFriendRuns;}
    bool                   ConvertOldToNew();
    Long64_t               FindValues(Long64_t major, Long64_t minor) const;
    Long64_t       GetEntryNumberFriend(const TTree *parent) override;
@@ -70,7 +98,7 @@ public:
    void           UpdateFormulaLeaves(const TTree *parent) override;
    void           SetTree(TTree *T) override;
 
-   ClassDefOverride(TTreeIndex,2);  //A Tree Index with majorname and minorname.
+   ClassDefOverride(TTreeIndex,4);  //A Tree Index with majorname and minorname.
 };
 
 #endif
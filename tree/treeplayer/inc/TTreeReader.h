@@ -30,6 +30,7 @@
 #include <iterator>
 #include <unordered_map>
 #include <string>
+#include <vector>
 
 class TDictionary;
 class TDirectory;
@@ -218,6 +219,8 @@ public:
    /// Restart a Next() loop from entry 0 (of TEntryList index 0 of fEntryList is set).
    void Restart();
 
+   void SetLazyBranches(const std::vector<std::string> &branchNames);
+
    ///\}
 
    EEntryStatus GetEntryStatus() const { return fEntryStatus; }
@@ -271,6 +274,8 @@ protected:
    EEntryStatus SetEntryBase(Long64_t entry, Bool_t local);
 
    Bool_t SetProxies();
+   void SetCacheEntryListRange();
+   void SetCacheSelectedEntries();
 
 private:
 
@@ -306,6 +311,7 @@ private:
    Long64_t fBeginEntry = 0LL; ///< This allows us to propagate the range to the TTreeCache
    Bool_t fProxiesSet = kFALSE; ///< True if the proxies have been set, false otherwise
    Bool_t fSetEntryBaseCallingLoadTree = kFALSE; ///< True if during the LoadTree execution triggered by SetEntryBase.
+   std::vector<std::string> fLazyBranches; ///< Branches only decompressed when read, see SetLazyBranches()
 
    friend class ROOT::Internal::TTreeReaderValueBase;
    friend class ROOT::Internal::TTreeReaderArrayBase;
@@ -35,12 +35,37 @@ A specialized TSelector for TTree::Draw.
 #include "TStyle.h"
 #include "TClass.h"
 #include "TColor.h"
+#include "TChain.h"
+#include "TFile.h"
 #include "strlcpy.h"
 
+#ifdef R__USE_IMT
+#include "ROOT/TTreeProcessorMT.hxx"
+#include "TTreeReader.h"
+#endif
+
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+
 ClassImp(TSelectorDraw);
 
 const Int_t kCustomHistogram = BIT(17);
 
+namespace {
+
+/// Whether the action fills a 1-D to 3-D histogram or profile, once the limits of the histogram are known
+bool IsHistogramAction(Int_t action)
+{
+   action = std::abs(action);
+   return action == 1 || action == 2 || action == 3 || action == 4 || action == 23;
+}
+
+} // anonymous namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Default selector constructor.
 
@@ -63,6 +88,7 @@ TSelectorDraw::TSelectorDraw()
    fMultiplicity   = 0;
    fSelect         = 0;
    fSelectedRows   = 0;
+   fParallelEntries = 0;
    fDraw           = 0;
    fObject         = 0;
    fOldHistogram   = 0;
@@ -108,6 +134,7 @@ void TSelectorDraw::Begin(TTree *tree)
    ResetAbort();
    ResetBit(kCustomHistogram);
    fSelectedRows   = 0;
+   fParallelEntries = 0;
    fTree = tree;
    fDimension = 0;
    fAction = 0;
@@ -935,6 +962,33 @@ void TSelectorDraw::Begin(TTree *tree)
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return kTRUE if the rest of the entries can be processed in parallel by ProcessParallel().
+/// This requires implicit multi-threading, a 1-D to 3-D histogram or profile to fill, no entry
+/// list, no object or string expression, no periodic update of the pad (see TTree::SetUpdate)
+/// and a tree whose entries can be read again from its files, i.e. a chain or a tree in a file
+/// opened for reading.
+
+Bool_t TSelectorDraw::CanProcessParallel() const
+{
+#ifdef R__USE_IMT
+   if (!ROOT::IsImplicitMTEnabled() || !fTree || !fObject || !IsHistogramAction(fAction))
+      return kFALSE;
+   if (fObjEval || fTreeElistArray || fTree->GetEntryList() || fTree->GetEventList() || fTree->GetUpdate())
+      return kFALSE;
+   for (Int_t i = 0; i < fDimension; ++i) {
+      if (!fVar[i] || fVar[i]->IsString())
+         return kFALSE;
+   }
+   if (fTree->InheritsFrom(TChain::Class()))
+      return kTRUE;
+   TFile *file = fTree->GetCurrentFile();
+   return file && !file->IsWritable();
+#else
+   return kFALSE;
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Delete internal buffers.
 
@@ -1345,6 +1399,186 @@ void TSelectorDraw::ProcessFillObject(Long64_t /*entry*/)
 
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Fill the histogram with the entries in [firstentry, lastentry) in parallel, over the clusters
+/// of the tree, see ROOT::TTreeProcessorMT. Each task compiles the expressions on its own copy of
+/// the tree and fills a clone of the histogram. The clones are shared by the tasks through a pool,
+/// so that there are no more clones than concurrent tasks, and are merged into the histogram at
+/// the end with TH1::Merge, which also takes care of the axes extended by the clones and of the
+/// limits computed from the buffers of the clones of an automatically binned histogram.
+///
+/// It must be called once the limits of the histogram are known, i.e. when GetAction() is positive.
+/// The values of the entries are not stored in the buffers returned by GetVal(). Return kFALSE,
+/// leaving the histogram untouched, if the entries could not be processed. The number of entries
+/// processed in parallel in the current loop is returned by GetParallelEntries().
+
+Bool_t TSelectorDraw::ProcessParallel(Long64_t firstentry, Long64_t lastentry)
+{
+#ifdef R__USE_IMT
+   TH1 *hist = static_cast<TH1 *>(fObject);
+   // the values of a buffer can not be taken apart from the clones
+   if (fAction <= 0 || !CanProcessParallel() || hist->GetBufferLength() > 0)
+      return kFALSE;
+   if (firstentry >= lastentry)
+      return kTRUE;
+
+   const Int_t action = fAction;
+   const Int_t dimension = fDimension;
+   const Bool_t fill3D = action != 3 || !hist->TestBit(kCanDelete);
+   // the weight of the trees of a chain, unless the chain has a global weight
+   const Bool_t treeWeights = fTree->InheritsFrom(TChain::Class()) && !fTree->TestBit(TChain::kGlobalWeight);
+   std::vector<std::string> varexps;
+   for (Int_t i = 0; i < dimension; ++i)
+      varexps.emplace_back(fVar[i]->GetTitle());
+   const std::string selection = fSelect ? fSelect->GetTitle() : "";
+   TList *aliases = fTree->GetListOfAliases();
+
+   std::mutex mutex; // protects the compilation of the formulas and the pool of histograms
+   std::vector<std::unique_ptr<TH1>> clones;
+   std::vector<TH1 *> freeClones;
+   std::atomic<Long64_t> selectedRows{0};
+
+   auto processRange = [&](TTreeReader &reader) {
+      TTree *tree = reader.GetTree();
+      std::vector<std::unique_ptr<TTreeFormula>> vars(dimension);
+      std::unique_ptr<TTreeFormula> select;
+      TTreeFormulaManager *manager = new TTreeFormulaManager(); // deleted with the last formula
+      TH1 *h = nullptr;
+      {
+         std::lock_guard<std::mutex> lock(mutex);
+         if (aliases) {
+            for (TObject *alias : *aliases)
+               tree->SetAlias(alias->GetName(), alias->GetTitle());
+         }
+         if (!selection.empty()) {
+            select.reset(new TTreeFormula("Selection", selection.c_str(), tree));
+            select->SetQuickLoad(kTRUE);
+            manager->Add(select.get());
+         }
+         for (Int_t i = 0; i < dimension; ++i) {
+            vars[i].reset(new TTreeFormula(TString::Format("Var%i", i + 1), varexps[i].c_str(), tree));
+            vars[i]->SetQuickLoad(kTRUE);
+            manager->Add(vars[i].get());
+         }
+         manager->Sync();
+         if ((select && !select->GetNdim()) || !vars[0]->GetNdim())
+            throw std::runtime_error("cannot compile the expressions on the tree of a task");
+         if (freeClones.empty()) {
+            clones.emplace_back(static_cast<TH1 *>(hist->Clone()));
+            clones.back()->SetDirectory(nullptr);
+            clones.back()->Reset();
+            freeClones.push_back(clones.back().get());
+         }
+         h = freeClones.back();
+         freeClones.pop_back();
+      }
+
+      Long64_t rows = 0;
+      Double_t v[4] = {0., 0., 0., 0.};
+      auto fill = [&](Double_t w) {
+         ++rows;
+         switch (action) {
+         case 1: h->Fill(v[0], w); break;
+         case 2: static_cast<TH2 *>(h)->Fill(v[1], v[0], w); break;
+         case 3:
+            if (fill3D)
+               static_cast<TH3 *>(h)->Fill(v[2], v[1], v[0], w);
+            break;
+         case 4: static_cast<TProfile *>(h)->Fill(v[1], v[0], w); break;
+         case 23: static_cast<TProfile2D *>(h)->Fill(v[2], v[1], v[0], w); break;
+         }
+      };
+
+      Int_t treeNumber = -1;
+      Double_t weight = fWeight;
+      Double_t first[4] = {0., 0., 0., 0.};
+      while (reader.Next()) {
+         if (tree->GetTreeNumber() != treeNumber) {
+            treeNumber = tree->GetTreeNumber();
+            for (auto &var : vars)
+               var->UpdateFormulaLeaves();
+            if (select)
+               select->UpdateFormulaLeaves();
+            if (treeWeights)
+               weight = tree->GetWeight();
+         }
+
+         // Same as ProcessFill and ProcessFillMultiple
+         if (!fMultiplicity) {
+            if (fForceRead && manager->GetNdata() <= 0)
+               continue;
+            const Double_t w = select ? weight * select->EvalInstance(0) : weight;
+            if (!w)
+               continue;
+            for (Int_t i = 0; i < dimension; ++i)
+               v[i] = vars[i]->EvalInstance(0);
+            fill(w);
+            continue;
+         }
+
+         const Int_t ndata = manager->GetNdata();
+         if (!ndata)
+            continue;
+         const Double_t w0 = select ? weight * select->EvalInstance(0) : weight;
+         if (!w0 && !fSelectMultiple)
+            continue;
+         Bool_t hasFirst = w0 != 0;
+         if (hasFirst) {
+            for (Int_t i = 0; i < dimension; ++i)
+               v[i] = first[i] = vars[i]->EvalInstance(0);
+            fill(w0);
+         } else {
+            for (auto &var : vars)
+               var->ResetLoading();
+         }
+         for (Int_t j = 1; j < ndata; ++j) {
+            Double_t w = w0;
+            if (fSelectMultiple) {
+               w = weight * select->EvalInstance(j);
+               if (!w)
+                  continue;
+               if (!hasFirst) {
+                  for (Int_t i = 0; i < dimension; ++i) {
+                     if (!fVarMultiple[i])
+                        first[i] = vars[i]->EvalInstance(0);
+                  }
+                  hasFirst = kTRUE;
+               }
+            }
+            for (Int_t i = 0; i < dimension; ++i)
+               v[i] = fVarMultiple[i] ? vars[i]->EvalInstance(j) : first[i];
+            fill(w);
+         }
+      }
+
+      selectedRows += rows;
+      std::lock_guard<std::mutex> lock(mutex);
+      freeClones.push_back(h);
+   };
+
+   try {
+      ROOT::TTreeProcessorMT processor(*fTree, 0u, {firstentry, lastentry});
+      processor.Process(processRange);
+   } catch (const std::exception &e) {
+      Warning("ProcessParallel", "%s: processing the entries sequentially", e.what());
+      return kFALSE;
+   }
+
+   TList list;
+   for (auto &clone : clones)
+      list.Add(clone.get());
+   if (!list.IsEmpty())
+      hist->Merge(&list);
+   fSelectedRows += selectedRows;
+   fParallelEntries += lastentry - firstentry;
+   return kTRUE;
+#else
+   (void)firstentry;
+   (void)lastentry;
+   return kFALSE;
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Set number of entries to estimate variable limits.
 
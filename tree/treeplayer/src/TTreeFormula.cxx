@@ -44,6 +44,7 @@
 #include "strlcpy.h"
 #include "snprintf.h"
 #include "TEntryList.h"
+#include "TEnv.h"
 
 #include <cctype>
 #include <cstdio>
@@ -51,6 +52,11 @@
 #include <cstdlib>
 #include <typeinfo>
 #include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
 
 const Int_t kMaxLen     = 1024;
 
@@ -90,6 +96,10 @@ The following method are available from the TFormLeafInfo interface:
  -  IsString()
  -  ReadValue(char *where, Int_t instance = 0) : Internal function to interpret the location 'where'
  -  Update() : react to the possible loading of a shared library.
+
+The formulas can be compiled with cling instead of being interpreted, which
+speeds up TTree::Draw and TTree::Scan for expressions with several operations.
+See TTreeFormula::SetJitCompilation.
 */
 
 ClassImp(TTreeFormula);
@@ -4006,6 +4016,13 @@ T TTreeFormula::EvalInstance(Int_t instance, const char *stringStackArg[])
       }
    }
 
+   if (std::is_same<T, Double_t>::value && fJitStatus != kJitUnavailable && IsJitCompilationEnabled()) {
+      if (fJitStatus == kJitNotTried)
+         JitCompile();
+      if (fJitStatus == kJitCompiled)
+         return EvalJitInstance(instance);
+   }
+
    T tab[kMAXFOUND];
    const Int_t kMAXSTRINGFOUND = 10;
    const char *stringStackLocal[kMAXSTRINGFOUND];
@@ -4412,6 +4429,377 @@ template double TTreeFormula::EvalInstance<double> (int, char const**);
 template long double TTreeFormula::EvalInstance<long double> (int, char const**);
 template long long TTreeFormula::EvalInstance<long long> (int, char const**);
 
+namespace {
+
+/// -1 until the default is read from the configuration
+std::atomic<int> gJitCompilation{-1};
+
+/// The C++ type of the values of a leaf that the compiled formulas can read directly
+const char *GetJitLeafType(TLeaf *leaf)
+{
+   // the values of the leaves of other branch types are not stored contiguously in the leaf
+   if (!leaf || leaf->GetBranch()->IsA() != TBranch::Class() || leaf->InheritsFrom(TLeafC::Class()))
+      return nullptr;
+   static const char *types[] = {"Char_t",   "UChar_t",   "Short_t", "UShort_t", "Int_t",  "UInt_t",
+                                 "Long64_t", "ULong64_t", "Float_t", "Double_t", "Bool_t"};
+   const char *typeName = leaf->GetTypeName();
+   for (const char *type : types) {
+      if (!strcmp(typeName, type))
+         return type;
+   }
+   return nullptr;
+}
+
+/// Declare the body of a compiled formula to cling, or find the function that was compiled for an identical body,
+/// e.g. by a previous TTree::Draw with the same expression. Return nullptr if the compilation failed.
+void *GetJitFunction(const std::string &body)
+{
+   static std::mutex mutex;
+   static std::unordered_map<std::string, void *> functions;
+   static bool headersDeclared = false;
+
+   std::lock_guard<std::mutex> lock(mutex);
+   auto it = functions.find(body);
+   if (it != functions.end())
+      return it->second;
+
+   if (!headersDeclared) {
+      headersDeclared = gInterpreter->Declare("#include \"TTreeFormula.h\"\n#include \"TMath.h\"\n"
+                                              "#include \"TRandom.h\"\n#include <algorithm>\n#include <cmath>\n");
+   }
+   const std::string name = "TTreeFormulaJit" + std::to_string(functions.size());
+   const std::string code = "#pragma cling optimize(2)\n"
+                            "namespace ROOT { namespace Internal { namespace TreeFormulaJit {\n"
+                            "Double_t " + name + body + "\n}}}\n";
+   void *function = nullptr;
+   if (headersDeclared && gInterpreter->Declare(code.c_str())) {
+      TInterpreter::EErrorCode error = TInterpreter::kNoError;
+      const std::string address = "(Longptr_t)&ROOT::Internal::TreeFormulaJit::" + name + ";";
+      const Longptr_t result = gInterpreter->Calc(address.c_str(), &error);
+      if (error == TInterpreter::kNoError)
+         function = reinterpret_cast<void *>(result);
+   }
+   functions[body] = function;
+   return function;
+}
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Enable or disable the compilation of the formulas with cling.
+///
+/// When enabled, the sequence of operations of a formula is translated into a
+/// C++ function the first time the formula is evaluated, and compiled once
+/// (formulas with the same operations on leaves of the same types, e.g. in
+/// successive calls to TTree::Draw with the same expression, share the same
+/// function). The compiled function is then used by EvalInstance() instead of
+/// interpreting the operations one by one, for every entry and every instance.
+///
+/// The instances of arrays, Alt$, Length$, Sum$, Min$, Max$, aliases and the
+/// short-circuiting of && and || behave exactly as in the interpreter: the
+/// dimensions are still computed by TTreeFormulaManager, and the sub-formulas
+/// of aliases and of the special functions are evaluated by their own
+/// TTreeFormula. Only the evaluations in double precision are compiled, the
+/// formulas using strings, data members or methods of objects, TCutG, entry
+/// lists or functions declared to the interpreter are always interpreted.
+///
+/// The default is taken from the rootrc entry `TreeFormula.JitCompilation`.
+
+void TTreeFormula::SetJitCompilation(Bool_t enable)
+{
+   gJitCompilation = enable ? 1 : 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return whether the formulas are compiled with cling, see SetJitCompilation().
+
+Bool_t TTreeFormula::IsJitCompilationEnabled()
+{
+   int enabled = gJitCompilation.load(std::memory_order_relaxed);
+   if (enabled < 0) {
+      enabled = gEnv->GetValue("TreeFormula.JitCompilation", 0) ? 1 : 0;
+      gJitCompilation = enabled;
+   }
+   return enabled;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Translate the operations of the formula into a C++ function and compile it
+/// with cling. Return false (and keep using the interpreter) if the formula uses
+/// a feature that the compiled functions do not support.
+///
+/// The generated function follows the interpreter operation by operation: the
+/// positions in the stack of values are resolved at code generation time, the
+/// jumps of the ternary operator and of the boolean optimization become gotos,
+/// and the leaves are read from their value pointers at the instances computed
+/// by GetRealInstance.
+
+Bool_t TTreeFormula::JitCompile()
+{
+   fJitStatus = kJitUnavailable;
+   fJitFunction = nullptr;
+   fJitCodes.clear();
+   fJitSubFormulas.clear();
+   fJitNeedEntries = kFALSE;
+   if (fNoper <= 1 || fAxis || IsString() || (fManager && fManager->fMultiVarDim) || !gInterpreter)
+      return kFALSE;
+
+   // the position in the stack before each operation, -1 until known
+   std::vector<Int_t> stackPos(fNoper + 1, -1);
+   std::vector<Bool_t> isTarget(fNoper + 1, kFALSE);
+   std::vector<Bool_t> isLeafCode(kMAXCODES, kFALSE);
+   auto addTarget = [&](Int_t target, Int_t pos) {
+      if (target < 0 || target > fNoper)
+         return kFALSE;
+      if (stackPos[target] >= 0 && stackPos[target] != pos)
+         return kFALSE;
+      stackPos[target] = pos;
+      isTarget[target] = kTRUE;
+      return kTRUE;
+   };
+   // C++ code for a call of a single argument function of the interpreter, with the same handling of the values
+   /// outside of its domain
+   auto unaryFunction = [](Int_t action, const std::string &x) -> std::string {
+      switch (action) {
+      case kcos: return "TMath::Cos(" + x + ")";
+      case ksin: return "TMath::Sin(" + x + ")";
+      case ktan: return "(TMath::Cos(" + x + ") == 0 ? 0. : TMath::Tan(" + x + "))";
+      case kacos: return "(TMath::Abs(" + x + ") > 1 ? 0. : TMath::ACos(" + x + "))";
+      case kasin: return "(TMath::Abs(" + x + ") > 1 ? 0. : TMath::ASin(" + x + "))";
+      case katan: return "TMath::ATan(" + x + ")";
+      case kcosh: return "TMath::CosH(" + x + ")";
+      case ksinh: return "TMath::SinH(" + x + ")";
+      case ktanh: return "(TMath::CosH(" + x + ") == 0 ? 0. : TMath::TanH(" + x + "))";
+      case kacosh: return "(" + x + " < 1 ? 0. : TMath::ACosH(" + x + "))";
+      case kasinh: return "TMath::ASinH(" + x + ")";
+      case katanh: return "(TMath::Abs(" + x + ") > 1 ? 0. : TMath::ATanH(" + x + "))";
+      case ksq: return "(" + x + " * " + x + ")";
+      case ksqrt: return "TMath::Sqrt(TMath::Abs(" + x + "))";
+      case klog: return "(" + x + " > 0 ? TMath::Log(" + x + ") : 0.)";
+      case kexp:
+         return "(" + x + " < -700 ? 0. : " + x + " > 700 ? TMath::Exp(700) : TMath::Exp(" + x + "))";
+      case klog10: return "(" + x + " > 0 ? TMath::Log10(" + x + ") : 0.)";
+      case kabs: return "TMath::Abs(" + x + ")";
+      case ksign: return "(" + x + " < 0 ? -1. : 1.)";
+      case kint: return "Double_t(Long64_t(" + x + "))";
+      case kSignInv: return "(-1 * " + x + ")";
+      case kNot: return "(" + x + " != 0 ? 0. : 1.)";
+      default: return "";
+      }
+   };
+
+   // C++ code for a binary operation of the interpreter
+   auto binaryOperation = [](Int_t action, const std::string &x, const std::string &y) -> std::string {
+      switch (action) {
+      case kAdd: return x + " + " + y;
+      case kSubstract: return x + " - " + y;
+      case kMultiply: return x + " * " + y;
+      case kDivide: return "(" + y + " == 0 ? 0. : " + x + " / " + y + ")";
+      case kModulo: return "Double_t(Long64_t(" + x + ") % Long64_t(" + y + "))";
+      case katan2: return "TMath::ATan2(" + x + ", " + y + ")";
+      case kfmod: return "fmod(" + x + ", " + y + ")";
+      case kpow: return "TMath::Power(" + x + ", " + y + ")";
+      case kmin: return "std::min(" + x + ", " + y + ")";
+      case kmax: return "std::max(" + x + ", " + y + ")";
+      case kAnd: return "(" + x + " != 0 && " + y + " != 0 ? 1. : 0.)";
+      case kOr: return "(" + x + " != 0 || " + y + " != 0 ? 1. : 0.)";
+      case kEqual: return "(" + x + " == " + y + " ? 1. : 0.)";
+      case kNotEqual: return "(" + x + " != " + y + " ? 1. : 0.)";
+      case kLess: return "(" + x + " < " + y + " ? 1. : 0.)";
+      case kGreater: return "(" + x + " > " + y + " ? 1. : 0.)";
+      case kLessThan: return "(" + x + " <= " + y + " ? 1. : 0.)";
+      case kGreaterThan: return "(" + x + " >= " + y + " ? 1. : 0.)";
+      case kBitAnd: return "Double_t(ULong64_t(" + x + ") & ULong64_t(" + y + "))";
+      case kBitOr: return "Double_t(ULong64_t(" + x + ") | ULong64_t(" + y + "))";
+      case kLeftShift: return "Double_t(ULong64_t(" + x + ") << ULong64_t(" + y + "))";
+      case kRightShift: return "Double_t(ULong64_t(" + x + ") >> ULong64_t(" + y + "))";
+      default: return "";
+      }
+   };
+
+   auto t = [](Int_t pos) { return "t[" + std::to_string(pos) + "]"; };
+   auto sub = [](Int_t op) { return "static_cast<TTreeFormula *>(s[" + std::to_string(op) + "])"; };
+
+   std::string statements;
+   Int_t pos = 0;
+   Int_t maxPos = 1;
+   Bool_t reachable = kTRUE; // false after an unconditional jump
+   for (Int_t i = 0; i < fNoper; ++i) {
+      if (isTarget[i])
+         statements += "L" + std::to_string(i) + ":\n";
+      if (!reachable) {
+         if (stackPos[i] < 0)
+            return kFALSE;
+         pos = stackPos[i];
+         reachable = kTRUE;
+      } else if (stackPos[i] >= 0 && stackPos[i] != pos) {
+         return kFALSE;
+      }
+      stackPos[i] = pos;
+
+      const Int_t oper = GetOper()[i];
+      const Int_t action = oper >> kTFOperShift;
+      const Int_t param = oper & kTFOperMask;
+      std::string statement;
+
+      if (action == kConstant) {
+         char value[64];
+         snprintf(value, sizeof(value), "%.17g", GetConstant<Double_t>(param));
+         statement = t(pos++) + " = " + value + ";";
+      } else if (action == kEnd) {
+         statement = "return t[0];";
+         reachable = kFALSE;
+      } else if (!unaryFunction(action, "").empty()) {
+         if (pos < 1)
+            return kFALSE;
+         statement = t(pos - 1) + " = " + unaryFunction(action, t(pos - 1)) + ";";
+      } else if (!binaryOperation(action, "", "").empty()) {
+         if (pos < 2)
+            return kFALSE;
+         statement = t(pos - 2) + " = " + binaryOperation(action, t(pos - 2), t(pos - 1)) + ";";
+         --pos;
+      } else if (action == kpi) {
+         statement = t(pos++) + " = TMath::ACos(-1);";
+      } else if (action == krndm) {
+         statement = t(pos++) + " = gRandom->Rndm();";
+      } else if (action == kJump) {
+         if (!addTarget(param + 1, pos))
+            return kFALSE;
+         statement = "goto L" + std::to_string(param + 1) + ";";
+         reachable = kFALSE;
+      } else if (action == kJumpIf) {
+         --pos;
+         if (pos < 0 || !addTarget(param + 1, pos))
+            return kFALSE;
+         statement = "if (!" + t(pos) + ") goto L" + std::to_string(param + 1) + ";";
+      } else if (action == kBoolOptimize) {
+         const Int_t target = i + param / 10 + 1;
+         const Int_t op = param % 10; // 1 is && , 2 is ||
+         if (pos < 1 || (op != 1 && op != 2) || !addTarget(target, pos))
+            return kFALSE;
+         const std::string jump = "goto L" + std::to_string(target) + "; }";
+         statement = op == 1 ? "if (!" + t(pos - 1) + ") { " + t(pos - 1) + " = 0; " + jump
+                             : "if (" + t(pos - 1) + ") { " + t(pos - 1) + " = 1; " + jump;
+      } else if (action == kAlias) {
+         fJitSubFormulas.push_back(i);
+         statement = t(pos++) + " = " + sub(i) + "->EvalInstance(instance);";
+      } else if (action == kAlternate) {
+         // the next operation computes the alternate value if the primary is out of range
+         fJitSubFormulas.push_back(i);
+         if (!addTarget(i + 2, pos + 1))
+            return kFALSE;
+         statement = "if (instance < " + sub(i) + "->GetNdata()) { " + t(pos) + " = " + sub(i) +
+                     "->EvalInstance(instance); goto L" + std::to_string(i + 2) + "; }";
+      } else if (action == kDefinedVariable) {
+         const Int_t lookupType = fLookupType[param];
+         const std::string n = std::to_string(param);
+         switch (lookupType) {
+         case kIndexOfEntry: statement = t(pos++) + " = e[0];"; fJitNeedEntries = kTRUE; break;
+         case kIndexOfLocalEntry: statement = t(pos++) + " = e[1];"; fJitNeedEntries = kTRUE; break;
+         case kEntries: statement = t(pos++) + " = e[2];"; fJitNeedEntries = kTRUE; break;
+         case kLocalEntries: statement = t(pos++) + " = e[3];"; fJitNeedEntries = kTRUE; break;
+         case kLength: statement = t(pos++) + " = length;"; break;
+         case kLengthFunc: statement = t(pos++) + " = " + sub(i) + "->GetNdata();"; break;
+         case kIteration: statement = t(pos++) + " = instance;"; break;
+         case kSum:
+            statement = "{ TTreeFormula *f = " + sub(i) + "; const Int_t len = f->GetNdata(); " + t(pos) +
+                        " = 0; for (Int_t j = 0; j < len; ++j) " + t(pos) + " += f->EvalInstance(j); }";
+            ++pos;
+            break;
+         case kMin:
+         case kMax:
+            statement = "{ TTreeFormula *f = " + sub(i) + "; const Int_t len = f->GetNdata(); " + t(pos) +
+                        " = len ? f->EvalInstance(0) : 0; for (Int_t j = 1; j < len; ++j) { const Double_t val = "
+                        "f->EvalInstance(j); if (val " + (lookupType == kMin ? "<" : ">") + " " + t(pos) + ") " +
+                        t(pos) + " = val; } }";
+            ++pos;
+            break;
+         case kDirect: {
+            if (fCodes[param] < 0)
+               return kFALSE; // a TCutG
+            const char *type = GetJitLeafType(static_cast<TLeaf *>(fLeaves.UncheckedAt(param)));
+            if (!type)
+               return kFALSE;
+            isLeafCode[param] = kTRUE;
+            statement = "if (ri[" + n + "] >= nd[" + n + "]) return 0; " + t(pos++) + " = static_cast<const " + type +
+                        " *>(v[" + n + "])[ri[" + n + "]];";
+            break;
+         }
+         default: return kFALSE;
+         }
+         if (lookupType == kLengthFunc || lookupType == kSum || lookupType == kMin || lookupType == kMax)
+            fJitSubFormulas.push_back(i);
+      } else {
+         // strings, function calls and Min/MaxIf$
+         return kFALSE;
+      }
+      statements += "   " + statement + "\n";
+      maxPos = std::max(maxPos, pos);
+   }
+   if (isTarget[fNoper])
+      statements += "L" + std::to_string(fNoper) + ":\n";
+   statements += "   return t[0];\n}\n";
+
+   // the leaf types are part of the generated code, the leaf codes are arguments
+   const std::string body = "(const void *const *v, const Int_t *ri, const Int_t *nd, TObject *const *s, "
+                            "const Long64_t *e, Int_t instance, Int_t length)\n{\n   Double_t t[" +
+                            std::to_string(maxPos) + "];\n" + statements;
+   fJitFunction = reinterpret_cast<JitFunction_t>(GetJitFunction(body));
+   if (!fJitFunction) {
+      Warning("JitCompile", "Could not compile the formula %s, it is interpreted", GetTitle());
+      return kFALSE;
+   }
+
+   for (Int_t code = 0; code < kMAXCODES; ++code) {
+      if (isLeafCode[code])
+         fJitCodes.push_back(code);
+   }
+   fJitValues.assign(kMAXCODES, nullptr);
+   fJitRealInstances.assign(kMAXCODES, 0);
+   fJitStatus = kJitCompiled;
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the formula with the function compiled by JitCompile().
+/// Like the interpreter, load the branches of the entry when evaluating the
+/// first instance.
+
+Double_t TTreeFormula::EvalJitInstance(Int_t instance)
+{
+   const Bool_t willLoad = (instance==0 || fNeedLoading); fNeedLoading = kFALSE;
+   if (willLoad) {
+      fDidBooleanOptimization = kFALSE;
+      for (Int_t code : fJitCodes) {
+         TLeaf *leaf = (TLeaf*)fLeaves.UncheckedAt(code);
+         TBranch *branch = (TBranch*)fBranches.UncheckedAt(code);
+         if (branch) {
+            R__LoadBranch(branch, branch->GetTree()->GetReadEntry(), fQuickLoad);
+         } else {
+            // a duplicate of another code, or a branch that the interpreter would only load on demand
+            branch = leaf->GetBranch();
+            R__LoadBranch(branch, branch->GetTree()->GetReadEntry(), kTRUE);
+         }
+         fJitValues[code] = leaf->GetValuePointer();
+      }
+      // the compiled function does not pass the boolean optimization state to the
+      // sub-formulas, which might be evaluated for the first time at instance > 0
+      for (Int_t op : fJitSubFormulas)
+         static_cast<TTreeFormula*>(fAliases.UncheckedAt(op))->LoadBranches();
+      if (fJitNeedEntries) {
+         fJitEntries[0] = fTree->GetReadEntry();
+         fJitEntries[1] = fTree->GetTree()->GetReadEntry();
+         fJitEntries[2] = fTree->GetEntries();
+         fJitEntries[3] = fTree->GetTree()->GetEntries();
+      }
+   }
+   for (Int_t code : fJitCodes)
+      fJitRealInstances[code] = fNdimensions[code] ? GetRealInstance(instance, code) : 0;
+
+   return fJitFunction(fJitValues.data(), fJitRealInstances.data(), fNdata, fAliases.GetObjectRef(), fJitEntries,
+                       instance, fManager->fNdata);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return DataMember corresponding to code.
 ///
@@ -5073,6 +5461,10 @@ void TTreeFormula::UpdateFormulaLeaves()
 {
    Int_t nleaves = fLeafNames.GetEntriesFast();
    ResetBit( kMissingLeaf );
+   // the types of the leaves might differ in the new tree: compile again (or reuse
+   // an already compiled function) at the next evaluation
+   fJitStatus = kJitNotTried;
+   fJitFunction = nullptr;
    for (Int_t i=0;i<nleaves;i++) {
       if (!fTree) break;
       if (!fLeafNames[i]) continue;
@@ -15,33 +15,275 @@ A Tree Index with majorname and minorname.
 
 #include "TTreeIndex.h"
 
+#include "Bytes.h" // frombuf
+#include "TBranch.h"
+#include "TBufferFile.h"
+#include "TChain.h"
+#include "TFile.h"
+#include "TLeaf.h"
+#include "TLeafC.h"
 #include "TTreeFormula.h"
 #include "TTree.h"
 #include "TBuffer.h"
 #include "TMath.h"
+#include "TROOT.h" // IsImplicitMTEnabled
+#include "TUUID.h"
+
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#include "ROOT/TTreeProcessorMT.hxx"
+#include "TTreeReader.h"
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <exception>
+#include <vector>
 
 ClassImp(TTreeIndex);
 
 
-struct IndexSortComparator {
+namespace {
 
-  IndexSortComparator(Long64_t *major, Long64_t *minor)
-        : fValMajor(major), fValMinor(minor)
-  {}
+/// The types of the leaves whose values can be read in bulk to build an index
+enum class EIndexLeafType { kConstant, kChar, kUChar, kShort, kUShort, kInt, kUInt, kLong64, kULong64, kFloat, kDouble,
+                            kBool };
 
-   template<typename Index>
-   bool operator()(Index i1, Index i2) {
-      if( *(fValMajor + i1) == *(fValMajor + i2) )
-         return *(fValMinor + i1) < *(fValMinor + i2);
-      else
-         return *(fValMajor + i1) < *(fValMajor + i2);
+/// A major or minor expression of an index that can be computed without a TTreeFormula: either an integer constant or
+/// a top-level branch with a single numeric leaf
+struct IndexColumn {
+   EIndexLeafType fType = EIndexLeafType::kConstant;
+   Long64_t fConstant = 0;
+   std::string fBranchName;
+   std::string fTypeName;
+};
+
+bool GetIndexColumn(TTree &tree, const TString &expression, IndexColumn &column)
+{
+   if (expression.IsDec()) {
+      column.fType = EIndexLeafType::kConstant;
+      column.fConstant = expression.Atoll();
+      return true;
+   }
+
+   if (tree.GetAlias(expression.Data()))
+      return false;
+   TLeaf *leaf = tree.GetLeaf(expression.Data());
+   if (!leaf || leaf->GetLen() != 1 || leaf->GetLeafCount() || leaf->InheritsFrom(TLeafC::Class()))
+      return false;
+   TBranch *branch = leaf->GetBranch();
+   // leaves of friend trees and of TBranchElements are left to TTreeFormula
+   if (branch->IsA() != TBranch::Class() || branch->GetNleaves() != 1 || branch->GetTree() != tree.GetTree())
+      return false;
+
+   const std::string typeName = leaf->GetTypeName();
+   static const std::vector<std::pair<std::string, EIndexLeafType>> types{
+      {"Char_t", EIndexLeafType::kChar},     {"UChar_t", EIndexLeafType::kUChar},
+      {"Short_t", EIndexLeafType::kShort},   {"UShort_t", EIndexLeafType::kUShort},
+      {"Int_t", EIndexLeafType::kInt},       {"UInt_t", EIndexLeafType::kUInt},
+      {"Long64_t", EIndexLeafType::kLong64}, {"ULong64_t", EIndexLeafType::kULong64},
+      {"Float_t", EIndexLeafType::kFloat},   {"Double_t", EIndexLeafType::kDouble},
+      {"Bool_t", EIndexLeafType::kBool}};
+   auto it = std::find_if(types.begin(), types.end(), [&typeName](const auto &t) { return t.first == typeName; });
+   if (it == types.end())
+      return false;
+   column.fType = it->second;
+   column.fBranchName = branch->GetName();
+   column.fTypeName = typeName;
+   return true;
+}
+
+template <typename T>
+void DecodeValues(char *raw, Long64_t n, Long64_t *values)
+{
+   for (Long64_t i = 0; i < n; ++i) {
+      T value;
+      frombuf(raw, &value);
+      values[i] = static_cast<Long64_t>(value);
+   }
+}
+
+/// Convert `n` values of the given type, serialized in big-endian order, to Long64_t
+void DecodeValues(EIndexLeafType type, char *raw, Long64_t n, Long64_t *values)
+{
+   switch (type) {
+   case EIndexLeafType::kChar: DecodeValues<Char_t>(raw, n, values); break;
+   case EIndexLeafType::kUChar: DecodeValues<UChar_t>(raw, n, values); break;
+   case EIndexLeafType::kShort: DecodeValues<Short_t>(raw, n, values); break;
+   case EIndexLeafType::kUShort: DecodeValues<UShort_t>(raw, n, values); break;
+   case EIndexLeafType::kInt: DecodeValues<Int_t>(raw, n, values); break;
+   case EIndexLeafType::kUInt: DecodeValues<UInt_t>(raw, n, values); break;
+   case EIndexLeafType::kLong64: DecodeValues<Long64_t>(raw, n, values); break;
+   case EIndexLeafType::kULong64: DecodeValues<ULong64_t>(raw, n, values); break;
+   case EIndexLeafType::kFloat: DecodeValues<Float_t>(raw, n, values); break;
+   case EIndexLeafType::kDouble: DecodeValues<Double_t>(raw, n, values); break;
+   case EIndexLeafType::kBool: DecodeValues<Bool_t>(raw, n, values); break;
+   case EIndexLeafType::kConstant: break;
    }
+}
 
-  // pointers to the start of index values tables keeping upper 64bit and lower 64bit
-  // of combined indexed 128bit value
-  Long64_t *fValMajor, *fValMinor;
+/// Read the values of entries [begin, end) of a column into `values`, without going through the TTreeFormula
+/// machinery. Whole baskets are read at once with the bulk I/O interface; entries before the first basket boundary
+/// of the range are read one at a time. `tree` can be a TChain. Return false if the column could not be read.
+bool ReadIndexColumn(TTree &tree, const IndexColumn &column, Long64_t begin, Long64_t end, Long64_t *values)
+{
+   if (column.fType == EIndexLeafType::kConstant) {
+      std::fill(values, values + (end - begin), column.fConstant);
+      return true;
+   }
+
+   TBufferFile buffer(TBuffer::kWrite, 32 * 1024);
+   for (Long64_t entry = begin; entry < end;) {
+      const Long64_t localEntry = tree.LoadTree(entry);
+      if (localEntry < 0)
+         return false;
+      // the files of a chain might store the column with different types
+      TBranch *branch = tree.GetTree()->GetBranch(column.fBranchName.c_str());
+      if (!branch || branch->GetNleaves() != 1 || !branch->SupportsBulkRead())
+         return false;
+      TLeaf *leaf = static_cast<TLeaf *>(branch->GetListOfLeaves()->At(0));
+      if (column.fTypeName != leaf->GetTypeName())
+         return false;
+      const Long64_t nEntries = std::min(end - entry, branch->GetEntries() - localEntry);
+      if (nEntries <= 0)
+         return false;
+
+      const Long64_t *basketEntry = branch->GetBasketEntry();
+      const Int_t basket = TMath::BinarySearch(Long64_t(branch->GetWriteBasket()) + 1, basketEntry, localEntry);
+      Long64_t nRead = 0;
+      if (basketEntry[basket] == localEntry) {
+         const Int_t nInBasket = branch->GetBulkRead().GetEntriesSerialized(localEntry, buffer);
+         if (nInBasket > 0) {
+            nRead = std::min(nEntries, Long64_t(nInBasket));
+            DecodeValues(column.fType, buffer.GetCurrent(), nRead, values + (entry - begin));
+         }
+      }
+      if (nRead == 0) {
+         // the range starts in the middle of a basket: read up to the beginning of the next basket
+         const Long64_t nextBasketEntry =
+            basket < branch->GetWriteBasket() ? basketEntry[basket + 1] : branch->GetEntries();
+         nRead = std::max(Long64_t(1), std::min(nEntries, nextBasketEntry - localEntry));
+         for (Long64_t i = 0; i < nRead; ++i) {
+            if (branch->GetEntry(localEntry + i) < 0)
+               return false;
+            values[entry - begin + i] = leaf->GetValueLong64();
+         }
+      }
+      entry += nRead;
+   }
+   return true;
+}
+
+/// Fill `major` and `minor` with the values of the index expressions for all the `n` entries of the tree, reading
+/// the branches in bulk, in parallel if implicit multi-threading is enabled. Only possible if the expressions are
+/// integer constants or plain numeric leaves and the tree is read from files, otherwise return false and the
+/// expressions must be evaluated with TTreeFormula.
+bool ReadIndexValuesBulk(TTree &tree, const TString &majorName, const TString &minorName, Long64_t n,
+                         Long64_t *major, Long64_t *minor)
+{
+   const bool isChain = tree.IsA() == TChain::Class();
+   if (!isChain && (!tree.GetCurrentFile() || tree.GetCurrentFile()->IsWritable()))
+      return false; // some baskets might still be in memory only
+   if (tree.GetEntryList())
+      return false;
+   const Long64_t oldEntry = tree.GetReadEntry();
+   IndexColumn majorColumn, minorColumn;
+   const bool canReadBulk = tree.LoadTree(0) >= 0 && GetIndexColumn(tree, majorName, majorColumn) &&
+                            GetIndexColumn(tree, minorName, minorColumn);
+   tree.LoadTree(oldEntry);
+   if (!canReadBulk)
+      return false;
+
+   auto readRange = [&](TTree &t, Long64_t begin, Long64_t end) {
+      return ReadIndexColumn(t, majorColumn, begin, end, major + begin) &&
+             ReadIndexColumn(t, minorColumn, begin, end, minor + begin);
+   };
+
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled()) {
+      std::atomic<bool> ok{true};
+      try {
+         ROOT::TTreeProcessorMT processor(tree, 0u, {0, n});
+         processor.Process([&](TTreeReader &reader) {
+            const auto range = reader.GetEntriesRange();
+            if (ok && !readRange(*reader.GetTree(), range.first, range.second))
+               ok = false;
+         });
+      } catch (const std::exception &) {
+         ok = false;
+      }
+      return ok;
+   }
+#endif
+
+   const bool ok = readRange(tree, 0, n);
+   tree.LoadTree(oldEntry);
+   return ok;
+}
+
+/// A (major, minor) pair of the index, with the entry it belongs to
+struct IndexValue {
+   Long64_t fMajor;
+   Long64_t fMinor;
+   Long64_t fEntry;
+   bool operator<(const IndexValue &other) const
+   {
+      if (fMajor != other.fMajor)
+         return fMajor < other.fMajor;
+      if (fMinor != other.fMinor)
+         return fMinor < other.fMinor;
+      return fEntry < other.fEntry;
+   }
 };
 
+/// Sort the (major, minor) pairs, breaking ties by entry number. With implicit multi-threading, chunks of the values
+/// are sorted in parallel and then merged pairwise, also in parallel.
+void SortIndexValues(std::vector<IndexValue> &values)
+{
+#ifdef R__USE_IMT
+   constexpr std::size_t minChunkSize = 1 << 16;
+   if (ROOT::IsImplicitMTEnabled() && values.size() >= 2 * minChunkSize) {
+      ROOT::TThreadExecutor pool;
+      const std::size_t nChunks =
+         std::min<std::size_t>(4 * pool.GetPoolSize(), values.size() / minChunkSize);
+      std::vector<std::size_t> bounds(nChunks + 1);
+      for (std::size_t i = 0; i <= nChunks; ++i)
+         bounds[i] = values.size() * i / nChunks;
+      pool.Foreach([&](unsigned int i) { std::sort(values.begin() + bounds[i], values.begin() + bounds[i + 1]); },
+                   ROOT::TSeqU(nChunks));
+      for (std::size_t width = 1; width < nChunks; width *= 2) {
+         const auto nMerges = (nChunks + 2 * width - 1) / (2 * width);
+         pool.Foreach(
+            [&](unsigned int i) {
+               const auto first = 2 * width * i;
+               const auto middle = std::min(first + width, nChunks);
+               const auto last = std::min(first + 2 * width, nChunks);
+               std::inplace_merge(values.begin() + bounds[first], values.begin() + bounds[middle],
+                                  values.begin() + bounds[last]);
+            },
+            ROOT::TSeqU(nMerges));
+      }
+      return;
+   }
+#endif
+   std::sort(values.begin(), values.end());
+}
+
+/// The hash of a (major, minor) pair in the hash index (a SplitMix64 finalizer over the combined values)
+ULong64_t HashIndexKey(Long64_t major, Long64_t minor)
+{
+   ULong64_t h = static_cast<ULong64_t>(major) * 0x9E3779B97F4A7C15ull ^ static_cast<ULong64_t>(minor);
+   h ^= h >> 30;
+   h *= 0xBF58476D1CE4E5B9ull;
+   h ^= h >> 27;
+   h *= 0x94D049BB133111EBull;
+   h ^= h >> 31;
+   return h;
+}
+
+} // anonymous namespace
+
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Default constructor for TTreeIndex
@@ -53,6 +295,18 @@ TTreeIndex::TTreeIndex(): TVirtualIndex()
    fIndexValues        = 0;
    fIndexValuesMinor   = 0;
    fIndex              = 0;
+   fHashSize           = 0;
+   fHashTable          = 0;
+   fHashIndexPending   = kFALSE;
+   fNFriendRuns        = 0;
+   fFriendMapEntries   = 0;
+   fFriendParentEntries = 0;
+   fFriendRunStarts    = 0;
+   fFriendRunEntries   = 0;
+   fFriendParentHasUUID = kFALSE;
+   fFriendParentChecked = 0;
+   fFriendParentMatches = kFALSE;
+   fLastFriendRun      = 0;
    fMajorFormula       = 0;
    fMinorFormula       = 0;
    fMajorFormulaParent = 0;
@@ -103,6 +357,9 @@ TTreeIndex::TTreeIndex(): TVirtualIndex()
 ///            the expressions given in major/minorname of TF are used
 ///            to compute the value pair major,minor with the data in T.
 ///         TF->GetEntryWithIndex(major,minor) is then called (tricky case!)
+///            If TF is read through its index for all the entries of T, the
+///            alignment can be computed once with BuildFriendEntryMap(T): the
+///            entries of TF are then found without evaluating major/minor in T.
 /// -  CASE 3: T->GetEntryWithIndex(major,minor) is called.
 ///            It is assumed that both T and TF have a TreeIndex built using
 ///            the same major and minor name.
@@ -118,6 +375,15 @@ TTreeIndex::TTreeIndex(): TVirtualIndex()
 ///
 /// Note that this function can also be applied to a TChain.
 ///
+/// If majorname and minorname are plain numeric leaves (or integer constants,
+/// like the default minorname) and the tree is read from files, their values
+/// are read directly from the baskets instead of being evaluated entry by entry,
+/// in parallel if implicit multi-threading is enabled. The sort of the values is
+/// also parallelized in that case. Other expressions are evaluated with TTreeFormula.
+///
+/// For trees with many lookups, a hash table of the index can be added with
+/// BuildHashIndex().
+///
 /// The return value is the number of entries in the Index (< 0 indicates failure)
 ///
 /// It is possible to play with different TreeIndex in the same Tree.
@@ -131,6 +397,18 @@ TTreeIndex::TTreeIndex(const TTree *T, const char *majorname, const char *minorn
    fIndexValues        = 0;
    fIndexValuesMinor   = 0;
    fIndex              = 0;
+   fHashSize           = 0;
+   fHashTable          = 0;
+   fHashIndexPending   = kFALSE;
+   fNFriendRuns        = 0;
+   fFriendMapEntries   = 0;
+   fFriendParentEntries = 0;
+   fFriendRunStarts    = 0;
+   fFriendRunEntries   = 0;
+   fFriendParentHasUUID = kFALSE;
+   fFriendParentChecked = 0;
+   fFriendParentMatches = kFALSE;
+   fLastFriendRun      = 0;
    fMajorFormula       = 0;
    fMinorFormula       = 0;
    fMajorFormulaParent = 0;
@@ -167,52 +445,57 @@ TTreeIndex::TTreeIndex(const TTree *T, const char *majorname, const char *minorn
    Long64_t *tmp_major = new Long64_t[fN];
    Long64_t *tmp_minor = new Long64_t[fN];
    Long64_t i;
-   Long64_t oldEntry = fTree->GetReadEntry();
-   Int_t current = -1;
-   for (i=0;i<fN;i++) {
-      Long64_t centry = fTree->LoadTree(i);
-      if (centry < 0) break;
-      if (fTree->GetTreeNumber() != current) {
-         current = fTree->GetTreeNumber();
-         fMajorFormula->UpdateFormulaLeaves();
-         fMinorFormula->UpdateFormulaLeaves();
-      }
-      auto GetAndRangeCheck = [this](bool isMajor, Long64_t entry) {
-         LongDouble_t ret = (isMajor ? fMajorFormula : fMinorFormula)->EvalInstance<LongDouble_t>();
-         // Check whether the value (vs significant bits) of ldRet can represent
-         // the full precision of the returned value. If we return 10^60, the
-         // value fits into a long double, but if sizeof(long double) ==
-         // sizeof(double) it cannot store the ones: the value returned by
-         // EvalInstance() only stores the higher bits.
-         LongDouble_t retCloserToZero = ret;
-         if (ret > 0)
-            retCloserToZero -= 1;
-         else
-            retCloserToZero += 1;
-         if (retCloserToZero == ret) {
-            Warning("TTreeIndex",
-                    "In tree entry %lld, %s value %s=%Lf possibly out of range for internal `long double`", entry,
-                    isMajor ? "major" : "minor", isMajor ? fMajorName.Data() : fMinorName.Data(), ret);
+   if (!ReadIndexValuesBulk(*fTree, fMajorName, fMinorName, fN, tmp_major, tmp_minor)) {
+      Long64_t oldEntry = fTree->GetReadEntry();
+      Int_t current = -1;
+      for (i=0;i<fN;i++) {
+         Long64_t centry = fTree->LoadTree(i);
+         if (centry < 0) break;
+         if (fTree->GetTreeNumber() != current) {
+            current = fTree->GetTreeNumber();
+            fMajorFormula->UpdateFormulaLeaves();
+            fMinorFormula->UpdateFormulaLeaves();
          }
-         return ret;
-      };
-      tmp_major[i] = GetAndRangeCheck(true, i);
-      tmp_minor[i] = GetAndRangeCheck(false, i);
+         auto GetAndRangeCheck = [this](bool isMajor, Long64_t entry) {
+            LongDouble_t ret = (isMajor ? fMajorFormula : fMinorFormula)->EvalInstance<LongDouble_t>();
+            // Check whether the value (vs significant bits) of ldRet can represent
+            // the full precision of the returned value. If we return 10^60, the
+            // value fits into a long double, but if sizeof(long double) ==
+            // sizeof(double) it cannot store the ones: the value returned by
+            // EvalInstance() only stores the higher bits.
+            LongDouble_t retCloserToZero = ret;
+            if (ret > 0)
+               retCloserToZero -= 1;
+            else
+               retCloserToZero += 1;
+            if (retCloserToZero == ret) {
+               Warning("TTreeIndex",
+                       "In tree entry %lld, %s value %s=%Lf possibly out of range for internal `long double`", entry,
+                       isMajor ? "major" : "minor", isMajor ? fMajorName.Data() : fMinorName.Data(), ret);
+            }
+            return ret;
+         };
+         tmp_major[i] = GetAndRangeCheck(true, i);
+         tmp_minor[i] = GetAndRangeCheck(false, i);
+      }
+      fTree->LoadTree(oldEntry);
    }
+
+   std::vector<IndexValue> values(fN);
+   for (i = 0; i < fN; i++)
+      values[i] = {tmp_major[i], tmp_minor[i], i};
+   delete [] tmp_major;
+   delete [] tmp_minor;
+   SortIndexValues(values);
+
    fIndex = new Long64_t[fN];
-   for(i = 0; i < fN; i++) { fIndex[i] = i; }
-   std::sort(fIndex, fIndex + fN, IndexSortComparator(tmp_major, tmp_minor) );
-   //TMath::Sort(fN,w,fIndex,0);
    fIndexValues = new Long64_t[fN];
    fIndexValuesMinor = new Long64_t[fN];
-   for (i=0;i<fN;i++) {
-      fIndexValues[i] = tmp_major[fIndex[i]];
-      fIndexValuesMinor[i] = tmp_minor[fIndex[i]];
+   for (i = 0; i < fN; i++) {
+      fIndexValues[i] = values[i].fMajor;
+      fIndexValuesMinor[i] = values[i].fMinor;
+      fIndex[i] = values[i].fEntry;
    }
-
-   delete [] tmp_major;
-   delete [] tmp_minor;
-   fTree->LoadTree(oldEntry);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -224,6 +507,9 @@ TTreeIndex::~TTreeIndex()
    delete [] fIndexValues;      fIndexValues = 0;
    delete [] fIndexValuesMinor;      fIndexValuesMinor = 0;
    delete [] fIndex;            fIndex = 0;
+   delete [] fHashTable;        fHashTable = 0;
+   delete [] fFriendRunStarts;  fFriendRunStarts = 0;
+   delete [] fFriendRunEntries; fFriendRunEntries = 0;
    delete fMajorFormula;        fMajorFormula  = 0;
    delete fMinorFormula;        fMinorFormula  = 0;
    delete fMajorFormulaParent;  fMajorFormulaParent = 0;
@@ -234,9 +520,16 @@ TTreeIndex::~TTreeIndex()
 /// Append 'add' to this index.  Entry 0 in add will become entry n+1 in this.
 /// If delaySort is true, do not sort the value, then you must call
 /// Append(0,kFALSE);
+/// The hash index, if any, is rebuilt after the sort: until then, lookups use
+/// the binary search.
 
 void TTreeIndex::Append(const TVirtualIndex *add, Bool_t delaySort )
 {
+   // the positions in the hash table are invalidated by the new values and by the sort
+   const Bool_t hadHashIndex = HasHashIndex() || fHashIndexPending;
+   DropHashIndex();
+   // the entries of this tree are renumbered
+   DropFriendEntryMap();
 
    if (add && add->GetN()) {
       // Create new buffer (if needed)
@@ -284,29 +577,19 @@ void TTreeIndex::Append(const TVirtualIndex *add, Bool_t delaySort )
 
    // Sort.
    if (!delaySort) {
-      Long64_t *addValues = GetIndexValues();
-      Long64_t *addValues2 = GetIndexValuesMinor();
-      Long64_t *ind = fIndex;
-      Long64_t *conv = new Long64_t[fN];
-
-      for(Long64_t i = 0; i < fN; i++) { conv[i] = i; }
-      std::sort(conv, conv+fN, IndexSortComparator(addValues, addValues2) );
-      //Long64_t *w = fIndexValues;
-      //TMath::Sort(fN,w,conv,0);
-
-      fIndex = new Long64_t[fN];
-      fIndexValues = new Long64_t[fN];
-      fIndexValuesMinor = new Long64_t[fN];
-
-      for (Int_t i=0;i<fN;i++) {
-         fIndex[i] = ind[conv[i]];
-         fIndexValues[i] = addValues[conv[i]];
-         fIndexValuesMinor[i] = addValues2[conv[i]];
+      std::vector<IndexValue> values(fN);
+      for (Long64_t i = 0; i < fN; i++)
+         values[i] = {fIndexValues[i], fIndexValuesMinor[i], fIndex[i]};
+      SortIndexValues(values);
+      for (Long64_t i = 0; i < fN; i++) {
+         fIndexValues[i] = values[i].fMajor;
+         fIndexValuesMinor[i] = values[i].fMinor;
+         fIndex[i] = values[i].fEntry;
       }
-      delete [] addValues;
-      delete [] addValues2;
-      delete [] ind;
-      delete [] conv;
+      if (hadHashIndex)
+         BuildHashIndex();
+   } else {
+      fHashIndexPending = hadHashIndex;
    }
 }
 
@@ -337,6 +620,10 @@ bool TTreeIndex::ConvertOldToNew()
 /// In case this (friend) Tree and 'master' do not share an index with the same
 /// major and minor name, the entry serial number in the (friend) tree
 /// and in the master Tree are assumed to be the same
+///
+/// If a friend entry map was built with BuildFriendEntryMap for the parent,
+/// the entry is taken from the map instead of evaluating major and minor in
+/// the parent.
 
 Long64_t TTreeIndex::GetEntryNumberFriend(const TTree *parent)
 {
@@ -345,6 +632,8 @@ Long64_t TTreeIndex::GetEntryNumberFriend(const TTree *parent)
    Long64_t pentry = parent->GetReadEntry();
    if (pentry >= parent->GetEntries())
       return -2;
+   if (pentry >= 0 && pentry < fFriendMapEntries && IsFriendEntryMapValidFor(parent))
+      return FindInFriendEntryMap(pentry);
    GetMajorFormulaParent(parent);
    GetMinorFormulaParent(parent);
    if (!fMajorFormulaParent || !fMinorFormulaParent) return -1;
@@ -395,6 +684,294 @@ Long64_t TTreeIndex::FindValues(Long64_t major, Long64_t minor) const
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Find the position of the major|minor values in the IndexValues tables using
+/// the hash index, or -1 if they are not in the index.
+/// Like FindValues, return the first position of the pair if it appears several times.
+
+Long64_t TTreeIndex::FindValuesInHash(Long64_t major, Long64_t minor) const
+{
+   const ULong64_t mask = fHashSize - 1;
+   for (ULong64_t slot = HashIndexKey(major, minor) & mask;; slot = (slot + 1) & mask) {
+      const Long64_t pos = fHashTable[slot];
+      if (pos < 0)
+         return -1;
+      if (fIndexValues[pos] == major && fIndexValuesMinor[pos] == minor)
+         return pos;
+   }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Build a hash table of the (major, minor) pairs of the index, so that
+/// GetEntryNumberWithIndex finds the entry of a pair in constant time instead
+/// of with a binary search. This pays off when many lookups are done in a large
+/// index, e.g. when reading a friend tree through its index in a different order.
+///
+/// The table uses about twice the memory of the sorted values. It is written
+/// together with the index, so it does not need to be rebuilt after reading
+/// the tree back from a file. It is rebuilt by Append, after the sort if the
+/// sort is delayed.
+///
+/// Return false if the index is empty.
+
+Bool_t TTreeIndex::BuildHashIndex()
+{
+   DropHashIndex();
+   if (fN <= 0)
+      return kFALSE;
+
+   // a power of two with a load factor of at most 1/2, to keep the probe sequences short
+   fHashSize = 2;
+   while (fHashSize < 2 * fN)
+      fHashSize *= 2;
+   fHashTable = new Long64_t[fHashSize];
+   std::fill(fHashTable, fHashTable + fHashSize, -1);
+
+   const ULong64_t mask = fHashSize - 1;
+   for (Long64_t pos = 0; pos < fN; pos++) {
+      // only the first of equal pairs is inserted: they are contiguous in the sorted tables
+      if (pos > 0 && fIndexValues[pos] == fIndexValues[pos - 1] && fIndexValuesMinor[pos] == fIndexValuesMinor[pos - 1])
+         continue;
+      ULong64_t slot = HashIndexKey(fIndexValues[pos], fIndexValuesMinor[pos]) & mask;
+      while (fHashTable[slot] >= 0)
+         slot = (slot + 1) & mask;
+      fHashTable[slot] = pos;
+   }
+   return kTRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Delete the hash table built by BuildHashIndex: lookups use the binary search
+/// in the sorted values again.
+
+void TTreeIndex::DropHashIndex()
+{
+   delete [] fHashTable;
+   fHashTable = 0;
+   fHashSize = 0;
+   fHashIndexPending = kFALSE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the entry of this tree aligned with the entry `parentEntry` of the
+/// parent tree in the friend entry map, or -1 if it is not in the index.
+/// The run of the previous lookup and the one following it are checked first,
+/// so that reading the parent sequentially does not need a binary search.
+
+Long64_t TTreeIndex::FindInFriendEntryMap(Long64_t parentEntry)
+{
+   auto inRun = [this](Long64_t run, Long64_t entry) {
+      return fFriendRunStarts[run] <= entry && (run + 1 == fNFriendRuns || entry < fFriendRunStarts[run + 1]);
+   };
+   Long64_t run = fLastFriendRun;
+   if (!inRun(run, parentEntry)) {
+      if (run + 1 < fNFriendRuns && inRun(run + 1, parentEntry))
+         run++;
+      else
+         run = TMath::BinarySearch(fNFriendRuns, fFriendRunStarts, parentEntry);
+      fLastFriendRun = run;
+   }
+   const Long64_t first = fFriendRunEntries[run];
+   return first < 0 ? -1 : first + (parentEntry - fFriendRunStarts[run]);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute once, for all the entries of the parent tree, the entries of this
+/// (friend) tree found with the index, and keep them as runs of consecutive
+/// entries: a run is a range of parent entries aligned with a range of
+/// consecutive friend entries, or with no friend entry at all.
+/// GetEntryNumberFriend then finds the friend entry in the runs, without
+/// evaluating major and minor in the parent tree nor searching the index.
+/// Friend trees written in the same order as their parent, up to missing or
+/// extra entries, need only a few runs.
+///
+/// The values of major and minor in the parent are read in bulk, in parallel
+/// if implicit multi-threading is enabled, when they are plain numeric leaves,
+/// and the lookups in the index are also done in parallel in that case.
+///
+/// The map is written with the index, and copied with it: e.g. the friends
+/// set up by TTreeProcessorMT for each task use it. It is only valid for the
+/// parent tree it was built for, with the same entry numbers. The name, the
+/// number of entries and the origin of the data of the parent are stored with
+/// the map, and the map is ignored for parents that do not match them:
+///  - for a tree read from a file, the UUID of its directory, which is kept
+///    when the file is opened again, e.g. by TTreeProcessorMT;
+///  - for a chain, the names of its files and trees;
+///  - for a tree in memory, the UUID of its directory, which is the one of the
+///    ROOT session for trees not attached to a file. Two trees in memory with
+///    the same name and number of entries cannot be told apart: drop the map
+///    with DropFriendEntryMap before the friend is used with another such tree.
+///    The map is never used for a tree that is not attached to a directory.
+/// The map should be rebuilt if the friend is used with another parent. It is
+/// dropped by Append.
+///
+/// Return the number of runs, or -1 if the map could not be built.
+
+Long64_t TTreeIndex::BuildFriendEntryMap(TTree *parent)
+{
+   DropFriendEntryMap();
+   if (!parent || fN <= 0)
+      return -1;
+   Long64_t n = parent->GetEntries();
+   if (n <= 0) {
+      Error("BuildFriendEntryMap", "Cannot build a friend entry map for a tree having no entries");
+      return -1;
+   }
+   if (!IsValidFor(parent)) {
+      Error("BuildFriendEntryMap", "The tree %s does not have the values major=%s, minor=%s of the index",
+            parent->GetName(), fMajorName.Data(), fMinorName.Data());
+      return -1;
+   }
+
+   std::vector<Long64_t> major(n), minor(n);
+   if (!ReadIndexValuesBulk(*parent, fMajorName, fMinorName, n, major.data(), minor.data())) {
+      // evaluate the expressions like GetEntryNumberFriend does
+      Long64_t oldEntry = parent->GetReadEntry();
+      Int_t current = -1;
+      for (Long64_t i = 0; i < n; i++) {
+         if (parent->LoadTree(i) < 0) {
+            n = i;
+            break;
+         }
+         if (parent->GetTreeNumber() != current) {
+            current = parent->GetTreeNumber();
+            fMajorFormulaParent->UpdateFormulaLeaves();
+            fMinorFormulaParent->UpdateFormulaLeaves();
+         }
+         major[i] = (Long64_t)fMajorFormulaParent->EvalInstance();
+         minor[i] = (Long64_t)fMinorFormulaParent->EvalInstance();
+      }
+      parent->LoadTree(oldEntry);
+   }
+
+   std::vector<Long64_t> entries(n);
+   auto findEntries = [&](Long64_t begin, Long64_t end) {
+      for (Long64_t i = begin; i < end; i++)
+         entries[i] = GetEntryNumberWithIndex(major[i], minor[i]);
+   };
+#ifdef R__USE_IMT
+   constexpr Long64_t minChunkSize = 1 << 16;
+   if (ROOT::IsImplicitMTEnabled() && n >= 2 * minChunkSize) {
+      ROOT::TThreadExecutor pool;
+      const Long64_t nChunks = std::min<Long64_t>(4 * pool.GetPoolSize(), n / minChunkSize);
+      pool.Foreach([&](unsigned int i) { findEntries(n * i / nChunks, n * (i + 1) / nChunks); },
+                   ROOT::TSeqU(nChunks));
+   } else
+#endif
+   {
+      findEntries(0, n);
+   }
+
+   std::vector<Long64_t> runStarts, runEntries;
+   for (Long64_t i = 0; i < n; i++) {
+      const Bool_t continuesRun = i > 0 && (entries[i] < 0 ? entries[i - 1] < 0
+                                                           : entries[i - 1] >= 0 && entries[i] == entries[i - 1] + 1);
+      if (!continuesRun) {
+         runStarts.push_back(i);
+         runEntries.push_back(entries[i] < 0 ? -1 : entries[i]);
+      }
+   }
+   if (runStarts.empty())
+      return -1;
+
+   fNFriendRuns = runStarts.size();
+   fFriendMapEntries = n;
+   fFriendParentName = parent->GetName();
+   fFriendParentEntries = parent->GetEntries();
+   fFriendParentId = GetFriendParentId(parent);
+   DecodeFriendParentId();
+   fFriendRunStarts = new Long64_t[fNFriendRuns];
+   fFriendRunEntries = new Long64_t[fNFriendRuns];
+   std::copy(runStarts.begin(), runStarts.end(), fFriendRunStarts);
+   std::copy(runEntries.begin(), runEntries.end(), fFriendRunEntries);
+   fLastFriendRun = 0;
+   return fNFriendRuns;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Delete the friend entry map built by BuildFriendEntryMap: the friend entries
+/// are found by evaluating major and minor in the parent tree again.
+
+void TTreeIndex::DropFriendEntryMap()
+{
+   delete [] fFriendRunStarts;
+   delete [] fFriendRunEntries;
+   fFriendRunStarts = 0;
+   fFriendRunEntries = 0;
+   fNFriendRuns = 0;
+   fFriendMapEntries = 0;
+   fFriendParentName = "";
+   fFriendParentEntries = 0;
+   fFriendParentId = "";
+   fLastFriendRun = 0;
+   fFriendParentHasUUID = kFALSE;
+   fFriendParentChecked = 0;
+   fFriendParentMatches = kFALSE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if the friend entry map was built for a parent tree with the
+/// name, the number of entries and the origin of the data of `parent`.
+
+Bool_t TTreeIndex::IsFriendEntryMapValidFor(const TTree *parent)
+{
+   if (!HasFriendEntryMap() || fFriendParentEntries != parent->GetEntries() ||
+       fFriendParentName != parent->GetName())
+      return kFALSE;
+   if (auto chain = dynamic_cast<const TChain *>(parent)) {
+      // the files of a chain are only compared again when it changes or loads another tree
+      if (chain != fFriendParentChecked) {
+         fFriendParentChecked = chain;
+         fFriendParentMatches = fFriendParentId == GetFriendParentId(chain);
+      }
+      return fFriendParentMatches;
+   }
+   if (!fFriendParentHasUUID || !parent->GetDirectory())
+      return kFALSE;
+   UChar_t uuid[16];
+   parent->GetDirectory()->GetUUID().GetUUID(uuid);
+   return memcmp(uuid, fFriendParentUUID, sizeof(uuid)) == 0;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Decode the UUID of the directory of the parent tree stored in
+/// fFriendParentId, to compare it with the one of the parent at each lookup.
+
+void TTreeIndex::DecodeFriendParentId()
+{
+   // the identity of a chain is a list of files and trees, ending with ';'
+   fFriendParentHasUUID = !fFriendParentId.IsNull() && !fFriendParentId.EndsWith(";");
+   if (fFriendParentHasUUID)
+      TUUID(fFriendParentId.Data()).GetUUID(fFriendParentUUID);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return a string identifying where the data of `parent` come from: the
+/// names of the files and trees of a chain, or the UUID of the directory of a
+/// tree, or an empty string for a tree that is not attached to a directory.
+
+TString TTreeIndex::GetFriendParentId(const TTree *parent)
+{
+   TString id;
+   if (auto chain = dynamic_cast<const TChain *>(parent)) {
+      TIter next(chain->GetListOfFiles());
+      while (auto element = next())
+         id += TString::Format("%s:%s;", element->GetTitle(), element->GetName());
+   } else if (parent->GetDirectory()) {
+      id = parent->GetDirectory()->GetUUID().AsString();
+   }
+   return id;
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return entry number corresponding to major and minor number.
 /// Note that this function returns only the entry number, not the data
@@ -415,6 +992,11 @@ Long64_t TTreeIndex::GetEntryNumberWithBestIndex(Long64_t major, Long64_t minor)
 {
    if (fN == 0) return -1;
 
+   if (fHashTable) {
+      Long64_t hashPos = FindValuesInHash(major, minor);
+      if (hashPos >= 0)
+         return fIndex[hashPos];
+   }
    Long64_t pos = FindValues(major, minor);
    if( pos < fN && fIndexValues[pos] == major && fIndexValuesMinor[pos] == minor )
       return fIndex[pos];
@@ -433,6 +1015,8 @@ Long64_t TTreeIndex::GetEntryNumberWithBestIndex(Long64_t major, Long64_t minor)
 /// The function performs binary search in this sorted table.
 /// If it finds a pair that maches val, it returns directly the
 /// index in the table, otherwise it returns -1.
+/// If a hash index was built with BuildHashIndex, it is used instead of the
+/// binary search.
 ///
 /// See also GetEntryNumberWithBestIndex
 
@@ -440,6 +1024,10 @@ Long64_t TTreeIndex::GetEntryNumberWithIndex(Long64_t major, Long64_t minor) con
 {
    if (fN == 0) return -1;
 
+   if (fHashTable) {
+      Long64_t pos = FindValuesInHash(major, minor);
+      return pos < 0 ? -1 : fIndex[pos];
+   }
    Long64_t pos = FindValues(major, minor);
    if( pos < fN && fIndexValues[pos] == major && fIndexValuesMinor[pos] == minor )
       return fIndex[pos];
@@ -597,6 +1185,29 @@ void TTreeIndex::Streamer(TBuffer &R__b)
       }
       fIndex      = new Long64_t[fN];
       R__b.ReadFastArray(fIndex,fN);
+      DropHashIndex();
+      if( R__v > 2 ) {
+         R__b >> fHashSize;
+         if (fHashSize > 0) {
+            fHashTable = new Long64_t[fHashSize];
+            R__b.ReadFastArray(fHashTable,fHashSize);
+         }
+      }
+      DropFriendEntryMap();
+      if( R__v > 3 ) {
+         R__b >> fFriendMapEntries;
+         fFriendParentName.Streamer(R__b);
+         R__b >> fFriendParentEntries;
+         fFriendParentId.Streamer(R__b);
+         DecodeFriendParentId();
+         R__b >> fNFriendRuns;
+         if (fNFriendRuns > 0) {
+            fFriendRunStarts = new Long64_t[fNFriendRuns];
+            fFriendRunEntries = new Long64_t[fNFriendRuns];
+            R__b.ReadFastArray(fFriendRunStarts,fNFriendRuns);
+            R__b.ReadFastArray(fFriendRunEntries,fNFriendRuns);
+         }
+      }
       R__b.CheckByteCount(R__s, R__c, TTreeIndex::IsA());
    } else {
       R__c = R__b.WriteVersion(TTreeIndex::IsA(), kTRUE);
@@ -607,6 +1218,15 @@ void TTreeIndex::Streamer(TBuffer &R__b)
       R__b.WriteFastArray(fIndexValues, fN);
       R__b.WriteFastArray(fIndexValuesMinor, fN);
       R__b.WriteFastArray(fIndex, fN);
+      R__b << fHashSize;
+      R__b.WriteFastArray(fHashTable, fHashSize);
+      R__b << fFriendMapEntries;
+      fFriendParentName.Streamer(R__b);
+      R__b << fFriendParentEntries;
+      fFriendParentId.Streamer(R__b);
+      R__b << fNFriendRuns;
+      R__b.WriteFastArray(fFriendRunStarts, fNFriendRuns);
+      R__b.WriteFastArray(fFriendRunEntries, fNFriendRuns);
       R__b.SetByteCount(R__c, kTRUE);
    }
 }
@@ -626,6 +1246,8 @@ void TTreeIndex::UpdateFormulaLeaves(const TTree *parent)
       if (parent) fMinorFormulaParent->SetTree(const_cast<TTree*>(parent));
       fMinorFormulaParent->UpdateFormulaLeaves();
    }
+   // the parent chain may now read other files
+   fFriendParentChecked = 0;
 }
 ////////////////////////////////////////////////////////////////////////////////
 /// this function is called by TChain::LoadTree and TTreePlayer::UpdateFormulaLeaves
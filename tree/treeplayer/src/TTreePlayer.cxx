@@ -2287,7 +2287,17 @@ Long64_t TTreePlayer::Process(TSelector *selector,Option_t *option, Long64_t nen
       fSelectorUpdate = selector;
       UpdateFormulaLeaves();
 
+      // TTree::Draw and TTree::Project into a histogram or a profile: with implicit multi-threading, the entries are
+      // processed in parallel as soon as the limits of the histogram are known. This is only done if there are more
+      // entries than the estimate, since the values of the entries processed in parallel are not kept (see GetV1()).
+      Bool_t drawParallel = selector == fSelector && nentries > fTree->GetEstimate() && fSelector->CanProcessParallel();
+
       for (entry=firstentry;entry<firstentry+nentries;entry++) {
+         if (drawParallel && fSelector->GetAction() > 0) {
+            drawParallel = kFALSE;
+            if (fSelector->ProcessParallel(entry, firstentry + nentries))
+               break;
+         }
          entryNumber = fTree->GetEntryNumber(entry);
          if (entryNumber < 0) break;
          if (timer && timer->ProcessEvents()) break;
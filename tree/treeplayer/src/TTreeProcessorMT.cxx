@@ -19,12 +19,22 @@ passes a function whose only parameter is a TTreeReader. The function iterates
 on a subrange of entries by using that TTreeReader.
 
 The implementation of ROOT::TTreeProcessorMT parallelizes the processing of the subranges,
-each corresponding to a cluster in the TTree. This is possible thanks to the use
+each made of consecutive clusters of the TTree. This is possible thanks to the use
 of a ROOT::TThreadedObject, so that each thread works with its own TFile and TTree
-objects.
+objects. The clusters of each file are distributed evenly among the workers, which process
+them in subranges of a few clusters; a worker that runs out of clusters takes over half of
+the remaining clusters of the busiest worker, so that no worker stays idle while there is
+work left.
+
+When a TEntryList is processed, the subranges are made of the clusters that contain
+selected entries, balanced by their number of selected entries: no task is created
+for the other clusters, and the TTreeCache of each task only reads the baskets that
+contain selected entries.
 */
 
 #include "TROOT.h"
+#include "ROOT/RRangeScheduler.hxx"
+#include "ROOT/TSeq.hxx"
 #include "ROOT/TTreeProcessorMT.hxx"
 
 using namespace ROOT;
@@ -119,13 +129,35 @@ ConvertToElistClusters(std::vector<std::vector<EntryRange>> &&clusters, TEntryLi
    return elistClusters;
 }
 
+/// Merge the consecutive entry-list clusters of each file, as returned by ConvertToElistClusters, so that each file
+/// has around maxTasksPerFile tasks with a similar number of selected entries. The clusters without selected entries
+/// have already been dropped, and the tree entries between the selected ones are skipped by the TTreeCache of the task.
+static void MergeElistClusters(std::vector<std::vector<EntryRange>> &elistClusters, unsigned int maxTasksPerFile)
+{
+   for (auto &clustersInThisFile : elistClusters) {
+      if (clustersInThisFile.size() <= maxTasksPerFile)
+         continue;
+      const Long64_t nSelected = clustersInThisFile.back().second - clustersInThisFile.front().first;
+      const Long64_t entriesPerTask = (nSelected + maxTasksPerFile - 1) / maxTasksPerFile;
+      std::vector<EntryRange> tasks;
+      tasks.reserve(maxTasksPerFile + 1);
+      for (const auto &c : clustersInThisFile) {
+         if (!tasks.empty() && tasks.back().second - tasks.back().first < entriesPerTask)
+            tasks.back().second = c.second; // the ranges of entry-list indices are contiguous
+         else
+            tasks.emplace_back(c);
+      }
+      clustersInThisFile = std::move(tasks);
+   }
+}
+
 // EntryRanges and number of entries per file
 using ClustersAndEntries = std::pair<std::vector<std::vector<EntryRange>>, std::vector<Long64_t>>;
 
 ////////////////////////////////////////////////////////////////////////
 /// Return a vector of cluster boundaries for the given tree and files.
 static ClustersAndEntries MakeClusters(const std::vector<std::string> &treeNames,
-                                       const std::vector<std::string> &fileNames, const unsigned int maxTasksPerFile,
+                                       const std::vector<std::string> &fileNames,
                                        const EntryRange &range = {0, std::numeric_limits<Long64_t>::max()})
 {
    // Note that as a side-effect of opening all files that are going to be used in the
@@ -193,53 +225,38 @@ static ClustersAndEntries MakeClusters(const std::vector<std::string> &treeNames
                              "but the starting entry (" + range.first + ") is larger than the total number of " +
                              "entries (" + offset + ") in the dataset.");
 
-   // Here we "fuse" clusters together if the number of clusters is too big with respect to
-   // the number of slots, otherwise we can incur in an overhead which is big enough
-   // to make parallelisation detrimental to performance.
-   // For example, this is the case when, following a merging of many small files, a file
-   // contains a tree with many entries and with clusters of just a few entries each.
-   // Another problematic case is a high number of slots (e.g. 256) coupled with a high number
-   // of files (e.g. 1000 files): the large amount of files might result in a large amount
-   // of tasks, but the elevated concurrency level makes the little synchronization required by
-   // task initialization very expensive. In this case it's better to simply process fewer, larger tasks.
-   // Cluster-merging can help reduce the number of tasks down to a minumum of one task per file.
-   //
-   // The criterion according to which we fuse clusters together is to have around
-   // TTreeProcessorMT::GetTasksPerWorkerHint() clusters per slot.
-   // Concretely, for each file we will cap the number of tasks to ceil(GetTasksPerWorkerHint() * nWorkers / nFiles).
-
-   std::vector<std::vector<EntryRange>> eventRangesPerFile(clustersPerFile.size());
-   auto clustersPerFileIt = clustersPerFile.begin();
-   auto eventRangesPerFileIt = eventRangesPerFile.begin();
-   for (; clustersPerFileIt != clustersPerFile.end(); clustersPerFileIt++, eventRangesPerFileIt++) {
-      const auto clustersInThisFileSize = clustersPerFileIt->size();
-      const auto nFolds = clustersInThisFileSize / maxTasksPerFile;
-      // If the number of clusters is less than maxTasksPerFile
-      // we take the clusters as they are
-      if (nFolds == 0) {
-         *eventRangesPerFileIt = std::move(*clustersPerFileIt);
-         continue;
-      }
-      // Otherwise, we have to merge clusters, distributing the reminder evenly
-      // onto the first clusters
-      auto nReminderClusters = clustersInThisFileSize % maxTasksPerFile;
-      const auto &clustersInThisFile = *clustersPerFileIt;
-      for (auto i = 0ULL; i < clustersInThisFileSize; ++i) {
-         const auto start = clustersInThisFile[i].first;
-         // We lump together at least nFolds clusters, therefore
-         // we need to jump ahead of nFolds-1.
-         i += (nFolds - 1);
-         // We now add a cluster if we have some reminder left
-         if (nReminderClusters > 0) {
-            i += 1U;
-            nReminderClusters--;
-         }
-         const auto end = clustersInThisFile[i].second;
-         eventRangesPerFileIt->emplace_back(EntryRange({start, end}));
-      }
-   }
+   return std::make_pair(std::move(clustersPerFile), std::move(entriesPerFile));
+}
 
-   return std::make_pair(std::move(eventRangesPerFile), std::move(entriesPerFile));
+////////////////////////////////////////////////////////////////////////
+/// Process the cluster-aligned entry ranges of a file with one task per worker of the pool.
+///
+/// Processing too many small ranges comes with an overhead which is big enough to make parallelisation detrimental
+/// to performance, e.g. for a file that results from the merging of many small files, with a tree with many entries
+/// and clusters of just a few entries each, or with a large number of slots and files. Processing too few large ranges
+/// leaves workers idle at the end of the event loop if some ranges take longer than others.
+///
+/// Therefore each worker starts from an even share of the ranges, and takes runs of at most `grainSize` consecutive
+/// ranges at a time, which it processes with a single TTreeReader. A worker that runs out of ranges takes over half of
+/// the remaining ranges of the busiest worker (see ROOT::Internal::RRangeScheduler). This way the work is only split
+/// at cluster boundaries, and only as much as needed to keep all workers busy.
+template <typename F>
+static void ProcessClusterRanges(ROOT::TThreadExecutor &pool, const std::vector<EntryRange> &clusters,
+                                 unsigned int maxTasks, F &&processRange)
+{
+   if (clusters.empty())
+      return;
+   const auto nClusters = static_cast<ULong64_t>(clusters.size());
+   const auto nWorkers = static_cast<unsigned int>(std::min<ULong64_t>(pool.GetPoolSize(), nClusters));
+   maxTasks = std::max(maxTasks, 1u);
+   const auto grainSize = (nClusters + maxTasks - 1) / maxTasks;
+   ROOT::Internal::RRangeScheduler scheduler({0ull, nClusters}, nWorkers, grainSize);
+   auto runWorker = [&](unsigned int worker) {
+      ROOT::Internal::RRangeScheduler::Range_t run;
+      while (scheduler.Next(worker, run))
+         processRange(EntryRange{clusters[run.first].first, clusters[run.second - 1].second});
+   };
+   pool.Foreach(runWorker, ROOT::TSeqU(nWorkers));
 }
 
 } // anonymous namespace
@@ -451,7 +468,9 @@ TTreeProcessorMT::TTreeProcessorMT(TTree &tree, UInt_t nThreads, const EntryRang
 /// \param[in] func User-defined function that processes a subrange of entries
 void TTreeProcessorMT::Process(std::function<void(TTreeReader &)> func)
 {
-   // compute number of tasks per file
+   // Compute the number of tasks per file: the clusters of a file are handed out to the workers in runs of about
+   // 1/maxTasksPerFile of the file, which are only split further when workers run out of work
+   // (see ProcessClusterRanges)
    const unsigned int maxTasksPerFile =
       std::ceil(float(GetTasksPerWorkerHint() * fPool.GetPoolSize()) / float(fFileNames.size()));
 
@@ -468,9 +487,14 @@ void TTreeProcessorMT::Process(std::function<void(TTreeReader &)> func)
    auto &allClusters = allClusterAndEntries.first;
    const auto &allEntries = allClusterAndEntries.second;
    if (shouldRetrieveAllClusters) {
-      allClusterAndEntries = MakeClusters(fTreeNames, fFileNames, maxTasksPerFile, fGlobalRange);
-      if (hasEntryList)
+      // With an entry list, the tasks are made of the clusters that contain selected entries: they are merged only
+      // after the ones without selected entries are dropped, according to the number of selected entries. The merged
+      // ranges are then the units that the workers hand out to each other.
+      allClusterAndEntries = MakeClusters(fTreeNames, fFileNames, fGlobalRange);
+      if (hasEntryList) {
          allClusters = ConvertToElistClusters(std::move(allClusters), fEntryList, fTreeNames, fFileNames, allEntries);
+         MergeElistClusters(allClusters, maxTasksPerFile);
+      }
    }
 
    // Per-file processing in case we retrieved all cluster info upfront
@@ -480,7 +504,7 @@ void TTreeProcessorMT::Process(std::function<void(TTreeReader &)> func)
             fTreeView->GetTreeReader(c.first, c.second, fTreeNames, fFileNames, fFriendInfo, fEntryList, allEntries);
          func(*r);
       };
-      fPool.Foreach(processCluster, allClusters[fileIdx]);
+      ProcessClusterRanges(fPool, allClusters[fileIdx], maxTasksPerFile, processCluster);
    };
 
    // Per-file processing that also retrieves cluster info for a file
@@ -488,14 +512,14 @@ void TTreeProcessorMT::Process(std::function<void(TTreeReader &)> func)
       // Evaluate clusters (with local entry numbers) and number of entries for this file
       const auto &treeNames = std::vector<std::string>({fTreeNames[fileIdx]});
       const auto &fileNames = std::vector<std::string>({fFileNames[fileIdx]});
-      const auto clustersAndEntries = MakeClusters(treeNames, fileNames, maxTasksPerFile);
+      const auto clustersAndEntries = MakeClusters(treeNames, fileNames);
       const auto &clusters = clustersAndEntries.first[0];
       const auto &entries = clustersAndEntries.second[0];
       auto processCluster = [&](const EntryRange &c) {
          auto r = fTreeView->GetTreeReader(c.first, c.second, treeNames, fileNames, fFriendInfo, fEntryList, {entries});
          func(*r);
       };
-      fPool.Foreach(processCluster, clusters);
+      ProcessClusterRanges(fPool, clusters, maxTasksPerFile, processCluster);
    };
 
    const auto firstNonEmpty =
@@ -536,6 +560,9 @@ unsigned int TTreeProcessorMT::GetTasksPerWorkerHint()
 /// processed files features a bad clustering, for example with a lot of
 /// entries and just a few entries per cluster, or to limit the number of
 /// tasks spawned when a very large number of files and workers is used.
+/// The hint sets the size of the subranges of clusters that the workers
+/// process at a time: workers that run out of work split the remaining
+/// subranges of the others further, down to single clusters.
 void TTreeProcessorMT::SetTasksPerWorkerHint(unsigned int tasksPerWorkerHint)
 {
    fgTasksPerWorkerHint = tasksPerWorkerHint;
@@ -18,6 +18,9 @@
 #include "TTreeReaderValue.h"
 #include "TFriendProxy.h"
 
+#include <algorithm>
+#include <utility>
+#include <vector>
 
 // clang-format off
 /**
@@ -339,6 +342,7 @@ Bool_t TTreeReader::Notify()
       for (auto value: fValues) {
          value->NotifyNewTree(fTree->GetTree());
       }
+      SetCacheSelectedEntries();
    }
 
    return kTRUE;
@@ -370,15 +374,22 @@ Bool_t TTreeReader::SetProxies() {
    // Operations 1, 2 and 3 need to happen in this order. See: https://sft.its.cern.ch/jira/browse/ROOT-9773?focusedCommentId=87837
    if (fProxiesSet) {
       const auto curFile = fTree->GetCurrentFile();
-      if (curFile && fTree->GetTree()->GetReadCache(curFile, true)) {
-         if (!(-1LL == fEndEntry && 0ULL == fBeginEntry)) {
+      auto cache = curFile ? fTree->GetTree()->GetReadCache(curFile, true) : nullptr;
+      if (cache) {
+         if (fEntryList) {
+            // fBeginEntry and fEndEntry are indices in the TEntryList, not entry numbers
+            SetCacheEntryListRange();
+         } else if (!(-1LL == fEndEntry && 0ULL == fBeginEntry)) {
             // We need to avoid to pass -1 as end entry to the SetCacheEntryRange method
             const auto lastEntry = (-1LL == fEndEntry) ? fTree->GetEntriesFast() : fEndEntry;
             fTree->SetCacheEntryRange(fBeginEntry, lastEntry);
          }
+         SetCacheSelectedEntries();
          for (auto value: fValues) {
             fTree->AddBranchToCache(value->GetProxy()->GetBranchName(), true);
          }
+         for (const auto &branchName : fLazyBranches)
+            cache->SetLazyBranch(branchName.c_str());
          fTree->StopCacheLearningPhase();
       }
    }
@@ -386,6 +397,109 @@ Bool_t TTreeReader::SetProxies() {
    return kTRUE;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Restrict the TTreeCache of the current tree to the entries from the first to
+/// the last one of the TEntryList that are in the range of the reader.
+
+void TTreeReader::SetCacheEntryListRange()
+{
+   const Long64_t nListEntries = fEntryList->GetN();
+   const Long64_t endIndex = (fEndEntry < 0 || fEndEntry > nListEntries) ? nListEntries : fEndEntry;
+   if ((fBeginEntry == 0 && endIndex == nListEntries) || fBeginEntry >= endIndex)
+      return;
+
+   // Global entry number of the index-th entry of the list
+   auto getEntry = [this](Long64_t index) {
+      if (!fEntryList->GetLists())
+         return fEntryList->GetEntry(index);
+      int treenum = -1;
+      const Long64_t localEntry = fEntryList->GetEntryAndTree(index, treenum);
+      return localEntry < 0 ? localEntry : localEntry + static_cast<TChain *>(fTree)->GetTreeOffset()[treenum];
+   };
+   const Long64_t firstEntry = getEntry(fBeginEntry);
+   const Long64_t lastEntry = getEntry(endIndex - 1);
+   // reset the position of the list for the loading of the next entry
+   getEntry(fEntry >= 0 ? fEntry : fBeginEntry);
+   if (firstEntry < 0 || lastEntry < 0)
+      return;
+
+   // the cache of the current tree of a chain counts the entries from the beginning of the tree
+   const Long64_t offset = fTree->GetTree()->GetChainOffset();
+   fTree->SetCacheEntryRange(std::max(firstEntry - offset, 0LL), lastEntry - offset + 1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Tell the TTreeCache of the current tree which of its entries are in the
+/// TEntryList, so that it does not read the clusters and the baskets that only
+/// contain entries which are skipped. Called for each new tree of a TChain.
+
+void TTreeReader::SetCacheSelectedEntries()
+{
+   if (!fEntryList)
+      return;
+   TTree *tree = fTree->GetTree();
+   TFile *curFile = fTree->GetCurrentFile();
+   TTreeCache *cache = (tree && curFile) ? tree->GetReadCache(curFile) : nullptr;
+   if (!cache)
+      return;
+
+   const TEntryList *list = fEntryList;
+   if (fEntryList->GetLists()) {
+      // the sub-list of the current tree, if any: local entry numbers
+      list = nullptr;
+      TIter next(fEntryList->GetLists());
+      while (auto sublist = static_cast<TEntryList *>(next())) {
+         if (sublist->GetTreeNumber() == fTree->GetTreeNumber()) {
+            list = sublist;
+            break;
+         }
+      }
+   }
+
+   std::vector<std::pair<Long64_t, Long64_t>> selected;
+   if (list) {
+      // a list without sub-lists has global entry numbers
+      const Long64_t offset = list == fEntryList ? tree->GetChainOffset() : 0;
+      const Long64_t nEntries = tree->GetEntries();
+      for (const auto &range : list->GetEntryRanges()) {
+         const Long64_t first = std::max(range.first - offset, 0LL);
+         const Long64_t last = std::min(range.second - offset, nEntries);
+         if (first < last)
+            selected.emplace_back(first, last);
+      }
+   }
+   cache->SetSelectedEntries(std::move(selected));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Do not decompress the baskets of these branches ahead of their use: they are
+/// put in the TTreeCache with the others, in compressed form, but decompressed
+/// only when a TTreeReaderValue or TTreeReaderArray reads one of their entries.
+/// Use it for the branches which are only read for a fraction of the entries,
+/// e.g. after a selection. It must be called before the first entry is loaded.
+///
+/// TTreeReaderValues and TTreeReaderArrays always read their branch on access,
+/// and a TTreeCache keeps its baskets compressed, so this changes the reading
+/// when the cache decompresses its baskets in parallel, see
+/// TTreeCacheUnzip::SetParallelUnzip. The work avoided is given by
+/// TTreeCacheUnzip::GetNLazy and TTreeCacheUnzip::GetNLazyUnzip, and by
+/// TTreeCache::GetNUnusedBaskets for the baskets that were never decompressed.
+/// ~~~{.cpp}
+/// TTreeReader reader("events", file);
+/// TTreeReaderValue<bool> pass(reader, "pass");
+/// TTreeReaderArray<float> jetPt(reader, "jets.pt");
+/// reader.SetLazyBranches({"jets"});
+/// while (reader.Next()) {
+///    if (*pass)
+///       h.Fill(jetPt[0]);
+/// }
+/// ~~~
+
+void TTreeReader::SetLazyBranches(const std::vector<std::string> &branchNames)
+{
+   fLazyBranches = branchNames;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Set the range of entries to be loaded by `Next()`; end will not be loaded.
 ///
@@ -0,0 +1,100 @@
+#include <TFile.h>
+#include <TSystem.h>
+#include <TTree.h>
+#include <TTreeCache.h>
+#include <TTreeCacheUnzip.h>
+#include <TTreeReader.h>
+#include <TTreeReaderArray.h>
+#include <TTreeReaderValue.h>
+
+#include "gtest/gtest.h"
+
+#include <memory>
+
+namespace {
+
+// A light branch read for every entry and a heavy one with many baskets per cluster
+void WriteLazyTree(const char *fileName)
+{
+   TFile f(fileName, "RECREATE");
+   TTree t("t", "t");
+   Int_t pass;
+   Double_t heavy[64];
+   t.Branch("pass", &pass);
+   t.Branch("heavy", heavy, "heavy[64]/D");
+   t.SetAutoFlush(500);
+   for (int i = 0; i < 10000; ++i) {
+      pass = (i % 1000 == 0);
+      for (int j = 0; j < 64; ++j)
+         heavy[j] = i * 64 + j;
+      t.Fill();
+   }
+   t.Write();
+}
+
+// Read the heavy branch only for the entries that pass the selection
+void ReadLazyTree(TTreeReader &reader)
+{
+   TTreeReaderValue<Int_t> pass(reader, "pass");
+   TTreeReaderArray<Double_t> heavy(reader, "heavy");
+   reader.SetLazyBranches({"heavy"});
+   int nPassed = 0;
+   while (reader.Next()) {
+      if (*pass) {
+         const auto entry = reader.GetCurrentEntry();
+         EXPECT_EQ(heavy[0], entry * 64);
+         EXPECT_EQ(heavy[63], entry * 64 + 63);
+         ++nPassed;
+      }
+   }
+   EXPECT_EQ(nPassed, 10);
+}
+
+} // anonymous namespace
+
+TEST(TTreeReaderLazyBranches, UnusedBaskets)
+{
+   const auto fileName = "treereader_lazybranches_unusedbaskets.root";
+   WriteLazyTree(fileName);
+
+   std::unique_ptr<TFile> f(TFile::Open(fileName));
+   auto t = f->Get<TTree>("t");
+   TTreeReader reader(t);
+   ReadLazyTree(reader);
+
+   auto cache = t->GetReadCache(f.get());
+   ASSERT_NE(cache, nullptr);
+   // the baskets of the heavy branch are fetched, but only the ones of the 10 selected entries are decompressed
+   const auto nBaskets = t->GetBranch("heavy")->GetWriteBasket();
+   EXPECT_GT(nBaskets, 100);
+   EXPECT_GT(cache->GetNUnusedBaskets(), nBaskets / 2);
+   EXPECT_TRUE(cache->IsLazyBranch(t->GetBranch("heavy")));
+   EXPECT_FALSE(cache->IsLazyBranch(t->GetBranch("pass")));
+
+   f.reset();
+   gSystem->Unlink(fileName);
+}
+
+TEST(TTreeReaderLazyBranches, ParallelUnzip)
+{
+   const auto fileName = "treereader_lazybranches_parallelunzip.root";
+   WriteLazyTree(fileName);
+
+   TTreeCacheUnzip::SetParallelUnzip(TTreeCacheUnzip::kEnable);
+   {
+      std::unique_ptr<TFile> f(TFile::Open(fileName));
+      auto t = f->Get<TTree>("t");
+      TTreeReader reader(t);
+      ReadLazyTree(reader);
+
+      auto cache = dynamic_cast<TTreeCacheUnzip *>(t->GetReadCache(f.get()));
+      ASSERT_NE(cache, nullptr);
+      // the baskets of the heavy branch are not unzipped ahead of their use
+      EXPECT_GT(cache->GetNLazy(), 100);
+      EXPECT_GT(cache->GetNLazyUnzip(), 0);
+      EXPECT_LE(cache->GetNLazyUnzip(), 10);
+   }
+   TTreeCacheUnzip::SetParallelUnzip(TTreeCacheUnzip::kDisable);
+
+   gSystem->Unlink(fileName);
+}
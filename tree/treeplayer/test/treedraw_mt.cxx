@@ -0,0 +1,195 @@
+#include <TChain.h>
+#include <TFile.h>
+#include <TH1.h>
+#include <TROOT.h>
+#include <TSelectorDraw.h>
+#include <TSystem.h>
+#include <TTree.h>
+
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#ifdef R__USE_IMT
+
+namespace {
+
+// Write a tree with many small clusters, with a scalar and a variable size array
+void WriteDrawTree(const char *fileName, int seed)
+{
+   TFile f(fileName, "RECREATE");
+   TTree t("t", "t");
+   Double_t x, y, z;
+   Int_t n;
+   Float_t arr[10];
+   t.Branch("x", &x);
+   t.Branch("y", &y);
+   t.Branch("z", &z);
+   t.Branch("n", &n);
+   t.Branch("arr", arr, "arr[n]/F");
+   t.SetAutoFlush(500);
+   for (int i = 0; i < 20000; ++i) {
+      const int k = i * 7 + seed;
+      x = (k % 1000) * 0.01;
+      y = ((k * 13) % 997) * 0.02 - 5.;
+      z = (k % 17) * 0.5;
+      n = k % 10;
+      for (int j = 0; j < n; ++j)
+         arr[j] = (k + j) % 50;
+      t.Fill();
+   }
+   t.Write();
+}
+
+// Number of entries of the last TTree::Draw that were processed in parallel
+Long64_t GetParallelEntries(TTree &t)
+{
+   auto selector = dynamic_cast<TSelectorDraw *>(t.GetPlayer()->GetSelector());
+   return selector ? selector->GetParallelEntries() : -1;
+}
+
+// Draw the expression in a fresh histogram, with or without implicit multi-threading
+std::unique_ptr<TH1> DrawHistogram(TTree &t, bool mt, const std::string &varexp, const std::string &binning,
+                                   const char *selection, const char *option, Long64_t &nrows)
+{
+   if (mt)
+      ROOT::EnableImplicitMT(4);
+   nrows = t.Draw((varexp + ">>hdraw" + binning).c_str(), selection, option);
+   if (mt)
+      ROOT::DisableImplicitMT();
+   // the entries after the first estimate are processed in parallel, and only with implicit multi-threading
+   if (mt)
+      EXPECT_GT(GetParallelEntries(t), 0) << varexp;
+   else
+      EXPECT_EQ(GetParallelEntries(t), 0) << varexp;
+   std::unique_ptr<TH1> h(static_cast<TH1 *>(gDirectory->Get("hdraw")));
+   if (h)
+      h->SetDirectory(nullptr);
+   return h;
+}
+
+void CompareDraws(TTree &t, const std::string &varexp, const char *selection = "", const char *option = "goff",
+                  const std::string &binning = "")
+{
+   Long64_t serialRows = 0, mtRows = 0;
+   auto serial = DrawHistogram(t, false, varexp, binning, selection, option, serialRows);
+   auto mt = DrawHistogram(t, true, varexp, binning, selection, option, mtRows);
+   ASSERT_NE(serial, nullptr) << varexp;
+   ASSERT_NE(mt, nullptr) << varexp;
+   EXPECT_EQ(serialRows, mtRows) << varexp;
+   EXPECT_EQ(serial->GetEntries(), mt->GetEntries()) << varexp;
+   ASSERT_EQ(serial->GetNcells(), mt->GetNcells()) << varexp;
+   EXPECT_DOUBLE_EQ(serial->GetXaxis()->GetXmin(), mt->GetXaxis()->GetXmin()) << varexp;
+   EXPECT_DOUBLE_EQ(serial->GetXaxis()->GetXmax(), mt->GetXaxis()->GetXmax()) << varexp;
+   for (Int_t bin = 0; bin < serial->GetNcells(); ++bin) {
+      EXPECT_NEAR(serial->GetBinContent(bin), mt->GetBinContent(bin), 1e-6 * (1. + serial->GetBinContent(bin)))
+         << varexp << " bin " << bin;
+   }
+}
+
+} // anonymous namespace
+
+TEST(TTreeDrawMT, Histograms)
+{
+   const auto fileName = "treedrawmt_histograms.root";
+   WriteDrawTree(fileName, 0);
+
+   std::unique_ptr<TFile> f(TFile::Open(fileName));
+   auto t = f->Get<TTree>("t");
+   t->SetEstimate(1000);
+
+   // histograms with automatic limits, found by the first estimate of the entries
+   CompareDraws(*t, "x");
+   CompareDraws(*t, "y:x");
+   CompareDraws(*t, "z:y:x", "", "goff box");
+   CompareDraws(*t, "y:x", "", "goff prof");
+   CompareDraws(*t, "z:y:x", "", "goff prof");
+   // histograms with fixed limits, entirely processed in parallel
+   CompareDraws(*t, "x", "", "goff", "(50,0,5)");
+   CompareDraws(*t, "y:x", "z>2", "goff", "(20,0,10,20,-5,15)");
+   // selection used as a weight, arrays and selections on the elements of arrays
+   CompareDraws(*t, "x", "z*(y>0)");
+   CompareDraws(*t, "arr", "arr>10");
+   CompareDraws(*t, "arr:x", "x>2");
+   CompareDraws(*t, "Sum$(arr)", "n>3");
+
+   f.reset();
+   gSystem->Unlink(fileName);
+}
+
+TEST(TTreeDrawMT, ChainAndRange)
+{
+   const auto fileName1 = "treedrawmt_chainandrange_1.root";
+   const auto fileName2 = "treedrawmt_chainandrange_2.root";
+   WriteDrawTree(fileName1, 1);
+   WriteDrawTree(fileName2, 2);
+
+   TChain c("t");
+   c.Add(fileName1);
+   c.Add(fileName2);
+   c.SetEstimate(1000);
+   c.SetAlias("r", "sqrt(x*x+y*y)");
+
+   CompareDraws(c, "r");
+   CompareDraws(c, "Entry$", "x>5", "goff", "(100,0,40000)");
+
+   // a range of entries across the two files
+   Long64_t serialRows = 0, mtRows = 0;
+   ROOT::EnableImplicitMT(4);
+   mtRows = c.Draw("y>>hrange(100,-5,15)", "", "goff", 25000, 10000);
+   ROOT::DisableImplicitMT();
+   // the limits are fixed: all the entries of the range are processed in parallel
+   EXPECT_EQ(GetParallelEntries(c), 25000);
+   std::unique_ptr<TH1> mt(static_cast<TH1 *>(gDirectory->Get("hrange")));
+   mt->SetDirectory(nullptr);
+   serialRows = c.Draw("y>>hrange(100,-5,15)", "", "goff", 25000, 10000);
+   std::unique_ptr<TH1> serial(static_cast<TH1 *>(gDirectory->Get("hrange")));
+   serial->SetDirectory(nullptr);
+   EXPECT_EQ(serialRows, 25000);
+   EXPECT_EQ(mtRows, serialRows);
+   for (Int_t bin = 0; bin < serial->GetNcells(); ++bin)
+      EXPECT_EQ(serial->GetBinContent(bin), mt->GetBinContent(bin));
+
+   gSystem->Unlink(fileName1);
+   gSystem->Unlink(fileName2);
+}
+
+TEST(TTreeDrawMT, BufferedHistogram)
+{
+   const auto fileName = "treedrawmt_bufferedhistogram.root";
+   WriteDrawTree(fileName, 3);
+
+   std::unique_ptr<TFile> f(TFile::Open(fileName));
+   auto t = f->Get<TTree>("t");
+   t->SetEstimate(1000);
+
+   // existing histograms that find their limits from their buffer, emptied before or after the first estimate
+   for (const int bufferSize : {500, 100000}) {
+      Long64_t rows[2];
+      double mean[2], rms[2];
+      for (const bool mt : {false, true}) {
+         TH1D h("hbuffer", "", 100, 0., 0.);
+         h.SetBuffer(bufferSize);
+         if (mt)
+            ROOT::EnableImplicitMT(4);
+         rows[mt] = t->Project("hbuffer", "y", "x>1");
+         if (mt)
+            ROOT::DisableImplicitMT();
+         h.BufferEmpty();
+         EXPECT_EQ(h.GetEntries(), rows[mt]);
+         mean[mt] = h.GetMean();
+         rms[mt] = h.GetRMS();
+      }
+      EXPECT_GT(rows[0], 10000);
+      EXPECT_EQ(rows[0], rows[1]);
+      EXPECT_NEAR(mean[0], mean[1], 1e-9);
+      EXPECT_NEAR(rms[0], rms[1], 1e-9);
+   }
+
+   f.reset();
+   gSystem->Unlink(fileName);
+}
+
+#endif
@@ -0,0 +1,94 @@
+#include <TTree.h>
+#include <TTreeFormula.h>
+
+#include "gtest/gtest.h"
+
+#include <string>
+#include <vector>
+
+namespace {
+
+// Restore the default of the formula compilation at the end of a test
+struct JitCompilationRAII {
+   bool fOld = TTreeFormula::IsJitCompilationEnabled();
+   ~JitCompilationRAII() { TTreeFormula::SetJitCompilation(fOld); }
+};
+
+void FillTree(TTree &t)
+{
+   Int_t n;
+   Float_t x;
+   Double_t arr[10];
+   Short_t fixed[3];
+   Long64_t id;
+   t.Branch("n", &n);
+   t.Branch("x", &x);
+   t.Branch("arr", arr, "arr[n]/D");
+   t.Branch("fixed", fixed, "fixed[3]/S");
+   t.Branch("id", &id);
+   for (id = 0; id < 100; ++id) {
+      n = id % 7;
+      x = 0.25f * id - 10;
+      for (int i = 0; i < n; ++i)
+         arr[i] = 1.5 * i - 0.1 * id;
+      for (int i = 0; i < 3; ++i)
+         fixed[i] = id * (i - 1);
+      t.Fill();
+   }
+   t.SetAlias("shifted", "x + 3");
+}
+
+// The values selected by TTree::Draw for the expression and selection
+std::vector<double> Draw(TTree &t, const char *expression, const char *selection)
+{
+   const auto nRows = t.Draw(expression, selection, "goff");
+   if (nRows <= 0)
+      return {};
+   return std::vector<double>(t.GetV1(), t.GetV1() + nRows);
+}
+
+} // anonymous namespace
+
+TEST(TTreeFormulaJit, SameResultsAsInterpreter)
+{
+   JitCompilationRAII restore;
+   TTree t("t", "t");
+   FillTree(t);
+
+   const std::vector<std::pair<const char *, const char *>> queries{
+      {"x*x + sqrt(id) - log(n)", ""},
+      {"x / (n - 3)", "id % 3 == 0"},
+      {"arr", "x > 0 && n > 2"},
+      {"arr * fixed[1] + x", "arr > 0 || id < 10"},
+      {"fixed", "fixed != 0"},
+      {"arr[2] + Iteration$", "n > 2 ? x > -5 : id > 50"},
+      {"Length$(arr) + Sum$(arr) + Max$(arr) - Min$(arr)", ""},
+      {"Alt$(arr[3], -1) + shifted", "!(id & 1)"},
+      {"Entry$ + abs(fixed[2]) + (id >> 2)", "int(x) % 2 == 1"},
+      {"atan2(x, 1 + n) + pow(abs(x), 0.5) + min(x, arr)", ""},
+   };
+   for (const auto &query : queries) {
+      TTreeFormula::SetJitCompilation(false);
+      const auto interpreted = Draw(t, query.first, query.second);
+      TTreeFormula::SetJitCompilation(true);
+      const auto compiled = Draw(t, query.first, query.second);
+      ASSERT_EQ(interpreted.size(), compiled.size()) << query.first << " with selection " << query.second;
+      EXPECT_FALSE(interpreted.empty()) << query.first << " with selection " << query.second;
+      for (std::size_t i = 0; i < interpreted.size(); ++i)
+         EXPECT_DOUBLE_EQ(interpreted[i], compiled[i]) << query.first << " with selection " << query.second;
+   }
+}
+
+TEST(TTreeFormulaJit, FallbackToInterpreter)
+{
+   JitCompilationRAII restore;
+   TTreeFormula::SetJitCompilation(true);
+   TTree t("t", "t");
+   FillTree(t);
+
+   // string comparisons are not compiled
+   TTreeFormula f("f", "x * 2 + (\"a\" == \"a\")", &t);
+   t.GetEntry(42);
+   f.GetNdata();
+   EXPECT_DOUBLE_EQ(f.EvalInstance(), (0.25 * 42 - 10) * 2 + 1);
+}
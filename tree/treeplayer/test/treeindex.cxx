@@ -0,0 +1,317 @@
+#include <TChain.h>
+#include <TFile.h>
+#include <TROOT.h>
+#include <TSystem.h>
+#include <TTree.h>
+#include <TTreeIndex.h>
+
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <vector>
+
+namespace {
+
+// Write a tree with the runs in decreasing order and the events of each run in increasing order, with small baskets
+// so that the index is built from many of them
+void WriteIndexedTree(const char *fileName, int firstRun, int nRuns, int nEvents)
+{
+   TFile f(fileName, "RECREATE");
+   TTree t("t", "t");
+   Int_t run;
+   Long64_t event;
+   Float_t weight;
+   t.Branch("run", &run, 512);
+   t.Branch("event", &event, 512);
+   t.Branch("weight", &weight, 512);
+   for (run = firstRun + nRuns - 1; run >= firstRun; --run) {
+      for (event = 0; event < nEvents; ++event) {
+         weight = event + 0.5f;
+         t.Fill();
+      }
+   }
+   t.Write();
+}
+
+void CheckLookups(TTree &t, int firstRun, int nRuns, int nEvents)
+{
+   for (int run = firstRun; run < firstRun + nRuns; ++run) {
+      for (Long64_t event = 0; event < nEvents; event += 7) {
+         const Long64_t expected = (firstRun + nRuns - 1 - run) * nEvents + event;
+         EXPECT_EQ(t.GetEntryNumberWithIndex(run, event), expected);
+      }
+   }
+   EXPECT_EQ(t.GetEntryNumberWithIndex(firstRun + nRuns, 0), -1);
+   EXPECT_EQ(t.GetEntryNumberWithIndex(firstRun, nEvents), -1);
+}
+
+} // anonymous namespace
+
+TEST(TTreeIndex, BuildFromFile)
+{
+   const auto fileName = "treeindex_buildfromfile.root";
+   WriteIndexedTree(fileName, 100, 20, 250);
+
+   std::unique_ptr<TFile> f(TFile::Open(fileName));
+   auto t = f->Get<TTree>("t");
+   ASSERT_GT(t->BuildIndex("run", "event"), 0);
+   CheckLookups(*t, 100, 20, 250);
+
+   // a leaf that is not an integer, and an expression, both truncated to integers
+   ASSERT_GT(t->BuildIndex("weight"), 0);
+   EXPECT_EQ(t->GetEntryNumberWithIndex(3, 0), 3);
+   ASSERT_GT(t->BuildIndex("run", "event*2"), 0);
+   EXPECT_EQ(t->GetEntryNumberWithIndex(119, 20), 10);
+
+   f.reset();
+   gSystem->Unlink(fileName);
+}
+
+#ifdef R__USE_IMT
+TEST(TTreeIndex, BuildFromChainMT)
+{
+   const auto fileName1 = "treeindex_buildfromchainmt_1.root";
+   const auto fileName2 = "treeindex_buildfromchainmt_2.root";
+   WriteIndexedTree(fileName1, 10, 10, 300);
+   WriteIndexedTree(fileName2, 0, 10, 300);
+
+   ROOT::EnableImplicitMT(4);
+   {
+      TChain c("t");
+      c.Add(fileName1);
+      c.Add(fileName2);
+      ASSERT_GT(c.BuildIndex("run", "event"), 0);
+      CheckLookups(c, 0, 20, 300);
+   }
+   ROOT::DisableImplicitMT();
+
+   gSystem->Unlink(fileName1);
+   gSystem->Unlink(fileName2);
+}
+#endif
+
+TEST(TTreeIndex, HashIndex)
+{
+   TTree t("t", "t");
+   Int_t run;
+   Int_t event;
+   t.Branch("run", &run);
+   t.Branch("event", &event);
+   for (run = 0; run < 10; ++run) {
+      for (event = 99; event >= 0; --event)
+         t.Fill();
+   }
+   // a duplicated pair: the lookups return the first entry, with and without the hash index
+   run = 5;
+   event = 50;
+   t.Fill();
+
+   ASSERT_GT(t.BuildIndex("run", "event"), 0);
+   auto index = static_cast<TTreeIndex *>(t.GetTreeIndex());
+   EXPECT_FALSE(index->HasHashIndex());
+   const Long64_t withoutHash = t.GetEntryNumberWithIndex(5, 50);
+   EXPECT_EQ(withoutHash, 549);
+
+   EXPECT_TRUE(index->BuildHashIndex());
+   EXPECT_TRUE(index->HasHashIndex());
+   EXPECT_EQ(t.GetEntryNumberWithIndex(5, 50), withoutHash);
+   for (Long64_t entry = 0; entry < 1000; entry += 13) {
+      t.GetEntry(entry);
+      EXPECT_EQ(t.GetEntryNumberWithIndex(run, event), entry);
+   }
+   EXPECT_EQ(t.GetEntryNumberWithIndex(10, 0), -1);
+   EXPECT_EQ(t.GetEntryNumberWithIndex(0, 100), -1);
+   // not in the index: fall back to the closest lower pair
+   EXPECT_EQ(t.GetEntryNumberWithBestIndex(0, 100), 0);
+
+   index->DropHashIndex();
+   EXPECT_FALSE(index->HasHashIndex());
+   EXPECT_EQ(t.GetEntryNumberWithIndex(3, 3), 396);
+}
+
+TEST(TTreeIndex, HashIndexDelayedSort)
+{
+   TTree t1("t1", "t1");
+   TTree t2("t2", "t2");
+   Int_t run;
+   t1.Branch("run", &run);
+   t2.Branch("run", &run);
+   for (run = 0; run < 100; ++run)
+      t1.Fill();
+   for (run = 199; run >= 100; --run)
+      t2.Fill();
+   ASSERT_GT(t1.BuildIndex("run"), 0);
+   ASSERT_GT(t2.BuildIndex("run"), 0);
+   auto index = static_cast<TTreeIndex *>(t1.GetTreeIndex());
+   ASSERT_TRUE(index->BuildHashIndex());
+
+   // the hash index is dropped until the delayed sort and rebuilt by it
+   index->Append(t2.GetTreeIndex(), kTRUE);
+   EXPECT_FALSE(index->HasHashIndex());
+   index->Append(nullptr, kFALSE);
+   EXPECT_TRUE(index->HasHashIndex());
+   EXPECT_EQ(index->GetN(), 200);
+   EXPECT_EQ(index->GetEntryNumberWithIndex(42, 0), 42);
+   EXPECT_EQ(index->GetEntryNumberWithIndex(150, 0), 149);
+   EXPECT_EQ(index->GetEntryNumberWithIndex(200, 0), -1);
+}
+
+TEST(TTreeIndex, HashIndexIsWritten)
+{
+   const auto fileName = "treeindex_hashindexiswritten.root";
+   {
+      TFile f(fileName, "RECREATE");
+      TTree t("t", "t");
+      Int_t run;
+      t.Branch("run", &run);
+      for (run = 1000; run > 0; --run)
+         t.Fill();
+      t.BuildIndex("run");
+      static_cast<TTreeIndex *>(t.GetTreeIndex())->BuildHashIndex();
+      t.Write();
+   }
+
+   std::unique_ptr<TFile> f(TFile::Open(fileName));
+   auto t = f->Get<TTree>("t");
+   auto index = dynamic_cast<TTreeIndex *>(t->GetTreeIndex());
+   ASSERT_NE(index, nullptr);
+   EXPECT_TRUE(index->HasHashIndex());
+   EXPECT_EQ(t->GetEntryNumberWithIndex(1000), 0);
+   EXPECT_EQ(t->GetEntryNumberWithIndex(1), 999);
+   EXPECT_EQ(t->GetEntryNumberWithIndex(1001), -1);
+
+   f.reset();
+   gSystem->Unlink(fileName);
+}
+
+TEST(TTreeIndex, FriendEntryMap)
+{
+   const auto fileName = "treeindex_friendentrymap.root";
+   // the friend has the runs in the opposite order of the parent, and misses one of its runs
+   WriteIndexedTree(fileName, 0, 10, 100);
+   TTree parent("parent", "parent");
+   Int_t run;
+   Long64_t event;
+   parent.Branch("run", &run);
+   parent.Branch("event", &event);
+   for (run = 0; run < 11; ++run) {
+      for (event = 0; event < 100; ++event)
+         parent.Fill();
+   }
+
+   std::vector<Long64_t> expected;
+   {
+      std::unique_ptr<TFile> f(TFile::Open(fileName, "UPDATE"));
+      auto t = f->Get<TTree>("t");
+      ASSERT_GT(t->BuildIndex("run", "event"), 0);
+      parent.AddFriend(t);
+      for (Long64_t entry = 0; entry < parent.GetEntries(); ++entry)
+         expected.push_back(t->LoadTreeFriend(parent.LoadTree(entry), &parent));
+      EXPECT_EQ(expected[0], 900);
+      EXPECT_EQ(expected[1000], -1);
+
+      auto index = static_cast<TTreeIndex *>(t->GetTreeIndex());
+      // one run per run number of the friend, and one for the run that is not in the friend
+      EXPECT_EQ(index->BuildFriendEntryMap(&parent), 11);
+      EXPECT_TRUE(index->HasFriendEntryMap());
+      for (Long64_t entry = 0; entry < parent.GetEntries(); ++entry)
+         EXPECT_EQ(t->LoadTreeFriend(parent.LoadTree(entry), &parent), expected[entry]) << entry;
+      for (Long64_t entry = parent.GetEntries() - 1; entry >= 0; entry -= 37)
+         EXPECT_EQ(t->LoadTreeFriend(parent.LoadTree(entry), &parent), expected[entry]) << entry;
+      parent.RemoveFriend(t);
+
+      // the map is not used for another parent, even with the same number of entries
+      TTree other("other", "other");
+      other.Branch("run", &run);
+      other.Branch("event", &event);
+      for (run = 10; run >= 0; --run) {
+         for (event = 0; event < 100; ++event)
+            other.Fill();
+      }
+      other.AddFriend(t);
+      for (Long64_t entry = 0; entry < other.GetEntries(); entry += 7) {
+         const Long64_t sameValuesInParent = (10 - entry / 100) * 100 + entry % 100;
+         EXPECT_EQ(t->LoadTreeFriend(other.LoadTree(entry), &other), expected[sameValuesInParent]) << entry;
+      }
+      other.RemoveFriend(t);
+      EXPECT_TRUE(index->HasFriendEntryMap());
+      t->Write("", TObject::kOverwrite);
+   }
+
+   // the map is written with the index
+   std::unique_ptr<TFile> f(TFile::Open(fileName));
+   auto t = f->Get<TTree>("t");
+   auto index = dynamic_cast<TTreeIndex *>(t->GetTreeIndex());
+   ASSERT_NE(index, nullptr);
+   EXPECT_EQ(index->GetNFriendRuns(), 11);
+   for (Long64_t entry = 0; entry < parent.GetEntries(); entry += 3)
+      EXPECT_EQ(t->LoadTreeFriend(parent.LoadTree(entry), &parent), expected[entry]) << entry;
+   index->DropFriendEntryMap();
+   EXPECT_FALSE(index->HasFriendEntryMap());
+   EXPECT_EQ(t->LoadTreeFriend(parent.LoadTree(550), &parent), expected[550]);
+
+   f.reset();
+   gSystem->Unlink(fileName);
+}
+
+TEST(TTreeIndex, FriendEntryMapOtherFile)
+{
+   const auto friendFileName = "treeindex_friendentrymapotherfile_friend.root";
+   const auto parentFileName = "treeindex_friendentrymapotherfile_parent.root";
+   const auto otherFileName = "treeindex_friendentrymapotherfile_other.root";
+   WriteIndexedTree(friendFileName, 0, 10, 100);
+   // two parent trees with the same name and number of entries, with the runs in opposite orders
+   auto writeParent = [](const char *fileName, bool reversed) {
+      TFile f(fileName, "RECREATE");
+      TTree parent("parent", "parent");
+      Int_t run;
+      Long64_t event;
+      parent.Branch("run", &run);
+      parent.Branch("event", &event);
+      for (Int_t i = 0; i < 10; ++i) {
+         run = reversed ? 9 - i : i;
+         for (event = 0; event < 100; ++event)
+            parent.Fill();
+      }
+      parent.Write();
+   };
+   writeParent(parentFileName, false);
+   writeParent(otherFileName, true);
+
+   std::unique_ptr<TFile> friendFile(TFile::Open(friendFileName));
+   auto t = friendFile->Get<TTree>("t");
+   ASSERT_GT(t->BuildIndex("run", "event"), 0);
+   auto index = static_cast<TTreeIndex *>(t->GetTreeIndex());
+   {
+      std::unique_ptr<TFile> f(TFile::Open(parentFileName));
+      auto parent = f->Get<TTree>("parent");
+      EXPECT_EQ(index->BuildFriendEntryMap(parent), 10);
+   }
+
+   // the map is still used when the file of the parent is opened again
+   {
+      std::unique_ptr<TFile> f(TFile::Open(parentFileName));
+      auto parent = f->Get<TTree>("parent");
+      parent->AddFriend(t);
+      for (Long64_t entry = 0; entry < parent->GetEntries(); entry += 7)
+         EXPECT_EQ(t->LoadTreeFriend(parent->LoadTree(entry), parent), 900 - (entry / 100) * 100 + entry % 100);
+      parent->RemoveFriend(t);
+   }
+
+   // but not for a same-named tree with as many entries in another file
+   {
+      std::unique_ptr<TFile> f(TFile::Open(otherFileName));
+      auto other = f->Get<TTree>("parent");
+      ASSERT_EQ(other->GetEntries(), 1000);
+      other->AddFriend(t);
+      for (Long64_t entry = 0; entry < other->GetEntries(); entry += 7)
+         EXPECT_EQ(t->LoadTreeFriend(other->LoadTree(entry), other), entry) << entry;
+      other->RemoveFriend(t);
+   }
+   EXPECT_TRUE(index->HasFriendEntryMap());
+
+   friendFile.reset();
+   gSystem->Unlink(friendFileName);
+   gSystem->Unlink(parentFileName);
+   gSystem->Unlink(otherFileName);
+}
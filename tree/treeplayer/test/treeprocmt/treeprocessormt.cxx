@@ -1,15 +1,20 @@
 #include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <random>
 #include <string>
 #include <thread>
 #include <utility>
 
+#include <TEntryList.h>
 #include <TFile.h>
 #include <TTree.h>
 #include <TSystem.h>
 #include <TTreeReader.h>
+#include <TTreeReaderArray.h>
 #include <TTreeReaderValue.h>
 #include <ROOT/TTreeProcessorMT.hxx>
 
@@ -300,21 +305,16 @@ TEST(TreeProcessorMT, LimitNTasks_CheckEntries)
    ROOT::TTreeProcessorMT p(filename, treename);
    p.Process(f);
 
-   if (nslots == 4) {
-      EXPECT_EQ(nTasks, 40U) << "Wrong number of tasks generated!\n";
-      EXPECT_EQ(nEntriesCountsMap[24], 9U) << "Wrong number of tasks with 24 clusters each!\n";
-      EXPECT_EQ(nEntriesCountsMap[25], 31U) << "Wrong number of tasks with 25 clusters each!\n";
-   }
-   else if (nslots == 2) {
-      EXPECT_EQ(nTasks, 20U) << "Wrong number of tasks generated!\n";
-      EXPECT_EQ(nEntriesCountsMap[49], 9U) << "Wrong number of tasks with 49 clusters each!\n";
-      EXPECT_EQ(nEntriesCountsMap[50], 11U) << "Wrong number of tasks with 50 clusters each!\n";
-   }
-   else if (nslots == 1) {
-      EXPECT_EQ(nTasks, 10U) << "Wrong number of tasks generated!\n";
-      EXPECT_EQ(nEntriesCountsMap[99], 9U) << "Wrong number of tasks with 99 clusters each!\n";
-      EXPECT_EQ(nEntriesCountsMap[100], 1U) << "Wrong number of tasks with 100 clusters each!\n";
+   // around GetTasksPerWorkerHint() tasks per slot, each with at most 991 / (10 * nslots) clusters (rounded up)
+   const auto maxClustersPerTask = (991U + 10U * nslots - 1U) / (10U * nslots);
+   EXPECT_GE(nTasks, 10U * nslots) << "Wrong number of tasks generated!\n";
+   auto nProcessed = 0U;
+   for (const auto &countAndN : nEntriesCountsMap) {
+      EXPECT_GE(countAndN.first, 1U);
+      EXPECT_LE(countAndN.first, maxClustersPerTask) << "Too many clusters in a task!\n";
+      nProcessed += countAndN.first * countAndN.second;
    }
+   EXPECT_EQ(nProcessed, 991U);
 
    gSystem->Unlink(filename);
    ROOT::DisableImplicitMT();
@@ -362,6 +362,128 @@ TEST(TreeProcessorMT, LimitNTasks_CheckClusters)
    gSystem->Unlink(filename);
 }
 
+TEST(TreeProcessorMT, ClusterAlignedWorkStealing)
+{
+   const auto filename = "treeprocmt_clusteralignedworkstealing.root";
+   const auto nEntries = 10000;
+   {
+      // clusters of 10 entries
+      TFile f(filename, "recreate");
+      TTree t("t", "t");
+      int v = 0;
+      t.Branch("v", &v);
+      t.SetAutoFlush(10);
+      for (v = 0; v < nEntries; ++v)
+         t.Fill();
+      t.Write();
+   }
+
+   std::mutex m;
+   std::vector<std::pair<Long64_t, Long64_t>> ranges;
+   std::vector<int> nProcessed(nEntries, 0);
+   ROOT::EnableImplicitMT(4);
+   ROOT::TTreeProcessorMT p(filename, "t");
+   std::atomic<bool> isFirstRange{true};
+   p.Process([&](TTreeReader &r) {
+      // the first range is slow: the other workers take over its worker's clusters
+      if (isFirstRange.exchange(false))
+         std::this_thread::sleep_for(std::chrono::milliseconds(500));
+      TTreeReaderValue<int> v(r, "v");
+      std::vector<int> values;
+      while (r.Next())
+         values.push_back(*v);
+      std::lock_guard<std::mutex> lg(m);
+      ranges.emplace_back(r.GetEntriesRange());
+      for (auto value : values)
+         ++nProcessed[value];
+   });
+   const auto nSlots = ROOT::GetThreadPoolSize();
+   ROOT::DisableImplicitMT();
+
+   // every entry is processed exactly once
+   EXPECT_EQ(std::count(nProcessed.begin(), nProcessed.end(), 1), nEntries);
+   // ranges are made of whole clusters, and are no larger than 1/(10 * nSlots) of the file (rounded up)
+   const Long64_t nClusters = nEntries / 10;
+   const Long64_t maxClustersPerRange = (nClusters + 10 * nSlots - 1) / (10 * nSlots);
+   for (const auto &range : ranges) {
+      EXPECT_EQ(range.first % 10, 0) << range.first;
+      EXPECT_EQ(range.second % 10, 0) << range.second;
+      EXPECT_LE(range.second - range.first, maxClustersPerRange * 10);
+   }
+   CheckClusters(ranges, nEntries);
+
+   gSystem->Unlink(filename);
+}
+
+TEST(TreeProcessorMT, SparseEntryList)
+{
+   const auto filename = "treeprocmt_sparseentrylist.root";
+   const auto nEntries = 20000;
+   {
+      // clusters of 100 entries, with random values that cannot be compressed
+      TFile f(filename, "recreate");
+      TTree t("t", "t");
+      int v = 0;
+      double x[16];
+      t.Branch("v", &v);
+      t.Branch("x", x, "x[16]/D");
+      t.SetAutoFlush(100);
+      std::mt19937 gen(42);
+      std::uniform_real_distribution<double> dist;
+      for (v = 0; v < nEntries; ++v) {
+         for (auto &xi : x)
+            xi = dist(gen);
+         t.Fill();
+      }
+      t.Write();
+   }
+
+   // a few entries in 4 of the 200 clusters
+   const std::vector<int> selected{310, 311, 399, 5000, 5150, 5199, 19999};
+   std::unique_ptr<TFile> f(TFile::Open(filename));
+   auto t = f->Get<TTree>("t");
+   const auto fileSize = f->GetSize();
+   TEntryList elist("elist", "elist", t);
+   for (auto entry : selected)
+      elist.Enter(entry);
+
+   std::mutex m;
+   std::vector<int> processed;
+   std::map<TFile *, Long64_t> bytesReadPerFile;
+   auto nTasks = 0u;
+   ROOT::EnableImplicitMT(4);
+   ROOT::TTreeProcessorMT p(*t, elist);
+   p.Process([&](TTreeReader &r) {
+      TTreeReaderValue<int> v(r, "v");
+      TTreeReaderArray<double> x(r, "x");
+      std::vector<int> values;
+      while (r.Next()) {
+         values.push_back(*v);
+         EXPECT_EQ(x.GetSize(), 16u);
+      }
+      std::lock_guard<std::mutex> lg(m);
+      ++nTasks;
+      // no task for the clusters without selected entries
+      EXPECT_FALSE(values.empty());
+      processed.insert(processed.end(), values.begin(), values.end());
+      auto file = r.GetTree()->GetCurrentFile();
+      bytesReadPerFile[file] = std::max(bytesReadPerFile[file], file->GetBytesRead());
+   });
+   ROOT::DisableImplicitMT();
+
+   std::sort(processed.begin(), processed.end());
+   EXPECT_EQ(processed, selected);
+   EXPECT_LE(nTasks, 4u);
+   Long64_t bytesRead = 0;
+   for (const auto &fileAndBytes : bytesReadPerFile)
+      bytesRead += fileAndBytes.second;
+   // only the clusters with selected entries are read, plus the metadata
+   EXPECT_LT(bytesRead, fileSize / 10) << bytesRead << " bytes read out of " << fileSize;
+
+   f.reset();
+   gSystem->Unlink(filename);
+}
+
 TEST(TreeProcessorMT, TreeWithFriendTree)
 {
    std::vector<std::string> fileNames = {"TreeWithFriendTree_Tree.root", "TreeWithFriendTree_Friend.root"};